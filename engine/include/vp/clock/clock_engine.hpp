@@ -26,6 +26,10 @@
 #include <vp/itf/clk.hpp>
 #include <vp/itf/implem/clock_class.hpp>
 
+// Number of cycles covered by the clock engine timing wheel. Delayed events enqueued further
+// in the future go to an overflow heap until they get close enough. Must be a power of 2.
+#define VP_CLOCK_WHEEL_SIZE 256
+
 namespace vp
 {
 
@@ -160,7 +164,34 @@ namespace vp
 
         int64_t exec();
 
-        bool has_events() { return this->nb_enqueued_to_cycle || this->delayed_queue || this->permanent_first; }
+        bool has_events() { return this->nb_delayed || this->permanent_first; }
+
+        // Insert a delayed event either into the timing wheel or into the overflow heap
+        void delayed_push(ClockEvent *event);
+
+        // Remove and return the first delayed event, which must be at cycle next_delayed_cycle
+        ClockEvent *delayed_pop();
+
+        // Remove a delayed event from wherever it is enqueued
+        void delayed_remove(ClockEvent *event);
+
+        // Get the first delayed event, or NULL if there is none
+        ClockEvent *delayed_first();
+
+        // Recompute next_delayed_cycle, knowing that no delayed event is before cycle "from"
+        void delayed_update_next(int64_t from);
+
+        // Move the timing wheel window to the specified cycle and bring back into the wheel
+        // the overflow events which now fit in it
+        void wheel_advance(int64_t base);
+
+        void wheel_push(ClockEvent *event);
+
+        void overflow_push(ClockEvent *event);
+        void overflow_remove(ClockEvent *event);
+        inline bool overflow_before(ClockEvent *a, ClockEvent *b);
+        void overflow_sift_up(int64_t index);
+        void overflow_sift_down(int64_t index);
 
         void pre_start();
 
@@ -177,7 +208,6 @@ namespace vp
         vp::Trace clock_trace;
 
         int factor;
-        ClockEvent *delayed_queue = NULL;
         ClockEvent *permanent_first = NULL;
         ClockEvent *permanent_last = NULL;
         int current_cycle = 0;
@@ -190,13 +220,35 @@ namespace vp
         // engine is updated by an external interaction.
         int64_t cycles = 0;
 
-        // Tells how many events are enqueued to the circular buffer.
-        // If it is zero, there could still be some events in the delayed queue.
-        int nb_enqueued_to_cycle = 0;
+        // Timing wheel for delayed events. Each slot contains a FIFO list of the events to be
+        // executed at a cycle within the window [wheel_base, wheel_base + VP_CLOCK_WHEEL_SIZE[,
+        // the slot being the cycle modulo the wheel size.
+        ClockEvent *wheel_first[VP_CLOCK_WHEEL_SIZE] = {};
+        ClockEvent *wheel_last[VP_CLOCK_WHEEL_SIZE] = {};
+
+        // One bit per wheel slot, set when the slot contains at least one event, so that the
+        // next non-empty slot can be found without browsing slots.
+        uint64_t wheel_bitmap[VP_CLOCK_WHEEL_SIZE / 64] = {};
+
+        // First cycle covered by the timing wheel
+        int64_t wheel_base = 0;
+
+        // Number of events in the timing wheel
+        int nb_wheel = 0;
+
+        // Delayed events which are beyond the timing wheel window, as a min-heap ordered by cycle
+        // and then by enqueue order
+        std::vector<ClockEvent *> overflow;
+
+        // Incremented for each event pushed to the overflow heap, to keep FIFO order between
+        // events enqueued at the same cycle
+        uint64_t overflow_seq = 0;
+
+        // Total number of delayed events, either in the wheel or in the overflow heap
+        int nb_delayed = 0;
 
-        // This time is relevant only when no event is enqueued into the circular
-        // buffer of event so that the number of cycles can be resynchronized when
-        // something happen (an event is pushed or the frequency is changed).
+        // This time is relevant only when no event is enqueued so that the number of cycles can
+        // be resynchronized when something happen (an event is pushed or the frequency is changed).
         // This is set when control is given back to the time engine and used
         // to recompute the numer of cycles when the engine is updated by an
         // external event.
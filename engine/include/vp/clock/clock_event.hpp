@@ -272,7 +272,14 @@ namespace vp
         int64_t stall_cycle;
         // Clock engine owning this event
         ClockEngine *clock;
+        // Clock engine whose queues contain this event while it is enqueued. This can differ from
+        // the owning engine when the block switches to another engine while the event is pending.
+        ClockEngine *queued_engine = NULL;
         bool pending_disable = false;
+        // Position of the event in the clock engine overflow heap, or -1 if it is not in it
+        int64_t queue_index = -1;
+        // Sequence number used by the clock engine overflow heap to order events at the same cycle
+        uint64_t queue_seq = 0;
     };
 
 };
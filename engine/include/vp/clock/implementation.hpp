@@ -50,7 +50,7 @@ inline void vp::Block::event_enqueue_ext(vp::ClockEvent *event, int64_t cycles)
 
 inline void vp::Block::event_cancel(vp::ClockEvent *event)
 {
-  event->clock->cancel(event);
+  event->cancel();
 }
 
 inline void vp::Block::event_reenqueue(vp::ClockEvent *event, int64_t cycles)
@@ -105,7 +105,7 @@ inline void vp::ClockEvent::cancel()
 {
     if (this->is_enqueued())
     {
-      this->clock->cancel(this);
+      this->queued_engine->cancel(this);
     }
 }
 
@@ -22,6 +22,8 @@
 #ifndef __VP_ITF_IO_HPP__
 #define __VP_ITF_IO_HPP__
 
+#include <algorithm>
+#include <vector>
 #include "vp/vp.hpp"
 #include "vp/queue.hpp"
 
@@ -58,16 +60,108 @@ namespace vp {
   #define IO_REQ_PAYLOAD_SIZE 64
   #define IO_REQ_NB_ARGS 16
 
+  // Maximum number of free requests kept by each master port, the other ones go to the pool of
+  // the thread
+  #define IO_REQ_POOL_MASTER_SIZE 32
+
+  // Value written to the fields of requests when they are freed in debug mode, so that any use
+  // after they are freed is easy to spot
+  #define IO_REQ_POISON 0xdeadbeefdeadbeefULL
+
   typedef IoReqStatus (IoReqMeth)(vp::Block *, vp::IoReq *);
   typedef IoReqStatus (IoReqMethMuxed)(vp::Block *, IoReq *, int id);
 
   typedef void (IoRespMeth)(vp::Block *, vp::IoReq *);
   typedef void (IoGrantMeth)(vp::Block *, vp::IoReq *);
 
+  class IoDmi;
+
+  typedef bool (IoDmiMeth)(vp::Block *, uint64_t addr, vp::IoDmi *dmi);
+  typedef bool (IoDmiMethMuxed)(vp::Block *, uint64_t addr, vp::IoDmi *dmi, int id);
+  typedef void (IoDmiInvalidateMeth)(vp::Block *, uint64_t base, uint64_t size);
+
+
+
+  /**
+   * @brief Direct memory interface grant
+   *
+   * A target can give an initiator a direct access to a range of its memory through a host
+   * pointer, so that the initiator can access it without sending any request. Components
+   * between the initiator and the target forward the query and convert the granted range into
+   * the address space of their input.
+   */
+  class IoDmi
+  {
+  public:
+    // First address of the granted range
+    uint64_t base = 0;
+    // Size of the granted range
+    uint64_t size = 0;
+    // Host pointer corresponding to the first address of the range
+    uint8_t *data = NULL;
+    // True if reads can be done through the host pointer
+    bool read = false;
+    // True if writes can be done through the host pointer
+    bool write = false;
+    // Fixed latency in cycles to be applied to each access
+    int64_t latency = 0;
+
+    // Restrict the granted range to the specified one. Returns false if nothing remains.
+    inline bool clip(uint64_t base, uint64_t size);
+  };
+
+  /**
+   * @brief Segment of a vectored request
+   *
+   * A vectored request carries a list of segments, each one being an access to a contiguous
+   * area, so that transfers made of many small chunks, like strided or multi-bank transfers, go
+   * through the interconnect as a single request.
+   * Each segment has its own timing, which the initiator must initialize, usually to 0, and which
+   * components update exactly as they would for a scalar request with the same address and size.
+   */
+  class IoReqSegment
+  {
+  public:
+    uint64_t addr;
+    uint64_t size;
+    uint8_t *data;
+    int64_t latency = 0;
+    int64_t duration = 0;
+  };
+
+  /**
+   * @brief Pool of free requests
+   *
+   * Requests allocated with IoMaster::req_new are taken from the pool of the master port, then
+   * from the pool of the current thread, and only allocated on the heap when both are empty, so
+   * that models allocating one request per transaction do not go through the heap allocator.
+   * Pools are not locked since the master ports of a partition are only used from the thread
+   * simulating it, and the thread pool is only used by its own thread.
+   */
+  class IoReqPool
+  {
+  public:
+    ~IoReqPool();
+
+    // Get a free request, or NULL if the pool is empty
+    inline IoReq *get();
+    // Put a request which is not used anymore into the pool
+    inline void put(IoReq *req);
+    inline int get_nb_free() { return this->nb_free; }
+
+    // Pool of the current thread, used when the pool of a master port is empty or full
+    static thread_local IoReqPool thread_pool;
+
+  private:
+    IoReq *first_free = NULL;
+    int nb_free = 0;
+  };
+
   class IoReq : public vp::QueueElem
   {
     friend class IoMaster;
     friend class IoSlave;
+    friend class IoReqPool;
 
   public:
     IoReq() {}
@@ -106,7 +200,7 @@ namespace vp {
     inline uint64_t get_latency() { return this->latency; }
     inline void inc_latency(uint64_t incr) { this->latency += incr; }
 
-    inline void set_duration(uint64_t duration) { if (duration > this->duration) this->duration = duration; }
+    inline void set_duration(uint64_t duration) { if ((int64_t)duration > this->duration) this->duration = duration; }
     inline uint64_t get_duration() { return this->duration; }
 
     inline uint64_t get_full_latency() { return latency + duration; }
@@ -152,7 +246,7 @@ namespace vp {
 
     inline void prepare() { latency = 0; duration=0; debug=false; }
     inline void init() {
-      prepare(); current_arg=0;
+      prepare(); current_arg=0; nb_segments=0;
 #ifdef VP_MEMCHECK_ACTIVE
       // In case case memory check is enabled, set it to NULL since models will check it
       // to know if they should report valid flags
@@ -160,6 +254,23 @@ namespace vp {
 #endif
     }
 
+    // Turn the request into a vectored one, accessing the specified segments. The address, size
+    // and data of the request are then not used.
+    // Vectored requests must be handled synchronously, all segments being done when the
+    // request call returns. When it returns, the latency and duration of the request are the
+    // highest ones of the segments. A slave which does not accept them receives the segments one
+    // by one through the same request, and must not reply asynchronously to any of them.
+    inline void set_segments(IoReqSegment *segments, int nb_segments) { this->segments = segments; this->nb_segments = nb_segments; }
+    inline IoReqSegment *get_segments() { return this->segments; }
+    inline int get_nb_segments() { return this->nb_segments; }
+    inline bool is_vectored() { return this->nb_segments != 0; }
+    // Set the latency and duration of the request to the highest ones of the segments
+    inline void update_segments_timing();
+    // Can be used by a component receiving a vectored request to handle its segments one by one,
+    // the handler being called with the request turned into a scalar request for each of them.
+    template<typename F>
+    inline IoReqStatus handle_segments(F handler);
+
     inline void set_initiator(int initiator) { this->initiator = initiator; }
     inline int get_initiator() { return this->initiator; }
 
@@ -178,6 +289,8 @@ namespace vp {
     int id;
     int initiator = -1;
     bool debug=false;
+    IoReqSegment *segments = NULL;
+    int nb_segments = 0;
 
 
   private:
@@ -187,6 +300,9 @@ namespace vp {
     uint8_t payload[IO_REQ_PAYLOAD_SIZE];
     void *args[IO_REQ_NB_ARGS];
     int current_arg = 0;
+    // True when the request is in a pool, used in debug mode to detect double frees and uses
+    // after free
+    bool is_free = false;
   };
 
 
@@ -206,7 +322,8 @@ namespace vp {
     // Can be called to allocate an IO request.
     inline IoReq *req_new(uint64_t addr, uint8_t *data, uint64_t size, bool is_write);
 
-    // Can be called to deallocate an IO request.
+    // Can be called to deallocate an IO request allocated with req_new. The request is recycled
+    // and must not be used anymore.
     inline void req_del(IoReq *req);
 
     // Return if this master port is bound.
@@ -221,11 +338,20 @@ namespace vp {
     // caller, not to us.
     inline IoReqStatus req_forward(IoReq *req);
 
+    // Tell if the slave accepts vectored requests. Vectored requests sent to a slave which does
+    // not accept them are split by this port into one scalar request per segment.
+    inline bool is_vectored() { return this->vectored; }
+
     // Can be called by master component to forward an IO request.
     // Compared to other req methods, with this one, the caller can define
     // on which port the response will be sent back by the slave.
     inline IoReqStatus req(IoReq *req, IoSlave *SlavePort);
 
+    // Can be called to ask for a direct memory access to the range containing the
+    // specified address. Returns true and fills dmi if it is granted.
+    // The grant stays valid until the invalidation callback is called.
+    inline bool dmi_req(uint64_t addr, IoDmi *dmi);
+
 
 
     /*
@@ -240,6 +366,10 @@ namespace vp {
     // an IO request response. Before being set, a default empty callback is active.
     inline void set_resp_meth(IoRespMeth *meth);
 
+    // Set the callback on master side called when the slave is revoking the direct memory
+    // accesses it granted on a range. Before being set, a default empty callback is active.
+    inline void set_dmi_invalidate_meth(IoDmiInvalidateMeth *meth);
+
 
 
     /*
@@ -280,6 +410,12 @@ namespace vp {
     // Default response callback, just do nothing.
     static inline void resp_default(vp::Block *, vp::IoReq *);
 
+    // DMI invalidation callback set by the user.
+    void (*dmi_invalidate_meth)(vp::Block *context, uint64_t base, uint64_t size);
+
+    // Default DMI invalidation callback, just do nothing.
+    static inline void dmi_invalidate_default(vp::Block *, uint64_t base, uint64_t size);
+
 
     /*
      * Slave callbacks
@@ -288,6 +424,10 @@ namespace vp {
     // Callback set by the user on slave port and retrieved during binding
     IoReqStatus (*req_meth)(vp::Block *, vp::IoReq *);
 
+    // Send the segments of a vectored request one by one to a slave which does not accept
+    // vectored requests
+    inline IoReqStatus req_split(IoReq *req, IoReqMeth *meth, vp::Block *context);
+
     // req_meth saved when the slave port is multiplexed as a stub is setup instead
     IoReqStatus (*req_meth_mux)(vp::Block *, IoReq *, int mux);
 
@@ -295,6 +435,20 @@ namespace vp {
     // setup instead
     IoReqStatus (*req_meth_freq_cross)(vp::Block *, vp::IoReq *);
 
+    // DMI callbacks set by the user on slave port and retrieved during binding
+    IoDmiMeth *dmi_meth = NULL;
+    IoDmiMethMuxed *dmi_meth_mux = NULL;
+
+    // Slave context for the DMI callbacks, which is kept separately since the normal one
+    // can be replaced by stubs
+    vp::Block *dmi_context = NULL;
+
+    // True if the slave accepts vectored requests
+    bool vectored = false;
+
+    // Requests freed through this port, reused by the next allocations
+    IoReqPool req_pool;
+
 
     /*
      * Stubs
@@ -384,6 +538,22 @@ namespace vp {
     // when calling the callback, and can be used to multiplex a slave port
     inline void set_req_meth_muxed(IoReqMethMuxed *meth, int id);
 
+    // Set the callback on slave side called when the master is asking for a direct memory
+    // access. Before being set, direct accesses are always refused.
+    inline void set_dmi_meth(IoDmiMeth *meth);
+
+    // Same as set_dmi_meth for a multiplexed slave port. The id is the one given to
+    // set_req_meth_muxed.
+    inline void set_dmi_meth_muxed(IoDmiMethMuxed *meth);
+
+    // Can be called by the slave to revoke the direct memory accesses granted on the specified
+    // range to all the masters bound to this port.
+    inline void dmi_invalidate(uint64_t base, uint64_t size);
+
+    // Must be called by slaves which can handle vectored requests, before the port is bound.
+    // Otherwise masters split them into scalar requests before they reach the slave.
+    inline void set_vectored(bool vectored) { this->vectored = vectored; }
+
 
 
     /*
@@ -419,6 +589,16 @@ namespace vp {
     // This one gets called instead of the normal once in case it is not NULL
     IoReqStatus (*req_meth_mux)(vp::Block *context, IoReq *, int mux);
 
+    // DMI callbacks set by the user, NULL if direct accesses are not supported
+    IoDmiMeth *dmi_meth = NULL;
+    IoDmiMethMuxed *dmi_meth_mux = NULL;
+
+    // Master ports bound to this port, which must be notified when DMI grants are revoked
+    std::vector<IoMaster *> dmi_masters;
+
+    // True if the slave accepts vectored requests
+    bool vectored = false;
+
 
 
     /*
@@ -480,6 +660,7 @@ namespace vp {
     // Set default callbacks in case the user does not set them
     this->resp_meth = &IoMaster::resp_default;
     this->grant_meth = &IoMaster::grant_default;
+    this->dmi_invalidate_meth = &IoMaster::dmi_invalidate_default;
   }
 
 
@@ -490,6 +671,10 @@ namespace vp {
     // as the slave port is serving several master ports and need
     // to reply to us.
     req->resp_port = SlavePort;
+    if (unlikely(req->nb_segments != 0 && !this->vectored))
+    {
+      return this->req_split(req, this->req_meth, (vp::Block *)this->get_remote_context());
+    }
     return this->req_meth((vp::Block *)this->get_remote_context(), req);
   }
 
@@ -499,6 +684,10 @@ namespace vp {
   {
     // We don't redefine the slave port, as the request must be forwarded,
     // this way the slave will reply directly to the previous initiator
+    if (unlikely(req->nb_segments != 0 && !this->vectored))
+    {
+      return this->req_split(req, this->req_meth, (vp::Block *)this->get_remote_context());
+    }
     return this->req_meth((vp::Block *)this->get_remote_context(), req);
   }
 
@@ -508,16 +697,66 @@ namespace vp {
   {
     // Case where the response port is given by the called
     req->resp_port = port;
+    if (unlikely(req->nb_segments != 0 && !port->vectored))
+    {
+      return this->req_split(req, port->req_meth, (vp::Block *)port->get_remote_context());
+    }
     return port->req_meth((vp::Block *)port->get_remote_context(), req);
   }
 
 
 
+  inline IoReqStatus IoMaster::req_split(IoReq *req, IoReqMeth *meth, vp::Block *context)
+  {
+    return req->handle_segments([this, context, meth](IoReq *req) {
+      IoReqStatus status = meth(context, req);
+      // The request is reused for the next segment, it can not be kept by the slave
+      vp_assert_always(status != IO_REQ_PENDING, this->get_owner()->get_trace(),
+        "Received asynchronous reply for a segment of a vectored request\n");
+      return status;
+    });
+  }
+
+
+
+
+  inline bool IoMaster::dmi_req(uint64_t addr, IoDmi *dmi)
+  {
+    if (this->dmi_meth_mux)
+    {
+      return this->dmi_meth_mux(this->dmi_context, addr, dmi, this->slave_req_mux_id);
+    }
+    else if (this->dmi_meth)
+    {
+      return this->dmi_meth(this->dmi_context, addr, dmi);
+    }
+
+    return false;
+  }
+
+
 
   inline IoReq *IoMaster::req_new(uint64_t addr, uint8_t *data, uint64_t size, bool is_write)
   {
-    // For now we allocate new requests but this would be better to manage a pool of requests
-    IoReq *req = new IoReq(addr, data, size, is_write);
+    IoReq *req = this->req_pool.get();
+    if (req == NULL)
+    {
+      req = IoReqPool::thread_pool.get();
+      if (req == NULL)
+      {
+        return new IoReq(addr, data, size, is_write);
+      }
+    }
+
+    // Recycled requests are fully reinitialized so that nothing leaks from their previous use
+    req->addr = addr;
+    req->data = data;
+    req->size = size;
+    req->is_write = (IoReqOpcode)is_write;
+    req->second_data = NULL;
+    req->second_memcheck_data = NULL;
+    req->initiator = -1;
+    req->init();
 
     return req;
   }
@@ -526,7 +765,56 @@ namespace vp {
 
   inline void IoMaster::req_del(IoReq *req)
   {
-    delete req;
+    if (this->req_pool.get_nb_free() < IO_REQ_POOL_MASTER_SIZE)
+    {
+      this->req_pool.put(req);
+    }
+    else
+    {
+      IoReqPool::thread_pool.put(req);
+    }
+  }
+
+
+
+  inline IoReq *IoReqPool::get()
+  {
+    IoReq *req = this->first_free;
+    if (req)
+    {
+      this->first_free = req->next;
+      this->nb_free--;
+#ifdef VP_TRACE_ACTIVE
+      vp_assert_always(req->is_free && req->addr == IO_REQ_POISON, NULL,
+        "IO request was modified after being freed (req: %p)\n", req);
+      req->is_free = false;
+#endif
+    }
+    return req;
+  }
+
+
+
+  inline void IoReqPool::put(IoReq *req)
+  {
+#ifdef VP_TRACE_ACTIVE
+    vp_assert_always(!req->is_free, NULL, "IO request freed twice (req: %p)\n", req);
+    req->is_free = true;
+
+    // Poison the request so that a model still using it gets garbage instead of stale but
+    // plausible values
+    req->addr = IO_REQ_POISON;
+    req->size = IO_REQ_POISON;
+    req->data = (uint8_t *)(uintptr_t)IO_REQ_POISON;
+    req->resp_port = (IoSlave *)(uintptr_t)IO_REQ_POISON;
+    req->current_arg = -1;
+    memset(req->payload, 0xdd, sizeof(req->payload));
+    memset((void *)req->args, 0xdd, sizeof(req->args));
+#endif
+
+    req->next = this->first_free;
+    this->first_free = req;
+    this->nb_free++;
   }
 
 
@@ -545,12 +833,25 @@ namespace vp {
 
 
 
+  inline void IoMaster::set_dmi_invalidate_meth(IoDmiInvalidateMeth *meth)
+  {
+    dmi_invalidate_meth = meth;
+  }
+
+
+
   inline void IoMaster::resp_default(vp::Block *, vp::IoReq *)
   {
   }
 
 
 
+  inline void IoMaster::dmi_invalidate_default(vp::Block *, uint64_t base, uint64_t size)
+  {
+  }
+
+
+
   inline void IoMaster::grant_default(vp::Block *, vp::IoReq *)
   {
   }
@@ -582,6 +883,11 @@ namespace vp {
       this->slave_context_for_mux = (vp::Block *)port->get_context();
       this->slave_req_mux_id = port->req_mux_id;
     }
+
+    this->dmi_meth = port->dmi_meth;
+    this->dmi_meth_mux = port->dmi_meth_mux;
+    this->dmi_context = (vp::Block *)port->get_context();
+    this->vectored = port->vectored;
   }
 
 
@@ -660,6 +966,7 @@ namespace vp {
     port->SlavePort->master_resp_meth = port->resp_meth;
     port->SlavePort->master_grant_meth = port->grant_meth;
     port->SlavePort->set_remote_context(port->get_context());
+    this->dmi_masters.push_back(port);
   }
 
 
@@ -680,6 +987,51 @@ namespace vp {
 
 
 
+  inline void IoSlave::set_dmi_meth(IoDmiMeth *meth)
+  {
+    this->dmi_meth = meth;
+    this->dmi_meth_mux = NULL;
+  }
+
+
+
+  inline void IoSlave::set_dmi_meth_muxed(IoDmiMethMuxed *meth)
+  {
+    this->dmi_meth_mux = meth;
+    this->dmi_meth = NULL;
+  }
+
+
+
+  inline void IoSlave::dmi_invalidate(uint64_t base, uint64_t size)
+  {
+    for (IoMaster *master: this->dmi_masters)
+    {
+      master->dmi_invalidate_meth((vp::Block *)master->get_context(), base, size);
+    }
+  }
+
+
+
+  inline bool IoDmi::clip(uint64_t base, uint64_t size)
+  {
+    uint64_t end = std::min(this->base + this->size, base + size);
+    if (base > this->base)
+    {
+      this->data += base - this->base;
+      this->base = base;
+    }
+    if (end <= this->base)
+    {
+      this->size = 0;
+      return false;
+    }
+    this->size = end - this->base;
+    return true;
+  }
+
+
+
   inline IoReqStatus IoSlave::req_default(IoSlave *, IoReq *)
   {
     return IO_REQ_OK;
@@ -761,6 +1113,52 @@ namespace vp {
   {
   }
 
+  inline void IoReq::update_segments_timing()
+  {
+    int64_t latency = 0;
+    int64_t duration = 0;
+    for (int i=0; i<this->nb_segments; i++)
+    {
+      latency = std::max(latency, this->segments[i].latency);
+      duration = std::max(duration, this->segments[i].duration);
+    }
+    this->latency = latency;
+    this->duration = duration;
+  }
+
+  template<typename F>
+  inline IoReqStatus IoReq::handle_segments(F handler)
+  {
+    IoReqSegment *segments = this->segments;
+    int nb_segments = this->nb_segments;
+    IoReqStatus status = IO_REQ_OK;
+
+    this->nb_segments = 0;
+
+    for (int i=0; i<nb_segments; i++)
+    {
+      IoReqSegment *segment = &segments[i];
+      this->addr = segment->addr;
+      this->size = segment->size;
+      this->data = segment->data;
+      this->latency = segment->latency;
+      this->duration = segment->duration;
+
+      if (handler(this) != IO_REQ_OK)
+      {
+        status = IO_REQ_INVALID;
+      }
+
+      segment->latency = this->latency;
+      segment->duration = this->duration;
+    }
+
+    this->nb_segments = nb_segments;
+    this->update_segments_timing();
+
+    return status;
+  }
+
 };
 
 #endif
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <string.h>
+#include <vector>
 
 namespace vp {
 
@@ -32,33 +33,69 @@ namespace vp {
 
     public:
         MappingTreeEntry(int id, std::string name, js::Config *config);
-        MappingTreeEntry(uint64_t base, MappingTreeEntry *left, MappingTreeEntry *right);
 
         std::string name;
         int id;
         uint64_t base = 0;
         uint64_t size = 0;
-
-    private:
-        MappingTreeEntry *next = NULL;
-        uint64_t lowest_base = 0;
-        MappingTreeEntry *left = NULL;
-        MappingTreeEntry *right = NULL;
     };
 
+    /**
+     * @brief Address map of a router
+     *
+     * Once built, the mappings are kept in a contiguous array sorted by base address, which is
+     * searched with a branch-free binary search. Requests falling outside all mappings go to the
+     * default mapping, if any.
+     */
     class MappingTree
     {
     public:
         MappingTree(vp::Trace *trace);
         void insert(int id, std::string name, js::Config *config);
         void build();
-        MappingTreeEntry *get(uint64_t base, uint64_t size, bool is_write);
+        inline MappingTreeEntry *get(uint64_t base, uint64_t size, bool is_write);
+        // Tell if a mapping returned by get can be reused for any other address it contains. This
+        // is false if some mappings overlap, since the one returned then depends on the address.
+        inline bool is_cacheable() { return this->cacheable; }
 
     private:
         vp::Trace *trace;
-        MappingTreeEntry *first_map_entry = NULL;
-        MappingTreeEntry *top_map_entry = NULL;
+        // Mappings in insertion order, before the table is built
+        std::vector<MappingTreeEntry *> mappings;
+        // Sorted table, with the bases and the entries in separate arrays so that the search
+        // only touches the bases
+        std::vector<uint64_t> bases;
+        std::vector<MappingTreeEntry *> entries;
         MappingTreeEntry *default_entry = NULL;
         MappingTreeEntry *error_entry = NULL;
+        bool cacheable = true;
     };
+
+    inline MappingTreeEntry *MappingTree::get(uint64_t base, uint64_t size, bool is_write)
+    {
+        size_t len = this->bases.size();
+
+        if (len != 0)
+        {
+            // Find the last mapping whose base is lower or equal to the address. The number of
+            // iterations only depends on the number of mappings, and the selection is a
+            // conditional move, so that the search does not suffer from branch mispredictions.
+            const uint64_t *bases = this->bases.data();
+            const uint64_t *current = bases;
+            while (len > 1)
+            {
+                size_t half = len / 2;
+                current = current[half] <= base ? current + half : current;
+                len -= half;
+            }
+
+            MappingTreeEntry *entry = this->entries[current - bases];
+            if (base - entry->base < entry->size)
+            {
+                return entry;
+            }
+        }
+
+        return this->default_entry;
+    }
 };
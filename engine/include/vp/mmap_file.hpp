@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2020  GreenWaves Technologies, SAS, SAS, ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+namespace vp {
+
+    /**
+     * @brief Allocate the content of a memory model
+     *
+     * The area is zero-filled and reserved without committing swap space, so that the host only
+     * allocates the pages which are accessed. It can then be preloaded with mmap_file.
+     *
+     * @param size Size in bytes of the area.
+     * @return The area, or NULL if it could not be allocated.
+     */
+    void *mmap_alloc(uint64_t size);
+
+    /**
+     * @brief Free an area allocated with mmap_alloc
+     *
+     * This also unmaps the files which were mapped into it.
+     */
+    void mmap_free(void *area, uint64_t size);
+
+    /**
+     * @brief Preload a memory area with a file
+     *
+     * The file is mapped over the beginning of the area instead of being read into it, so that
+     * preloading costs nothing until the pages are accessed.
+     *
+     * By default the file is mapped copy-on-write. Only the pages which are written are copied,
+     * the file is never modified and pages which are only read are shared with the host page
+     * cache. Since pages which were not copied reflect the file, it must not be modified while
+     * the simulation is running.
+     *
+     * When shared is true, the file becomes the persistent content of the whole area and
+     * everything written to the area ends up in the file. The file is created if it does not
+     * exist and extended with zeros if it is smaller than the area.
+     *
+     * @param area Area to preload, which must be page aligned and come from mmap_alloc.
+     * @param size Size in bytes of the area.
+     * @param path Path of the file.
+     * @param shared True if writes should be propagated to the file.
+     * @return The number of bytes at the beginning of the area which now come from the file, or
+     *     -1 on failure, in which case errno gives the reason.
+     */
+    int64_t mmap_file(void *area, uint64_t size, std::string path, bool shared);
+
+};
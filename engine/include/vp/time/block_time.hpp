@@ -109,8 +109,12 @@ namespace vp
         // Access to parent class owning this BlockTime
         vp::Block &top;
 
-        // Next block in the queue. Used by time scheduler to queue this block
-        vp::Block *next;
+        // Position of this block in the time engine queue. Only valid when the block is enqueued.
+        int64_t queue_index = -1;
+
+        // Sequence number given by the time engine when this block is enqueued, used to order
+        // blocks having the same timestamp
+        uint64_t queue_seq = 0;
 
         // True if this block is currently being executed by the time engine
         bool running = false;
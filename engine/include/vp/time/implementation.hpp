@@ -94,9 +94,27 @@ inline void vp::TimeEngine::update(int64_t time)
         this->time = time;
 }
 
+inline vp::Block *vp::TimeEngine::first_client_get()
+{
+    return this->clients.size() ? this->clients[0] : NULL;
+}
+
+inline bool vp::TimeEngine::queue_before(vp::Block *a, vp::Block *b)
+{
+    // Clients with the same timestamp are executed in reverse order of enqueueing
+    return a->time.next_event_time < b->time.next_event_time ||
+        (a->time.next_event_time == b->time.next_event_time && a->time.queue_seq > b->time.queue_seq);
+}
+
 inline int64_t vp::TimeEngine::get_next_event_time()
 {
-    return this->first_client ? this->first_client->time.next_event_time : -1;
+    vp::Block *first = this->first_client_get();
+    return first ? first->time.next_event_time : -1;
+}
+
+inline bool vp::TimeEngine::is_partitioned()
+{
+    return this->parent != NULL || this->partitions.size() != 0;
 }
 
 inline bool vp::BlockTime::enqueue_to_engine(int64_t time)
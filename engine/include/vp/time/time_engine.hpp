@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <vector>
+#include <pthread.h>
 #include "vp/json.hpp"
 
 namespace vp
@@ -28,16 +31,23 @@ namespace vp
     class BlockTime;
     class Component;
     class Time_engine_stop_event;
+    class Time_engine_window_event;
+    class PartitionBench;
+
+    typedef void (TimeSyncMeth)(vp::Block *, void *);
 
     class TimeEngine
     {
 
         friend class gv::GvsocLauncher;
         friend class vp::Time_engine_stop_event;
+        friend class vp::Time_engine_window_event;
         friend class vp::BlockTime;
         friend class vp::ClockEngine;
         friend class vp::Top;
         friend class gv::GvProxy;
+        // Benchmark of the parallel mode, which drives the engine as the launcher does
+        friend class vp::PartitionBench;
 
     public:
         TimeEngine(js::Config *config);
@@ -84,6 +94,54 @@ namespace vp
         void pause();
 
 
+        /**
+         * @brief Create a time partition
+         *
+         * In parallel mode, this creates a new time engine which will execute the events of a
+         * sub-tree of components in its own host thread. All partitions are synchronized
+         * at each time quantum.
+         * If parallel mode is not enabled, this returns this engine, so that the components stay
+         * in the same partition.
+         *
+         * @return The time engine of the new partition
+         */
+        vp::TimeEngine *partition_new();
+
+        /**
+         * @brief Tell if the simulation is split into several partitions
+         *
+         * @return True if events are executed by several engines in parallel
+         */
+        inline bool is_partitioned();
+
+        /**
+         * @brief Post a callback to another partition
+         *
+         * In parallel mode, a partition must not directly call components of another partition.
+         * Instead, it can post a callback which will be executed at the next synchronization point,
+         * when all partitions are stopped. Callbacks posted during the same quantum are executed
+         * in a fixed order, partition by partition, so that the simulation stays deterministic.
+         * If the simulation is not partitioned, the callback is immediately executed.
+         *
+         * @param block The block given as first argument of the callback.
+         * @param meth The callback.
+         * @param arg The data given as second argument of the callback.
+         */
+        void sync_post(vp::Block *block, vp::TimeSyncMeth *meth, void *arg);
+
+        /**
+         * @brief Register a callback executed by host threads when they stop executing events
+         *
+         * The callback is executed by the host thread which executed the events, each time the
+         * engine stops, and in parallel mode at the end of each window. Models keeping some
+         * state in the host thread, like the host FP exceptions, can use it to flush this state
+         * before other threads access the models. Registering the same callback several times
+         * has no effect.
+         *
+         * @param callback The callback.
+         */
+        static void thread_flush_register(void (*callback)());
+
         /**
          * @brief DEPRECATED
          * I2s_verif still using it, should switch to time_event
@@ -111,6 +169,18 @@ namespace vp
 
         bool enqueue(vp::Block *client, int64_t time);
 
+        // Get the client with the earliest event, or NULL if none is enqueued
+        inline vp::Block *first_client_get();
+
+        // Insert, remove and reorder clients in the queue. The queue is an indexed 4-ary heap,
+        // each client knows its position so that it can be removed in O(log n).
+        void queue_push(vp::Block *client);
+        void queue_pop();
+        void queue_remove(vp::Block *client);
+        inline bool queue_before(vp::Block *a, vp::Block *b);
+        void queue_sift_up(int64_t index);
+        void queue_sift_down(int64_t index);
+
         bool handle_locks();
 
         inline int64_t get_next_event_time();
@@ -123,8 +193,36 @@ namespace vp
         gv::Gvsoc_user *launcher_get() { return this->launcher; }
 
         int64_t exec();
+        int64_t exec_events();
         void flush_all();
 
+        // Execute events of all partitions, by windows of one quantum
+        int64_t exec_parallel();
+
+        // Execute the events of this partition until the end of the current window
+        void partition_exec_window(int64_t end_time);
+
+        // Get the time of the first event over all partitions
+        int64_t partitions_next_event_time();
+
+        // Execute all pending callbacks posted between partitions
+        void sync_flush();
+
+        // Routine of the host thread executing a partition
+        static void *partition_routine(void *arg);
+
+        // Execute the callbacks registered with thread_flush_register
+        static void thread_flush();
+
+        // Wait for all partitions at the end of the window, accounting the wait in the statistics
+        void partition_window_end_wait();
+
+        // Dump the statistics of the partitions, if they were enabled
+        void partitions_stats_dump();
+
+        // Make the partition threads exit and wait for them
+        void partitions_join();
+
         inline void critical_enter();
         inline void critical_exit();
         inline void critical_wait();
@@ -137,10 +235,15 @@ namespace vp
         // Get retain count
         inline int retain_count();
 
-        // List of clients having time events to execute.
-        // They are sorted out according to the timestamp of their first event,
-        // from lowest to highest
-        vp::Block *first_client = NULL;
+        // Clients having time events to execute.
+        // This is a min-heap ordered by the timestamp of their first event, clients with the
+        // same timestamp being executed in reverse order of enqueueing, as with the sorted list
+        // used before.
+        std::vector<vp::Block *> clients;
+
+        // Incremented each time a client is enqueued, used to execute the last enqueued client
+        // first between clients with the same timestamp
+        uint64_t enqueue_seq = 0;
 
         // Mutex used to update the count of pending lock requests
         pthread_mutex_t lock_mutex;
@@ -160,13 +263,16 @@ namespace vp
         // Top component of the system
         Component *top;
 
+        // Requests below can be posted by other host threads, like the launcher or the partition
+        // threads, which is why they are atomic.
+
         // True to make the engine goes out of his main fast loop. This is a way to make it go to
         // his slow loop so that it checks if there is a lock or a pause request
-        bool stop_req = false;
+        std::atomic<bool> stop_req{false};
 
         // Set to true when the engine should pause the simulation. A stop request should also be
         // posted to make the engine goes out of the fast loop.
-        bool pause_req = false;
+        std::atomic<bool> pause_req{false};
 
         // True if someone has requested to lock the engine. Locking the engine means that
         // an external thread wants to interact with the models.
@@ -174,7 +280,7 @@ namespace vp
         int lock_req = 0;
 
         // True if the engine should quit. A stop request must also be posted.
-        bool finished = false;
+        std::atomic<bool> finished{false};
 
         // This gives teh exit status when engine has finished
         int stop_status = -1;
@@ -189,5 +295,65 @@ namespace vp
         // In synchronous mode, since several threads can control the time, there is a retain
         // mechanism which makes sure time is progressing only if all threads ask for it.
         int retain = 0;
+
+        // True if simulation can be split into partitions executed in parallel
+        bool parallel_enabled = false;
+
+        // Duration in picoseconds of the windows during which partitions are executed
+        // without synchronizing
+        int64_t quantum = 0;
+
+        // For partition engines, engine which is synchronizing all partitions
+        vp::TimeEngine *parent = NULL;
+
+        // For the main engine, engines of the other partitions
+        std::vector<vp::TimeEngine *> partitions;
+
+        // Host threads executing the other partitions, created when the simulation starts
+        std::vector<pthread_t> partition_threads;
+
+        // Barriers used by all partitions to start and end each window
+        pthread_barrier_t window_start_barrier;
+        pthread_barrier_t window_end_barrier;
+
+        // Set by the main engine before releasing the window start barrier to make the partition
+        // threads exit
+        bool partitions_exit = false;
+
+        // End of the window currently executed by the partitions
+        int64_t window_end = 0;
+
+        // Event used to stop this partition at the end of each window
+        Time_engine_window_event *window_event = NULL;
+
+        // Set to true by the window event once the partition has reached the end of the window
+        bool window_done = false;
+
+        // Callbacks posted by the partition executed by this engine to other partitions
+        struct SyncRequest
+        {
+            vp::Block *block;
+            vp::TimeSyncMeth *meth;
+            void *arg;
+        };
+        std::vector<SyncRequest> sync_requests;
+
+        // True if host time statistics must be collected for each partition and dumped at the
+        // end of the simulation
+        bool parallel_stats = false;
+        // Number of windows executed by this partition
+        int64_t stats_windows = 0;
+        // Host time in nanoseconds spent executing the events of this partition
+        int64_t stats_busy_time = 0;
+        // Host time in nanoseconds spent waiting for the other partitions at the end of windows
+        int64_t stats_wait_time = 0;
+        // Number of callbacks posted by this partition to the other ones
+        int64_t stats_sync_requests = 0;
+
+        // Engine whose partition is being executed by the current host thread
+        static thread_local vp::TimeEngine *running_engine;
+
+        // Callbacks registered with thread_flush_register
+        static std::vector<void (*)()> thread_flush_callbacks;
     };
 };
@@ -85,11 +85,13 @@ namespace vp {
 
   inline void vp::Trace::fatal(const char *fmt, ...)
   {
+    flockfile(this->trace_file);
     dump_fatal_header();
     va_list ap;
     va_start(ap, fmt);
     if (vfprintf(this->trace_file, fmt, ap) < 0) {}
     va_end(ap);
+    funlockfile(this->trace_file);
     exit(1);
   }
 
@@ -97,11 +99,13 @@ namespace vp {
   #ifdef VP_TRACE_ACTIVE
   	if (is_active && comp->traces.get_trace_engine()->get_trace_level() >= this->level)
     {
+      flockfile(this->trace_file);
       dump_warning_header();
       va_list ap;
       va_start(ap, fmt);
       if (vfprintf(this->trace_file, fmt, ap) < 0) {}
       va_end(ap);
+      funlockfile(this->trace_file);
 
 
       if (comp->traces.get_trace_engine()->get_werror())
@@ -118,11 +122,13 @@ namespace vp {
     {
       if (comp->traces.get_trace_engine()->is_warning_active(type))
       {
+        flockfile(this->trace_file);
         dump_warning_header();
         va_list ap;
         va_start(ap, fmt);
         if (vfprintf(this->trace_file, fmt, ap) < 0) {}
         va_end(ap);
+        funlockfile(this->trace_file);
 
         if (comp->traces.get_trace_engine()->get_werror())
         {
@@ -138,11 +144,13 @@ namespace vp {
   #ifdef VP_TRACE_ACTIVE
   	if (is_active && comp->traces.get_trace_engine()->get_trace_level() >= this->level)
     {
+      flockfile(this->trace_file);
       dump_header();
       va_list ap;
       va_start(ap, fmt);
       if (vfprintf(this->trace_file, fmt, ap) < 0) {}
-      va_end(ap);  
+      va_end(ap);
+      funlockfile(this->trace_file);
     }
   #endif
   }
@@ -152,6 +160,7 @@ namespace vp {
   #ifdef VP_TRACE_ACTIVE
     if (is_active && comp->traces.get_trace_engine()->get_trace_level() >= level)
     {
+      flockfile(this->trace_file);
       dump_header();
       if (level == vp::Trace::LEVEL_ERROR)
       {
@@ -164,11 +173,12 @@ namespace vp {
       va_list ap;
       va_start(ap, fmt);
       if (vfprintf(this->trace_file, fmt, ap) < 0) {}
-      va_end(ap);  
+      va_end(ap);
       if (level == vp::Trace::LEVEL_ERROR || level == vp::Trace::LEVEL_WARNING)
       {
         fprintf(this->trace_file, "\033[0m");
       }
+      funlockfile(this->trace_file);
     }
   #endif
   }
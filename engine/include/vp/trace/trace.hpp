@@ -76,6 +76,9 @@ namespace vp {
     void set_full_path(std::string path) { this->full_path = path; }
     std::string get_full_path() { return this->full_path; }
 
+    // Headers are dumped with a separate write from the message, callers must hold the lock of
+    // the trace file around both, so that partition threads sharing the file do not interleave
+    // their lines
     void dump_header();
     void dump_warning_header();
     void dump_fatal_header();
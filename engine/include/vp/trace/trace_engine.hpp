@@ -38,6 +38,8 @@ namespace vp {
 
     #define TRACE_FORMAT_LONG  0
     #define TRACE_FORMAT_SHORT 1
+    // Instruction traces are dumped in a binary format, other traces use the long format
+    #define TRACE_FORMAT_BINARY 2
 
     class trace_regex
     {
@@ -58,6 +60,9 @@ namespace vp {
         ~TraceEngine();
 
         int get_format() { return this->trace_format; }
+
+        // Return the active traces which are dumped to the specified file
+        std::vector<vp::Trace *> get_file_traces(FILE *file);
         
         void set_vcd_user(gv::Vcd_user *user);
 
@@ -101,6 +106,8 @@ namespace vp {
 
         void start();
         void check_traces();
+        // Tell if at least one event trace is being dumped
+        bool has_active_events();
 
         int get_max_path_len() { return max_path_len; }
 
@@ -140,7 +147,7 @@ namespace vp {
         std::unordered_map<std::string, std::string> active_events;
 
         FILE *trace_file;
-        vp::Component *top;
+        vp::Component *top = NULL;
         js::Config *config;
 
         void enqueue_pending(vp::Trace *trace, int64_t timestamp, int64_t cycles, uint8_t *event);
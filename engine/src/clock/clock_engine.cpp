@@ -89,6 +89,7 @@ vp::ClockEvent *vp::ClockEngine::enable(vp::ClockEvent *event)
             this->permanent_first = event;
 
             event->enqueued = true;
+            event->queued_engine = this;
             event->cycle = -1;
         }
     }
@@ -98,7 +99,7 @@ vp::ClockEvent *vp::ClockEngine::enable(vp::ClockEvent *event)
 
 void vp::ClockEngine::stalled_event_handler(vp::Block *__this, ClockEvent *event)
 {
-    vp::ClockEngine *_this = (vp::ClockEngine *)event->clock;
+    vp::ClockEngine *_this = event->queued_engine;
 
     if (event->pending_disable)
     {
@@ -268,8 +269,10 @@ vp::ClockEvent *vp::ClockEngine::enqueue(vp::ClockEvent *event, int64_t cycle)
             return event;
         }
 
-        // Otherwise cancel it, so that we can enqueue it with new lower cycle count
-        this->cancel(event);
+        // Otherwise cancel it, so that we can enqueue it with new lower cycle count.
+        // The event may be enqueued in another clock engine, which is the only one
+        // knowing where it is queued.
+        event->queued_engine->cancel(event);
     }
 
     vp_assert(!event->enqueued, 0, "Enqueueing already enqueued event\n");
@@ -277,6 +280,7 @@ vp::ClockEvent *vp::ClockEngine::enqueue(vp::ClockEvent *event, int64_t cycle)
 
     event->enqueued = true;
     event->clock = this;
+    event->queued_engine = this;
 
     if (unlikely(!this->time.is_running()))
     {
@@ -286,76 +290,295 @@ vp::ClockEvent *vp::ClockEngine::enqueue(vp::ClockEvent *event, int64_t cycle)
         }
     }
 
-    vp::ClockEvent *current = delayed_queue, *prev = NULL;
+    event->cycle = full_cycle;
+
+    this->delayed_push(event);
+
+    return event;
+}
 
-    while (current && current->cycle <= full_cycle)
+void vp::ClockEngine::delayed_push(vp::ClockEvent *event)
+{
+    this->nb_delayed++;
+
+    if (event->cycle < this->next_delayed_cycle)
     {
-        prev = current;
-        current = current->next;
+        this->next_delayed_cycle = event->cycle;
     }
 
-    if (prev)
-        prev->next = event;
+    if (event->cycle - this->wheel_base < VP_CLOCK_WHEEL_SIZE)
+    {
+        this->wheel_push(event);
+    }
     else
-        delayed_queue = event;
-    event->next = current;
-    event->cycle = full_cycle;
+    {
+        this->overflow_push(event);
+    }
+}
 
-    this->next_delayed_cycle = this->delayed_queue->cycle;
+void vp::ClockEngine::wheel_push(vp::ClockEvent *event)
+{
+    int slot = event->cycle & (VP_CLOCK_WHEEL_SIZE - 1);
+
+    // Events are appended so that events at the same cycle are executed in enqueue order
+    event->next = NULL;
+    event->prev = this->wheel_last[slot];
+    if (this->wheel_last[slot])
+    {
+        this->wheel_last[slot]->next = event;
+    }
+    else
+    {
+        this->wheel_first[slot] = event;
+        this->wheel_bitmap[slot >> 6] |= 1ULL << (slot & 63);
+    }
+    this->wheel_last[slot] = event;
+    this->nb_wheel++;
+}
+
+vp::ClockEvent *vp::ClockEngine::delayed_pop()
+{
+    int64_t cycle = this->next_delayed_cycle;
+    vp::ClockEvent *event = this->delayed_first();
+
+    this->delayed_remove(event);
+    this->delayed_update_next(cycle);
 
     return event;
 }
 
-vp::ClockEvent *vp::ClockEngine::get_next_event()
+void vp::ClockEngine::delayed_remove(vp::ClockEvent *event)
 {
-    // There is no quick way of getting the next event.
-    // We have to first check if there is an event in the circular buffer
-    // and if not in the delayed queue
+    this->nb_delayed--;
 
-    if (this->permanent_first)
+    if (event->queue_index != -1)
     {
-        return this->permanent_first;
+        this->overflow_remove(event);
+        return;
     }
 
-    return this->delayed_queue;
+    int slot = event->cycle & (VP_CLOCK_WHEEL_SIZE - 1);
+
+    if (event->prev)
+    {
+        event->prev->next = event->next;
+    }
+    else
+    {
+        this->wheel_first[slot] = event->next;
+    }
+
+    if (event->next)
+    {
+        event->next->prev = event->prev;
+    }
+    else
+    {
+        this->wheel_last[slot] = event->prev;
+    }
+
+    if (this->wheel_first[slot] == NULL)
+    {
+        this->wheel_bitmap[slot >> 6] &= ~(1ULL << (slot & 63));
+    }
+
+    this->nb_wheel--;
 }
 
-void vp::ClockEngine::cancel(vp::ClockEvent *event)
+vp::ClockEvent *vp::ClockEngine::delayed_first()
 {
-    if (!event->is_enqueued())
+    if (this->nb_wheel)
+    {
+        return this->wheel_first[this->next_delayed_cycle & (VP_CLOCK_WHEEL_SIZE - 1)];
+    }
+    else if (this->overflow.size())
+    {
+        return this->overflow[0];
+    }
+    return NULL;
+}
+
+void vp::ClockEngine::delayed_update_next(int64_t from)
+{
+    if (this->nb_wheel)
+    {
+        // Wheel events are all in the window [from, wheel_base + VP_CLOCK_WHEEL_SIZE[, each
+        // slot holding a single cycle, so we just need to find the first non-empty slot,
+        // starting from the one of cycle "from" and wrapping around.
+        int start = from & (VP_CLOCK_WHEEL_SIZE - 1);
+        int word = start >> 6;
+        uint64_t bits = this->wheel_bitmap[word] & (~0ULL << (start & 63));
+        int nb_words = VP_CLOCK_WHEEL_SIZE / 64;
+
+        for (int i=0; i<=nb_words; i++)
+        {
+            if (bits)
+            {
+                int slot = (word << 6) + __builtin_ctzll(bits);
+                this->next_delayed_cycle = from + ((slot - start) & (VP_CLOCK_WHEEL_SIZE - 1));
+                return;
+            }
+            word = (word + 1) & (nb_words - 1);
+            bits = this->wheel_bitmap[word];
+        }
+    }
+
+    if (this->overflow.size())
+    {
+        this->next_delayed_cycle = this->overflow[0]->cycle;
+    }
+    else
+    {
+        this->next_delayed_cycle = INT64_MAX;
+    }
+}
+
+void vp::ClockEngine::wheel_advance(int64_t base)
+{
+    if (base <= this->wheel_base)
+    {
         return;
+    }
 
-    // There is no way to know if the event is enqueued into the circular buffer
-    // or in the delayed queue so first go through the delayed queue and if it is
-    // not found, look in the circular buffer
+    this->wheel_base = base;
 
-    // First the delayed queue
-    vp::ClockEvent *current = delayed_queue, *prev = NULL;
-    while (current)
+    while (this->overflow.size() && this->overflow[0]->cycle - base < VP_CLOCK_WHEEL_SIZE)
     {
-        if (current == event)
+        vp::ClockEvent *event = this->overflow[0];
+        this->overflow_remove(event);
+        this->wheel_push(event);
+    }
+}
+
+inline bool vp::ClockEngine::overflow_before(vp::ClockEvent *a, vp::ClockEvent *b)
+{
+    return a->cycle < b->cycle || (a->cycle == b->cycle && a->queue_seq < b->queue_seq);
+}
+
+void vp::ClockEngine::overflow_sift_up(int64_t index)
+{
+    vp::ClockEvent *event = this->overflow[index];
+
+    while (index > 0)
+    {
+        int64_t parent = (index - 1) >> 1;
+        vp::ClockEvent *parent_event = this->overflow[parent];
+        if (!this->overflow_before(event, parent_event))
         {
-            if (prev)
-                prev->next = event->next;
-            else
-                delayed_queue = event->next;
+            break;
+        }
+        this->overflow[index] = parent_event;
+        parent_event->queue_index = index;
+        index = parent;
+    }
+
+    this->overflow[index] = event;
+    event->queue_index = index;
+}
+
+void vp::ClockEngine::overflow_sift_down(int64_t index)
+{
+    int64_t size = this->overflow.size();
+    vp::ClockEvent *event = this->overflow[index];
+
+    while (1)
+    {
+        int64_t child = (index << 1) + 1;
+        if (child >= size)
+        {
+            break;
+        }
 
-            goto end;
+        if (child + 1 < size && this->overflow_before(this->overflow[child + 1], this->overflow[child]))
+        {
+            child++;
         }
 
-        prev = current;
-        current = current->next;
+        if (!this->overflow_before(this->overflow[child], event))
+        {
+            break;
+        }
+
+        this->overflow[index] = this->overflow[child];
+        this->overflow[index]->queue_index = index;
+        index = child;
     }
 
-    event->disable();
+    this->overflow[index] = event;
+    event->queue_index = index;
+}
+
+void vp::ClockEngine::overflow_push(vp::ClockEvent *event)
+{
+    event->queue_seq = this->overflow_seq++;
+    this->overflow.push_back(event);
+    this->overflow_sift_up(this->overflow.size() - 1);
+}
 
-    // TODO some models are pushing events to a different one that that they belong to
-    // vp_assert(0, NULL, "Didn't find event in any queue while canceling event\n");
+void vp::ClockEngine::overflow_remove(vp::ClockEvent *event)
+{
+    int64_t index = event->queue_index;
+    vp::ClockEvent *last = this->overflow.back();
+    this->overflow.pop_back();
+    event->queue_index = -1;
 
-end:
-    event->enqueued = false;
+    if (last != event)
+    {
+        this->overflow[index] = last;
+        last->queue_index = index;
+        if (index > 0 && this->overflow_before(last, this->overflow[(index - 1) >> 1]))
+        {
+            this->overflow_sift_up(index);
+        }
+        else
+        {
+            this->overflow_sift_down(index);
+        }
+    }
+}
+
+vp::ClockEvent *vp::ClockEngine::get_next_event()
+{
+    if (this->permanent_first)
+    {
+        return this->permanent_first;
+    }
+
+    return this->delayed_first();
+}
+
+void vp::ClockEngine::cancel(vp::ClockEvent *event)
+{
+    if (!event->is_enqueued())
+        return;
+
+    // The event may be queued in another engine, e.g. when the component switched its clock
+    // while the event was pending, or when the event is cancelled through another engine. Only
+    // the engine where it was queued can remove it, and its owning engine may already have
+    // been changed, so the queue is taken from the event.
+    if (event->queued_engine != this)
+    {
+        event->queued_engine->cancel(event);
+        return;
+    }
+
+    // Permanent events have their cycle set to -1, all others are delayed events which can
+    // be removed directly from the wheel or the overflow heap.
+    if (event->cycle == -1)
+    {
+        event->disable();
+    }
+    else
+    {
+        this->delayed_remove(event);
+
+        if (event->cycle == this->next_delayed_cycle)
+        {
+            this->delayed_update_next(event->cycle);
+        }
+    }
 
-    this->next_delayed_cycle = this->delayed_queue ? this->delayed_queue->cycle : INT64_MAX;
+    event->enqueued = false;
 
     if (!this->has_events())
         this->dequeue_from_engine();
@@ -397,7 +620,7 @@ int64_t vp::ClockEngine::exec()
                 if (likely(this->next_delayed_cycle > this->cycles))
                 {
                     vp::TimeEngine *engine = this->time_engine;
-                    if (likely(time_engine->first_client == NULL && !time_engine->stop_req))
+                    if (likely(time_engine->clients.size() == 0 && !time_engine->stop_req))
                     {
                         engine->time += period;
                         current = this->permanent_first;
@@ -413,23 +636,19 @@ int64_t vp::ClockEngine::exec()
     }
     else
     {
-        vp_assert(this->cycles <= delayed_queue->cycle, NULL, "Executing event in the past\n");
+        vp_assert(this->cycles <= this->next_delayed_cycle, NULL, "Executing event in the past\n");
 
-        this->cycles = delayed_queue->cycle;
+        this->cycles = this->next_delayed_cycle;
     }
 
-    while (delayed_queue)
-    {
-        if (delayed_queue->cycle > this->get_cycles())
-        {
-            break;
-        }
+    // Move the wheel window forward, so that events enqueued from now on can use the whole
+    // wheel. All delayed events are at or after the current cycle.
+    this->wheel_advance(std::min(this->cycles, this->next_delayed_cycle));
 
-        ClockEvent *current = delayed_queue;
+    while (this->next_delayed_cycle <= this->get_cycles())
+    {
+        ClockEvent *current = this->delayed_pop();
         current->enqueued = false;
-        delayed_queue = delayed_queue->next;
-
-        this->next_delayed_cycle = this->delayed_queue ? this->delayed_queue->cycle : INT64_MAX;
 
         current->meth(current->_this, current);
     }
@@ -443,9 +662,9 @@ int64_t vp::ClockEngine::exec()
     else
     {
 
-        if (delayed_queue)
+        if (this->nb_delayed)
         {
-            int64_t cycle_diff = delayed_queue->cycle - get_cycles();
+            int64_t cycle_diff = this->next_delayed_cycle - get_cycles();
             int64_t time_diff = cycle_diff * period;
             return time_diff;
         }
@@ -460,7 +679,7 @@ vp::ClockEvent *vp::ClockEngine::reenqueue(vp::ClockEvent *event, int64_t enqueu
 {
     if (event->is_enqueued())
     {
-        cancel(event);
+        event->queued_engine->cancel(event);
     }
 
     enqueue(event, enqueue_cycles);
@@ -521,7 +740,6 @@ vp::ClockEngine::ClockEngine(vp::ComponentConf &config)
     apply_frequency_event(this, &vp::ClockEngine::apply_frequency_handler)
 {
     this->time_engine = config.time_engine;
-    delayed_queue = NULL;
     current_cycle = 0;
 
     this->apply_frequency(get_js_config()->get_child_int("frequency"));
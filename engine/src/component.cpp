@@ -364,8 +364,17 @@ void vp::Component::reset_sync(vp::Block *__this, bool active)
 
 vp::Component *vp::Component::new_component(std::string name, js::Config *config, std::string module_name)
 {
+    vp::TimeEngine *time_engine = this->time.get_engine();
+
+    // Components flagged as time partitions get their own engine, so that their events can be
+    // executed in parallel with the rest of the system
+    if (config->get_child_bool("time_partition"))
+    {
+        time_engine = time_engine->partition_new();
+    }
+
     vp::Component *instance = vp::Component::load_component(config, this->gv_config, this, name,
-        this->time.get_engine(), this->traces.get_trace_engine(), this->power.get_engine());
+        time_engine, this->traces.get_trace_engine(), this->power.get_engine());
 
     this->get_trace()->msg(vp::Trace::LEVEL_DEBUG, "New component (name: %s)\n", name.c_str());
 
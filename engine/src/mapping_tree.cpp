@@ -21,24 +21,14 @@
 
 #include <vp/vp.hpp>
 #include <vp/mapping_tree.hpp>
+#include <algorithm>
 
 vp::MappingTreeEntry::MappingTreeEntry(int id, std::string name, js::Config *config)
 {
     this->id = id;
     this->name = name;
-    js::Config *conf;
     this->base = config->get_uint("base");
     this->size = config->get_uint("size");
-    this->lowest_base = base;
-}
-
-vp::MappingTreeEntry::MappingTreeEntry(uint64_t base, vp::MappingTreeEntry *left,
-    vp::MappingTreeEntry *right)
-{
-    this->base = base;
-    this->left = left;
-    this->right = right;
-    this->lowest_base = left->lowest_base;
 }
 
 vp::MappingTree::MappingTree(vp::Trace *trace)
@@ -62,76 +52,24 @@ void vp::MappingTree::insert(int id, std::string name, js::Config *config)
         }
         else
         {
-            vp::MappingTreeEntry *current = this->first_map_entry;
-            vp::MappingTreeEntry *prev = NULL;
-
-            while (current && current->base < entry->base)
-            {
-                prev = current;
-                current = current->next;
-            }
-
-            if (prev == NULL)
-            {
-                entry->next = this->first_map_entry;
-                this->first_map_entry = entry;
-            }
-            else
-            {
-                entry->next = current;
-                prev->next = entry;
-            }
-        }
-    }
-}
-
-vp::MappingTreeEntry *vp::MappingTree::get(uint64_t base, uint64_t size, bool is_write)
-{
-    vp::MappingTreeEntry *entry = this->top_map_entry;
-
-    if (entry)
-    {
-        while(1) {
-            // The entry does not have any child, this means we are at a final entry
-            if (entry->left == NULL)
-            {
-                break;
-            }
-
-            if (base >= entry->base)
-            {
-                entry = entry->right;
-            }
-            else
-            {
-                entry = entry->left;
-            }
-        }
-
-        if (entry && (base < entry->base || base > entry->base + entry->size - 1))
-        {
-            entry = NULL;
+            this->mappings.push_back(entry);
         }
     }
-
-    if (entry == NULL)
-    {
-        entry = this->default_entry;
-    }
-
-    return entry;
 }
 
 void vp::MappingTree::build()
 {
-    vp::MappingTreeEntry *current = this->first_map_entry;
+    // Mappings with the same base are kept in reverse insertion order, so that the first one
+    // inserted is the last one and is the one selected by the search
+    std::vector<vp::MappingTreeEntry *> sorted(this->mappings.rbegin(), this->mappings.rend());
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](vp::MappingTreeEntry *a, vp::MappingTreeEntry *b) { return a->base < b->base; });
 
     this->trace->msg(vp::Trace::LEVEL_INFO, "Building router table\n");
-    while(current)
+    for (vp::MappingTreeEntry *entry: sorted)
     {
         this->trace->msg(vp::Trace::LEVEL_INFO, "  0x%16llx : 0x%16llx -> %s\n",
-            current->base, current->base + current->size, current->name.c_str());
-        current = current->next;
+            entry->base, entry->base + entry->size, entry->name.c_str());
     }
 
     if (this->error_entry != NULL)
@@ -146,60 +84,22 @@ void vp::MappingTree::build()
             this->default_entry->name.c_str());
     }
 
-    vp::MappingTreeEntry *first_in_level = this->first_map_entry;
-
-    // Loop until we merged everything into a single entry
-    // Start with the routing table entries
-    current = this->first_map_entry;
-
-    // The first loop is here to loop until we have merged everything to a single entry
-    while(1) {
-        // Gives the map entry that should be on the left side of the next created entry
-        vp::MappingTreeEntry *left = NULL;
-
-        // Gives the last allocated entry where the entry should be inserted
-        vp::MappingTreeEntry *current_in_level=NULL;
-
-        // The second loop is iterating on a single level to merge entries 2 by 2
-        while(current)
-        {
-            if (left == NULL)
-            {
-                left = current;
-            }
-            else
-            {
-                vp::MappingTreeEntry *entry = new vp::MappingTreeEntry(current->lowest_base, left, current);
-
-                left = NULL;
-                if (current_in_level)
-                {
-                    current_in_level->next = entry;
-                }
-                else
-                {
-                    first_in_level = entry;
-                }
-                current_in_level = entry;
-            }
-
-            current = current->next;
-        }
+    this->bases.clear();
+    this->entries.clear();
+    this->cacheable = true;
 
-        current = first_in_level;
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        vp::MappingTreeEntry *entry = sorted[i];
 
-        // Stop in case we got a single entry
-        if (current_in_level == NULL)
+        if (i + 1 < sorted.size() && sorted[i + 1]->base - entry->base < entry->size)
         {
-            break;
+            this->trace->msg(vp::Trace::LEVEL_DEBUG, "Mapping %s overlaps mapping %s\n",
+                entry->name.c_str(), sorted[i + 1]->name.c_str());
+            this->cacheable = false;
         }
 
-        // In case an entry is alone, insert it at the end, it will be merged with an upper entry
-        if (left != NULL)
-        {
-            current_in_level->next = left;
-        }
+        this->bases.push_back(entry->base);
+        this->entries.push_back(entry);
     }
-
-    this->top_map_entry = first_in_level;
 }
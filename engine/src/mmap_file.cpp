@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2020  GreenWaves Technologies, SAS, SAS, ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <vp/mmap_file.hpp>
+
+void *vp::mmap_alloc(uint64_t size)
+{
+    void *area = mmap(NULL, std::max<uint64_t>(size, 1), PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    return area == MAP_FAILED ? NULL : area;
+}
+
+void vp::mmap_free(void *area, uint64_t size)
+{
+    if (area)
+    {
+        munmap(area, std::max<uint64_t>(size, 1));
+    }
+}
+
+int64_t vp::mmap_file(void *area, uint64_t size, std::string path, bool shared)
+{
+    int fd = shared ? open(path.c_str(), O_RDWR | O_CREAT, 0600) : open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return -1;
+    }
+
+    int64_t mapped = -1;
+    struct stat st;
+    if (fstat(fd, &st) == 0)
+    {
+        uint64_t file_size = st.st_size;
+
+        if (!shared)
+        {
+            // Pages entirely after the end of the file can't be accessed, so only the part of
+            // the area covered by the file is mapped, the rest keeps its anonymous pages.
+            mapped = std::min(file_size, size);
+        }
+        else if (file_size >= size || ftruncate(fd, size) == 0)
+        {
+            mapped = size;
+        }
+
+        // The mapping replaces the anonymous pages of the area, which then get released
+        if (mapped > 0 && mmap(area, mapped, PROT_READ | PROT_WRITE,
+            (shared ? MAP_SHARED : MAP_PRIVATE) | MAP_FIXED, fd, 0) == MAP_FAILED)
+        {
+            mapped = -1;
+        }
+    }
+
+    // The mapping stays valid once the file is closed
+    int error = errno;
+    close(fd);
+    errno = error;
+
+    return mapped;
+}
@@ -20,6 +20,21 @@
  */
 
 #include <vp/vp.hpp>
+#include <vp/itf/io.hpp>
+
+
+thread_local vp::IoReqPool vp::IoReqPool::thread_pool;
+
+
+vp::IoReqPool::~IoReqPool()
+{
+    while (this->first_free)
+    {
+        vp::IoReq *req = this->first_free;
+        this->first_free = req->next;
+        delete req;
+    }
+}
 
 
 vp::MasterPort::MasterPort(vp::Component *owner)
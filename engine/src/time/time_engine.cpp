@@ -22,6 +22,10 @@
 #include <vp/vp.hpp>
 #include "vp/time/time_engine.hpp"
 #include <vp/time/time_event.hpp>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string.h>
 
 
 namespace vp
@@ -38,29 +42,100 @@ namespace vp
         static void event_handler_nofree(vp::Block *__this, vp::TimeEvent *event);
         Component *top;
     };
+
+    class Time_engine_window_event : public vp::Block
+    {
+    public:
+        Time_engine_window_event(Component *top, std::string name, vp::TimeEngine *engine);
+
+    private:
+        int64_t exec() override;
+        vp::TimeEngine *engine;
+    };
+}
+
+thread_local vp::TimeEngine *vp::TimeEngine::running_engine = NULL;
+
+std::vector<void (*)()> vp::TimeEngine::thread_flush_callbacks;
+
+static void partition_barrier_wait(pthread_barrier_t *barrier)
+{
+    int error = pthread_barrier_wait(barrier);
+    if (error != 0 && error != PTHREAD_BARRIER_SERIAL_THREAD)
+    {
+        throw std::runtime_error("Unable to synchronize partitions: " +
+            std::string(strerror(error)));
+    }
 }
 
 vp::TimeEngine::TimeEngine(js::Config *config)
-    : first_client(NULL)
 {
     pthread_mutex_init(&lock_mutex, NULL);
     pthread_mutex_init(&mutex, NULL);
     pthread_cond_init(&cond, NULL);
+
+    if (config)
+    {
+        this->parallel_enabled = config->get_child_bool("parallel/enabled");
+        this->quantum = config->get_child_int("parallel/quantum");
+        this->parallel_stats = config->get_child_bool("parallel/stats");
+    }
+
+    if (this->quantum <= 0)
+    {
+        this->quantum = 100000;
+    }
 }
 
 void vp::TimeEngine::init(vp::Component *top)
 {
     this->top = top;
     this->stop_event = new vp::Time_engine_stop_event(this->top);
+
+    // Partitions are created while the components are built, before the main engine is
+    // initialized, they are initialized now the same way
+    for (vp::TimeEngine *partition: this->partitions)
+    {
+        partition->init(top);
+    }
 }
 
 int64_t vp::TimeEngine::exec()
 {
-    vp::Block *current = this->first_client;
+    if (unlikely(this->partitions.size() != 0))
+    {
+        return this->exec_parallel();
+    }
+
+    int64_t time = this->exec_events();
+    vp::TimeEngine::thread_flush();
+    return time;
+}
+
+void vp::TimeEngine::thread_flush_register(void (*callback)())
+{
+    std::vector<void (*)()> &callbacks = vp::TimeEngine::thread_flush_callbacks;
+    if (std::find(callbacks.begin(), callbacks.end(), callback) == callbacks.end())
+    {
+        callbacks.push_back(callback);
+    }
+}
+
+void vp::TimeEngine::thread_flush()
+{
+    for (void (*callback)(): vp::TimeEngine::thread_flush_callbacks)
+    {
+        callback();
+    }
+}
+
+int64_t vp::TimeEngine::exec_events()
+{
+    vp::Block *current = this->first_client_get();
 
     if (current)
     {
-        first_client = current->time.next;
+        this->queue_pop();
         current->time.is_enqueued = false;
 
         // Update the global engine time with the current event time
@@ -72,7 +147,7 @@ int64_t vp::TimeEngine::exec()
 
             int64_t time = current->exec();
 
-            vp::Block *next = this->first_client;
+            vp::Block *next = this->first_client_get();
 
             // Shortcut to quickly continue with the same client
             if (likely(time > 0))
@@ -87,9 +162,8 @@ int64_t vp::TimeEngine::exec()
                     }
                     else
                     {
-                        current->time.next = first_client;
-                        first_client = current;
                         current->time.next_event_time = time;
+                        this->queue_push(current);
                         current->time.is_enqueued = true;
                         current->time.running = false;
                         break;
@@ -97,27 +171,29 @@ int64_t vp::TimeEngine::exec()
                 }
             }
 
-            // Otherwise remove it, reenqueue it and continue with the next one.
-            // We can optimize a bit the operation as we already know
-            // who to schedule next.
-
+            // Otherwise reenqueue it and continue with the next one.
+            // If they have the same timestamp, it must be executed just after the next one,
+            // before the other clients with this timestamp. Since the last enqueued client is
+            // executed first, this is done by enqueueing the next one again after it.
             if (time > 0)
             {
                 current->time.next_event_time = time;
-                vp::Block *client = next->time.next, *prev = next;
-                while (client && client->time.next_event_time < time)
+                if (next->time.next_event_time == time)
                 {
-                    prev = client;
-                    client = client->time.next;
+                    this->queue_pop();
+                    this->queue_push(current);
+                    this->queue_push(next);
+                }
+                else
+                {
+                    this->queue_push(current);
                 }
-                current->time.next = client;
-                prev->time.next = current;
                 current->time.is_enqueued = true;
             }
 
             current->time.running = false;
 
-            current = first_client;
+            current = this->first_client_get();
 
             // Leave the loop either if there is no more client to schedule or if there is a stop request.
             // In case of a stop request, always take it into account when time is increased so that teh engine
@@ -128,9 +204,9 @@ int64_t vp::TimeEngine::exec()
                 break;
             }
 
-            vp_assert(first_client->time.next_event_time >= get_time(), NULL, "event time is before vp time\n");
+            vp_assert(current->time.next_event_time >= get_time(), NULL, "event time is before vp time\n");
 
-            first_client = current->time.next;
+            this->queue_pop();
             current->time.is_enqueued = false;
 
             // Update the global engine time with the current event time
@@ -138,16 +214,382 @@ int64_t vp::TimeEngine::exec()
         }
     }
 
-    int64_t time = -1;
+    return this->get_next_event_time();
+}
 
-    if (this->first_client)
+vp::TimeEngine *vp::TimeEngine::partition_new()
+{
+    if (!this->parallel_enabled && (this->parent == NULL || !this->parent->parallel_enabled))
     {
-        time = this->first_client->time.next_event_time;
+        return this;
+    }
+
+    // Partitions are not nested, they are all synchronized by the main engine
+    vp::TimeEngine *main = this->parent ? this->parent : this;
+    vp::TimeEngine *engine = new vp::TimeEngine(NULL);
+    engine->parent = main;
+    engine->quantum = main->quantum;
+    engine->parallel_stats = main->parallel_stats;
+    main->partitions.push_back(engine);
+
+    return engine;
+}
+
+int64_t vp::TimeEngine::partitions_next_event_time()
+{
+    int64_t time = this->get_next_event_time();
+
+    for (vp::TimeEngine *partition: this->partitions)
+    {
+        int64_t partition_time = partition->get_next_event_time();
+        if (partition_time != -1 && (time == -1 || partition_time < time))
+        {
+            time = partition_time;
+        }
     }
 
     return time;
 }
 
+int64_t vp::TimeEngine::exec_parallel()
+{
+    // Host threads are created the first time we execute, once all components are created
+    if (this->partition_threads.size() == 0)
+    {
+        // Event traces are dumped in timestamp order by a single dumper, which partitions
+        // executing different times from several threads would break
+        if (this->top->traces.get_trace_engine()->has_active_events())
+        {
+            throw std::runtime_error("Event traces are not supported in parallel mode");
+        }
+
+        int nb_partitions = this->partitions.size() + 1;
+        int error = pthread_barrier_init(&this->window_start_barrier, NULL, nb_partitions);
+        if (error == 0)
+        {
+            error = pthread_barrier_init(&this->window_end_barrier, NULL, nb_partitions);
+        }
+        if (error != 0)
+        {
+            throw std::runtime_error("Unable to create partition barriers: " +
+                std::string(strerror(error)));
+        }
+
+        this->window_event = new Time_engine_window_event(this->top, "window_event", this);
+        int index = 0;
+        for (vp::TimeEngine *partition: this->partitions)
+        {
+            partition->window_event = new Time_engine_window_event(this->top,
+                "partition_" + std::to_string(index++) + "_window_event", partition);
+            pthread_t thread;
+            error = pthread_create(&thread, NULL, &vp::TimeEngine::partition_routine, partition);
+            if (error != 0)
+            {
+                throw std::runtime_error("Unable to create partition thread: " +
+                    std::string(strerror(error)));
+            }
+            this->partition_threads.push_back(thread);
+        }
+    }
+
+    vp::TimeEngine::running_engine = this;
+
+    while (1)
+    {
+        int64_t next_time = this->partitions_next_event_time();
+        if (next_time == -1)
+        {
+            return -1;
+        }
+
+        // Windows are aligned on the quantum, and idle periods are skipped, so that
+        // synchronization points only depend on the quantum and on the events.
+        // A window includes its end time.
+        this->window_end = (next_time + this->quantum - 1) / this->quantum * this->quantum;
+
+        // Windows must not go beyond the time where the engine is asked to stop, for example
+        // when stepping, so that all partitions stop exactly at this time
+        vp::BlockTime *stop_time = &this->stop_event->time;
+        if (stop_time->is_enqueued && stop_time->next_event_time < this->window_end)
+        {
+            this->window_end = stop_time->next_event_time;
+        }
+
+        partition_barrier_wait(&this->window_start_barrier);
+        this->partition_exec_window(this->window_end);
+        this->partition_window_end_wait();
+
+        // All partitions are now stopped at the end of the window, we can safely execute
+        // the interactions between them
+        this->sync_flush();
+
+        // Pauses, quits and locks do not interrupt the window, so that all partitions always
+        // stop at the same time. Check now if someone asked us to stop.
+        this->stop_req = this->lock_req > 0 || this->pause_req || this->finished;
+        if (this->stop_req)
+        {
+            break;
+        }
+    }
+
+    return this->partitions_next_event_time();
+}
+
+void vp::TimeEngine::partition_exec_window(int64_t end_time)
+{
+    std::chrono::steady_clock::time_point start;
+
+    if (this->parallel_stats)
+    {
+        start = std::chrono::steady_clock::now();
+    }
+
+    this->window_done = false;
+    this->enqueue(this->window_event, end_time);
+
+    // The engine may also stop because of a lock request from another thread, just continue
+    // until the window event is executed, all partitions must reach the end of the window.
+    // Pauses and quits are only handled by the main engine once the window is over.
+    while (!this->window_done)
+    {
+        this->exec_events();
+    }
+
+    vp::TimeEngine::thread_flush();
+
+    this->stop_req = false;
+
+    if (this->parallel_stats)
+    {
+        this->stats_windows++;
+        this->stats_busy_time += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+void vp::TimeEngine::partition_window_end_wait()
+{
+    vp::TimeEngine *main = this->parent ? this->parent : this;
+
+    if (!this->parallel_stats)
+    {
+        partition_barrier_wait(&main->window_end_barrier);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    partition_barrier_wait(&main->window_end_barrier);
+    this->stats_wait_time += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void vp::TimeEngine::partitions_stats_dump()
+{
+    if (!this->parallel_stats || this->partitions.size() == 0)
+    {
+        return;
+    }
+
+    std::vector<vp::TimeEngine *> engines = { this };
+    engines.insert(engines.end(), this->partitions.begin(), this->partitions.end());
+
+    fprintf(stdout, "Parallel simulation statistics (quantum: %lld ps)\n",
+        (long long)this->quantum);
+    fprintf(stdout, "%10s %10s %14s %14s %10s %14s\n", "partition", "windows", "busy (ms)",
+        "wait (ms)", "busy (%)", "sync requests");
+
+    int index = 0;
+    for (vp::TimeEngine *engine: engines)
+    {
+        int64_t total = engine->stats_busy_time + engine->stats_wait_time;
+        std::string name = engine == this ? "main" : std::to_string(index++);
+        fprintf(stdout, "%10s %10lld %14.3f %14.3f %10.1f %14lld\n", name.c_str(),
+            (long long)engine->stats_windows, engine->stats_busy_time / 1e6,
+            engine->stats_wait_time / 1e6,
+            total ? 100.0 * engine->stats_busy_time / total : 0.0,
+            (long long)engine->stats_sync_requests);
+    }
+}
+
+void *vp::TimeEngine::partition_routine(void *arg)
+{
+    vp::TimeEngine *engine = (vp::TimeEngine *)arg;
+    vp::TimeEngine *main = engine->parent;
+
+    vp::TimeEngine::running_engine = engine;
+
+    while (1)
+    {
+        partition_barrier_wait(&main->window_start_barrier);
+        if (main->partitions_exit)
+        {
+            break;
+        }
+        engine->partition_exec_window(main->window_end);
+        engine->partition_window_end_wait();
+    }
+
+    return NULL;
+}
+
+void vp::TimeEngine::partitions_join()
+{
+    if (this->partition_threads.size() == 0)
+    {
+        return;
+    }
+
+    // Partition threads are waiting for the next window when the main engine is not running,
+    // release them with the exit request
+    this->partitions_exit = true;
+    partition_barrier_wait(&this->window_start_barrier);
+
+    for (pthread_t thread: this->partition_threads)
+    {
+        pthread_join(thread, NULL);
+    }
+    this->partition_threads.clear();
+
+    pthread_barrier_destroy(&this->window_start_barrier);
+    pthread_barrier_destroy(&this->window_end_barrier);
+}
+
+void vp::TimeEngine::sync_post(vp::Block *block, vp::TimeSyncMeth *meth, void *arg)
+{
+    if (!this->is_partitioned())
+    {
+        meth(block, arg);
+        return;
+    }
+
+    // Each host thread only pushes to the queue of the partition it is executing, so that
+    // no locking is needed. Queues are only read once all partitions are stopped.
+    vp::TimeEngine *engine = vp::TimeEngine::running_engine ? vp::TimeEngine::running_engine : this;
+    engine->sync_requests.push_back({ block, meth, arg });
+    engine->stats_sync_requests++;
+}
+
+void vp::TimeEngine::sync_flush()
+{
+    std::vector<vp::TimeEngine *> engines = { this };
+    engines.insert(engines.end(), this->partitions.begin(), this->partitions.end());
+
+    // Executing a callback can post new ones, iterate until there is none
+    bool pending = true;
+    while (pending)
+    {
+        pending = false;
+        for (vp::TimeEngine *engine: engines)
+        {
+            if (engine->sync_requests.size())
+            {
+                std::vector<SyncRequest> requests;
+                requests.swap(engine->sync_requests);
+                for (SyncRequest &request: requests)
+                {
+                    request.meth(request.block, request.arg);
+                }
+                pending = true;
+            }
+        }
+    }
+}
+
+void vp::TimeEngine::queue_sift_up(int64_t index)
+{
+    vp::Block *client = this->clients[index];
+
+    while (index > 0)
+    {
+        int64_t parent = (index - 1) >> 2;
+        vp::Block *parent_client = this->clients[parent];
+        if (!this->queue_before(client, parent_client))
+        {
+            break;
+        }
+        this->clients[index] = parent_client;
+        parent_client->time.queue_index = index;
+        index = parent;
+    }
+
+    this->clients[index] = client;
+    client->time.queue_index = index;
+}
+
+void vp::TimeEngine::queue_sift_down(int64_t index)
+{
+    int64_t size = this->clients.size();
+    vp::Block *client = this->clients[index];
+
+    while (1)
+    {
+        int64_t first_child = (index << 2) + 1;
+        if (first_child >= size)
+        {
+            break;
+        }
+
+        // Find the earliest of the 4 children
+        int64_t last_child = std::min(first_child + 4, size);
+        int64_t best = first_child;
+        for (int64_t child = first_child + 1; child < last_child; child++)
+        {
+            if (this->queue_before(this->clients[child], this->clients[best]))
+            {
+                best = child;
+            }
+        }
+
+        if (!this->queue_before(this->clients[best], client))
+        {
+            break;
+        }
+
+        this->clients[index] = this->clients[best];
+        this->clients[index]->time.queue_index = index;
+        index = best;
+    }
+
+    this->clients[index] = client;
+    client->time.queue_index = index;
+}
+
+void vp::TimeEngine::queue_push(vp::Block *client)
+{
+    client->time.queue_seq = this->enqueue_seq++;
+    this->clients.push_back(client);
+    this->queue_sift_up(this->clients.size() - 1);
+}
+
+void vp::TimeEngine::queue_pop()
+{
+    this->queue_remove(this->clients[0]);
+}
+
+void vp::TimeEngine::queue_remove(vp::Block *client)
+{
+    int64_t index = client->time.queue_index;
+    vp::Block *last = this->clients.back();
+    this->clients.pop_back();
+    client->time.queue_index = -1;
+
+    if (last != client)
+    {
+        // Move the last client to the free slot and restore the heap ordering from there,
+        // which can require moving it either up or down.
+        this->clients[index] = last;
+        last->time.queue_index = index;
+        if (index > 0 && this->queue_before(last, this->clients[(index - 1) >> 2]))
+        {
+            this->queue_sift_up(index);
+        }
+        else
+        {
+            this->queue_sift_down(index);
+        }
+    }
+}
+
 bool vp::TimeEngine::handle_locks()
 {
     __asm__ __volatile__ ("" : : : "memory");
@@ -197,7 +639,7 @@ int64_t vp::TimeEngine::run_until(int64_t end_time, bool main_controller)
             if (!event->is_enqueued())
             {
                 delete event;
-                return this->get_next_event_time();
+                return this->partitions_next_event_time();
             }
         }
 
@@ -229,7 +671,7 @@ int64_t vp::TimeEngine::run_until(int64_t end_time, bool main_controller)
         // Checks locks since we may have been stopped by them
         if (main_controller && this->handle_locks())
         {
-            time = this->first_client == NULL ? -1 : this->first_client->time.next_event_time;
+            time = this->partitions_next_event_time();
         }
 
         // Leave only once our event is over
@@ -316,24 +758,13 @@ bool vp::TimeEngine::dequeue(vp::Block *client)
 
     client->time.is_enqueued = false;
 
-    vp::Block *current = this->first_client, *prev = NULL;
-    while (current && current != client)
-    {
-        prev = current;
-        current = current->time.next;
-    }
-    if (prev)
-        prev->time.next = client->time.next;
-    else
-        this->first_client = client->time.next;
+    this->queue_remove(client);
 
     return true;
 }
 
 bool vp::TimeEngine::enqueue(vp::Block *client, int64_t full_time)
 {
-    bool update = false;
-
     vp_assert(full_time >= get_time(), NULL, "Time must be higher than current time\n");
 
     if (client->time.is_running())
@@ -347,24 +778,11 @@ bool vp::TimeEngine::enqueue(vp::Block *client, int64_t full_time)
     }
 
     client->time.is_enqueued = true;
-
-    vp::Block *current = first_client, *prev = NULL;
     client->time.next_event_time = full_time;
-    while (current && current->time.next_event_time < client->time.next_event_time)
-    {
-        prev = current;
-        current = current->time.next;
-    }
-    if (prev)
-        prev->time.next = client;
-    else
-    {
-        update = true;
-        first_client = client;
-    }
-    client->time.next = current;
 
-    if (update && this->launcher)
+    this->queue_push(client);
+
+    if (this->first_client_get() == client && this->launcher)
     {
         this->launcher->was_updated();
     }
@@ -374,6 +792,12 @@ bool vp::TimeEngine::enqueue(vp::Block *client, int64_t full_time)
 
 void vp::TimeEngine::quit(int status)
 {
+    if (this->parent)
+    {
+        this->parent->quit(status);
+        return;
+    }
+
     this->pause();
     this->stop_status = status;
     this->finished = true;
@@ -389,9 +813,21 @@ void vp::TimeEngine::quit(int status)
 
 void vp::TimeEngine::pause()
 {
-    this->stop_req = true;
+    if (this->parent)
+    {
+        this->parent->pause();
+        return;
+    }
+
     this->pause_req = true;
 
+    // When partitioned, the pause is only handled at the end of the current window, so that
+    // all partitions stop at the same time
+    if (this->partitions.size() == 0)
+    {
+        this->stop_req = true;
+    }
+
     // Notify the condition in case we are waiting for locks, to allow leaving the engine.
     pthread_cond_broadcast(&cond);
 }
@@ -452,6 +888,20 @@ void vp::Time_engine_stop_event::event_handler_nofree(vp::Block *__this, vp::Tim
     _this->top->time.get_engine()->retain_inc(1);
 }
 
+vp::Time_engine_window_event::Time_engine_window_event(vp::Component *top, std::string name,
+    vp::TimeEngine *engine)
+    : vp::Block(top, name, engine), engine(engine)
+{
+}
+
+int64_t vp::Time_engine_window_event::exec()
+{
+    // Stop the partition once all events of the end of the window have been executed
+    this->engine->window_done = true;
+    this->engine->stop_req = true;
+    return -1;
+}
+
 void vp::TimeEngine::retain_inc(int inc)
 {
     this->retain += inc;
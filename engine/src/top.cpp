@@ -59,6 +59,8 @@ void vp::Top::start()
 
 vp::Top::~Top()
 {
+    this->time_engine->partitions_stats_dump();
+    this->time_engine->partitions_join();
     delete this->power_engine;
     delete this->trace_engine;
 }
\ No newline at end of file
@@ -135,11 +135,13 @@ void vp::Trace::dump_header()
 
 void vp::Trace::force_warning(const char *fmt, ...)
 {
+    flockfile(this->trace_file);
     dump_warning_header();
     va_list ap;
     va_start(ap, fmt);
     if (vfprintf(this->trace_file, fmt, ap) < 0) {}
     va_end(ap);
+    funlockfile(this->trace_file);
 
     if (comp->traces.get_trace_engine()->get_werror())
     {
@@ -152,11 +154,13 @@ void vp::Trace::force_warning(vp::Trace::warning_type_e type, const char *fmt, .
 {
     if (comp->traces.get_trace_engine()->is_warning_active(type))
     {
+        flockfile(this->trace_file);
         dump_warning_header();
         va_list ap;
         va_start(ap, fmt);
         if (vfprintf(this->trace_file, fmt, ap) < 0) {}
         va_end(ap);
+        funlockfile(this->trace_file);
 
         if (comp->traces.get_trace_engine()->get_werror())
         {
@@ -167,11 +171,13 @@ void vp::Trace::force_warning(vp::Trace::warning_type_e type, const char *fmt, .
 
 void vp::Trace::force_warning_no_error(const char *fmt, ...)
 {
+    flockfile(this->trace_file);
     dump_warning_header();
     va_list ap;
     va_start(ap, fmt);
     if (vfprintf(this->trace_file, fmt, ap) < 0) {}
     va_end(ap);
+    funlockfile(this->trace_file);
 }
 
 
@@ -179,11 +185,13 @@ void vp::Trace::force_warning_no_error(vp::Trace::warning_type_e type, const cha
 {
     if (comp->traces.get_trace_engine()->is_warning_active(type))
     {
+        flockfile(this->trace_file);
         dump_warning_header();
         va_list ap;
         va_start(ap, fmt);
         if (vfprintf(this->trace_file, fmt, ap) < 0) {}
         va_end(ap);
+        funlockfile(this->trace_file);
     }
 }
 
@@ -221,6 +229,16 @@ void vp::Trace::set_active(bool active)
 
 void vp::Trace::set_event_active(bool active)
 {
+    // Event traces activated while partitions are executed in parallel are refused, since
+    // the event dumper needs events in timestamp order and from a single thread. Those
+    // activated before the partitions start are rejected when the simulation starts.
+    if (active && this->comp->time.get_engine() && this->comp->time.get_engine()->is_partitioned())
+    {
+        fprintf(stderr, "Ignoring event trace %s, event traces are not supported in parallel mode\n",
+            this->path.c_str());
+        active = false;
+    }
+
     this->is_event_active = active;
 
     if (active)
@@ -344,7 +362,9 @@ vp::TraceEngine::~TraceEngine()
 
 void vp::TraceEngine::flush()
 {
-    if (!this->use_external_dumper)
+    // The engine may be destroyed without having been initialized, for example by tools using
+    // the engines without any component, in which case no event can be pending
+    if (!this->use_external_dumper && this->top)
     {
         // Flush only the events until the current timestamp as we may resume
         // the execution right after
@@ -125,6 +125,31 @@ void vp::TraceEngine::check_traces()
     }
 }
 
+bool vp::TraceEngine::has_active_events()
+{
+    for (auto x : this->traces_array)
+    {
+        if (x->get_event_active())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<vp::Trace *> vp::TraceEngine::get_file_traces(FILE *file)
+{
+    std::vector<vp::Trace *> result;
+    for (auto x : this->traces_array)
+    {
+        if (x->get_active() && x->trace_file == file)
+        {
+            result.push_back(x);
+        }
+    }
+    return result;
+}
+
 void vp::TraceEngine::reg_trace(vp::Trace *trace, int event, string path, string name)
 {
     this->traces_array.push_back(trace);
@@ -242,6 +267,10 @@ vp::TraceEngine::TraceEngine(js::Config *config)
     {
         this->trace_format = TRACE_FORMAT_SHORT;
     }
+    else if (format == "binary")
+    {
+        this->trace_format = TRACE_FORMAT_BINARY;
+    }
     else
     {
         this->trace_format = TRACE_FORMAT_LONG;
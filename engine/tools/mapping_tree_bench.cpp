@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Microbenchmark of the router address decoding. Tables of contiguous mappings of increasing
+// sizes are built, and MappingTree::get is timed on random addresses, on addresses walking
+// through a single mapping as a core does, and on addresses outside all mappings, which go to the
+// default one. The mapping returned for each address is also checked, including when mappings
+// have the same base, in which case the first one inserted must be selected.
+//
+// Usage: gvsoc_mapping_tree_bench [<lookups per measure>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+#include <vp/vp.hpp>
+#include <vp/mapping_tree.hpp>
+
+#define MAPPING_SIZE 0x10000ULL
+
+static uint64_t rand_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t rand_get()
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+    return rand_state;
+}
+
+static void insert(vp::MappingTree *tree, int id, std::string name, uint64_t base, uint64_t size)
+{
+    js::Config *config = js::import_config_from_string("{\"base\": " + std::to_string(base) +
+        ", \"size\": " + std::to_string(size) + "}");
+    tree->insert(id, name, config);
+}
+
+static double bench_ns(vp::MappingTree *tree, std::vector<uint64_t> &addrs, int64_t nb_lookups,
+    int64_t *checksum)
+{
+    size_t mask = addrs.size() - 1;
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < nb_lookups; i++)
+    {
+        *checksum += tree->get(addrs[i & mask], 4, false)->id;
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / nb_lookups;
+}
+
+static int check_same_base()
+{
+    vp::Trace trace;
+    vp::MappingTree tree(&trace);
+    insert(&tree, 0, "first", 0x1000, 0x100);
+    insert(&tree, 1, "second", 0x1000, 0x100);
+    insert(&tree, 2, "default", 0, 0);
+    tree.build();
+
+    if (tree.get(0x1080, 4, false)->id != 0)
+    {
+        printf("Mappings with the same base: got %s instead of first\n",
+            tree.get(0x1080, 4, false)->name.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int64_t nb_lookups = argc > 1 ? strtoll(argv[1], NULL, 0) : 10000000;
+    int errors = check_same_base();
+    int64_t checksum = 0;
+
+    printf("%9s %12s %12s %12s\n", "mappings", "random", "sequential", "default");
+
+    for (int nb_mappings = 2; nb_mappings <= 256; nb_mappings *= 2)
+    {
+        vp::Trace trace;
+        vp::MappingTree tree(&trace);
+
+        // The mappings are inserted in a shuffled order, as they come from the configuration
+        std::vector<int> order;
+        for (int i = 0; i < nb_mappings; i++)
+        {
+            order.push_back(i);
+        }
+        for (int i = nb_mappings - 1; i > 0; i--)
+        {
+            std::swap(order[i], order[rand_get() % (i + 1)]);
+        }
+        for (int i: order)
+        {
+            insert(&tree, i, "mapping" + std::to_string(i), i * MAPPING_SIZE, MAPPING_SIZE);
+        }
+        insert(&tree, nb_mappings, "default", 0, 0);
+        tree.build();
+
+        std::vector<uint64_t> random_addrs(1 << 16), seq_addrs(1 << 16), default_addrs(1 << 16);
+        for (size_t i = 0; i < random_addrs.size(); i++)
+        {
+            random_addrs[i] = rand_get() % (nb_mappings * MAPPING_SIZE);
+            seq_addrs[i] = (nb_mappings / 2) * MAPPING_SIZE + (i * 4) % MAPPING_SIZE;
+            default_addrs[i] = nb_mappings * MAPPING_SIZE + rand_get() % MAPPING_SIZE;
+
+            if (tree.get(random_addrs[i], 4, false)->id != (int)(random_addrs[i] / MAPPING_SIZE) ||
+                tree.get(default_addrs[i], 4, false)->id != nb_mappings)
+            {
+                if (errors++ < 4)
+                {
+                    printf("Wrong mapping for address 0x%llx with %d mappings\n",
+                        (unsigned long long)random_addrs[i], nb_mappings);
+                }
+            }
+        }
+
+        double random_ns = bench_ns(&tree, random_addrs, nb_lookups, &checksum);
+        double seq_ns = bench_ns(&tree, seq_addrs, nb_lookups, &checksum);
+        double default_ns = bench_ns(&tree, default_addrs, nb_lookups, &checksum);
+
+        printf("%9d %9.2f ns %9.2f ns %9.2f ns\n", nb_mappings, random_ns, seq_ns, default_ns);
+    }
+
+    // Printed so that the lookups can not be optimized away
+    printf("checksum: %lld\n", (long long)checksum);
+
+    return errors ? 1 : 0;
+}
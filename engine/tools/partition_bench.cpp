@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Benchmark of the parallel mode on a synthetic multi-cluster platform. Each cluster has
+// several cores, each one modelled by a time event executed at each cycle of a 1GHz clock, with
+// a fixed amount of host work per cycle standing for the execution of an instruction. Each core
+// regularly sends a request to the next cluster through the partition synchronization, as the
+// traffic going through partition bridges does.
+// The platform is first simulated with all clusters in the main engine, and then with the
+// clusters spread over 2, 4 and up to one partition per cluster. The host time and the speedup
+// against the sequential simulation are reported for each case. The requests received and the
+// work done by the clusters are also checked, since they must not depend on the partitioning.
+// The trace and power report files which the engines always open are created in a temporary
+// directory, removed as soon as they are opened.
+//
+// Usage: gvsoc_partition_bench [<clusters> [<cycles> [<work per cycle> [<quantum in ps>]]]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <unistd.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vp/vp.hpp>
+
+#define NB_CORES 4
+#define CYCLE_PERIOD 1000
+// Number of cycles between 2 requests sent by a core to the next cluster
+#define REQ_PERIOD 64
+
+static char output_dir[PATH_MAX];
+static char saved_dir[PATH_MAX];
+
+// Go to a temporary directory, so that the engines open their output files there
+static int output_dir_enter()
+{
+    snprintf(output_dir, sizeof(output_dir), "/tmp/gvsoc_partition_bench.XXXXXX");
+    if (getcwd(saved_dir, sizeof(saved_dir)) == NULL || mkdtemp(output_dir) == NULL ||
+        chdir(output_dir) != 0)
+    {
+        perror("Unable to create the temporary output directory");
+        return -1;
+    }
+    return 0;
+}
+
+// Remove the output files, which stay open, and go back to the initial directory
+static void output_dir_leave()
+{
+    unlink("trace_file.txt");
+    unlink("power_report.csv");
+    if (chdir(saved_dir) != 0 || rmdir(output_dir) != 0)
+    {
+        perror("Unable to remove the temporary output directory");
+    }
+}
+
+class Cluster final : public vp::Block
+{
+public:
+    Cluster(vp::Block *parent, std::string name, vp::TimeEngine *engine, int64_t nb_cycles,
+        int work);
+
+    // Cluster receiving the requests of this one
+    Cluster *next = NULL;
+    // Number of requests received from the previous cluster
+    int64_t nb_reqs = 0;
+    // Combination of the results of the work done by the cores
+    uint64_t checksum = 0;
+
+private:
+    static void core_exec(vp::Block *__this, vp::TimeEvent *event);
+    static void req_handle(vp::Block *__this, void *arg);
+
+    std::unique_ptr<vp::TimeEvent> cores[NB_CORES];
+    uint64_t core_state[NB_CORES];
+    int64_t core_cycles[NB_CORES];
+    int64_t nb_cycles;
+    int work;
+};
+
+Cluster::Cluster(vp::Block *parent, std::string name, vp::TimeEngine *engine, int64_t nb_cycles,
+    int work)
+    : vp::Block(parent, name, engine), nb_cycles(nb_cycles), work(work)
+{
+    for (int i = 0; i < NB_CORES; i++)
+    {
+        this->cores[i] = std::unique_ptr<vp::TimeEvent>(new vp::TimeEvent(this, &core_exec));
+        this->cores[i]->get_args()[0] = (void *)(intptr_t)i;
+        this->core_state[i] = 0x9e3779b97f4a7c15ULL + i;
+        this->core_cycles[i] = 0;
+        this->cores[i]->enqueue(CYCLE_PERIOD);
+    }
+}
+
+void Cluster::core_exec(vp::Block *__this, vp::TimeEvent *event)
+{
+    Cluster *_this = (Cluster *)__this;
+    int core = (intptr_t)event->get_args()[0];
+
+    uint64_t state = _this->core_state[core];
+    for (int i = 0; i < _this->work; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+    }
+    _this->core_state[core] = state;
+
+    int64_t cycles = ++_this->core_cycles[core];
+    if (cycles % REQ_PERIOD == 0)
+    {
+        _this->time.get_engine()->sync_post(_this->next, &req_handle, NULL);
+    }
+
+    if (cycles < _this->nb_cycles)
+    {
+        event->enqueue(CYCLE_PERIOD);
+    }
+    else
+    {
+        _this->checksum ^= state;
+    }
+}
+
+void Cluster::req_handle(vp::Block *__this, void *arg)
+{
+    Cluster *_this = (Cluster *)__this;
+    _this->nb_reqs++;
+}
+
+namespace vp
+{
+    // Drives the time engine as the launcher does
+    class PartitionBench
+    {
+    public:
+        static double run(int nb_partitions, int nb_clusters, int64_t nb_cycles, int work,
+            int64_t quantum, int64_t *nb_reqs, uint64_t *checksum);
+    };
+};
+
+double vp::PartitionBench::run(int nb_partitions, int nb_clusters, int64_t nb_cycles, int work,
+    int64_t quantum, int64_t *nb_reqs, uint64_t *checksum)
+{
+    js::Config *config = js::import_config_from_string("{\"traces\": {\"include_regex\": [], "
+        "\"level\": \"info\"}, \"events\": {\"include_regex\": [], \"include_raw\": []}, "
+        "\"memcheck\": false, \"parallel\": {\"enabled\": " +
+        std::string(nb_partitions > 1 ? "true" : "false") + ", \"quantum\": " +
+        std::to_string(quantum) + ", \"stats\": false}}");
+
+    if (output_dir_enter())
+    {
+        exit(1);
+    }
+    vp::TimeEngine time_engine(config);
+    vp::TraceEngine trace_engine(config);
+    vp::PowerEngine power_engine;
+    output_dir_leave();
+
+    vp::ComponentConf conf("", NULL, js::import_config_from_string("{}"), config, &time_engine,
+        &trace_engine, &power_engine);
+    vp::Component top(conf);
+
+    // Without parallel mode, partitions are the main engine
+    std::vector<vp::TimeEngine *> partitions;
+    for (int i = 0; i < nb_partitions; i++)
+    {
+        partitions.push_back(time_engine.partition_new());
+    }
+
+    time_engine.init(&top);
+
+    std::vector<std::unique_ptr<Cluster>> clusters;
+    for (int i = 0; i < nb_clusters; i++)
+    {
+        clusters.emplace_back(new Cluster(&top, "cluster" + std::to_string(i),
+            partitions[i % nb_partitions], nb_cycles, work));
+    }
+    for (int i = 0; i < nb_clusters; i++)
+    {
+        clusters[i]->next = clusters[(i + 1) % nb_clusters].get();
+    }
+
+    time_engine.critical_enter();
+    time_engine.retain_inc(1);
+
+    auto start = std::chrono::steady_clock::now();
+    time_engine.run_until((nb_cycles + 1) * CYCLE_PERIOD, true);
+    auto end = std::chrono::steady_clock::now();
+
+    time_engine.partitions_join();
+    time_engine.critical_exit();
+
+    *nb_reqs = 0;
+    *checksum = 0;
+    for (std::unique_ptr<Cluster> &cluster: clusters)
+    {
+        *nb_reqs += cluster->nb_reqs;
+        *checksum ^= cluster->checksum;
+    }
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    int nb_clusters = argc > 1 ? strtol(argv[1], NULL, 0) : 8;
+    int64_t nb_cycles = argc > 2 ? strtoll(argv[2], NULL, 0) : 200000;
+    int work = argc > 3 ? strtol(argv[3], NULL, 0) : 100;
+    int64_t quantum = argc > 4 ? strtoll(argv[4], NULL, 0) : 100000;
+
+    int64_t expected_reqs = (int64_t)nb_clusters * NB_CORES * (nb_cycles / REQ_PERIOD);
+
+    printf("%d clusters, %d cores per cluster, %lld cycles, %d work per cycle, quantum %lld ps\n",
+        nb_clusters, NB_CORES, (long long)nb_cycles, work, (long long)quantum);
+    printf("%10s %14s %10s\n", "partitions", "host (ms)", "speedup");
+
+    double ref_time = 0;
+    uint64_t ref_checksum = 0;
+    int errors = 0;
+
+    for (int nb_partitions = 1; ; nb_partitions *= 2)
+    {
+        if (nb_partitions > nb_clusters)
+        {
+            nb_partitions = nb_clusters;
+        }
+
+        int64_t nb_reqs;
+        uint64_t checksum;
+        double time = vp::PartitionBench::run(nb_partitions, nb_clusters, nb_cycles, work,
+            quantum, &nb_reqs, &checksum);
+
+        if (nb_partitions == 1)
+        {
+            ref_time = time;
+            ref_checksum = checksum;
+        }
+
+        printf("%10d %14.1f %9.2fx\n", nb_partitions, time, ref_time / time);
+
+        if (nb_reqs != expected_reqs || checksum != ref_checksum)
+        {
+            printf("Error with %d partitions: %lld requests instead of %lld, checksum 0x%llx "
+                "instead of 0x%llx\n", nb_partitions, (long long)nb_reqs,
+                (long long)expected_reqs, (unsigned long long)checksum,
+                (unsigned long long)ref_checksum);
+            errors++;
+        }
+
+        if (nb_partitions == nb_clusters)
+        {
+            break;
+        }
+    }
+
+    return errors != 0;
+}
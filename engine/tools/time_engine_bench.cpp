@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Microbenchmark of the time engine client queue. For 1 to 10000 clients, all enqueued at random
+// times, a random client is repeatedly rescheduled to another random time, as clock engines and
+// time events do when their next event changes. Each reschedule removes the client from the
+// queue and inserts it again. The trace and power report files which the engines always open are
+// created in a temporary directory, removed as soon as they are opened.
+//
+// Usage: gvsoc_time_engine_bench [<reschedules per measure>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <unistd.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vp/vp.hpp>
+
+// Clients are deleted through their final type, since vp::Block has no virtual destructor
+class Client final : public vp::Block
+{
+public:
+    using vp::Block::Block;
+};
+
+static char output_dir[] = "/tmp/gvsoc_time_engine_bench.XXXXXX";
+static char saved_dir[PATH_MAX];
+
+// Go to a temporary directory, so that the engines open their output files there
+static int output_dir_enter()
+{
+    if (getcwd(saved_dir, sizeof(saved_dir)) == NULL || mkdtemp(output_dir) == NULL ||
+        chdir(output_dir) != 0)
+    {
+        perror("Unable to create the temporary output directory");
+        return -1;
+    }
+    return 0;
+}
+
+// Remove the output files, which stay open, and go back to the initial directory
+static void output_dir_leave()
+{
+    unlink("trace_file.txt");
+    unlink("power_report.csv");
+    if (chdir(saved_dir) != 0 || rmdir(output_dir) != 0)
+    {
+        perror("Unable to remove the temporary output directory");
+    }
+}
+
+static uint64_t rand_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t rand_get()
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+    return rand_state;
+}
+
+int main(int argc, char *argv[])
+{
+    int64_t nb_reschedules = argc > 1 ? strtoll(argv[1], NULL, 0) : 1000000;
+    static const int nb_clients_list[] = { 1, 10, 100, 1000, 10000 };
+
+    js::Config *config = js::import_config_from_string("{\"traces\": {\"include_regex\": [], "
+        "\"level\": \"info\"}, \"events\": {\"include_regex\": [], \"include_raw\": []}, "
+        "\"memcheck\": false}");
+
+    if (output_dir_enter())
+    {
+        return 1;
+    }
+    vp::TimeEngine time_engine(config);
+    vp::TraceEngine trace_engine(config);
+    vp::PowerEngine power_engine;
+    output_dir_leave();
+
+    printf("%9s %14s\n", "clients", "reschedule");
+
+    for (int nb_clients: nb_clients_list)
+    {
+        vp::Block top(NULL, "top", &time_engine, &trace_engine, &power_engine);
+        std::vector<std::unique_ptr<Client>> clients;
+        for (int i = 0; i < nb_clients; i++)
+        {
+            Client *client = new Client(&top, "client" + std::to_string(i));
+            client->time.enqueue_to_engine(rand_get() % 1000000);
+            clients.emplace_back(client);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int64_t i = 0; i < nb_reschedules; i++)
+        {
+            Client *client = clients[rand_get() % nb_clients].get();
+            client->time.dequeue_from_engine();
+            client->time.enqueue_to_engine(rand_get() % 1000000);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        printf("%9d %11.2f ns\n", nb_clients,
+            std::chrono::duration<double, std::nano>(end - start).count() / nb_reschedules);
+
+        for (std::unique_ptr<Client> &client: clients)
+        {
+            client->time.dequeue_from_engine();
+        }
+    }
+
+    return 0;
+}
@@ -28,6 +28,7 @@
 #include <cpu/iss/include/lsu.hpp>
 #include <cpu/iss/include/decode.hpp>
 #include <cpu/iss/include/trace.hpp>
+#include <cpu/iss/include/profiler.hpp>
 #include <cpu/iss/include/csr.hpp>
 #include <cpu/iss/include/dbgunit.hpp>
 #include <cpu/iss/include/exception.hpp>
@@ -66,6 +67,7 @@ public:
     DbgUnit dbgunit;
     Syscalls syscalls;
     Trace trace;
+    Profiler profiler;
     Csr csr;
     Mmu mmu;
     Pmp pmp;
@@ -90,6 +92,9 @@ public:
 
     void start();
     void reset(bool active);
+    void stop();
+    std::string handle_command(gv::GvProxy *proxy, FILE *req_file, FILE *reply_file,
+        std::vector<std::string> args, std::string req) override;
 
     Iss iss;
 
@@ -99,7 +104,7 @@ private:
 
 inline Iss::Iss(IssWrapper &top)
     : prefetcher(*this), exec(top, *this), insn_cache(*this), decode(*this), timing(*this), core(*this), irq(*this),
-      gdbserver(*this), lsu(*this), dbgunit(*this), syscalls(top, *this), trace(*this), csr(*this),
+      gdbserver(*this), lsu(*this), dbgunit(*this), syscalls(top, *this), trace(*this), profiler(*this), csr(*this),
       regfile(top, *this), mmu(*this), pmp(*this), exception(*this), memcheck(top, *this), top(top)
 {
 }
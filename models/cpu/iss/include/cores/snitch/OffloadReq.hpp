@@ -31,6 +31,8 @@ public:
     iss_reg_t pc;
     // Offloaded instruction info
     iss_insn_t insn;
+    // Cold part of the offloaded instruction, which insn.cold points to
+    iss_insn_cold_t insn_cold;
     // Whether the instruction is memory write
     bool is_write;
     // Rounding mode of fp instruction
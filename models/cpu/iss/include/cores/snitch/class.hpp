@@ -29,6 +29,7 @@
 #include <cpu/iss/include/lsu.hpp>
 #include <cpu/iss/include/decode.hpp>
 #include <cpu/iss/include/trace.hpp>
+#include <cpu/iss/include/profiler.hpp>
 #include <cpu/iss/include/csr.hpp>
 #include <cpu/iss/include/dbgunit.hpp>
 #include <cpu/iss/include/exception.hpp>
@@ -81,6 +82,7 @@ public:
     DbgUnit dbgunit;
     Syscalls syscalls;
     Trace trace;
+    Profiler profiler;
     Csr csr;
     Mmu mmu;
     Pmp pmp;
@@ -125,6 +127,7 @@ public:
 
     // Temporary request information
     iss_insn_t insn;
+    iss_insn_cold_t insn_cold;
     iss_reg_t pc;
     bool is_write;
     unsigned int frm;
@@ -158,6 +161,9 @@ public:
 
     void start();
     void reset(bool active);
+    void stop();
+    std::string handle_command(gv::GvProxy *proxy, FILE *req_file, FILE *reply_file,
+        std::vector<std::string> args, std::string req) override;
 
     Iss iss;
 
@@ -28,6 +28,7 @@
 #include <cpu/iss/include/lsu.hpp>
 #include <cpu/iss/include/decode.hpp>
 #include <cpu/iss/include/trace.hpp>
+#include <cpu/iss/include/profiler.hpp>
 #include <cpu/iss/include/csr.hpp>
 #include <cpu/iss/include/dbgunit.hpp>
 #include <cpu/iss/include/exception.hpp>
@@ -73,6 +74,7 @@ public:
     DbgUnit dbgunit;
     Syscalls syscalls;
     Trace trace;
+    Profiler profiler;
     Csr csr;
     Mmu mmu;
     Pmp pmp;
@@ -106,6 +108,9 @@ public:
 
     void start();
     void reset(bool active);
+    void stop();
+    std::string handle_command(gv::GvProxy *proxy, FILE *req_file, FILE *reply_file,
+        std::vector<std::string> args, std::string req) override;
 
     Iss iss;
 
@@ -39,4 +39,6 @@ public:
     iss_reg_t pc;
     // Offloaded instruction info
     iss_insn_t insn;
+    // Cold part of the offloaded instruction, which insn.cold points to
+    iss_insn_cold_t insn_cold;
 };
\ No newline at end of file
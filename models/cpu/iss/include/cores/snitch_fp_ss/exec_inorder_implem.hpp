@@ -49,7 +49,7 @@ inline void Exec::interrupt_taken()
 
 static inline iss_reg_t iss_exec_stalled_insn_fast(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 {
-    iss_reg_t next_insn =  insn->stall_fast_handler(iss, insn, pc);
+    iss_reg_t next_insn =  insn->cold->stall_fast_handler(iss, insn, pc);
     int latency = insn->latency;
 
 #if defined(CONFIG_GVSOC_ISS_SCOREBOARD)
@@ -206,7 +206,10 @@ inline void Exec::insn_exec_power(iss_insn_t *insn)
 {
     if (this->iss.top.power.get_power_trace()->get_active())
     {
-        this->iss.timing.insn_groups_power[insn->decoder_item->u.insn.power_group].account_energy_quantum();
+        // The power models compute with host floats, the FP exceptions of the core must not
+        // get them
+        lib_ff_flags_sync();
+        this->iss.timing.insn_groups_power[insn->cold->decoder_item->u.insn.power_group].account_energy_quantum();
     }
 }
 
@@ -26,6 +26,13 @@
 
 class Csr;
 
+// Number of CSR addresses, CSRs are indexed by their 12-bit address
+#define ISS_NB_CSRS 4096
+
+// Writing the CSR can change how instructions are decoded or when interrupts are taken, which
+// is only checked by the full instruction handler, so the core must leave the fast mode
+#define CSR_FLAG_FULL_MODE (1 << 0)
+
 typedef struct
 {
     union
@@ -154,7 +161,9 @@ public:
 
     void declare_pcer(int index, std::string name, std::string help);
     void declare_csr(CsrAbtractReg *reg, std::string name, iss_reg_t address, iss_reg_t reset_val=0, iss_reg_t mask=-1);
-    CsrAbtractReg *get_csr(iss_reg_t address);
+    inline CsrAbtractReg *get_csr(iss_reg_t address);
+    void set_flags(iss_reg_t address, uint8_t flags);
+    inline uint8_t get_flags(iss_reg_t address);
 
     bool access(bool is_write, iss_reg_t address, iss_reg_t &value);
 
@@ -246,7 +255,20 @@ private:
     bool time_access(bool is_write, iss_reg_t &value);
     bool mcycle_access(bool is_write, iss_reg_t &value);
 
-    std::map<iss_reg_t, CsrAbtractReg *> regs;
+    // Dispatch table indexed by CSR address, giving the generic register handling the CSR, or
+    // NULL if it is handled by the legacy functions, and the flags of the CSR
+    CsrAbtractReg *regs[ISS_NB_CSRS];
+    uint8_t flags[ISS_NB_CSRS];
     vp::WireMaster<uint64_t> time_itf;
 
 };
+
+inline CsrAbtractReg *Csr::get_csr(iss_reg_t address)
+{
+    return address < ISS_NB_CSRS ? this->regs[address] : NULL;
+}
+
+inline uint8_t Csr::get_flags(iss_reg_t address)
+{
+    return address < ISS_NB_CSRS ? this->flags[address] : 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+
+// Debug information of a range of addresses
+typedef struct
+{
+    // First address of the range
+    uint64_t base;
+    // Address following the last one of the range
+    uint64_t end;
+    // Offsets of the names in the string table
+    uint32_t func;
+    uint32_t inline_func;
+    uint32_t file;
+    uint32_t line;
+} debug_info_range_t;
+
+// Index of the debug information of a binary, giving the function, inline function, file and
+// line of each address.
+//
+// It is built from the text file generated from the ELF/DWARF information, with one address
+// and its information per line. Consecutive addresses with the same information are merged into
+// ranges, which are sorted by address and refer to a table of unique strings.
+// The index is cached next to the text file, so that it is only built once and then just mapped
+// into memory, and is shared by all the cores using the same binary.
+class DebugInfo
+{
+public:
+    // Get the index of the specified debug information file, or NULL if it can't be read
+    static std::shared_ptr<DebugInfo> get(std::string path);
+
+    ~DebugInfo();
+
+    // Get the range containing the address, or NULL if there is none
+    const debug_info_range_t *find(uint64_t addr);
+    inline const char *get_str(uint32_t offset) { return this->strings + offset; }
+
+private:
+    bool load(std::string path, std::string index_path);
+    bool build(std::string path, std::string index_path);
+
+    // Mapped index file, or NULL if the index had to be built in memory
+    void *map = NULL;
+    size_t map_size;
+    std::vector<uint8_t> buffer;
+
+    const debug_info_range_t *ranges;
+    uint32_t nb_ranges;
+    const char *strings;
+};
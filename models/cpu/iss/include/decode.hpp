@@ -35,27 +35,72 @@ public:
     vp::Trace trace;
 
     static void flush_cache_sync(vp::Block *_this, bool active);
+    static void flush_cache_line_sync(vp::Block *_this, bool active);
+    static void flush_cache_line_addr_sync(vp::Block *_this, uint32_t addr);
 
     // decode
     vp::WireSlave<bool> flush_cache_itf;
+    // Invalidation of the decoded instructions of a single cache line, whose address must be
+    // first set with flush_cache_line_addr_itf
+    vp::WireSlave<bool> flush_cache_line_itf;
+    vp::WireSlave<uint32_t> flush_cache_line_addr_itf;
+    uint32_t flush_cache_line_addr;
     const char *isa;
-    std::vector<iss_insn_t *> insn_tables;
     bool has_double;
 
     std::vector<iss_decoder_item_t *> *get_insns_from_tag(std::string tag);
+    // Decode again the arguments of a decoded instruction, used when its debug record is allocated
+    void decode_args(iss_insn_t *insn, iss_insn_arg_t *args);
 
 private:
     int decode_opcode(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode);
     int decode_item(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss_decoder_item_t *item);
     int decode_opcode_group(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss_decoder_item_t *item);
     int decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss_decoder_item_t *item);
+    void decode_arg(iss_insn_t *insn, iss_opcode_t opcode, iss_decoder_arg_t *darg, iss_insn_arg_t *arg);
     uint64_t decode_ranges(iss_opcode_t opcode, iss_decoder_range_set_t *range_set, bool is_signed);
     int decode_info(iss_insn_t *insn, iss_opcode_t opcode, iss_decoder_arg_info_t *info, bool is_signed);
 
+    // Number of instructions decoded so far, and number of opcode group entries read to decode
+    // them, dumped each time an instruction is decoded
+    int64_t nb_decoded_insns;
+    int64_t nb_group_lookups;
+    vp::Trace decoded_insns_event;
+    vp::Trace group_lookups_event;
+
+    // Arguments of the instruction being decoded when it has no debug record
+    iss_insn_arg_t args[ISS_MAX_DECODE_ARGS];
+
     Iss &iss;
 };
 
 
+// Get the item of a decoder group matching the opcode, or NULL if none matches. The number of
+// group entries read to find it is added to nb_lookups
+static inline iss_decoder_item_t *iss_decoder_group_get(iss_decoder_item_t *item,
+    iss_opcode_t opcode, int64_t &nb_lookups)
+{
+    iss_opcode_t group_opcode = (opcode >> item->u.group.bit) & ((1ULL << item->u.group.width) - 1);
+
+    if (item->u.group.table)
+    {
+        nb_lookups++;
+        return item->u.group.table[group_opcode];
+    }
+
+    for (int i = 0; i < item->u.group.nb_groups; i++)
+    {
+        iss_decoder_item_t *current = item->u.group.groups[i];
+        nb_lookups++;
+        if (group_opcode == current->opcode && !current->opcode_others)
+        {
+            return current;
+        }
+    }
+
+    return item->u.group.others;
+}
+
 iss_reg_t iss_fetch_pc_handler(Iss *iss, iss_insn_t *insn, iss_reg_t pc);
 iss_reg_t iss_decode_pc_handler(Iss *iss, iss_insn_t *insn, iss_reg_t pc);
 
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <string.h>
+#include <vp/vp.hpp>
+#include <vp/itf/io.hpp>
+
+// Direct memory accesses bypass the interconnect, they can't be used when every access must be
+// checked, or when the core has its own handling of memory accesses
+#if !defined(VP_MEMCHECK_ACTIVE) && !defined(CONFIG_GVSOC_ISS_SNITCH)
+#define ISS_HAS_DMI 1
+#endif
+
+// Number of entries of the cache, as a power of 2
+#define ISS_DMI_CACHE_BITS 4
+// Size of the pages tracked by the cache, as a power of 2
+#define ISS_DMI_PAGE_BITS 12
+
+// Cache of the direct memory accesses granted on an IO master interface.
+// Each entry tracks one page, which is either directly accessible through a host pointer, or
+// refused, in which case accesses go through the interface as usual. This also caches refusals
+// so that the targets are only queried once per page.
+class DmiCache
+{
+public:
+    inline DmiCache(vp::IoMaster &itf);
+
+    // Try to do the access directly. Returns false if it must go through the interface, otherwise
+    // the data has been copied and latency is set to the one of the target.
+    inline bool access(uint64_t addr, uint8_t *data, uint64_t size, bool is_write, int64_t &latency);
+
+    // Forget the entries overlapping the specified range, must be called when grants are revoked
+    inline void invalidate(uint64_t base, uint64_t size);
+
+    // Forget all the entries
+    inline void flush();
+
+private:
+    struct Entry
+    {
+        // Index of the page, -1 if the entry is empty
+        uint64_t page;
+        // Host pointer of the first byte of the page
+        uint8_t *data;
+        // Rights on the page, both false if it was refused
+        bool read;
+        bool write;
+        // Latency given by the target
+        int64_t latency;
+    };
+
+    inline Entry *refill(uint64_t page);
+
+    vp::IoMaster &itf;
+    Entry entries[1 << ISS_DMI_CACHE_BITS];
+};
+
+
+
+inline DmiCache::DmiCache(vp::IoMaster &itf)
+    : itf(itf)
+{
+    this->flush();
+}
+
+inline bool DmiCache::access(uint64_t addr, uint8_t *data, uint64_t size, bool is_write,
+    int64_t &latency)
+{
+    uint64_t page = addr >> ISS_DMI_PAGE_BITS;
+    Entry *entry = &this->entries[page & ((1 << ISS_DMI_CACHE_BITS) - 1)];
+
+    if (unlikely(entry->page != page))
+    {
+        entry = this->refill(page);
+    }
+
+    uint64_t offset = addr & ((1 << ISS_DMI_PAGE_BITS) - 1);
+    if (!(is_write ? entry->write : entry->read) || offset + size > (1 << ISS_DMI_PAGE_BITS))
+    {
+        return false;
+    }
+
+    if (is_write)
+    {
+        memcpy(entry->data + offset, data, size);
+    }
+    else
+    {
+        memcpy(data, entry->data + offset, size);
+    }
+
+    latency = entry->latency;
+
+    return true;
+}
+
+inline DmiCache::Entry *DmiCache::refill(uint64_t page)
+{
+    Entry *entry = &this->entries[page & ((1 << ISS_DMI_CACHE_BITS) - 1)];
+    uint64_t base = page << ISS_DMI_PAGE_BITS;
+    vp::IoDmi dmi;
+
+    entry->page = page;
+    entry->read = false;
+    entry->write = false;
+
+    // Only grants covering the whole page are kept, anything else is considered as refused
+    if (this->itf.dmi_req(base, &dmi) && dmi.clip(base, 1 << ISS_DMI_PAGE_BITS) &&
+        dmi.size == (1 << ISS_DMI_PAGE_BITS))
+    {
+        entry->data = dmi.data;
+        entry->read = dmi.read;
+        entry->write = dmi.write;
+        entry->latency = dmi.latency;
+    }
+
+    return entry;
+}
+
+inline void DmiCache::invalidate(uint64_t base, uint64_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    uint64_t first_page = base >> ISS_DMI_PAGE_BITS;
+    uint64_t last_page = (base + (size - 1)) >> ISS_DMI_PAGE_BITS;
+    if (last_page < first_page)
+    {
+        last_page = (uint64_t)-1 >> ISS_DMI_PAGE_BITS;
+    }
+
+    for (Entry &entry: this->entries)
+    {
+        if (entry.page >= first_page && entry.page <= last_page)
+        {
+            entry.page = -1;
+        }
+    }
+}
+
+inline void DmiCache::flush()
+{
+    for (Entry &entry: this->entries)
+    {
+        entry.page = -1;
+    }
+}
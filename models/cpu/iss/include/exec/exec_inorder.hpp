@@ -85,9 +85,13 @@ public:
     void dbg_unit_step_check();
 
     inline void insn_exec_profiling();
+    inline bool insn_exec_profiling_active();
     inline void insn_exec_power(iss_insn_t *insn);
 
     inline void interrupt_taken();
+    // Can be called to force the current instruction batch to stop after the current instruction,
+    // so that the core synchronizes with the clock engine
+    inline void batch_break();
     inline bool handle_stall_cycles();
 
     iss_reg_t current_insn;
@@ -98,6 +102,7 @@ public:
 
     static void exec_instr(vp::Block *__this, vp::ClockEvent *event);
     static void exec_instr_check_all(vp::Block *__this, vp::ClockEvent *event);
+    static void exec_instr_batch(vp::Block *__this, vp::ClockEvent *event);
 
     int64_t get_cycles();
 
@@ -158,6 +163,18 @@ public:
 
     int stall_reg;
 
+    // Temporal decoupling. When batch_insns is greater than 1, the fast handler executes up to
+    // batch_insns instructions per clock event, or until the core runs batch_quantum cycles
+    // ahead of the clock engine (0 means no limit). The core synchronizes back with the engine
+    // when the batch ends, by stalling its clock event for the cycles it ran ahead.
+    int64_t batch_insns;
+    int64_t batch_quantum;
+    // Number of cycles the core is currently running ahead of the clock engine inside a batch
+    int64_t batch_cycles;
+    // Set when something needs the core to synchronize with the engine, like a stall, an
+    // interrupt or an IO which was not handled synchronously
+    bool batch_stop;
+
     inline void offload_insn(IssOffloadInsn<iss_reg_t> *insn);
 
 private:
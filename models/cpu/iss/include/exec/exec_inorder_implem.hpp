@@ -46,12 +46,17 @@ inline void Exec::interrupt_taken()
     this->iss.exec.insn_table_index = 0;
 }
 
+inline void Exec::batch_break()
+{
+    this->batch_stop = true;
+}
+
 
 static inline iss_reg_t iss_exec_stalled_insn_fast(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 {
     int latency = insn->latency;
 
-    iss_reg_t next_insn =  insn->stall_fast_handler(iss, insn, pc);
+    iss_reg_t next_insn =  insn->cold->stall_fast_handler(iss, insn, pc);
 
 #if defined(CONFIG_GVSOC_ISS_SCOREBOARD)
     if (latency > 0)
@@ -77,7 +82,7 @@ static inline iss_reg_t iss_exec_stalled_insn(Iss *iss, iss_insn_t *insn, iss_re
 
 inline int64_t Exec::get_cycles()
 {
-    return this->iss.top.clock.get_cycles() + this->stall_cycles;
+    return this->iss.top.clock.get_cycles() + this->batch_cycles + this->stall_cycles;
 }
 
 inline iss_insn_callback_t Exec::insn_trace_callback_get()
@@ -111,6 +116,7 @@ inline void Exec::insn_hold(vp::ClockEventMeth *meth)
     // Flag that we cannto execute instructions so that no one tries
     // to change the event callback
     this->insn_on_hold = true;
+    this->batch_break();
     this->iss.exec.instr_event.set_callback(meth);
 }
 
@@ -175,6 +181,7 @@ inline void Exec::stalled_inc()
         this->instr_event.disable();
     }
     this->stalled.inc(1);
+    this->batch_break();
 }
 
 inline void Exec::stalled_dec()
@@ -211,16 +218,33 @@ inline void Exec::insn_exec_profiling()
     }
 }
 
+inline bool Exec::insn_exec_profiling_active()
+{
+    return this->iss.timing.pc_trace_event.get_event_active() ||
+        this->iss.timing.active_pc_trace_event.get_event_active() ||
+        this->iss.timing.func_trace_event.get_event_active() ||
+        this->iss.timing.inline_trace_event.get_event_active() ||
+        this->iss.timing.file_trace_event.get_event_active() ||
+        this->iss.timing.line_trace_event.get_event_active() ||
+        this->iss.profiler.active;
+}
+
 inline void Exec::insn_exec_power(iss_insn_t *insn)
 {
     if (this->iss.top.power.get_power_trace()->get_active())
     {
-        this->iss.timing.insn_groups_power[insn->decoder_item->u.insn.power_group].account_energy_quantum();
+        // The power models compute with host floats, the FP exceptions of the core must not
+        // get them
+        lib_ff_flags_sync();
+        this->iss.timing.insn_groups_power[insn->cold->decoder_item->u.insn.power_group].account_energy_quantum();
     }
 }
 
 inline void Exec::switch_to_full_mode()
 {
+    // Whatever required the full mode must be seen by the engine, stop the current batch
+    this->batch_break();
+
     // Only switch to full mode instruction if we are not currently executing instructions,
     // do not overwrite the event callback used for another activity
     if (!this->insn_on_hold)
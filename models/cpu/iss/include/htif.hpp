@@ -118,6 +118,7 @@ private:
     void exec_syscall();
     uint8_t read_uint8(iss_reg_t addr);
     static void htif_handler(vp::Block *__this, vp::ClockEvent *event);
+    void tohost_written();
 
     iss_reg_t sys_exit(iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t);
     iss_reg_t sys_openat(iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t);
@@ -157,5 +158,8 @@ private:
 
     iss_reg_t tohost_addr;
     iss_reg_t fromhost_addr;
+    // If true, tohost is periodically read to check for commands, otherwise it is only checked
+    // when the core writes it
+    bool polling;
     vp::ClockEvent htif_event;
 };
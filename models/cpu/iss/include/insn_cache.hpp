@@ -21,35 +21,187 @@
 
 #pragma once
 
-// The size of a page corresponds to the tlb page size with instructions of at least 2 bytes
+#include <cpu/iss/include/insn_jit.hpp>
+
+// Number of address bits covered by a page, which has one instruction every 2 bytes.
+// This can be overwritten by the core configuration.
+#if defined(CONFIG_GVSOC_ISS_INSN_PAGE_BITS)
+#define INSN_PAGE_BITS CONFIG_GVSOC_ISS_INSN_PAGE_BITS
+#else
 #define INSN_PAGE_BITS 9
+#endif
 #define INSN_PAGE_SIZE (1 << (INSN_PAGE_BITS - 1))
 #define INSN_PAGE_MASK (INSN_PAGE_SIZE - 1)
 
+#if defined(CONFIG_GVSOC_ISS_MMU) && INSN_PAGE_BITS > 12
+#error "Instruction pages can't be bigger than MMU pages"
+#endif
+
 struct InsnPage
 {
-    iss_insn_t insns[INSN_PAGE_SIZE];
+    inline ~InsnPage();
+    // Aligned on cache lines, so that the fields read to execute an instruction, which are at
+    // the beginning of the instruction, are usually in a single line
+    alignas(64) iss_insn_t insns[INSN_PAGE_SIZE];
+    // Cold parts of the instructions, kept apart so that the instructions are contiguous
+    iss_insn_cold_t cold[INSN_PAGE_SIZE];
     InsnPage *next;
 };
 
+// Instructions which are not in a page, like the micro-instructions of a macro-instruction,
+// freed when the cache is flushed
+struct InsnTable
+{
+    iss_insn_t *insns;
+    iss_insn_cold_t *cold;
+    int nb_insns;
+};
+
+// Pages are found from their physical page index through a radix table. The 2 lowest levels
+// are arrays indexed by the page index bits, while the upper bits select the directory through
+// a map, which is rarely looked up since the last directory is remembered.
+#define INSN_TABLE_LEVEL_BITS 10
+#define INSN_TABLE_LEVEL_SIZE (1 << INSN_TABLE_LEVEL_BITS)
+#define INSN_TABLE_LEVEL_MASK (INSN_TABLE_LEVEL_SIZE - 1)
+
+struct InsnPageTable
+{
+    InsnPage *pages[INSN_TABLE_LEVEL_SIZE];
+};
+
+struct InsnPageDir
+{
+    InsnPageTable *tables[INSN_TABLE_LEVEL_SIZE];
+};
+
+// Number of entries of the direct-mapped cache of recently used pages
+#define INSN_PAGE_CACHE_SIZE 16
+// Number of page lookups after which the miss rate of the page cache is dumped
+#define INSN_PAGE_CACHE_STATS_PERIOD 1024
+
+// Maximum number of instructions in a translated block
+#define INSN_BLOCK_MAX_INSNS 64
+// Number of successors remembered by a block for chaining
+#define INSN_BLOCK_NB_NEXT 2
+
+// Translated block, containing straight-line instructions which can be executed one after the
+// other without looking up the instruction cache.
+// Blocks are filled while they are executed for the first time, and are complete once an
+// instruction does not continue to the next one, or once they reach the end of the page or the
+// maximum size. They remember their last successors so that a loop can execute as a chain of
+// blocks without looking up the block table.
+struct InsnBlock
+{
+    iss_reg_t pc;                             // Virtual address of the first instruction
+    int nb_insns;                             // Number of instructions currently in the block
+    bool complete;                            // True if no instruction can be added anymore
+    iss_insn_t *insns[INSN_BLOCK_MAX_INSNS];  // Instructions of the block, in execution order
+    iss_reg_t next_pc[INSN_BLOCK_NB_NEXT];    // Address of the successor blocks
+    InsnBlock *next[INSN_BLOCK_NB_NEXT];      // Successor blocks, NULL if the entry is not used
+    int next_victim;                          // Next successor entry to be replaced
+    int64_t nb_exec;                          // Number of times the block was entered, for JIT profiling
+    bool jit_done;                            // True if the block already went through the JIT
+    InsnJitRun *jit_runs;                     // Translated runs indexed by first instruction, or NULL
+};
+
 class InsnCache
 {
 public:
     InsnCache(Iss &iss);
     void build();
     void flush();
+    // Request the invalidation of the decoded instructions in the specified physical range.
+    // This can be called in the middle of an instruction, pages are invalidated before the next
+    // instruction is executed
+    void invalidate(iss_addr_t paddr, iss_addr_t size);
+    // Invalidate the pages whose invalidation was requested
+    void invalidate_apply();
+    // Check if a data store is modifying decoded instructions
+    inline void store_check(iss_addr_t paddr, iss_addr_t size);
     bool insn_is_decoded(iss_insn_t *insn);
     iss_insn_t *get_insn_from_cache(iss_reg_t vaddr, iss_reg_t &index);
     inline iss_insn_t *get_insn(iss_reg_t vaddr, iss_reg_t &index);
     void mode_flush();
-    inline void insn_init(iss_insn_t *insn, iss_addr_t addr);
+    inline void insn_init(iss_insn_t *insn, iss_insn_cold_t *cold, iss_addr_t addr);
+    // Allocate a table of instructions which is freed when the cache is flushed
+    iss_insn_t *insn_table_alloc(int nb_insns);
+    // Get the debug information of an instruction, and allocate it if needed
+    inline iss_insn_debug_t *insn_debug_get(iss_insn_t *insn);
+    iss_insn_debug_t *insn_debug_alloc(iss_insn_t *insn);
     InsnPage *page_get(iss_reg_t paddr);
+    // Get the page with the specified physical page index, or NULL if it does not exist
+    InsnPage *page_find(iss_reg_t index);
+    // Remove the page with the specified physical page index from the table and free it
+    void page_remove(iss_reg_t index);
+
+    // Get the translated block starting at the specified address. prev is the block which has
+    // just been executed and is used for chaining, it can be NULL
+    inline InsnBlock *block_get(InsnBlock *prev, iss_reg_t pc);
+    InsnBlock *block_get_from_table(InsnBlock *prev, iss_reg_t pc);
+    // Free all translated blocks. This must not be called while a block is being executed
+    void block_flush();
+    // Account one execution of the block and translate it to host code once it gets hot.
+    // Returns true if the block was translated
+    inline bool block_jit_check(InsnBlock *block);
+    void block_jit_translate(InsnBlock *block);
+    // Account instructions executed through translated code
+    inline void jit_native_account(int64_t nb_insns);
+
+    // True if hot blocks are translated to host code
+    bool jit_enabled;
+    // True if the whole cache is flushed on fence.i and stores are not checked, which is only
+    // the case if store tracking is disabled
+    bool full_flush;
+    // True if some pages must be invalidated before the next instruction
+    bool invalidate_pending;
 
 
 private:
     InsnPage *current_insn_page;
     iss_reg_t current_insn_page_base;
-    std::unordered_map<iss_reg_t, InsnPage *>pages;
+    // Get the slot of the radix table where the page with the specified index is stored,
+    // allocating the intermediate tables if needed, or NULL if they are not allocated
+    InsnPage **page_slot(iss_reg_t index, bool alloc);
+    void page_cache_flush();
+
+    // Upper level of the radix table, indexed by the page index bits above the 2 table levels
+    std::unordered_map<iss_reg_t, InsnPageDir *> page_dirs;
+    // Last directory which was looked up, to avoid the map lookup
+    iss_reg_t last_dir_index;
+    InsnPageDir *last_dir;
+    // Direct-mapped cache of the recently used pages, indexed by the low bits of the page index
+    iss_reg_t page_cache_index[INSN_PAGE_CACHE_SIZE];
+    InsnPage *page_cache[INSN_PAGE_CACHE_SIZE];
+    // Number of page lookups and page cache misses since the last statistics dump
+    int page_lookups;
+    int page_misses;
+    // Miss rate of the page cache, dumped every INSN_PAGE_CACHE_STATS_PERIOD lookups
+    vp::Trace page_miss_rate_event;
+    // Number of instruction debug records allocated so far, dumped each time one is allocated
+    int64_t nb_debug_records;
+    vp::Trace debug_records_event;
+    std::vector<InsnTable> insn_tables;
+    // Physical address range covering all the pages, used to quickly filter stores
+    iss_addr_t code_start;
+    iss_addr_t code_end;
+    // Index of the pages to be invalidated before the next instruction
+    std::vector<iss_reg_t> invalidate_pages;
+    std::unordered_map<iss_reg_t, InsnBlock *>blocks;
+    // Set when the address translation changed while a block may be executing, blocks are then
+    // flushed when the next one is looked up
+    bool block_flush_pending;
+    // Number of executions after which a block is translated to host code
+    int64_t jit_threshold;
+    // Number of instructions translated to host code so far, dumped each time a run is translated
+    int64_t jit_translated_insns;
+    vp::Trace jit_translated_insns_event;
+    // Number of instructions executed through translated code so far, dumped at the end of each
+    // instruction batch which executed some
+    int64_t jit_native_insns;
+    vp::Trace jit_native_insns_event;
+#if defined(ISS_HAS_JIT)
+    InsnJit jit;
+#endif
 
     Iss &iss;
 };
@@ -67,12 +219,77 @@ inline iss_insn_t *InsnCache::get_insn(iss_reg_t vaddr, iss_reg_t &index)
     return this->get_insn_from_cache(vaddr, index);
 }
 
-inline void InsnCache::insn_init(iss_insn_t *insn, iss_addr_t addr)
+inline InsnBlock *InsnCache::block_get(InsnBlock *prev, iss_reg_t pc)
+{
+    if (likely(prev != NULL))
+    {
+        for (int i=0; i<INSN_BLOCK_NB_NEXT; i++)
+        {
+            if (prev->next[i] != NULL && prev->next_pc[i] == pc)
+            {
+                return prev->next[i];
+            }
+        }
+    }
+
+    return this->block_get_from_table(prev, pc);
+}
+
+inline void InsnCache::store_check(iss_addr_t paddr, iss_addr_t size)
+{
+    if (unlikely(paddr < this->code_end && paddr + size > this->code_start))
+    {
+        this->invalidate(paddr, size);
+    }
+}
+
+inline bool InsnCache::block_jit_check(InsnBlock *block)
+{
+#if defined(ISS_HAS_JIT)
+    if (unlikely(!block->jit_done) && block->complete && ++block->nb_exec >= this->jit_threshold)
+    {
+        this->block_jit_translate(block);
+        return true;
+    }
+#endif
+    return false;
+}
+
+inline void InsnCache::jit_native_account(int64_t nb_insns)
+{
+    this->jit_native_insns += nb_insns;
+    if (this->jit_native_insns_event.get_event_active())
+    {
+        this->jit_native_insns_event.event((uint8_t *)&this->jit_native_insns);
+    }
+}
+
+inline InsnPage::~InsnPage()
+{
+    for (int i=0; i<INSN_PAGE_SIZE; i++)
+    {
+        delete this->cold[i].debug;
+    }
+}
+
+inline iss_insn_debug_t *InsnCache::insn_debug_get(iss_insn_t *insn)
+{
+    if (unlikely(insn->cold->debug == NULL))
+    {
+        insn->cold->debug = this->insn_debug_alloc(insn);
+    }
+    return insn->cold->debug;
+}
+
+inline void InsnCache::insn_init(iss_insn_t *insn, iss_insn_cold_t *cold, iss_addr_t addr)
 {
+    insn->cold = cold;
     insn->handler = iss_decode_pc_handler;
     insn->fast_handler = iss_decode_pc_handler;
+    cold->decoder_item = NULL;
+    cold->debug = NULL;
     insn->addr = addr;
 #if defined(CONFIG_GVSOC_ISS_RI5KY)
-    insn->hwloop_handler = NULL;
+    cold->hwloop_handler = NULL;
 #endif
 }
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// The JIT tier is only available on x86-64 hosts, for 32-bit cores which do not need to observe
+// every instruction for timing, HW loops, scoreboarding or memcheck.
+#if defined(__x86_64__) && defined(ISS_WORD_32) && !defined(CONFIG_GVSOC_ISS_TIMED) && \
+    !defined(CONFIG_GVSOC_ISS_RI5KY) && !defined(CONFIG_GVSOC_ISS_SNITCH) && \
+    !defined(CONFIG_GVSOC_ISS_SCOREBOARD) && !defined(VP_MEMCHECK_ACTIVE)
+#define ISS_HAS_JIT 1
+#endif
+
+// Native code executing a run of instructions, which gets the integer register file as argument
+typedef void (*InsnJitCode)(iss_reg_t *regs);
+
+// Native code for a run of consecutive instructions of a block
+struct InsnJitRun
+{
+    InsnJitCode code;   // Native code, NULL if no run starts at this instruction
+    int nb_insns;       // Number of instructions executed by the native code
+    int size;           // Total size in bytes of these instructions
+};
+
+#if defined(ISS_HAS_JIT)
+
+// Minimum number of instructions in a run to make it worth being translated. Runs of 2
+// instructions are still slightly faster than interpreted, see tools/jit_bench.cpp
+#define INSN_JIT_MIN_RUN 2
+// Size of the executable memory where host code is generated
+#define INSN_JIT_BUFFER_SIZE (16 * 1024 * 1024)
+// Maximum number of bytes of host code generated for one instruction
+#define INSN_JIT_MAX_INSN_BYTES 32
+
+// Translator from instructions to x86-64 host code.
+// Only the base integer instructions which cannot trap and have no side effect other than
+// writing their output register are translated, anything else stays executed by the instruction
+// handlers. Since registers are read from and written to the register file for each
+// instruction, the architectural state is exact at the end of each run.
+// Branches, jumps, loads and stores are deliberately not translated. Their handlers account
+// branch penalties and performance events, and go through address translation, PMP checks,
+// misaligned accesses and store watch, which translated code would have to replicate.
+// The gain thus depends on the share of ALU instructions in the hot loops. On the kernels of
+// tools/jit_bench.cpp, compute loops like CRC or hashes run 1.3 to 2.6 times faster than with the
+// batch interpreter, while loops dominated by memory accesses and branches, like memcpy or strlen,
+// are not faster.
+// The code buffer is never writable and executable at the same time. It is executable, and the
+// pages where a run is generated are only made writable while the run is being emitted.
+class InsnJit
+{
+public:
+    // Operations which can be translated
+    typedef enum
+    {
+        OP_NONE,
+        OP_NOP,
+        OP_LUI,
+        OP_AUIPC,
+        OP_ADDI,
+        OP_SLTI,
+        OP_SLTIU,
+        OP_XORI,
+        OP_ORI,
+        OP_ANDI,
+        OP_SLLI,
+        OP_SRLI,
+        OP_SRAI,
+        OP_ADD,
+        OP_SUB,
+        OP_SLL,
+        OP_SLT,
+        OP_SLTU,
+        OP_XOR,
+        OP_SRL,
+        OP_SRA,
+        OP_OR,
+        OP_AND,
+        OP_MUL,
+    } op_e;
+
+    inline ~InsnJit();
+
+    // Allocate the executable memory where the code is generated
+    inline bool init(size_t size);
+    // Free all the generated code
+    inline void reset();
+    // Get the operation of an instruction, OP_NONE if it can't be translated
+    inline op_e insn_op(iss_insn_t *insn);
+    // Translate a run of instructions starting at pc. They must all be supported. Returns NULL
+    // if the code buffer is full or if its protection could not be changed
+    inline InsnJitCode run_translate(iss_insn_t **insns, int nb_insns, iss_reg_t pc);
+
+    // Set when the protection of the code buffer could not be changed, the translated code must
+    // then not be executed anymore
+    bool failed = false;
+
+private:
+    inline void emit8(uint8_t value);
+    inline void emit32(uint32_t value);
+    // Emit an instruction on eax or ecx with a register of the register file as memory operand
+    inline void emit_mem(std::initializer_list<uint8_t> opcode, int x86_reg, int reg);
+    inline void emit_load(int x86_reg, int reg) { this->emit_mem({0x8B}, x86_reg, reg); }
+    inline void emit_store(int reg) { this->emit_mem({0x89}, 0, reg); }
+    // Emit an ALU operation on eax with a 32-bit immediate, opcode is the eax short form
+    inline void emit_imm(uint8_t opcode, uint32_t imm) { this->emit8(opcode); this->emit32(imm); }
+    inline void emit_set(uint8_t cond);
+    inline void insn_translate(iss_insn_t *insn, op_e op, iss_reg_t pc);
+
+    // Change the protection of the pages covering the specified part of the buffer
+    inline bool protect(size_t offset, size_t size, int prot);
+
+    uint8_t *buffer = NULL;
+    size_t buffer_size = 0;
+    // Current position where code is generated
+    size_t pos = 0;
+    // Operations of the instructions indexed by their label
+    std::unordered_map<std::string, op_e> ops;
+};
+
+
+
+inline InsnJit::~InsnJit()
+{
+    if (this->buffer)
+    {
+        munmap(this->buffer, this->buffer_size);
+    }
+}
+
+inline bool InsnJit::init(size_t size)
+{
+    void *buffer = mmap(NULL, size, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED)
+    {
+        return false;
+    }
+
+    this->buffer = (uint8_t *)buffer;
+    this->buffer_size = size;
+    this->pos = 0;
+
+    this->ops = {
+        { "nop", OP_NOP }, { "c.nop", OP_NOP },
+        { "lui", OP_LUI }, { "c.lui", OP_LUI },
+        { "auipc", OP_AUIPC },
+        { "addi", OP_ADDI }, { "c.addi", OP_ADDI }, { "c.addi4spn", OP_ADDI },
+        { "c.addi16sp", OP_ADDI }, { "c.li", OP_ADDI },
+        { "slti", OP_SLTI }, { "sltiu", OP_SLTIU },
+        { "xori", OP_XORI }, { "ori", OP_ORI },
+        { "andi", OP_ANDI }, { "c.andi", OP_ANDI },
+        { "slli", OP_SLLI }, { "c.slli", OP_SLLI },
+        { "srli", OP_SRLI }, { "c.srli", OP_SRLI },
+        { "srai", OP_SRAI }, { "c.srai", OP_SRAI },
+        { "add", OP_ADD }, { "c.add", OP_ADD }, { "c.mv", OP_ADD },
+        { "sub", OP_SUB }, { "c.sub", OP_SUB },
+        { "sll", OP_SLL }, { "slt", OP_SLT }, { "sltu", OP_SLTU },
+        { "xor", OP_XOR }, { "c.xor", OP_XOR },
+        { "srl", OP_SRL }, { "sra", OP_SRA },
+        { "or", OP_OR }, { "c.or", OP_OR },
+        { "and", OP_AND }, { "c.and", OP_AND },
+        { "mul", OP_MUL },
+    };
+
+    return true;
+}
+
+inline bool InsnJit::protect(size_t offset, size_t size, int prot)
+{
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t start = offset & ~(page_size - 1);
+    size_t end = std::min((offset + size + page_size - 1) & ~(page_size - 1), this->buffer_size);
+
+    return mprotect(&this->buffer[start], end - start, prot) == 0;
+}
+
+inline void InsnJit::reset()
+{
+    this->pos = 0;
+}
+
+inline InsnJit::op_e InsnJit::insn_op(iss_insn_t *insn)
+{
+    iss_decoder_item_t *item = insn->cold->decoder_item;
+
+    // Instructions whose handler has been patched after decoding, for example by a breakpoint,
+    // must keep going through their handler
+    if (item == NULL || insn->fast_handler != item->u.insn.fast_handler)
+    {
+        return OP_NONE;
+    }
+
+    auto it = this->ops.find(item->u.insn.label);
+    return it == this->ops.end() ? OP_NONE : it->second;
+}
+
+inline void InsnJit::emit8(uint8_t value)
+{
+    this->buffer[this->pos++] = value;
+}
+
+inline void InsnJit::emit32(uint32_t value)
+{
+    memcpy(&this->buffer[this->pos], &value, 4);
+    this->pos += 4;
+}
+
+inline void InsnJit::emit_mem(std::initializer_list<uint8_t> opcode, int x86_reg, int reg)
+{
+    for (uint8_t byte: opcode)
+    {
+        this->emit8(byte);
+    }
+    // ModRM for [rdi + disp32], rdi holding the register file
+    this->emit8(0x87 | (x86_reg << 3));
+    this->emit32(reg * sizeof(iss_reg_t));
+}
+
+inline void InsnJit::emit_set(uint8_t cond)
+{
+    // setcc al; movzx eax, al
+    this->emit8(0x0F); this->emit8(cond); this->emit8(0xC0);
+    this->emit8(0x0F); this->emit8(0xB6); this->emit8(0xC0);
+}
+
+inline void InsnJit::insn_translate(iss_insn_t *insn, op_e op, iss_reg_t pc)
+{
+    // x86 register numbers
+    const int eax = 0, ecx = 1;
+
+    switch (op)
+    {
+        case OP_NOP:
+            return;
+
+        case OP_LUI:
+            this->emit_imm(0xB8, insn->uim[0]);
+            break;
+
+        case OP_AUIPC:
+            this->emit_imm(0xB8, insn->uim[0] + pc);
+            break;
+
+        case OP_ADDI:
+        case OP_SLTI:
+        case OP_SLTIU:
+        case OP_XORI:
+        case OP_ORI:
+        case OP_ANDI:
+            this->emit_load(eax, insn->in_regs[0]);
+            switch (op)
+            {
+                case OP_ADDI: this->emit_imm(0x05, insn->sim[0]); break;
+                case OP_XORI: this->emit_imm(0x35, insn->sim[0]); break;
+                case OP_ORI:  this->emit_imm(0x0D, insn->sim[0]); break;
+                case OP_ANDI: this->emit_imm(0x25, insn->sim[0]); break;
+                case OP_SLTI:  this->emit_imm(0x3D, insn->sim[0]); this->emit_set(0x9C); break;
+                case OP_SLTIU: this->emit_imm(0x3D, insn->sim[0]); this->emit_set(0x92); break;
+                default: break;
+            }
+            break;
+
+        case OP_SLLI:
+        case OP_SRLI:
+        case OP_SRAI:
+            this->emit_load(eax, insn->in_regs[0]);
+            this->emit8(0xC1);
+            this->emit8(op == OP_SLLI ? 0xE0 : op == OP_SRLI ? 0xE8 : 0xF8);
+            this->emit8(insn->uim[0] & 0x1F);
+            break;
+
+        case OP_SLL:
+        case OP_SRL:
+        case OP_SRA:
+            // x86 also only uses the 5 low bits of cl for 32-bit shifts
+            this->emit_load(eax, insn->in_regs[0]);
+            this->emit_load(ecx, insn->in_regs[1]);
+            this->emit8(0xD3);
+            this->emit8(op == OP_SLL ? 0xE0 : op == OP_SRL ? 0xE8 : 0xF8);
+            break;
+
+        default:
+            this->emit_load(eax, insn->in_regs[0]);
+            switch (op)
+            {
+                case OP_ADD: this->emit_mem({0x03}, eax, insn->in_regs[1]); break;
+                case OP_SUB: this->emit_mem({0x2B}, eax, insn->in_regs[1]); break;
+                case OP_XOR: this->emit_mem({0x33}, eax, insn->in_regs[1]); break;
+                case OP_OR:  this->emit_mem({0x0B}, eax, insn->in_regs[1]); break;
+                case OP_AND: this->emit_mem({0x23}, eax, insn->in_regs[1]); break;
+                case OP_MUL: this->emit_mem({0x0F, 0xAF}, eax, insn->in_regs[1]); break;
+                case OP_SLT:
+                    this->emit_mem({0x3B}, eax, insn->in_regs[1]); this->emit_set(0x9C); break;
+                case OP_SLTU:
+                    this->emit_mem({0x3B}, eax, insn->in_regs[1]); this->emit_set(0x92); break;
+                default: break;
+            }
+            break;
+    }
+
+    this->emit_store(insn->out_regs[0]);
+}
+
+inline InsnJitCode InsnJit::run_translate(iss_insn_t **insns, int nb_insns, iss_reg_t pc)
+{
+    if (this->buffer == NULL ||
+        this->pos + (nb_insns + 1) * INSN_JIT_MAX_INSN_BYTES > this->buffer_size)
+    {
+        return NULL;
+    }
+
+    size_t start = this->pos;
+    size_t max_size = (nb_insns + 1) * INSN_JIT_MAX_INSN_BYTES;
+
+    if (!this->protect(start, max_size, PROT_READ | PROT_WRITE))
+    {
+        this->failed = true;
+        return NULL;
+    }
+
+    InsnJitCode code = (InsnJitCode)&this->buffer[this->pos];
+
+    for (int i=0; i<nb_insns; i++)
+    {
+        this->insn_translate(insns[i], this->insn_op(insns[i]), pc);
+        pc += insns[i]->size;
+    }
+
+    // ret
+    this->emit8(0xC3);
+
+    if (!this->protect(start, max_size, PROT_READ | PROT_EXEC))
+    {
+        // The pages may still hold code translated before, no code must be executed anymore
+        this->failed = true;
+        return NULL;
+    }
+
+    return code;
+}
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+// Binary instruction trace format, produced by the ISS when traces are dumped with the binary
+// format, and read back by gvsoc_insn_trace to produce the usual text traces.
+// This file is shared by both sides and must not depend on the ISS.
+//
+// The file starts with INSN_TRACE_BIN_MAGIC followed by the version as a 32-bit integer.
+// It is then made of chunks, each starting with the stream identifier and the size in bytes of
+// its records as 32-bit integers. A stream holds the records of one core, in execution order,
+// and its chunks are in order in the file, but chunks of different streams are interleaved.
+//
+// Each record starts with its type on one byte. All the other integers are LEB128-encoded, and
+// signed ones are zigzag-encoded first. Strings are their size followed by their characters.
+//
+// INSN_TRACE_BIN_STREAM, first record of a stream:
+//     path, maximum trace path length, register width in bits, flags
+// INSN_TRACE_BIN_DESC, static information of a decoded instruction:
+//     identifier, opcode, flags, [inline function, line], label, number of arguments, then for
+//     each argument:
+//         type, decoder flags, attributes, [name], then depending on the type:
+//         register: index, immediate: value, indirect immediate: register index, immediate,
+//         indirect register: offset register index, base register index
+// INSN_TRACE_BIN_INSN, one executed instruction:
+//     descriptor identifier, flags, pc delta, time delta, cycles delta, privilege mode,
+//     [register dump], [string dump], then for each argument the values of the registers it
+//     uses, followed by their inverted memcheck validity if the stream has
+//     INSN_TRACE_BIN_STREAM_MEMCHECK, so that fully valid values take one byte:
+//         register: value, indirect immediate: register value,
+//         indirect register: offset register value, base register value
+//     Registers are only dumped if they are floating-point ones or are not x0, and the validity
+//     is not dumped for floating-point registers.
+//     The deltas are relative to the previous instruction of the same stream.
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#define INSN_TRACE_BIN_MAGIC "GVINSNTR"
+#define INSN_TRACE_BIN_MAGIC_SIZE 8
+#define INSN_TRACE_BIN_VERSION 1
+
+// Size of the chunks of records
+#define INSN_TRACE_BIN_CHUNK_SIZE (256 * 1024)
+
+// Record types
+#define INSN_TRACE_BIN_STREAM 0
+#define INSN_TRACE_BIN_DESC   1
+#define INSN_TRACE_BIN_INSN   2
+
+// Stream flags
+#define INSN_TRACE_BIN_STREAM_MEMCHECK (1 << 0)  // Register values come with their validity
+#define INSN_TRACE_BIN_STREAM_DOUBLE   (1 << 1)  // FP registers are dumped on 64 bits
+#define INSN_TRACE_BIN_STREAM_SINGLE_REGFILE (1 << 2)  // FP registers are integer ones
+
+// Descriptor flags
+#define INSN_TRACE_BIN_DESC_MACRO_OP (1 << 0)    // Only dumped with the long format
+#define INSN_TRACE_BIN_DESC_DEBUG    (1 << 1)    // Debug information of the pc follows
+
+// Argument types, same values as the ISS decoder
+#define INSN_TRACE_BIN_ARG_NONE         0
+#define INSN_TRACE_BIN_ARG_OUT_REG      1
+#define INSN_TRACE_BIN_ARG_IN_REG       2
+#define INSN_TRACE_BIN_ARG_UIMM         3
+#define INSN_TRACE_BIN_ARG_SIMM         4
+#define INSN_TRACE_BIN_ARG_INDIRECT_IMM 5
+#define INSN_TRACE_BIN_ARG_INDIRECT_REG 6
+#define INSN_TRACE_BIN_ARG_FLAG         7
+
+// Argument decoder flags, same values as the ISS decoder
+#define INSN_TRACE_BIN_ARG_FLAG_POSTINC 1
+#define INSN_TRACE_BIN_ARG_FLAG_PREINC  2
+#define INSN_TRACE_BIN_ARG_FLAG_FREG    8
+#define INSN_TRACE_BIN_ARG_FLAG_REG64   16
+
+// Argument attributes
+#define INSN_TRACE_BIN_ARG_DUMP_REG (1 << 0)     // The register name appears in the arguments
+#define INSN_TRACE_BIN_ARG_NAME     (1 << 1)     // The immediate is dumped with a name
+
+// Instruction flags
+#define INSN_TRACE_BIN_INSN_REG_DUMP (1 << 0)
+#define INSN_TRACE_BIN_INSN_STR_DUMP (1 << 1)
+
+// Maximum size of an encoded integer
+#define INSN_TRACE_BIN_INT_SIZE 10
+
+
+static inline uint8_t *insn_trace_bin_put(uint8_t *buff, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        *buff++ = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    *buff++ = value;
+    return buff;
+}
+
+static inline uint8_t *insn_trace_bin_put_signed(uint8_t *buff, int64_t value)
+{
+    return insn_trace_bin_put(buff, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static inline uint8_t *insn_trace_bin_put_str(uint8_t *buff, const char *str)
+{
+    size_t size = strlen(str);
+    buff = insn_trace_bin_put(buff, size);
+    memcpy(buff, str, size);
+    return buff + size;
+}
+
+// Decoder of the integers and strings of a record, flagging an error instead of reading beyond
+// the end of the data
+class InsnTraceBinReader
+{
+public:
+    InsnTraceBinReader(const uint8_t *data, size_t size) : current(data), end(data + size) {}
+
+    inline bool done() { return this->current >= this->end; }
+
+    inline uint8_t get_byte()
+    {
+        if (this->current >= this->end)
+        {
+            this->error = true;
+            return 0;
+        }
+        return *this->current++;
+    }
+
+    inline uint64_t get()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte = this->get_byte();
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return value;
+            }
+        }
+        this->error = true;
+        return value;
+    }
+
+    inline int64_t get_signed()
+    {
+        uint64_t value = this->get();
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    inline std::string get_str()
+    {
+        uint64_t size = this->get();
+        if (size > (uint64_t)(this->end - this->current))
+        {
+            this->error = true;
+            return "";
+        }
+        std::string result((const char *)this->current, size);
+        this->current += size;
+        return result;
+    }
+
+    bool error = false;
+
+private:
+    const uint8_t *current;
+    const uint8_t *end;
+};
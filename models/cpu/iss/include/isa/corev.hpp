@@ -43,7 +43,7 @@ static inline iss_reg_t corev_hwloop_check_exec(Iss *iss, iss_insn_t *insn, iss_
 
     // First execute the instructions as it is the last one of the loop body.
     // The real handler has been saved when the loop was started.
-    iss_reg_t insn_next = insn->hwloop_handler(iss, insn, pc);
+    iss_reg_t insn_next = insn->cold->hwloop_handler(iss, insn, pc);
 
     if (elw_interrupted)
     {
@@ -102,16 +102,16 @@ static inline void corev_hwloop_set_insn_end(Iss *iss, iss_reg_t pc)
     abort();
     // if (insn->fetched)
     // {
-    //     if (insn->hwloop_handler == NULL)
+    //     if (insn->cold->hwloop_handler == NULL)
     //     {
-    //         insn->hwloop_handler = insn->handler;
+    //         insn->cold->hwloop_handler = insn->handler;
     //         insn->handler = hwloop_check_exec;
     //         insn->fast_handler = hwloop_check_exec;
     //     }
     // }
     // else
     // {
-    //     insn->hwloop_handler = hwloop_check_exec;
+    //     insn->cold->hwloop_handler = hwloop_check_exec;
     // }
 }
 
@@ -25,10 +25,15 @@
 
 static inline void csr_decode(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 {
-    // In case traces are active, convert the CSR number into a name
+    // In case traces are active, convert the CSR number into a name. The debug record is always
+    // allocated before decoding when instruction traces are active
 #ifdef VP_TRACE_ACTIVE
-    insn->args[2].flags = (iss_decoder_arg_flag_e)(insn->args[2].flags | ISS_DECODER_ARG_FLAG_DUMP_NAME);
-    insn->args[2].name = iss_csr_name(iss, UIM_GET(0));
+    iss_insn_debug_t *debug = insn->cold->debug;
+    if (debug)
+    {
+        debug->args[2].flags = (iss_decoder_arg_flag_e)(debug->args[2].flags | ISS_DECODER_ARG_FLAG_DUMP_NAME);
+        debug->args[2].name = iss_csr_name(iss, UIM_GET(0));
+    }
 #endif
 }
 
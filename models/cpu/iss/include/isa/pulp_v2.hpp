@@ -703,7 +703,7 @@ static inline iss_reg_t hwloop_check_exec(Iss *iss, iss_insn_t *insn, iss_reg_t
 
     // First execute the instructions as it is the last one of the loop body.
     // The real handler has been saved when the loop was started.
-    iss_reg_t insn_next = insn->hwloop_handler(iss, insn, pc);
+    iss_reg_t insn_next = insn->cold->hwloop_handler(iss, insn, pc);
 
     if (iss->exec.halted.get())
     {
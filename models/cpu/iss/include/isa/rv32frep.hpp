@@ -32,8 +32,8 @@ static inline iss_reg_t frep_o_exec(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 #ifdef CONFIG_GVSOC_ISS_SNITCH
     // Add access check REG_GET(0) here, one of input operand is from register.
     // Latency accumulates after the instruction if there's data dependency.
-    insn->max_rpt = REG_GET(0);
-    insn->is_outer = true;
+    insn->cold->max_rpt = REG_GET(0);
+    insn->cold->is_outer = true;
     
     // Send an IO request to check whether the subsystem is ready for offloading.
     bool acc_req_ready = iss->check_state(insn);
@@ -59,8 +59,8 @@ static inline iss_reg_t frep_o_exec(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 static inline iss_reg_t frep_i_exec(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 {
 #ifdef CONFIG_GVSOC_ISS_SNITCH
-    insn->max_rpt = REG_GET(0);
-    insn->is_outer = false;
+    insn->cold->max_rpt = REG_GET(0);
+    insn->cold->is_outer = false;
     
     // Send an IO request to check whether the subsystem is ready for offloading.
     bool acc_req_ready = iss->check_state(insn);
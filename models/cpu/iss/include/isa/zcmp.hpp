@@ -36,19 +36,15 @@ static inline iss_reg_t cm_insn_handle(Iss *iss, iss_insn_t *insn, iss_reg_t pc,
     int nb_regs = (UIM_GET(0) - 3) & 0xf;
     int nb_insns = nb_regs + 1 + ret + retz;
 
-    iss_insn_t *table = insn->expand_table;
+    iss_insn_t *table = insn->cold->expand_table;
     if (table == NULL)
     {
         // The table of micro-instructions can be empty if it is the first time we execute this instruction or
         // if there was a cache flush.
         // In both cases, we need to fill an array of instruction opcodes and decode it.
-        table = new iss_insn_t[nb_insns];
-        insn->expand_table = table;
-
-        for (int i=0; i<nb_insns; i++)
-        {
-            iss->insn_cache.insn_init(&table[i], 0);
-        }
+        // Instruction table is freed by the cache when it is flushed
+        table = iss->insn_cache.insn_table_alloc(nb_insns);
+        insn->cold->expand_table = table;
 
         // The maximum immediate is a multiple of 4 with 4 bytes per register, and adjusted with second
         // instruction immediate
@@ -103,9 +99,6 @@ static inline iss_reg_t cm_insn_handle(Iss *iss, iss_insn_t *insn, iss_reg_t pc,
         {
             iss->decode.decode_pc(&table[i], insn->addr);
         }
-
-        // Instruction table must be pushed to decoder so that it is freed when cache is flushed
-        iss->decode.insn_tables.push_back(table);
     }
 
     // Lock the IRQs if we enter the atomic section
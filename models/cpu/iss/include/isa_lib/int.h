@@ -1428,11 +1428,54 @@ static inline unsigned int lib_VEC_PACK_SC_HL_16(Iss *s, unsigned int a, unsigne
 
 #include "cpu/iss/flexfloat/flexfloat.h"
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
+#include <cmath>
 #include <fenv.h>
 #pragma STDC FENV_ACCESS ON
 
+// Operations on binary32 and binary64 are executed with host floats, flexfloat is only used for
+// the other formats. gvsoc_isa_lib_check (tools/isa_lib_check.cpp) compares both paths and
+// reports their speed.
+#ifndef CONFIG_GVSOC_ISS_USE_NATIVE_FLOAT
+#define CONFIG_GVSOC_ISS_USE_NATIVE_FLOAT 1
+#endif
+
+#define FF_IS_F32(e, m) (CONFIG_GVSOC_ISS_USE_NATIVE_FLOAT && (e) == 8 && (m) == 23)
+#define FF_IS_F64(e, m) (CONFIG_GVSOC_ISS_USE_NATIVE_FLOAT && (e) == 11 && (m) == 52)
+
+// Executes the operation with host floats if the format allows it. The expression gets the
+// operands through x, y and z.
+#define FF_NATIVE_EXEC(s, expr, a, b, c, e, m)                                      \
+    if (FF_IS_F32(e, m))                                                            \
+    {                                                                               \
+        lib_ff_flags_acquire(s);                                                    \
+        float x = lib_ff_to_f32(a), y = lib_ff_to_f32(b), z = lib_ff_to_f32(c);     \
+        (void)y; (void)z;                                                           \
+        return lib_ff_from_f32(expr);                                               \
+    }                                                                               \
+    if (FF_IS_F64(e, m))                                                            \
+    {                                                                               \
+        lib_ff_flags_acquire(s);                                                    \
+        double x = lib_ff_to_f64(a), y = lib_ff_to_f64(b), z = lib_ff_to_f64(c);    \
+        (void)y; (void)z;                                                           \
+        return lib_ff_from_f64(expr);                                               \
+    }
+
+// Fused multiply-add with host floats. RISC-V raises the invalid flag when the multiplicands are
+// zero and infinity even if the addend is a quiet NaN, which the host does not do.
+template <typename T>
+static inline T lib_ff_native_fma(T x, T y, T z)
+{
+    if (std::isnan(z) && ((x == 0 && std::isinf(y)) || (std::isinf(x) && y == 0)))
+    {
+        feraiseexcept(FE_INVALID);
+    }
+    return std::fma(x, y, z);
+}
+
 #define FF_INIT_1(a, e, m)                           \
+    lib_ff_flags_sync();                             \
     flexfloat_t ff_a, ff_res;                        \
     flexfloat_desc_t env = (flexfloat_desc_t){e, m}; \
     ff_init(&ff_a, env);                             \
@@ -1440,6 +1483,7 @@ static inline unsigned int lib_VEC_PACK_SC_HL_16(Iss *s, unsigned int a, unsigne
     flexfloat_set_bits(&ff_a, a);
 
 #define FF_INIT_2(a, b, e, m)                        \
+    lib_ff_flags_sync();                             \
     flexfloat_t ff_a, ff_b, ff_res;                  \
     flexfloat_desc_t env = (flexfloat_desc_t){e, m}; \
     ff_init(&ff_a, env);                             \
@@ -1449,6 +1493,7 @@ static inline unsigned int lib_VEC_PACK_SC_HL_16(Iss *s, unsigned int a, unsigne
     flexfloat_set_bits(&ff_b, b);
 
 #define FF_INIT_3(a, b, c, e, m)                     \
+    lib_ff_flags_sync();                             \
     flexfloat_t ff_a, ff_b, ff_c, ff_res;            \
     flexfloat_desc_t env = (flexfloat_desc_t){e, m}; \
     ff_init(&ff_a, env);                             \
@@ -1461,21 +1506,21 @@ static inline unsigned int lib_VEC_PACK_SC_HL_16(Iss *s, unsigned int a, unsigne
 
 #define FF_EXEC_1(s, name, a, e, m) \
     FF_INIT_(a, e, m)               \
-    feclearexcept(FE_ALL_EXCEPT);   \
+    lib_ff_flags_clear();           \
     name(&ff_res, &ff_a);           \
     update_fflags_fenv(s);          \
     return flexfloat_get_bits(&ff_res);
 
 #define FF_EXEC_2(s, name, a, b, e, m) \
     FF_INIT_2(a, b, e, m)              \
-    feclearexcept(FE_ALL_EXCEPT);      \
+    lib_ff_flags_clear();              \
     name(&ff_res, &ff_a, &ff_b);       \
     update_fflags_fenv(s);             \
     return flexfloat_get_bits(&ff_res);
 
 #define FF_EXEC_3(s, name, a, b, c, e, m) \
     FF_INIT_3(a, b, c, e, m)              \
-    feclearexcept(FE_ALL_EXCEPT);         \
+    lib_ff_flags_clear();                 \
     name(&ff_res, &ff_a, &ff_b, &ff_c);   \
     update_fflags_fenv(s);                \
     return flexfloat_get_bits(&ff_res);
@@ -1490,16 +1535,100 @@ static inline void clear_fflags(Iss *iss, unsigned long int fflags)
     iss->csr.fcsr.fflags &= ~fflags;
 }
 
+// Get the fflags corresponding to the current fenv exceptions
+static inline int get_fflags_fenv()
+{
+    int ex = fetestexcept(FE_ALL_EXCEPT);
+    return (!!(ex & FE_INEXACT)) |
+           (!!(ex & FE_UNDERFLOW) << 1) |
+           (!!(ex & FE_OVERFLOW) << 2) |
+           (!!(ex & FE_DIVBYZERO) << 3) |
+           (!!(ex & FE_INVALID) << 4);
+}
+
 // updates the fflags from fenv exceptions
 static inline void update_fflags_fenv(Iss *iss)
 {
-    int ex = fetestexcept(FE_ALL_EXCEPT);
-    int flags = !!(ex & FE_INEXACT) |
-                !!(ex & FE_UNDERFLOW) << 1 |
-                !!(ex & FE_OVERFLOW) << 2 |
-                !!(ex & FE_DIVBYZERO) << 3 |
-                !!(ex & FE_INVALID) << 4;
-    set_fflags(iss, flags);
+    set_fflags(iss, get_fflags_fenv());
+}
+
+// Operations executed with host floats do not clear and test the fenv exceptions, which is
+// expensive. Instead the exceptions accumulate in the host FPU for one core, and they are merged
+// into its fflags only when they are needed, i.e. when fflags is read or written, or when the
+// host exceptions are needed for another core or for a flexfloat operation.
+// This is the core whose exceptions are currently accumulated, if any. The host FP state is per
+// thread, and the thread executing the events also merges them each time the engine stops or
+// finishes a window, so that other threads see up-to-date fflags. Nothing is merged at the end
+// of the execution events, which would cost an exception test and clear on each FP instruction
+// in the default mode, so exceptions raised by host FP code of other models executed meanwhile
+// on the same thread are merged into the owner's fflags. The power accounting of the core,
+// which computes with host floats, merges them first when power traces are active.
+inline thread_local Iss *lib_ff_flags_owner = NULL;
+
+// Merge the exceptions accumulated by the host FPU into the fflags of their core
+static inline void lib_ff_flags_sync()
+{
+    if (unlikely(lib_ff_flags_owner != NULL))
+    {
+        set_fflags(lib_ff_flags_owner, get_fflags_fenv());
+        lib_ff_flags_owner = NULL;
+    }
+}
+
+// Clear fenv exceptions before an operation whose exceptions are tested right after
+static inline void lib_ff_flags_clear()
+{
+    lib_ff_flags_sync();
+    feclearexcept(FE_ALL_EXCEPT);
+}
+
+// Must be called before an operation executed with host floats
+static inline void lib_ff_flags_acquire(Iss *s)
+{
+    if (unlikely(lib_ff_flags_owner != s))
+    {
+        lib_ff_flags_clear();
+        lib_ff_flags_owner = s;
+    }
+}
+
+static inline float lib_ff_to_f32(unsigned long int a)
+{
+    uint32_t bits = a;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline double lib_ff_to_f64(unsigned long int a)
+{
+    uint64_t bits = a;
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Results are returned like flexfloat does, with canonical NaNs and sign-extended
+static inline unsigned long int lib_ff_from_f32(float value)
+{
+    if (std::isnan(value))
+    {
+        return 0x7fc00000;
+    }
+    int32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (int64_t)bits;
+}
+
+static inline unsigned long int lib_ff_from_f64(double value)
+{
+    if (std::isnan(value))
+    {
+        return 0x7ff8000000000000ULL;
+    }
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
 }
 
 // Inspired by https://stackoverflow.com/a/38470183
@@ -1613,21 +1742,25 @@ static inline uint64_t double_to_ulong(Iss *s, double dbl_i)
 
 static inline unsigned long int lib_flexfloat_add(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m)
 {
+    FF_NATIVE_EXEC(s, x + y, a, b, 0, e, m)
     FF_EXEC_2(s, ff_add, a, b, e, m)
 }
 
 static inline unsigned long int lib_flexfloat_sub(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m)
 {
+    FF_NATIVE_EXEC(s, x - y, a, b, 0, e, m)
     FF_EXEC_2(s, ff_sub, a, b, e, m)
 }
 
 static inline unsigned long int lib_flexfloat_mul(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m)
 {
+    FF_NATIVE_EXEC(s, x * y, a, b, 0, e, m)
     FF_EXEC_2(s, ff_mul, a, b, e, m)
 }
 
 static inline unsigned long int lib_flexfloat_div(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m)
 {
+    FF_NATIVE_EXEC(s, x / y, a, b, 0, e, m)
     FF_EXEC_2(s, ff_div, a, b, e, m)
 }
 
@@ -1636,7 +1769,7 @@ static inline unsigned long int lib_flexfloat_avg(Iss *s, unsigned long int a, u
     FF_INIT_2(a, b, e, m)
     flexfloat_t ff_two;
     ff_init_int(&ff_two, 2, (flexfloat_desc_t){e, m});
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     ff_add(&ff_res, &ff_a, &ff_b);
     ff_div(&ff_res, &ff_res, &ff_two);
     update_fflags_fenv(s);
@@ -1647,7 +1780,7 @@ static inline unsigned long int lib_flexfloat_avg(Iss *s, unsigned long int a, u
 static inline unsigned long int lib_flexfloat_itof(Iss *s, unsigned long int a, uint8_t e, uint8_t m)
 {
     flexfloat_t ff_a;
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     ff_init_int(&ff_a, a, (flexfloat_desc_t){e, m});
     update_fflags_fenv(s);
     return flexfloat_get_bits(&ff_a);
@@ -1666,14 +1799,16 @@ static inline unsigned long int lib_flexfloat_ftoi(Iss *s, unsigned long int a,
 
 static inline unsigned long int lib_flexfloat_madd(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m)
 {
+    FF_NATIVE_EXEC(s, lib_ff_native_fma(x, y, z), a, b, c, e, m)
     FF_EXEC_3(s, ff_fma, a, b, c, e, m)
 }
 
 static inline unsigned long int lib_flexfloat_msub(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m)
 {
+    FF_NATIVE_EXEC(s, lib_ff_native_fma(x, y, -z), a, b, c, e, m)
     FF_INIT_3(a, b, c, e, m)
     ff_inverse(&ff_c, &ff_c);
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
     update_fflags_fenv(s);
     return flexfloat_get_bits(&ff_res);
@@ -1681,9 +1816,10 @@ static inline unsigned long int lib_flexfloat_msub(Iss *s, unsigned long int a,
 
 static inline unsigned long int lib_flexfloat_nmsub(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m)
 {
+    FF_NATIVE_EXEC(s, lib_ff_native_fma(-x, y, z), a, b, c, e, m)
     FF_INIT_3(a, b, c, e, m)
     ff_inverse(&ff_a, &ff_a);
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
     update_fflags_fenv(s);
     return flexfloat_get_bits(&ff_res);
@@ -1691,8 +1827,9 @@ static inline unsigned long int lib_flexfloat_nmsub(Iss *s, unsigned long int a,
 
 static inline unsigned long int lib_flexfloat_nmadd(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m)
 {
+    FF_NATIVE_EXEC(s, lib_ff_native_fma(-x, y, -z), a, b, c, e, m)
     FF_INIT_3(a, b, c, e, m)
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     ff_fnma(&ff_res, &ff_a, &ff_b, &ff_c);
     update_fflags_fenv(s);
     return flexfloat_get_bits(&ff_res);
@@ -1750,8 +1887,19 @@ static inline void restoreFFRoundingMode(unsigned long int mode)
     fesetround(mode);
 }
 
+// Tells if the instruction rounds to nearest, which is the host default rounding mode, so that
+// the rounding mode does not need to be changed
+static inline bool lib_ff_round_is_default(Iss *s, unsigned long int round)
+{
+    return round == 0 || (round == 7 && s->csr.fcsr.frm == 0);
+}
+
 static inline unsigned long int lib_flexfloat_madd_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
 {
+    if (lib_ff_round_is_default(s, round))
+    {
+        return lib_flexfloat_madd(s, a, b, c, e, m);
+    }
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_madd(s, a, b, c, e, m);
     restoreFFRoundingMode(old);
@@ -1760,6 +1908,10 @@ static inline unsigned long int lib_flexfloat_madd_round(Iss *s, unsigned long i
 
 static inline unsigned long int lib_flexfloat_msub_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
 {
+    if (lib_ff_round_is_default(s, round))
+    {
+        return lib_flexfloat_msub(s, a, b, c, e, m);
+    }
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_msub(s, a, b, c, e, m);
     restoreFFRoundingMode(old);
@@ -1768,6 +1920,10 @@ static inline unsigned long int lib_flexfloat_msub_round(Iss *s, unsigned long i
 
 static inline unsigned long int lib_flexfloat_nmadd_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
 {
+    if (lib_ff_round_is_default(s, round))
+    {
+        return lib_flexfloat_nmadd(s, a, b, c, e, m);
+    }
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_nmadd(s, a, b, c, e, m);
     restoreFFRoundingMode(old);
@@ -1776,6 +1932,10 @@ static inline unsigned long int lib_flexfloat_nmadd_round(Iss *s, unsigned long
 
 static inline unsigned long int lib_flexfloat_nmsub_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
 {
+    if (lib_ff_round_is_default(s, round))
+    {
+        return lib_flexfloat_nmsub(s, a, b, c, e, m);
+    }
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_nmsub(s, a, b, c, e, m);
     restoreFFRoundingMode(old);
@@ -1784,6 +1944,10 @@ static inline unsigned long int lib_flexfloat_nmsub_round(Iss *s, unsigned long
 
 static inline unsigned long int lib_flexfloat_add_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
 {
+    if (lib_ff_round_is_default(s, round))
+    {
+        return lib_flexfloat_add(s, a, b, e, m);
+    }
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_add(s, a, b, e, m);
     restoreFFRoundingMode(old);
@@ -1792,6 +1956,10 @@ static inline unsigned long int lib_flexfloat_add_round(Iss *s, unsigned long in
 
 static inline unsigned long int lib_flexfloat_sub_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
 {
+    if (lib_ff_round_is_default(s, round))
+    {
+        return lib_flexfloat_sub(s, a, b, e, m);
+    }
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_sub(s, a, b, e, m);
     restoreFFRoundingMode(old);
@@ -1800,6 +1968,10 @@ static inline unsigned long int lib_flexfloat_sub_round(Iss *s, unsigned long in
 
 static inline unsigned long int lib_flexfloat_mul_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
 {
+    if (lib_ff_round_is_default(s, round))
+    {
+        return lib_flexfloat_mul(s, a, b, e, m);
+    }
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_mul(s, a, b, e, m);
     restoreFFRoundingMode(old);
@@ -1808,6 +1980,10 @@ static inline unsigned long int lib_flexfloat_mul_round(Iss *s, unsigned long in
 
 static inline unsigned long int lib_flexfloat_div_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
 {
+    if (lib_ff_round_is_default(s, round))
+    {
+        return lib_flexfloat_div(s, a, b, e, m);
+    }
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_div(s, a, b, e, m);
     restoreFFRoundingMode(old);
@@ -1822,17 +1998,28 @@ static inline unsigned long int lib_flexfloat_avg_round(Iss *s, unsigned long in
     return result;
 }
 
-static inline unsigned long int lib_flexfloat_sqrt_round(Iss *s, unsigned long int a, uint8_t e, uint8_t m, unsigned long int round)
+static inline unsigned long int lib_flexfloat_sqrt(Iss *s, unsigned long int a, uint8_t e, uint8_t m)
 {
-    int old = setFFRoundingMode(s, round);
+    FF_NATIVE_EXEC(s, std::sqrt(x), a, 0, 0, e, m)
     FF_INIT_1(a, e, m)
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     ff_init_double(&ff_res, sqrt(ff_get_double(&ff_a)), env);
     update_fflags_fenv(s);
-    restoreFFRoundingMode(old);
     return flexfloat_get_bits(&ff_res);
 }
 
+static inline unsigned long int lib_flexfloat_sqrt_round(Iss *s, unsigned long int a, uint8_t e, uint8_t m, unsigned long int round)
+{
+    if (lib_ff_round_is_default(s, round))
+    {
+        return lib_flexfloat_sqrt(s, a, e, m);
+    }
+    int old = setFFRoundingMode(s, round);
+    unsigned long int result = lib_flexfloat_sqrt(s, a, e, m);
+    restoreFFRoundingMode(old);
+    return result;
+}
+
 static inline unsigned long int lib_flexfloat_sgnj(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m)
 {
 #ifdef OLD
@@ -2083,7 +2270,7 @@ static inline unsigned long int lib_flexfloat_eq(Iss *s, unsigned long int a, un
         return 0;
     }
     FF_INIT_2(a, b, e, m)
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     int32_t res = ff_eq(&ff_a, &ff_b);
     update_fflags_fenv(s);
     return res;
@@ -2095,7 +2282,7 @@ static inline unsigned long int lib_flexfloat_ne(Iss *s, unsigned long int a, un
     if (IsNan(a, e, m) || IsNan(b, e, m))
         return 0;
     FF_INIT_2(a, b, e, m)
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     int32_t res = (ff_eq(&ff_a, &ff_b) == 0);
     update_fflags_fenv(s);
     return res;
@@ -2109,7 +2296,7 @@ static inline unsigned long int lib_flexfloat_lt(Iss *s, unsigned long int a, un
         return 0;
     }
     FF_INIT_2(a, b, e, m)
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     int32_t res = ff_lt(&ff_a, &ff_b);
     update_fflags_fenv(s);
     return res;
@@ -2120,7 +2307,7 @@ static inline unsigned long int lib_flexfloat_ge(Iss *s, unsigned long int a, un
     if (IsNan(a, e, m) || IsNan(b, e, m))
         return 0;
     FF_INIT_2(a, b, e, m)
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     int32_t res = (ff_lt(&ff_a, &ff_b) == 0);
     update_fflags_fenv(s);
     return res;
@@ -2134,7 +2321,7 @@ static inline unsigned long int lib_flexfloat_le(Iss *s, unsigned long int a, un
         return 0;
     }
     FF_INIT_2(a, b, e, m)
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     int32_t res = ff_le(&ff_a, &ff_b);
     update_fflags_fenv(s);
     return res;
@@ -2145,7 +2332,7 @@ static inline unsigned long int lib_flexfloat_gt(Iss *s, unsigned long int a, un
     if (IsNan(a, e, m) || IsNan(b, e, m))
         return 0;
     FF_INIT_2(a, b, e, m)
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     int32_t res = (ff_le(&ff_a, &ff_b) == 0);
     update_fflags_fenv(s);
     return res;
@@ -2383,7 +2570,7 @@ static inline int lib_flexfloat_cvt_ff_x_round(Iss *s, int a, uint8_t e, uint8_t
     flexfloat_t ff_a;
     a &= (0x1ULL << (e + m + 1)) - 1;
     a = (a ^ sign_mask) - sign_mask;
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     ff_init_int(&ff_a, a, (flexfloat_desc_t){e, m});
     update_fflags_fenv(s);
     restoreFFRoundingMode(old);
@@ -2396,7 +2583,7 @@ static inline unsigned long int lib_flexfloat_cvt_ff_xu_round(Iss *s, unsigned l
     int old = setFFRoundingMode(s, round);
     flexfloat_t ff_a;
     a &= (0x1ULL << (e + m + 1)) - 1;
-    feclearexcept(FE_ALL_EXCEPT);
+    lib_ff_flags_clear();
     ff_init_long(&ff_a, (unsigned long)a, (flexfloat_desc_t){e, m});
     update_fflags_fenv(s);
     restoreFFRoundingMode(old);
@@ -27,7 +27,9 @@
 #include "cpu/iss/flexfloat/flexfloat.h"
 #include "int.h"
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
+#include <type_traits>
 #include <fenv.h>
 #include "assert.h"
 
@@ -36,6 +38,7 @@
 
 
 #define FLOAT_INIT_1(a, e, m)                        \
+    lib_ff_flags_sync();                             \
     flexfloat_t ff_a, ff_res;                        \
     flexfloat_desc_t env = (flexfloat_desc_t){e, m}; \
     ff_init(&ff_a, env);                             \
@@ -43,6 +46,7 @@
     flexfloat_set_bits(&ff_a, a);
 
 #define FLOAT_INIT_2(a, b, e, m)                     \
+    lib_ff_flags_sync();                             \
     flexfloat_t ff_a, ff_b, ff_res;                  \
     flexfloat_desc_t env = (flexfloat_desc_t){e, m}; \
     ff_init(&ff_a, env);                             \
@@ -52,6 +56,7 @@
     flexfloat_set_bits(&ff_b, b);
 
 #define FLOAT_INIT_3(a, b, c, e, m)                  \
+    lib_ff_flags_sync();                             \
     flexfloat_t ff_a, ff_b, ff_c, ff_res;            \
     flexfloat_desc_t env = (flexfloat_desc_t){e, m}; \
     ff_init(&ff_a, env);                             \
@@ -66,21 +71,21 @@
 
 #define FLOAT_EXEC_1(name, a, e, m ,res)            \
     FLOAT_INIT_1(a, e, m)                           \
-    feclearexcept(FE_ALL_EXCEPT);                   \
+    lib_ff_flags_clear();                           \
     name(&ff_res, &ff_a);                           \
     update_fflags_fenv(iss);                        \
     res = flexfloat_get_bits(&ff_res);
 
 #define FLOAT_EXEC_2(name, a, b, e, m ,res)         \
     FLOAT_INIT_2(a, b, e, m)                        \
-    feclearexcept(FE_ALL_EXCEPT);                   \
+    lib_ff_flags_clear();                           \
     name(&ff_res, &ff_a, &ff_b);                    \
     update_fflags_fenv(iss);                        \
     res = flexfloat_get_bits(&ff_res);
 
 #define FLOAT_EXEC_3(name, a, b, c, e, m ,res)      \
     FLOAT_INIT_3(a, b, c, e, m)                     \
-    feclearexcept(FE_ALL_EXCEPT);                   \
+    lib_ff_flags_clear();                           \
     name(&ff_res, &ff_a, &ff_b, &ff_c);             \
     update_fflags_fenv(iss);                        \
     res = flexfloat_get_bits(&ff_res);
@@ -587,2785 +592,594 @@ INLINE void ff_sgnj(flexfloat_t *dest, const flexfloat_t *a,const flexfloat_t *b
 
 
 
-static inline void lib_ADDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
+// Integer kernels
+//
+// The elements are accessed directly in the register file with their native type and the SEW
+// dispatch is done once per instruction, so that each kernel is a plain loop over the elements
+// which the compiler can vectorize. Register groups are contiguous in the register file, so
+// elements beyond the first register of the group are simply at the next offsets.
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+template<int bits> struct lib_vint_types;
+template<> struct lib_vint_types<8>   { typedef int8_t   s; typedef uint8_t   u; };
+template<> struct lib_vint_types<16>  { typedef int16_t  s; typedef uint16_t  u; };
+template<> struct lib_vint_types<32>  { typedef int32_t  s; typedef uint32_t  u; };
+template<> struct lib_vint_types<64>  { typedef int64_t  s; typedef uint64_t  u; };
+template<> struct lib_vint_types<128> { typedef __int128 s; typedef unsigned __int128 u; };
 
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-        res = data1+data2;
+// Element type of the specified width and signedness
+template<int bits, bool is_signed>
+using lib_vint_t = typename std::conditional<is_signed, typename lib_vint_types<bits>::s,
+    typename lib_vint_types<bits>::u>::type;
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
+static inline uint8_t *lib_vreg(Iss *iss, int reg)
+{
+    return (uint8_t *)iss->spatz.vregfile.vregs + reg * sizeof(iss->spatz.vregfile.vregs[0]);
+}
 
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+template<typename T>
+static inline T lib_vget(Iss *iss, int reg, int i)
+{
+    T value;
+    memcpy(&value, lib_vreg(iss, reg) + i * sizeof(T), sizeof(T));
+    return value;
 }
 
-static inline void lib_ADDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
+template<typename T>
+static inline void lib_vset(Iss *iss, int reg, int i, T value)
+{
+    memcpy(lib_vreg(iss, reg) + i * sizeof(T), &value, sizeof(T));
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline bool lib_vmask(Iss *iss, int i)
+{
+    return (iss->spatz.vregfile.vregs[0][i / 8] >> (i % 8)) & 1;
+}
 
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1+data2;
+// Call the kernel with the current SEW as an std::integral_constant
+template<typename F>
+static inline void lib_vint_sew(Iss *iss, F kernel)
+{
+    switch (SEW)
+    {
+        case 8:  kernel(std::integral_constant<int, 8>()); break;
+        case 16: kernel(std::integral_constant<int, 16>()); break;
+        case 32: kernel(std::integral_constant<int, 32>()); break;
+        case 64: kernel(std::integral_constant<int, 64>()); break;
+    }
+}
 
+// Write op(i) to element i of vd, for all active elements between vstart and vl.
+// Inactive elements are left untouched.
+template<typename T, typename F>
+static inline void lib_vint_loop(Iss *iss, int vd, bool vm, F op)
+{
+    int start = VSTART;
+    int end = VL;
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
+    if (vm)
+    {
+        for (int i = start; i < end; i++)
+        {
+            lib_vset<T>(iss, vd, i, op(i));
         }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
+    }
+    else
+    {
+        for (int i = start; i < end; i++)
+        {
+            T res = op(i);
+            lib_vset<T>(iss, vd, i, lib_vmask(iss, i) ? res : lib_vget<T>(iss, vd, i));
         }
     }
 }
 
-static inline void lib_ADDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+// vd[i] = op(vs2[i], vs1[i], vd[i]), all elements being SEW-wide
+template<bool is_signed, typename F>
+static inline void lib_vint_vv(Iss *iss, int vs1, int vs2, int vd, bool vm, F op)
+{
+    lib_vint_sew(iss, [&](auto sew) {
+        typedef lib_vint_t<decltype(sew)::value, is_signed> T;
+        lib_vint_loop<T>(iss, vd, vm, [&](int i) {
+            return T(op(lib_vget<T>(iss, vs2, i), lib_vget<T>(iss, vs1, i), lib_vget<T>(iss, vd, i)));
+        });
+    });
+}
 
-        myAbs(iss, SEW, vs2, i, &data2);
+// vd[i] = op(vs2[i], x, vd[i]), the scalar being truncated to SEW
+template<bool is_signed, typename F>
+static inline void lib_vint_vx(Iss *iss, int vs2, int64_t x, int vd, bool vm, F op)
+{
+    lib_vint_sew(iss, [&](auto sew) {
+        typedef lib_vint_t<decltype(sew)::value, is_signed> T;
+        T b = T(x);
+        lib_vint_loop<T>(iss, vd, vm, [&](int i) {
+            return T(op(lib_vget<T>(iss, vs2, i), b, lib_vget<T>(iss, vd, i)));
+        });
+    });
+}
+
+// Widening version of lib_vint_vv, vs2 and vs1 are SEW-wide with their own signedness, while
+// the operation is done on unsigned elements of at least 2*SEW bits
+template<bool is_signed2, bool is_signed1, typename F>
+static inline void lib_vint_wvv(Iss *iss, int vs1, int vs2, int vd, bool vm, F op)
+{
+    lib_vint_sew(iss, [&](auto sew) {
+        typedef lib_vint_t<decltype(sew)::value, is_signed2> T2;
+        typedef lib_vint_t<decltype(sew)::value, is_signed1> T1;
+        typedef lib_vint_t<decltype(sew)::value * 2, false> TW;
+        typedef typename std::conditional<(sizeof(TW) < 8), uint64_t, TW>::type TC;
+        lib_vint_loop<TW>(iss, vd, vm, [&](int i) {
+            return TW(op(TC(TW(lib_vget<T2>(iss, vs2, i))), TC(TW(lib_vget<T1>(iss, vs1, i))),
+                TC(lib_vget<TW>(iss, vd, i))));
+        });
+    });
+}
+
+template<bool is_signed2, bool is_signed1, typename F>
+static inline void lib_vint_wvx(Iss *iss, int vs2, int64_t x, int vd, bool vm, F op)
+{
+    lib_vint_sew(iss, [&](auto sew) {
+        typedef lib_vint_t<decltype(sew)::value, is_signed2> T2;
+        typedef lib_vint_t<decltype(sew)::value, is_signed1> T1;
+        typedef lib_vint_t<decltype(sew)::value * 2, false> TW;
+        typedef typename std::conditional<(sizeof(TW) < 8), uint64_t, TW>::type TC;
+        TC b = TC(TW(T1(x)));
+        lib_vint_loop<TW>(iss, vd, vm, [&](int i) {
+            return TW(op(TC(TW(lib_vget<T2>(iss, vs2, i))), b, TC(lib_vget<TW>(iss, vd, i))));
+        });
+    });
+}
+
+// High half of the 2*SEW-wide product
+template<bool is_signed2, bool is_signed1, typename T2, typename T1>
+static inline T2 lib_vint_mulh(T2 a, T1 b)
+{
+    constexpr int bits = sizeof(T2) * 8;
+    typedef lib_vint_t<bits * 2, is_signed2 || is_signed1> TW;
+    typedef lib_vint_t<bits * 2, is_signed2> TW2;
+    typedef lib_vint_t<bits * 2, is_signed1> TW1;
+    return T2(TW(TW2(a) * TW1(b)) >> bits);
+}
 
-        res = data1+data2;
+// Division as specified by the vector extension, which never traps
+template<typename T>
+static inline T lib_vint_div(T a, T b)
+{
+    if (b == 0)
+    {
+        return T(-1);
+    }
+    if (std::is_signed<T>::value && b == T(-1))
+    {
+        typedef typename std::make_unsigned<T>::type U;
+        return T(U(0) - U(a));
+    }
+    return a / b;
+}
 
+template<typename T>
+static inline T lib_vint_rem(T a, T b)
+{
+    if (b == 0)
+    {
+        return a;
+    }
+    if (std::is_signed<T>::value && b == T(-1))
+    {
+        return 0;
+    }
+    return a % b;
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
+// vd[0] = op(...op(op(vs1[0], vs2[start]), vs2[start+1])..., vs2[vl-1]) on active elements
+template<bool is_signed, typename F>
+static inline void lib_vint_red(Iss *iss, int vs1, int vs2, int vd, bool vm, F op)
+{
+    lib_vint_sew(iss, [&](auto sew) {
+        typedef lib_vint_t<decltype(sew)::value, is_signed> T;
+        int start = VSTART;
+        int end = VL;
+        T res = lib_vget<T>(iss, vs1, 0);
+        for (int i = start; i < end; i++)
+        {
+            if (vm || lib_vmask(iss, i))
+            {
+                res = T(op(res, lib_vget<T>(iss, vs2, i)));
+            }
         }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
+        lib_vset<T>(iss, vd, 0, res);
+    });
+}
+
+// Move element i-offset of vs2 to element i of vd, only for i from start. Offsets are negative for
+// slides down, in which case elements coming from beyond VLMAX are zeroed.
+static inline void lib_vint_slide(Iss *iss, int vs2, int64_t offset, int64_t start, int vd, bool vm)
+{
+    lib_vint_sew(iss, [&](auto sew) {
+        typedef lib_vint_t<decltype(sew)::value, false> T;
+        int64_t vlmax = VLMAX;
+        int64_t end = VL;
+        for (int64_t i = start; i < end; i++)
+        {
+            if (i - offset >= vlmax)
+            {
+                lib_vset<T>(iss, vd, i, 0);
+            }
+            else if (vm || lib_vmask(iss, i))
+            {
+                lib_vset<T>(iss, vd, i, lib_vget<T>(iss, vs2, i - offset));
+            }
         }
-    }
+    });
+}
+
+static inline void lib_ADDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a + b; });
+}
+
+static inline void lib_ADDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a + b; });
+}
+
+static inline void lib_ADDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, sim, vd, vm, [](auto a, auto b, auto d) { return a + b; });
 }
 
 static inline void lib_SUBVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a - b; });
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_SUBVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a - b; });
+}
 
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
+static inline void lib_RSUBVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return b - a; });
+}
 
-        res = data2 - data1;
+static inline void lib_RSUBVI   (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, sim, vd, vm, [](auto a, auto b, auto d) { return b - a; });
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_ANDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a & b; });
 }
 
-static inline void lib_SUBVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_ANDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a & b; });
+}
 
-        myAbs(iss, SEW, vs2, i, &data2);
+static inline void lib_ANDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, sim, vd, vm, [](auto a, auto b, auto d) { return a & b; });
+}
 
-        res = data2 - data1;
+static inline void lib_ORVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a | b; });
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_ORVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a | b; });
 }
 
-static inline void lib_RSUBVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ 
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_ORVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, sim, vd, vm, [](auto a, auto b, auto d) { return a | b; });
+}
 
-        myAbs(iss, SEW, vs2, i, &data2);
+static inline void lib_XORVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a ^ b; });
+}
 
-        res = data1 - data2;
+static inline void lib_XORVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a ^ b; });
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_XORVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, sim, vd, vm, [](auto a, auto b, auto d) { return a ^ b; });
 }
 
-static inline void lib_RSUBVI   (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_MINVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<true>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a < b ? a : b; });
+}
 
-        myAbs(iss, SEW, vs2, i, &data2);
+static inline void lib_MINVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<true>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a < b ? a : b; });
+}
 
-        res = data1 - data2;
+static inline void lib_MINUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a < b ? a : b; });
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_MINUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a < b ? a : b; });
 }
 
-static inline void lib_ANDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
+static inline void lib_MAXVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<true>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a > b ? a : b; });
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
+static inline void lib_MAXVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<true>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a > b ? a : b; });
+}
 
-        res = data1 & data2;
+static inline void lib_MAXUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a > b ? a : b; });
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_MAXUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a > b ? a : b; });
 }
 
-static inline void lib_ANDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ 
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
+// Products are done on 64 bits so that small types are not promoted to int, which could overflow
+static inline void lib_MULVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return (uint64_t)a * b; });
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_MULVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return (uint64_t)a * b; });
+}
 
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 & data2;
+static inline void lib_MULHVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<true>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) {
+        return lib_vint_mulh<true, true>(a, b);
+    });
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_MULHVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<true>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) {
+        return lib_vint_mulh<true, true>(a, b);
+    });
 }
 
-static inline void lib_ANDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){  
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
+static inline void lib_MULHUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) {
+        return lib_vint_mulh<false, false>(a, b);
+    });
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_MULHUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) {
+        return lib_vint_mulh<false, false>(a, b);
+    });
+}
 
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 & data2;
+// vs2 is signed and vs1 or rs1 unsigned
+static inline void lib_MULHSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<true>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) {
+        return lib_vint_mulh<true, false>(a, typename std::make_unsigned<decltype(b)>::type(b));
+    });
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_MULHSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<true>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) {
+        return lib_vint_mulh<true, false>(a, typename std::make_unsigned<decltype(b)>::type(b));
+    });
 }
 
-static inline void lib_ORVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
+static inline void lib_MVVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs1, vd, vm, [](auto a, auto b, auto d) { return b; });
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
+static inline void lib_MVVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return b; });
+}
 
-        res = data1 | data2;
+static inline void lib_MVVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, sim, vd, vm, [](auto a, auto b, auto d) { return b; });
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
+static inline void lib_MVSX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    if(VSTART < VL){
+        if(vm){
+            lib_vint_sew(iss, [&](auto sew) {
+                typedef lib_vint_t<decltype(sew)::value, false> T;
+                lib_vset<T>(iss, vd, 0, T(rs1));
+            });
+        }else{
+            printf("MVSX VM=0 is RESERVED\n");
         }
     }
 }
 
-static inline void lib_ORVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 | data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_ORVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 | data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_XORVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data1 ^ data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_XORVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 ^ data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_XORVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 ^ data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MINVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = (data1 > data2)?data2:data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MINVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = (data1 > data2)?data2:data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MINUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbsU(iss, SEW, vs1, i, &data1);
-        myAbsU(iss, SEW, vs2, i, &data2);
-
-        res = (data1 > data2)?data2:data1;
-
-        intToBinU(SEW, res, resBin);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MINUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbsU(iss, SEW, vs2, i, &data2);
-        
-        res = (data1 > data2)?data2:data1;
-        
-        intToBinU(SEW, res, resBin);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MAXVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = (data1 > data2)?data1:data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MAXVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = (data1 > data2)?data1:data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MAXUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbsU(iss, SEW, vs1, i, &data1);
-        myAbsU(iss, SEW, vs2, i, &data2);
-
-        res = (data1 > data2)?data1:data2;
-
-        intToBinU(SEW, res, resBin);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MAXUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbsU(iss, SEW, vs2, i, &data2);
-        
-        res = (data1 > data2)?data1:data2;
-        
-        intToBinU(SEW, res, resBin);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MULVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MULVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MULHVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-
-    intToBin(64, rs1, data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, rs1, data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn == 1){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MVVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, res;
-    bool bin[8];
-    bool resBin[64];
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        
-        res = data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MVVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t res;
-    bool bin[8];
-    bool resBin[64];
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        res = rs1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MVVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t res;
-    bool bin[8];
-    bool resBin[64];
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        
-        res = sim;
-        intToBin(SEW, abs(res), resBin);
-        if(sim < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MVSX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t res;
-    bool resBin[64];
-    res = rs1;
-    if(VSTART < VL){
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(vm){
-            writeToVReg(iss, SEW, vd, 0, resBin);
-        }else{
-            printf("MVSX VM=0 is RESERVED\n");
-        }
-    }
-}
-
-static inline iss_reg_t lib_MVXS     (Iss *iss, int vs2, bool vm){
-
-    int64_t data1;
-
-    myAbs(iss, SEW, vs2, 0, &data1);
-
-    return iss_reg_t(data1);
-}
-
-static inline void lib_WMULVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-
-    intToBin(64, rs1, data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, rs1, data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn == 1){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MACCVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW, vd , i, data3);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(sgn){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MACCVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW, vd , i, data3);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;
-        }
-
-        extend2x(SEW, data3, data3Ext, true);
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MADDVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vd , i, data2);
-        buildDataBin(iss, SEW, vs2, i, data3);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(sgn){
-            twosComplement(SEW*2,mulOutBin);
-            sgn = 0;
-        }
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MADDVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vd , i, data2);
-        buildDataBin(iss, SEW, vs2 , i, data3);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-
-        extend2x(SEW, data3, data3Ext, true);
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_NMSACVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW, vd , i, data3);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(!sgn){//compare with VMACC
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_NMSACVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW, vd , i, data3);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(!((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1))){//compare with VMACC
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_NMSUBVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vd , i, data2);
-        buildDataBin(iss, SEW, vs2, i, data3);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(!sgn){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_NMSUBVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vd , i, data2);
-        buildDataBin(iss, SEW, vs2 , i, data3);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if(!((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1))){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW  , vs1, i, data1);
-        buildDataBin(iss, SEW  , vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;            
-        }
-        // extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(sgn){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;
-        }
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        buildDataBin(iss, SEW  , vs1, i, data1);
-        buildDataBin(iss, SEW  , vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCUSVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;
-        }
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if(sgn == 1){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCSUVV(Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW  , vs1, i, data1);
-        buildDataBin(iss, SEW  , vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;            
-        }
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(sgn){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCSUVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;
-        }
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_REDSUMVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res += data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_REDANDVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res &= data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_REDORVS  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res |= data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
+static inline iss_reg_t lib_MVXS     (Iss *iss, int vs2, bool vm){
+    int64_t res = 0;
+    lib_vint_sew(iss, [&](auto sew) {
+        res = lib_vget<lib_vint_t<decltype(sew)::value, true>>(iss, vs2, 0);
+    });
+    return iss_reg_t(res);
 }
 
-static inline void lib_REDXORVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res ^= data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
+static inline void lib_WMULVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_wvv<true, true>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a * b; });
 }
 
-static inline void lib_REDMINVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res = (res < data2)?res:data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
+static inline void lib_WMULVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_wvx<true, true>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a * b; });
 }
 
-static inline void lib_REDMINUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbsU(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbsU(iss, SEW, vs2, i, &data2);
-            res = (res < data2)?res:data2;
-        }
-    }
-    intToBinU(SEW, res, resBin);
-    writeToVReg(iss, SEW, vd, 0, resBin);    
+static inline void lib_WMULUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_wvv<false, false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a * b; });
 }
 
-static inline void lib_REDMAXVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res = (res > data2)?res:data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
+static inline void lib_WMULUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_wvx<false, false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a * b; });
 }
 
-static inline void lib_REDMAXUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbsU(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbsU(iss, SEW, vs2, i, &data2);
-            res = (res > data2)?res:data2;
-        }
-    }
-    intToBinU(SEW, res, resBin);
-    writeToVReg(iss, SEW, vd, 0, resBin);    
+static inline void lib_WMULSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_wvv<true, false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a * b; });
 }
 
-static inline void lib_SLIDEUPVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    int64_t OFFSET;
-    bool bin[8];
-   
-    OFFSET = rs1;
-    int s = MAX(VSTART,OFFSET); 
-
-    for (int i = s; i < VL; i++){
-        intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-
-        if(!mask(vm,bin)){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-OFFSET)*t+j];
-            }
-        }
-    }
+static inline void lib_WMULSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_wvx<true, false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a * b; });
 }
 
-static inline void lib_SLIDEUPVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    int64_t OFFSET;
-    bool bin[8];
-    OFFSET = sim;
-    int s = MAX(VSTART,OFFSET); 
-
-    for (int i = s; i < VL; i++){
-        intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        if(!mask(vm,bin)){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-OFFSET)*t+j];
-            }
-        }
-    }
+static inline void lib_MACCVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return (uint64_t)a * b + d; });
 }
 
-static inline void lib_SLIDEDWVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    int64_t OFFSET;
-    bool bin[8];
-    OFFSET = rs1;
-    int s = MAX(VSTART,OFFSET); 
-
-    for (int i = VSTART; i < VL; i++){
-        if(i+OFFSET >= VLMAX){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = 0;
-            }            
-        }else{
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-
-            if(!mask(vm,bin)){
-                for(int j = 0; j <  t ; j++){
-                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+OFFSET)*t+j];
-                }
-            }
-        }
-    }
+static inline void lib_MACCVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return (uint64_t)a * b + d; });
 }
 
-static inline void lib_SLIDEDWVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    int64_t OFFSET;
-    bool bin[8];
-    OFFSET = sim;
-
-    int s = MAX(VSTART,OFFSET); 
-
-    for (int i = VSTART; i < VL; i++){
-        if(i+OFFSET >= VLMAX){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = 0;
-            }            
-        }else{
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-            
-            if(!mask(vm,bin)){
-                for(int j = 0; j <  t ; j++){
-                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+OFFSET)*t+j];
-                }
-            }
-        }
-    }
+static inline void lib_MADDVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return (uint64_t)b * d + a; });
 }
 
-static inline void lib_SLIDE1UVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    bool bin[8];
-    bool data1[64];
-   
-    int s = MAX(VSTART,1); 
-    intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][0],bin);
-
-    int i = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-    if(rs1 < 0){
-        twosComplement(64,data1);
-    }
-    if(VSTART == 0){
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, 0, data1);
-        }
-    }
-    for (int i = s; i < VL; i++){
-        if(!((i-s)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i-s)/8],bin);
-        }
-        
-        if(!mask(vm,bin)){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-1)*t+j];
-            }
-        }
-    }
+static inline void lib_MADDVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return (uint64_t)b * d + a; });
 }
 
-static inline void lib_SLIDE1DVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    bool bin[8];
-    bool data1[64];
-    
-    intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][0],bin);
-
-    int i = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-    if(rs1 < 0){
-        twosComplement(64,data1);
-    }
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            if(i == VL-1){
-                writeToVReg(iss, SEW, vd, VL-1, data1);   
-            }else{
-                for(int j = 0; j <  t ; j++){
-                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+1)*t+j];
-                }
-            }
-        }
-    }
+static inline void lib_NMSACVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return d - (uint64_t)a * b; });
 }
 
-static inline void lib_DIVVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data2/data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_NMSACVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return d - (uint64_t)a * b; });
 }
 
-static inline void lib_DIVVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data2/data1;
-
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_NMSUBVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a - (uint64_t)b * d; });
 }
 
-static inline void lib_DIVUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbsU(iss, SEW, vs1, i, &data1);
-        myAbsU(iss, SEW, vs2, i, &data2);
+static inline void lib_NMSUBVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a - (uint64_t)b * d; });
+}
 
-        res = data2/data1;
+static inline void lib_WMACCVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_wvv<true, true>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a * b + d; });
+}
 
-        intToBin(SEW, res, resBin);
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_WMACCVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_wvx<true, true>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a * b + d; });
 }
 
-static inline void lib_DIVUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
+static inline void lib_WMACCUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_wvv<false, false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a * b + d; });
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_WMACCUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_wvx<false, false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a * b + d; });
+}
 
-        myAbsU(iss, SEW, vs2, i, &data2);
-        
-        res = data2/data1;
+static inline void lib_WMACCUSVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_wvx<true, false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a * b + d; });
+}
 
+static inline void lib_WMACCSUVV(Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_wvv<false, true>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return a * b + d; });
+}
 
-        intToBin(SEW, res, resBin);
+static inline void lib_WMACCSUVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_wvx<false, true>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return a * b + d; });
+}
 
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_REDSUMVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_red<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b) { return a + b; });
 }
 
-static inline void lib_REMVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
+static inline void lib_REDANDVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_red<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b) { return a & b; });
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_REDORVS  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_red<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b) { return a | b; });
+}
 
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
+static inline void lib_REDXORVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_red<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b) { return a ^ b; });
+}
 
-        res = data2%data1;
+static inline void lib_REDMINVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_red<true>(iss, vs1, vs2, vd, vm, [](auto a, auto b) { return a < b ? a : b; });
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_REDMINUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_red<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b) { return a < b ? a : b; });
 }
 
-static inline void lib_REMVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
+static inline void lib_REDMAXVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_red<true>(iss, vs1, vs2, vd, vm, [](auto a, auto b) { return a > b ? a : b; });
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_REDMAXUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_red<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b) { return a > b ? a : b; });
+}
 
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data2%data1;
+static inline void lib_SLIDEUPVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    lib_vint_slide(iss, vs2, rs1, MAX(VSTART, rs1), vd, vm);
+}
 
+static inline void lib_SLIDEUPVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
+    lib_vint_slide(iss, vs2, sim, MAX(VSTART, sim), vd, vm);
+}
 
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
+static inline void lib_SLIDEDWVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    lib_vint_slide(iss, vs2, -rs1, VSTART, vd, vm);
+}
+
+static inline void lib_SLIDEDWVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
+    lib_vint_slide(iss, vs2, -sim, VSTART, vd, vm);
+}
+
+static inline void lib_SLIDE1UVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    lib_vint_slide(iss, vs2, 1, MAX(VSTART, 1), vd, vm);
+    if(VSTART == 0 && VL > 0 && (vm || lib_vmask(iss, 0))){
+        lib_vint_sew(iss, [&](auto sew) {
+            typedef lib_vint_t<decltype(sew)::value, false> T;
+            lib_vset<T>(iss, vd, 0, T(rs1));
+        });
     }
 }
 
-static inline void lib_REMUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2;
-    int64_t res;
-    bool bin[8];
-    bool resBin[64];
+static inline void lib_SLIDE1DVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    if(VSTART < VL){
+        lib_vint_sew(iss, [&](auto sew) {
+            typedef lib_vint_t<decltype(sew)::value, false> T;
+            int end = VL - 1;
+            for (int i = VSTART; i < end; i++)
+            {
+                if (vm || lib_vmask(iss, i))
+                {
+                    lib_vset<T>(iss, vd, i, lib_vget<T>(iss, vs2, i + 1));
+                }
+            }
+            if (vm || lib_vmask(iss, end))
+            {
+                lib_vset<T>(iss, vd, end, T(rs1));
+            }
+        });
+    }
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_DIVVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<true>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return lib_vint_div(a, b); });
+}
 
-        myAbsU(iss, SEW, vs1, i, &data1);
-        myAbsU(iss, SEW, vs2, i, &data2);
+static inline void lib_DIVVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<true>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return lib_vint_div(a, b); });
+}
 
-        res = data2%data1;
-        intToBin(SEW, res, resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_DIVUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return lib_vint_div(a, b); });
 }
 
-static inline void lib_REMUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    uint64_t data1, data2;
-    int64_t res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
+static inline void lib_DIVUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return lib_vint_div(a, b); });
+}
 
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
+static inline void lib_REMVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<true>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return lib_vint_rem(a, b); });
+}
 
-        myAbsU(iss, SEW, vs2, i, &data2);
-        
-        res = data2%data1;
+static inline void lib_REMVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<true>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return lib_vint_rem(a, b); });
+}
 
+static inline void lib_REMUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    lib_vint_vv<false>(iss, vs1, vs2, vd, vm, [](auto a, auto b, auto d) { return lib_vint_rem(a, b); });
+}
 
-        intToBin(SEW, res, resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
+static inline void lib_REMUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    lib_vint_vx<false>(iss, vs2, rs1, vd, vm, [](auto a, auto b, auto d) { return lib_vint_rem(a, b); });
 }
 
 static inline void lib_FADDVV   (Iss *iss, int vs1,     int vs2, int vd, bool vm){
@@ -3720,7 +1534,7 @@ static inline void lib_FNMACCVV (Iss *iss, int vs1,     int vs2, int vd, bool vm
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
 
             FLOAT_INIT_3(data2, data1, data3, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_a.value = -ff_a.value;
             ff_c.value = -ff_c.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
@@ -3753,7 +1567,7 @@ static inline void lib_FNMACCVF (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
 
             FLOAT_INIT_3(data1, data2, data3, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_a.value = -ff_a.value;
             ff_c.value = -ff_c.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
@@ -3788,7 +1602,7 @@ static inline void lib_FMSACVV  (Iss *iss, int vs1,     int vs2, int vd, bool vm
 
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data2, data1, data3, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_c.value = -ff_c.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
@@ -3818,7 +1632,7 @@ static inline void lib_FMSACVF  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
         if(!mask(vm,bin)){
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data2, data3, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_c.value = -ff_c.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
@@ -3851,7 +1665,7 @@ static inline void lib_FNMSACVV (Iss *iss, int vs1,     int vs2, int vd, bool vm
 
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data2, data3, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_a.value = -ff_a.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
@@ -3881,7 +1695,7 @@ static inline void lib_FNMSACVF (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
         if(!mask(vm,bin)){
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data2, data3, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_a.value = -ff_a.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
@@ -3914,7 +1728,7 @@ static inline void lib_FMADDVV  (Iss *iss, int vs1,     int vs2, int vd, bool vm
 
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data3, data2, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);            
@@ -3943,7 +1757,7 @@ static inline void lib_FMADDVF  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
         if(!mask(vm,bin)){
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data3, data2, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -3975,7 +1789,7 @@ static inline void lib_FNMADDVV (Iss *iss, int vs1,     int vs2, int vd, bool vm
 
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data3, data2, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_a.value = -ff_a.value;
             ff_c.value = -ff_c.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
@@ -4006,7 +1820,7 @@ static inline void lib_FNMADDVF (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
         if(!mask(vm,bin)){
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data3, data2, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_a.value = -ff_a.value;
             ff_c.value = -ff_c.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
@@ -4040,7 +1854,7 @@ static inline void lib_FMSUBVV  (Iss *iss, int vs1,     int vs2, int vd, bool vm
 
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data3, data2, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_c.value = -ff_c.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
@@ -4070,7 +1884,7 @@ static inline void lib_FMSUBVF  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
         if(!mask(vm,bin)){
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data3, data2, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_c.value = -ff_c.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
@@ -4103,7 +1917,7 @@ static inline void lib_FNMSUBVV (Iss *iss, int vs1,     int vs2, int vd, bool vm
 
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data3, data2, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_a.value = -ff_a.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
@@ -4133,7 +1947,7 @@ static inline void lib_FNMSUBVF (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
         if(!mask(vm,bin)){
             int old = setFFRoundingMode(iss, iss->csr.fcsr.frm);
             FLOAT_INIT_3(data1, data3, data2, e, m)
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_a.value = -ff_a.value;
             ff_fma(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
@@ -4248,7 +2062,7 @@ static inline void lib_FWADDVV  (Iss *iss, int vs1,     int vs2, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_add(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4284,7 +2098,7 @@ static inline void lib_FWADDVF  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_add(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4322,7 +2136,7 @@ static inline void lib_FWADDWV  (Iss *iss, int vs1,     int vs2, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_add(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4358,7 +2172,7 @@ static inline void lib_FWADDWF  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_add(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4396,7 +2210,7 @@ static inline void lib_FWSUBVV  (Iss *iss, int vs1,     int vs2, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data2);
             flexfloat_set_bits(&ff_b, data1);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_sub(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4433,7 +2247,7 @@ static inline void lib_FWSUBVF  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data2);
             flexfloat_set_bits(&ff_b, data1);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_sub(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4471,7 +2285,7 @@ static inline void lib_FWSUBWV  (Iss *iss, int vs1,     int vs2, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data2);
             flexfloat_set_bits(&ff_b, data1);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_sub(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4508,7 +2322,7 @@ static inline void lib_FWSUBWF  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data2);
             flexfloat_set_bits(&ff_b, data1);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_sub(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4546,7 +2360,7 @@ static inline void lib_FWMULVV  (Iss *iss, int vs1,     int vs2, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_mul(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4583,7 +2397,7 @@ static inline void lib_FWMULVF  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
             ff_init(&ff_res, env2);
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_mul(&ff_res, &ff_a, &ff_b);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4624,7 +2438,7 @@ static inline void lib_FWMACCVV (Iss *iss, int vs1,     int vs2, int vd, bool vm
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
             flexfloat_set_bits(&ff_c, data3);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_macc(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4664,7 +2478,7 @@ static inline void lib_FWMACCVF (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
             flexfloat_set_bits(&ff_c, data3);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_macc(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4705,7 +2519,7 @@ static inline void lib_FWMSACVV (Iss *iss, int vs1,     int vs2, int vd, bool vm
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
             flexfloat_set_bits(&ff_c, data3);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_msac(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4745,7 +2559,7 @@ static inline void lib_FWMSACVF (Iss *iss, int vs2, int64_t rs1, int vd, bool vm
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
             flexfloat_set_bits(&ff_c, data3);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_msac(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4786,7 +2600,7 @@ static inline void lib_FWNMSACVV(Iss *iss, int vs1,     int vs2, int vd, bool vm
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
             flexfloat_set_bits(&ff_c, data3);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_nmsac(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -4826,7 +2640,7 @@ static inline void lib_FWNMSACVF(Iss *iss, int vs2, int64_t rs1, int vd, bool vm
             flexfloat_set_bits(&ff_a, data1);
             flexfloat_set_bits(&ff_b, data2);
             flexfloat_set_bits(&ff_c, data3);
-            feclearexcept(FE_ALL_EXCEPT);
+            lib_ff_flags_clear();
             ff_nmsac(&ff_res, &ff_a, &ff_b, &ff_c);
             update_fflags_fenv(iss);
             res = flexfloat_get_bits(&ff_res);
@@ -5542,1333 +3356,356 @@ static inline iss_freg_t lib_FMVFS     (Iss *iss, int vs2, bool vm){
             flexfloat_desc_t env2 = (flexfloat_desc_t){e2, m2};
             ff_init(&ff_a, env);
             ff_init(&ff_res, env2);
-            flexfloat_set_bits(&ff_a, data1);
-            ff_res.value = ff_a.value;
-            flexfloat_sanitize(&ff_res);
-            update_fflags_fenv(iss);
-            res = flexfloat_get_bits(&ff_res);
-            return iss_freg_t(res);
-    }else{
-        printf("REG is 64\n");        
-        return iss_freg_t(data1);
-    }
-}
-
-
-
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//                                                            VECTOR LOAD STORE
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-
-// ADD MASK TO LOAD AND STORE INSTRUCTIONS
-
-
-inline int Vlsu::Vlsu_io_access(Iss *iss, uint64_t addr, int size, uint8_t *data, bool is_write)// size in byte
-{
-    this->io_pending_addr = addr;
-    this->io_pending_size = size;
-    this->io_pending_data = data;
-    this->io_pending_is_write = is_write;
-    this->waiting_io_response = true;
-    this->handle_pending_io_access(iss);
-
-    return this->io_retval;
-}
-
-inline void Vlsu::handle_pending_io_access(Iss *iss)
-{
-    if (this->io_pending_size > 0){
-        vp::IoReq *req = &this->io_req;
-
-        uint32_t addr = this->io_pending_addr;        
-        uint32_t addr_aligned = addr & ~(4 - 1);
-        int size = addr_aligned + 4 - addr;
-        // printf("size = %d\n" , size);
-        // printf("io_pending_size = %d\n" , this->io_pending_size);        
-        if (size > this->io_pending_size){
-            size = this->io_pending_size;
-        }
-
-        req->init();
-        req->set_addr(addr);
-        req->set_size(size);
-        req->set_is_write(this->io_pending_is_write);
-        req->set_data(this->io_pending_data);
-
-        this->io_pending_data += size;
-        this->io_pending_size -= size;
-        this->io_pending_addr += size;
-
-        int err = this->io_itf[0].req(req);
-        if (err == vp::IO_REQ_OK){
-            // this->event->enqueue(this->io_req.get_latency() + 1);
-        }
-        else if (err == vp::IO_REQ_INVALID){
-            this->waiting_io_response = false;
-            this->io_retval = 1;
-        }
-        else{
-
-        }
-    }
-    else{
-        this->waiting_io_response = false;
-        this->io_retval = 0;
-    }
-}
-
-static inline void lib_VLE8V (Iss *iss, iss_reg_t rs1, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    // printf("VLE8\n");
-    // printf("vd = %d\n",vd);
-    // printf("VSTART = %ld\n",VSTART);
-    // printf("vl = %ld\n",VL);
-    // printf("RS1 = %lx\n",rs1);
-
-
-    int align = 0;
-    if(start_add%4 == 1){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][VSTART+1] = data[1];
-        iss->spatz.vregfile.vregs[vd][VSTART+2] = data[2];
-
-        start_add += 3;
-        align = 3;
-    }else if(start_add%4 == 2){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][VSTART+1] = data[1];
-
-        start_add += 2;
-        align = 2;        
-    }else if(start_add%4 == 3){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-
-        start_add += 1;
-        align = 1;
-    }else{
-        align = 0;
-    }
-
-
-
-
-
-
-
-    for (int i = VSTART+align; i < VL; i+=4){
- //       if(!i){
- //           printf("Vlsu_io_access\n");
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
- //       }else{
- //           printf("handle_pending_io_access\n");
- //           vlsu.handle_pending_io_access(iss);
- //       }
-
-        // printf("data0 = %x\n",data[0]);
-        // printf("data1 = %x\n",data[1]);
-        // printf("data2 = %x\n",data[2]);
-        // printf("data3 = %x\n",data[3]);
-
-        iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-        iss->spatz.vregfile.vregs[vd][i+2] = data[2];
-        iss->spatz.vregfile.vregs[vd][i+3] = data[3];
-
-        start_add += 4;
-    }
-}
-
-static inline void lib_VLE16V(Iss *iss, iss_reg_t rs1, int vd , bool vm){
-    // printf("LIB_VLE16V\n");
-    // printf("VSTART = %d\n",VSTART);
-    // printf("vl = %ld\n",vl);
-    // printf("VLEN/8 = %d\n",vlEN/8);
-    // printf("VM = %d\n",vm);
-    // printf("RS1 = %lx\n",rs1);
-    // printf("vd = %d\n",vd);
-
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-
-
-
-    int align = 0;
-    if(start_add%4 == 1){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][VSTART+1] = data[1];
-        iss->spatz.vregfile.vregs[vd][VSTART+2] = data[2];
-
-        start_add += 3;
-        align = 3;
-    }else if(start_add%4 == 2){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][VSTART+1] = data[1];
-
-        start_add += 2;
-        align = 2;        
-    }else if(start_add%4 == 3){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-
-        start_add += 1;
-        align = 1;
-    }else{
-        align = 0;
-    }
-
-
-    for (int i = VSTART+align; i < VL*2; i+=4){
-        //if(!i){
-            //vlsu.Vlsu_io_access(iss, rs1, vlEN/8, data, false);
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add, 4, data, false);
-        //}else{
-        //    vlsu.handle_pending_io_access(iss);
-        //}
-
-        // printf("data0 = %d\n",data[0]);
-        // printf("data1 = %d\n",data[1]);
-        // printf("data2 = %d\n",data[2]);
-        // printf("data3 = %d\n",data[3]);
-
-        // printf("vd = %d\n",vd);
-
-        //iss->spatz.vregfile.vregs[vd][i+0] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? (data[1]*pow(2,8) + data[0]) : iss->spatz.vregfile.vregs[vd][i+0];
-        //iss->spatz.vregfile.vregs[vd][i+1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? (data[3]*pow(2,8) + data[2]) : iss->spatz.vregfile.vregs[vd][i+1];
-
-        // iss->spatz.vregfile.vregs[vd][i+0] = (data[1]*pow(2,8) + data[0]);
-        // iss->spatz.vregfile.vregs[vd][i+1] = (data[3]*pow(2,8) + data[2]);
-
-        iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-        iss->spatz.vregfile.vregs[vd][i+2] = data[2];
-        iss->spatz.vregfile.vregs[vd][i+3] = data[3];
-
-        // printf("vd_vali = %d\n",(int)(data[1]*pow(2,8) + data[0]));
-        // printf("vd_vali+1 = %d\n",(int)(data[3]*pow(2,8) + data[2]));
-        start_add += 4;
-    }
-}
-
-static inline void lib_VLE32V(Iss *iss, iss_reg_t rs1, int vd , bool vm){
-    // printf("LIB_VLE32V\n");
-    // printf("VSTART = %d\n",VSTART);
-    // printf("vl = %ld\n",vl);
-    // printf("VLEN/8 = %d\n",vlEN/8);
-    // printf("VM = %d\n",vm);
-    // printf("RS1 = %lx\n",rs1);
-    // printf("vd = %d\n",vd);
-
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-
-    int align = 0;
-    if(start_add%4 == 1){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][VSTART+1] = data[1];
-        iss->spatz.vregfile.vregs[vd][VSTART+2] = data[2];
-
-        start_add += 3;
-        align = 3;
-    }else if(start_add%4 == 2){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][VSTART+1] = data[1];
-
-        start_add += 2;
-        align = 2;        
-    }else if(start_add%4 == 3){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-
-        start_add += 1;
-        align = 1;
-    }else{
-        align = 0;
-    }
-
-
-
-
-
-    for (int i = VSTART+align; i < VL*4; i+=4){
-        //if(!i){
-            //vlsu.Vlsu_io_access(iss, rs1, vlEN/8, data, false);
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add, 4, data, false);
-        //}else{
-        //    vlsu.handle_pending_io_access(iss);
-        //}
-
-        // printf("data0 = %d\n",data[0]);
-        // printf("data1 = %d\n",data[1]);
-        // printf("data2 = %d\n",data[2]);
-        // printf("data3 = %d\n",data[3]);
-
-        //printf("vd = %d\n",vd);
-
-        //iss->spatz.vregfile.vregs[vd][i+0] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? (data[1]*pow(2,8) + data[0]) : iss->spatz.vregfile.vregs[vd][i+0];
-        //iss->spatz.vregfile.vregs[vd][i+1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? (data[3]*pow(2,8) + data[2]) : iss->spatz.vregfile.vregs[vd][i+1];
-
-        // iss->spatz.vregfile.vregs[vd][i+0] = (data[1]*pow(2,8) + data[0]);
-        // iss->spatz.vregfile.vregs[vd][i+1] = (data[3]*pow(2,8) + data[2]);
-
-        iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-        iss->spatz.vregfile.vregs[vd][i+2] = data[2];
-        iss->spatz.vregfile.vregs[vd][i+3] = data[3];
-
-        // printf("vd0 = %d\n",iss->spatz.vregfile.vregs[vd][i+0]);
-        // printf("vd1 = %d\n",iss->spatz.vregfile.vregs[vd][i+1]);
-        // printf("vd2 = %d\n",iss->spatz.vregfile.vregs[vd][i+2]);
-        // printf("vd3 = %d\n",iss->spatz.vregfile.vregs[vd][i+3]);
-
-
-        // printf("vd_vali = %d\n",(int)(data[3]*pow(2,8*3) + data[2]*pow(2,8*2) + data[1]*pow(2,8) + data[0]));
-        start_add += 4;
-    }
-}
-
-static inline void lib_VLE64V(Iss *iss, iss_reg_t rs1, int vd , bool vm){
-    // printf("LIB_VLE64V\n");
-    // printf("VSTART = %d\n",VSTART);
-    // printf("vl = %ld\n",vl);
-    // printf("VLEN/8 = %d\n",vlEN/8);
-    // printf("VM = %d\n",vm);
-    // printf("RS1 = %lx\n",rs1);
-    // printf("vd = %d\n",vd);
-
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-
-    int align = 0;
-    if(start_add%4 == 1){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][VSTART+1] = data[1];
-        iss->spatz.vregfile.vregs[vd][VSTART+2] = data[2];
-
-        start_add += 3;
-        align = 3;
-    }else if(start_add%4 == 2){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][VSTART+1] = data[1];
-
-        start_add += 2;
-        align = 2;        
-    }else if(start_add%4 == 3){
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-        iss->spatz.vregfile.vregs[vd][VSTART+0] = data[0];
-
-        start_add += 1;
-        align = 1;
-    }else{
-        align = 0;
-    }
-
-
-    for (int i = VSTART+align; i < VL*8; i+=4){
-        //if(!i){
-            //vlsu.Vlsu_io_access(iss, rs1, vlEN/8, data, false);
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add, 4, data, false);
-        //}else{
-        //    vlsu.handle_pending_io_access(iss);
-        //}
-        // printf("LIB_VLE64V\n");
-
-        // printf("data0 = %d\n",data[0]);
-        // printf("data1 = %d\n",data[1]);
-        // printf("data2 = %d\n",data[2]);
-        // printf("data3 = %d\n",data[3]);
-
-        //printf("vd = %d\n",vd);
-
-        //iss->spatz.vregfile.vregs[vd][i+0] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? (data[1]*pow(2,8) + data[0]) : iss->spatz.vregfile.vregs[vd][i+0];
-        //iss->spatz.vregfile.vregs[vd][i+1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? (data[3]*pow(2,8) + data[2]) : iss->spatz.vregfile.vregs[vd][i+1];
-
-        // iss->spatz.vregfile.vregs[vd][i+0] = (data[1]*pow(2,8) + data[0]);
-        // iss->spatz.vregfile.vregs[vd][i+1] = (data[3]*pow(2,8) + data[2]);
-
-        iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-        iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-        iss->spatz.vregfile.vregs[vd][i+2] = data[2];
-        iss->spatz.vregfile.vregs[vd][i+3] = data[3];
-
-        // printf("vd0 = %d\n",iss->spatz.vregfile.vregs[vd][i+0]);
-        // printf("vd1 = %d\n",iss->spatz.vregfile.vregs[vd][i+1]);
-        // printf("vd2 = %d\n",iss->spatz.vregfile.vregs[vd][i+2]);
-        // printf("vd3 = %d\n",iss->spatz.vregfile.vregs[vd][i+3]);
-
-
-        // printf("vd_vali = %d\n",(int)(data[3]*pow(2,8*3) + data[2]*pow(2,8*2) + data[1]*pow(2,8) + data[0]));
-        start_add += 4;
-    }
-}
-
-static inline void lib_VSE8V (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
-    uint8_t data[4];
-    //printf("rs1  = %lu\n",rs1);
-    // printf("vd  = %d\n",vs3);
-
-    uint64_t start_add = rs1;
-
-
-
-    int align = 0;
-    if(start_add%4 == 1){
-        
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][VSTART+1];
-        data[2]  = iss->spatz.vregfile.vregs[vs3][VSTART+2];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-        
-        start_add += 3;
-        align = 3;
-    }else if(start_add%4 == 2){
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][VSTART+1];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-
-        start_add += 2;
-        align = 2;        
-    }else if(start_add%4 == 3){
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-
-        start_add += 1;
-        align = 1;
-    }else{
-        align = 0;
-    }
-
-
-
-
-    for (int i = VSTART+align; i < VL; i+=4){
-/*
-        data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0] : 0;
-        data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1] : 0;
-        data[2] = (vm || !(iss->spatz.vregfile.vregs[0][i+2]%2)) ? iss->spatz.vregfile.vregs[vs3][i+2] : 0;
-        data[3] = (vm || !(iss->spatz.vregfile.vregs[0][i+3]%2)) ? iss->spatz.vregfile.vregs[vs3][i+3] : 0;
-*/
-        // data[3] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0] : 0;
-        // data[2] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1] : 0;
-        // data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+2]%2)) ? iss->spatz.vregfile.vregs[vs3][i+2] : 0;
-        // data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+3]%2)) ? iss->spatz.vregfile.vregs[vs3][i+3] : 0;
-
-        data[0]  = iss->spatz.vregfile.vregs[vs3][i+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][i+1];
-        data[2]  = iss->spatz.vregfile.vregs[vs3][i+2];
-        data[3]  = iss->spatz.vregfile.vregs[vs3][i+3];
-
-
-        // printf("STORE8 \n");
-        // printf("data0  = %d\n",data[0 ]);
-        // printf("data1  = %d\n",data[1 ]);
-        // printf("data2  = %d\n",data[2 ]);
-        // printf("data3  = %d\n",data[3 ]);
-
-        // printf("addr  = %lu\n",start_add);
-
-        //if(!i){
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-        //}else{
-        //    vlsu.handle_pending_io_access(iss);
-        //}
-        start_add += 4;
-    }
-}
-
-static inline void lib_VSE16V(Iss *iss, iss_reg_t rs1, int vs3, bool vm){
-    uint8_t data[4];
-    //printf("rs1  = %lu\n",rs1);
-
-    uint64_t start_add = (uint64_t)rs1;    
-
-    int align = 0;
-    if(start_add%4 == 1){
-        
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][VSTART+1];
-        data[2]  = iss->spatz.vregfile.vregs[vs3][VSTART+2];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-        
-        start_add += 3;
-        align = 3;
-    }else if(start_add%4 == 2){
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][VSTART+1];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-
-        start_add += 2;
-        align = 2;        
-    }else if(start_add%4 == 3){
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-
-        start_add += 1;
-        align = 1;
-    }else{
-        align = 0;
-    }
-
-    for (int i = VSTART+align; i < VL*2; i+=4){
-        /*
-        data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0] : 0;
-        data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1] : 0;
-        */
-
-        // data[3] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0]/pow(2,8) : 0;
-        // data[2] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0] : 0;
-        // data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1]/pow(2,8) : 0;
-        // data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1] : 0;
-
-        // if(!i){
-        //     vlsu.Vlsu_io_access(iss, rs1,vlEN/8,data,true);
-        // }else{
-        //     vlsu.handle_pending_io_access(iss);
-        // }
-
-        data[0]  = iss->spatz.vregfile.vregs[vs3][i+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][i+1];
-        data[2]  = iss->spatz.vregfile.vregs[vs3][i+2];
-        data[3]  = iss->spatz.vregfile.vregs[vs3][i+3];
-        // printf("i = %d\t,vd = %d\n",i,vs3);
-
-        // printf("STORE16 \n");
-        // printf("data0  = %d\n",data[0]);
-        // printf("data1  = %d\n",data[1]);
-        // printf("data2  = %d\n",data[2]);
-        // printf("data3  = %d\n",data[3]);
-
-        // printf("addr  = %lu\n",start_add);
-
-        //if(!i){
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-        //}else{
-        //    vlsu.handle_pending_io_access(iss);
-        //}
-        start_add += 4;
-    }
-}
-
-static inline void lib_VSE32V(Iss *iss, iss_reg_t rs1, int vs3, bool vm){
-    uint8_t data[4];
-    //printf("rs1  = %lu\n",rs1);
-
-    uint64_t start_add = rs1;
-
-    int align = 0;
-    if(start_add%4 == 1){
-        
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][VSTART+1];
-        data[2]  = iss->spatz.vregfile.vregs[vs3][VSTART+2];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-        
-        start_add += 3;
-        align = 3;
-    }else if(start_add%4 == 2){
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][VSTART+1];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-
-        start_add += 2;
-        align = 2;        
-    }else if(start_add%4 == 3){
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-
-        start_add += 1;
-        align = 1;
-    }else{
-        align = 0;
-    }
-
-
-
-    for (int i = VSTART+align; i < VL*4; i+=4){
-        /*
-        data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0] : 0;
-        data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1] : 0;
-        */
-
-        // data[3] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0]/pow(2,8) : 0;
-        // data[2] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0] : 0;
-        // data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1]/pow(2,8) : 0;
-        // data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1] : 0;
-
-        // if(!i){
-        //     vlsu.Vlsu_io_access(iss, rs1,vlEN/8,data,true);
-        // }else{
-        //     vlsu.handle_pending_io_access(iss);
-        // }
-
-        data[0]  = iss->spatz.vregfile.vregs[vs3][i+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][i+1];
-        data[2]  = iss->spatz.vregfile.vregs[vs3][i+2];
-        data[3]  = iss->spatz.vregfile.vregs[vs3][i+3];
-
-
-        // printf("STORE32 \n");
-        // printf("data0  = %d\n",data[0]);
-        // printf("data1  = %d\n",data[1]);
-        // printf("data2  = %d\n",data[2]);
-        // printf("data3  = %d\n",data[3]);
-
-        // printf("addr  = %lu\n",start_add);
-
-        //if(!i){
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-        //}else{
-        //    vlsu.handle_pending_io_access(iss);
-        //}
-        start_add += 4;
+            flexfloat_set_bits(&ff_a, data1);
+            ff_res.value = ff_a.value;
+            flexfloat_sanitize(&ff_res);
+            update_fflags_fenv(iss);
+            res = flexfloat_get_bits(&ff_res);
+            return iss_freg_t(res);
+    }else{
+        printf("REG is 64\n");        
+        return iss_freg_t(data1);
     }
 }
 
-static inline void lib_VSE64V(Iss *iss, iss_reg_t rs1, int vs3, bool vm){
-    // uint8_t data[vl];
-    // uint32_t temp;
-    // for (int i = VSTART; i < VL*2; i+=1){
-    //     if(i%2){
-    //         temp = iss->spatz.vregfile.vregs[vs3][i+0]/pow(2,8*4);
-    //         data[3] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? temp/pow(2,8*3) : 0;
-    //         data[2] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? temp/pow(2,8*2) : 0;
-    //         data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? temp/pow(2,8*1) : 0;
-    //         data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? temp/pow(2,8*0) : 0;
-    //     }else{
-    //         temp = iss->spatz.vregfile.vregs[vs3][i+0];
-    //         data[3] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? temp/pow(2,8*3) : 0;
-    //         data[2] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? temp/pow(2,8*2) : 0;
-    //         data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? temp/pow(2,8*1) : 0;
-    //         data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? temp/pow(2,8*0) : 0;
-    //     }
-    //     if(!i){
-    //         vlsu.Vlsu_io_access(iss, rs1,vlEN/8,data,true);
-    //     }else{
-    //         vlsu.handle_pending_io_access(iss);
-    //     }
-    // }
-    uint8_t data[4];
-    //printf("rs1  = %lu\n",rs1);
-
-    uint64_t start_add = rs1;
-
-
-    int align = 0;
-    if(start_add%4 == 1){
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][VSTART+1];
-        data[2]  = iss->spatz.vregfile.vregs[vs3][VSTART+2];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-        
-        start_add += 3;
-        align = 3;
-    }else if(start_add%4 == 2){
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][VSTART+1];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-
-        start_add += 2;
-        align = 2;        
-    }else if(start_add%4 == 3){
-        data[0]  = iss->spatz.vregfile.vregs[vs3][VSTART+0];
-        iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-
-        start_add += 1;
-        align = 1;
-    }else{
-        align = 0;
-    }
 
-    for (int i = VSTART+align; i < VL*8; i+=4){
-        /*
-        data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0] : 0;
-        data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1] : 0;
-        */
-
-        // data[3] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0]/pow(2,8) : 0;
-        // data[2] = (vm || !(iss->spatz.vregfile.vregs[0][i+0]%2)) ? iss->spatz.vregfile.vregs[vs3][i+0] : 0;
-        // data[1] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1]/pow(2,8) : 0;
-        // data[0] = (vm || !(iss->spatz.vregfile.vregs[0][i+1]%2)) ? iss->spatz.vregfile.vregs[vs3][i+1] : 0;
-
-        // if(!i){
-        //     vlsu.Vlsu_io_access(iss, rs1,vlEN/8,data,true);
-        // }else{
-        //     vlsu.handle_pending_io_access(iss);
-        // }
-
-        data[0]  = iss->spatz.vregfile.vregs[vs3][i+0];
-        data[1]  = iss->spatz.vregfile.vregs[vs3][i+1];
-        data[2]  = iss->spatz.vregfile.vregs[vs3][i+2];
-        data[3]  = iss->spatz.vregfile.vregs[vs3][i+3];
-
-
-        // printf("STORE64 \n");
-        // printf("data0  = %d\n",data[0]);
-        // printf("data1  = %d\n",data[1]);
-        // printf("data2  = %d\n",data[2]);
-        // printf("data3  = %d\n",data[3]);
-
-        // printf("addr  = %lu\n",start_add);
-
-        //if(!i){
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-        //}else{
-        //    vlsu.handle_pending_io_access(iss);
-        //}
-        start_add += 4;
-    }
-}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//                                                            WHOLE REGISTER LOAD/STORE
+//                                                            VECTOR LOAD STORE
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static inline void lib_VL1RV (Iss *iss, iss_reg_t rs1, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    // printf("VLE8\n");
-    // printf("vd = %d\n",vd);
-    // printf("VSTART = %d\n",VSTART);
-    // printf("vl = %ld\n",vl);
-    for (int k = 0; k < 1; k++){
-        for (int i = 0; i < iss->csr.vlenb.value; i+=4){
-                iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
 
 
-            // printf("data0 = %d\n",data[0]);
-            // printf("data1 = %d\n",data[1]);
-            // printf("data2 = %d\n",data[2]);
-            // printf("data3 = %d\n",data[3]);
-
-            iss->spatz.vregfile.vregs[vd+k][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd+k][i+1] = data[1];
-            iss->spatz.vregfile.vregs[vd+k][i+2] = data[2];
-            iss->spatz.vregfile.vregs[vd+k][i+3] = data[3];
+inline int Vlsu::Vlsu_io_access(Iss *iss, uint64_t addr, int size, uint8_t *data, bool is_write)// size in byte
+{
+    this->io_pending_addr = addr;
+    this->io_pending_size = size;
+    this->io_pending_data = data;
+    this->io_pending_is_write = is_write;
+    this->io_retval = 0;
+    this->waiting_io_response = true;
 
-            start_add += 4;
-        }
+    while (this->waiting_io_response){
+        this->handle_pending_io_access(iss);
     }
-}
-static inline void lib_VL2RV (Iss *iss, iss_reg_t rs1, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    // printf("VLE8\n");
-    // printf("vd = %d\n",vd);
-    // printf("VSTART = %d\n",VSTART);
-    // printf("vl = %ld\n",vl);
-    for (int k = 0; k < 2; k++){
-        for (int i = 0; i < iss->csr.vlenb.value; i+=4){
-                iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-
 
-            // printf("data0 = %d\n",data[0]);
-            // printf("data1 = %d\n",data[1]);
-            // printf("data2 = %d\n",data[2]);
-            // printf("data3 = %d\n",data[3]);
+    return this->io_retval;
+}
 
-            iss->spatz.vregfile.vregs[vd+k][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd+k][i+1] = data[1];
-            iss->spatz.vregfile.vregs[vd+k][i+2] = data[2];
-            iss->spatz.vregfile.vregs[vd+k][i+3] = data[3];
+inline void Vlsu::handle_pending_io_access(Iss *iss)
+{
+    if (this->io_pending_size > 0){
+        uint64_t addr = this->io_pending_addr;
+        uint64_t burst_size = iss->spatz.VLEN / 8;
+        int size = burst_size - (addr & (burst_size - 1));
+        if (size > this->io_pending_size){
+            size = this->io_pending_size;
+        }
 
-            start_add += 4;
+        // Stores must invalidate the decoded instructions they overwrite and be seen by the store
+        // watch, whatever the path the burst takes below
+        if (this->io_pending_is_write){
+            iss->insn_cache.store_check(addr, size);
+            iss->lsu.store_watch_check(addr, size);
         }
-    }
-}
-static inline void lib_VL4RV (Iss *iss, iss_reg_t rs1, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    // printf("VLE8\n");
-    // printf("vd = %d\n",vd);
-    // printf("VSTART = %d\n",VSTART);
-    // printf("vl = %ld\n",vl);
-    for (int k = 0; k < 4; k++){
-        for (int i = 0; i < iss->csr.vlenb.value; i+=4){
-                iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
 
+        // Each port transfers the aligned words covered by the burst
+        this->insn_words += ((addr + size + VLSU_PORT_WIDTH - 1) / VLSU_PORT_WIDTH) - addr / VLSU_PORT_WIDTH;
 
-            // printf("data0 = %d\n",data[0]);
-            // printf("data1 = %d\n",data[1]);
-            // printf("data2 = %d\n",data[2]);
-            // printf("data3 = %d\n",data[3]);
+        int64_t latency = 0;
+        int err = vp::IO_REQ_OK;
+        bool done = false;
+#ifdef ISS_HAS_DMI
+        // Once a burst has been recorded for the vectored request, the next ones are recorded too
+        // so that the target sees them in program order
+        if (this->io_segments.size() == 0){
+            done = this->dmi_cache.access(addr, this->io_pending_data, size, this->io_pending_is_write, latency);
+        }
+#endif
+        if (!done && this->io_itf[0].is_vectored()){
+            this->io_segments.push_back({ addr, (uint64_t)size, this->io_pending_data });
+            this->io_segments_is_write = this->io_pending_is_write;
+        }
+        else if (!done)
+        {
+            vp::IoReq *req = &this->io_req;
 
-            iss->spatz.vregfile.vregs[vd+k][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd+k][i+1] = data[1];
-            iss->spatz.vregfile.vregs[vd+k][i+2] = data[2];
-            iss->spatz.vregfile.vregs[vd+k][i+3] = data[3];
+            req->init();
+            req->set_addr(addr);
+            req->set_size(size);
+            req->set_is_write(this->io_pending_is_write);
+            req->set_data(this->io_pending_data);
 
-            start_add += 4;
+            err = this->io_itf[0].req(req);
+            latency = req->get_latency();
         }
-    }
-}
-static inline void lib_VL8RV (Iss *iss, iss_reg_t rs1, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    // printf("VLE8\n");
-    // printf("vd = %d\n",vd);
-    // printf("VSTART = %d\n",VSTART);
-    // printf("vl = %ld\n",vl);
-    for (int k = 0; k < 8; k++){
-        for (int i = 0; i < iss->csr.vlenb.value; i+=4){
-                iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
 
+        if (latency > this->insn_latency){
+            this->insn_latency = latency;
+        }
 
-            // printf("data0 = %d\n",data[0]);
-            // printf("data1 = %d\n",data[1]);
-            // printf("data2 = %d\n",data[2]);
-            // printf("data3 = %d\n",data[3]);
-
-            iss->spatz.vregfile.vregs[vd+k][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd+k][i+1] = data[1];
-            iss->spatz.vregfile.vregs[vd+k][i+2] = data[2];
-            iss->spatz.vregfile.vregs[vd+k][i+3] = data[3];
+        this->io_pending_data += size;
+        this->io_pending_size -= size;
+        this->io_pending_addr += size;
 
-            start_add += 4;
+        if (err == vp::IO_REQ_INVALID){
+            this->waiting_io_response = false;
+            this->io_retval = 1;
         }
     }
+    else{
+        this->waiting_io_response = false;
+    }
 }
 
+inline void Vlsu::insn_start()
+{
+    this->io_retval = 0;
+    this->insn_latency = 0;
+    this->insn_words = 0;
+}
 
-static inline void lib_VS1RV (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
-    uint8_t data[4];
-    //printf("rs1  = %lu\n",rs1);
-    // printf("vd  = %d\n",vs3);
+inline void Vlsu::insn_end(Iss *iss)
+{
+    if (this->io_segments.size() != 0){
+        vp::IoReq *req = &this->io_req;
 
-    uint64_t start_add = rs1;
+        req->init();
+        req->set_is_write(this->io_segments_is_write);
+        req->set_segments(this->io_segments.data(), this->io_segments.size());
 
-    for(int k = 0; k < 1; k++){
-        for (int i = 0; i < iss->csr.vlenb.value; i+=4){
-            data[0]  = iss->spatz.vregfile.vregs[vs3+k][i+0];
-            data[1]  = iss->spatz.vregfile.vregs[vs3+k][i+1];
-            data[2]  = iss->spatz.vregfile.vregs[vs3+k][i+2];
-            data[3]  = iss->spatz.vregfile.vregs[vs3+k][i+3];
+        if (this->io_itf[0].req(req) == vp::IO_REQ_INVALID){
+            this->io_retval = 1;
+        }
+        if ((int64_t)req->get_latency() > this->insn_latency){
+            this->insn_latency = req->get_latency();
+        }
 
+        this->io_segments.clear();
+    }
 
-            // printf("STORE8 \n");
-            // printf("data0  = %d\n",data[0 ]);
-            // printf("data1  = %d\n",data[1 ]);
-            // printf("data2  = %d\n",data[2 ]);
-            // printf("data3  = %d\n",data[3 ]);
+    if (this->insn_words == 0){
+        return;
+    }
 
-            // printf("addr  = %lu\n",start_add);
+#if defined(PIPELINE_STALL_THRESHOLD)
+    // The first beat is covered by the latency of the slowest access
+    int64_t cycles = this->insn_latency + (this->insn_words + VLSU_NB_PORTS - 1) / VLSU_NB_PORTS - 1;
 
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-            start_add += 4;
-        }
+    if (cycles > PIPELINE_STALL_THRESHOLD){
+        iss->timing.stall_load_account(cycles - PIPELINE_STALL_THRESHOLD);
     }
+#endif
 }
-static inline void lib_VS2RV (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
-    uint8_t data[4];
-    //printf("rs1  = %lu\n",rs1);
-    // printf("vd  = %d\n",vs3);
 
-    uint64_t start_add = rs1;
+// Report a vector instruction for which the target refused an access, as it is done for scalar
+// atomics
+static inline void lib_vlsu_invalid(Iss *iss, bool is_write)
+{
+    vp_warning_always(&iss->trace, "Invalid vector access (pc: 0x%" PRIxFULLREG ", is_write: %d)\n",
+        iss->exec.current_insn, is_write);
+}
 
-    for(int k = 0; k < 2; k++){
-        for (int i = 0; i < iss->csr.vlenb.value; i+=4){
-            data[0]  = iss->spatz.vregfile.vregs[vs3+k][i+0];
-            data[1]  = iss->spatz.vregfile.vregs[vs3+k][i+1];
-            data[2]  = iss->spatz.vregfile.vregs[vs3+k][i+2];
-            data[3]  = iss->spatz.vregfile.vregs[vs3+k][i+3];
+// Access the active elements of vd between vstart and vl, element i being at address addr(i).
+// Active elements which are consecutive both in the register and in memory are gathered into
+// a single access, which makes unit-stride accesses whole bursts, and batches strided and indexed
+// accesses as much as their addresses allow.
+// A refused access stops the instruction, the following elements are not accessed.
+template<typename F>
+static inline void lib_vlsu_access(Iss *iss, int vd, int eew, bool vm, bool is_write, F addr)
+{
+    Vlsu *vlsu = &iss->spatz.vlsu;
+    uint8_t *reg = lib_vreg(iss, vd);
+    int size = eew / 8;
+    int end = VL;
+    int i = VSTART;
 
+    vlsu->insn_start();
 
-            // printf("STORE8 \n");
-            // printf("data0  = %d\n",data[0 ]);
-            // printf("data1  = %d\n",data[1 ]);
-            // printf("data2  = %d\n",data[2 ]);
-            // printf("data3  = %d\n",data[3 ]);
+    while (i < end){
+        if (!vm && !lib_vmask(iss, i)){
+            i++;
+            continue;
+        }
 
-            // printf("addr  = %lu\n",start_add);
+        int first = i;
+        uint64_t base = addr(i);
 
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-            start_add += 4;
+        i++;
+        while (i < end && (vm || lib_vmask(iss, i)) && addr(i) == base + (uint64_t)(i - first) * size){
+            i++;
         }
-    }
-}
-static inline void lib_VS4RV (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
-    uint8_t data[4];
-    //printf("rs1  = %lu\n",rs1);
-    // printf("vd  = %d\n",vs3);
 
-    uint64_t start_add = rs1;
+        if (vlsu->Vlsu_io_access(iss, base, (i - first) * size, reg + first * size, is_write)){
+            break;
+        }
+    }
 
-    for(int k = 0; k < 4; k++){
-        for (int i = 0; i < iss->csr.vlenb.value; i+=4){
-            data[0]  = iss->spatz.vregfile.vregs[vs3+k][i+0];
-            data[1]  = iss->spatz.vregfile.vregs[vs3+k][i+1];
-            data[2]  = iss->spatz.vregfile.vregs[vs3+k][i+2];
-            data[3]  = iss->spatz.vregfile.vregs[vs3+k][i+3];
+    vlsu->insn_end(iss);
 
+    if (vlsu->io_retval){
+        lib_vlsu_invalid(iss, is_write);
+    }
+}
 
-            // printf("STORE8 \n");
-            // printf("data0  = %d\n",data[0 ]);
-            // printf("data1  = %d\n",data[1 ]);
-            // printf("data2  = %d\n",data[2 ]);
-            // printf("data3  = %d\n",data[3 ]);
+static inline void lib_vlsu_unit(Iss *iss, iss_reg_t rs1, int vd, bool vm, int eew, bool is_write){
+    lib_vlsu_access(iss, vd, eew, vm, is_write, [&](int i) {
+        return (uint64_t)(iss_reg_t)(rs1 + (iss_reg_t)i * (eew / 8));
+    });
+}
 
-            // printf("addr  = %lu\n",start_add);
+static inline void lib_VLE8V (Iss *iss, iss_reg_t rs1, int vd , bool vm){
+    lib_vlsu_unit(iss, rs1, vd, vm, 8, false);
+}
 
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-            start_add += 4;
-        }
-    }
+static inline void lib_VLE16V(Iss *iss, iss_reg_t rs1, int vd , bool vm){
+    lib_vlsu_unit(iss, rs1, vd, vm, 16, false);
 }
-static inline void lib_VS8RV (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
-    uint8_t data[4];
-    //printf("rs1  = %lu\n",rs1);
-    // printf("vd  = %d\n",vs3);
 
-    uint64_t start_add = rs1;
+static inline void lib_VLE32V(Iss *iss, iss_reg_t rs1, int vd , bool vm){
+    lib_vlsu_unit(iss, rs1, vd, vm, 32, false);
+}
 
-    for(int k = 0; k < 8; k++){
-        for (int i = 0; i < iss->csr.vlenb.value; i+=4){
-            data[0]  = iss->spatz.vregfile.vregs[vs3+k][i+0];
-            data[1]  = iss->spatz.vregfile.vregs[vs3+k][i+1];
-            data[2]  = iss->spatz.vregfile.vregs[vs3+k][i+2];
-            data[3]  = iss->spatz.vregfile.vregs[vs3+k][i+3];
+static inline void lib_VLE64V(Iss *iss, iss_reg_t rs1, int vd , bool vm){
+    lib_vlsu_unit(iss, rs1, vd, vm, 64, false);
+}
 
+static inline void lib_VSE8V (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
+    lib_vlsu_unit(iss, rs1, vs3, vm, 8, true);
+}
 
-            // printf("STORE8 \n");
-            // printf("data0  = %d\n",data[0 ]);
-            // printf("data1  = %d\n",data[1 ]);
-            // printf("data2  = %d\n",data[2 ]);
-            // printf("data3  = %d\n",data[3 ]);
+static inline void lib_VSE16V(Iss *iss, iss_reg_t rs1, int vs3, bool vm){
+    lib_vlsu_unit(iss, rs1, vs3, vm, 16, true);
+}
 
-            // printf("addr  = %lu\n",start_add);
+static inline void lib_VSE32V(Iss *iss, iss_reg_t rs1, int vs3, bool vm){
+    lib_vlsu_unit(iss, rs1, vs3, vm, 32, true);
+}
 
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-            start_add += 4;
-        }
-    }
+static inline void lib_VSE64V(Iss *iss, iss_reg_t rs1, int vs3, bool vm){
+    lib_vlsu_unit(iss, rs1, vs3, vm, 64, true);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//                                                            STRIDED LOAD/STORE
+//                                                            WHOLE REGISTER LOAD/STORE
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static inline void lib_VLSE8V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];    
-    int i = VSTART;
-    while(i < VL){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        if(!(!(vm) && !bin[(i+0)%8])){
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,1,data,false);
-            iss->spatz.vregfile.vregs[vd][i+0] = data[0];
+// Only the first vlenb bytes of each register are accessed
+static inline void lib_vlsu_whole(Iss *iss, iss_reg_t rs1, int vd, int nb_regs, bool is_write){
+    Vlsu *vlsu = &iss->spatz.vlsu;
+    int size = iss->csr.vlenb.value;
+
+    vlsu->insn_start();
+    for (int k = 0; k < nb_regs; k++){
+        if (vlsu->Vlsu_io_access(iss, (iss_reg_t)(rs1 + k * size), size, lib_vreg(iss, vd + k), is_write)){
+            break;
         }
-        start_add += rs2;
-        i++;
     }
-}
+    vlsu->insn_end(iss);
 
-static inline void lib_VLSE16V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    int i = VSTART;
-    while(i < VL*2){
-        if(!((i/2)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/2)/8],bin);
-        }
-        if(!(!(vm) && !bin[((i/2)+0)%8])){
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,2,data,false);
-            iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-        }
-        start_add += rs2;
-        i+=2;
+    if (vlsu->io_retval){
+        lib_vlsu_invalid(iss, is_write);
     }
 }
 
-static inline void lib_VLSE32V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    int i = VSTART;
-    while(i < VL*4){
-        if(!((i/4)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/4)/8],bin);
-        }
-        if(!(!(vm) && !bin[((i/4)+0)%8])){
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-            iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-            iss->spatz.vregfile.vregs[vd][i+2] = data[2];
-            iss->spatz.vregfile.vregs[vd][i+3] = data[3];
-        }
-        start_add += rs2;
-        i+=4;
-    }
+static inline void lib_VL1RV (Iss *iss, iss_reg_t rs1, int vd , bool vm){
+    lib_vlsu_whole(iss, rs1, vd, 1, false);
 }
 
-static inline void lib_VLSE64V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    int flag = 0;
-    int i = VSTART;
-    while(i < VL*8){
-        if(!((i/8)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/8)/8],bin);
-        }
-        if(!(!(vm) && !bin[((i/8)+0)%8])){
-            if(flag){
-                flag = 0;
-                iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+4),4,data,false);
-                start_add += rs2;
-            }else{
-                flag = 1;
-                iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,false);
-            }
-            iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-            iss->spatz.vregfile.vregs[vd][i+2] = data[2];
-            iss->spatz.vregfile.vregs[vd][i+3] = data[3];        
-        }else{
-            if(flag){
-                start_add += rs2;
-                flag = 0;
-            }else{
-                flag = 1;
-            }
-        }
-        i+=4;        
-    }
+static inline void lib_VL2RV (Iss *iss, iss_reg_t rs1, int vd , bool vm){
+    lib_vlsu_whole(iss, rs1, vd, 2, false);
 }
 
+static inline void lib_VL4RV (Iss *iss, iss_reg_t rs1, int vd , bool vm){
+    lib_vlsu_whole(iss, rs1, vd, 4, false);
+}
 
-static inline void lib_VSSE8V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];    
-    int i = VSTART;
-    while(i < VL){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        if(!(!(vm) && !bin[(i+0)%8])){
-            data[0] = iss->spatz.vregfile.vregs[vd][i+0];
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,1,data,true);
-        }
-        start_add += rs2;
-        i++;
-    }
+static inline void lib_VL8RV (Iss *iss, iss_reg_t rs1, int vd , bool vm){
+    lib_vlsu_whole(iss, rs1, vd, 8, false);
 }
 
-static inline void lib_VSSE16V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    int i = VSTART;
-    while(i < VL*2){
-        if(!((i/2)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/2)/8],bin);
-        }
-        if(!(!(vm) && !bin[((i/2)+0)%8])){
-            data[0] = iss->spatz.vregfile.vregs[vd][i+0];
-            data[1] = iss->spatz.vregfile.vregs[vd][i+1];
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,2,data,true);
-        }
-        start_add += rs2;
-        i+=2;
-    }
+static inline void lib_VS1RV (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
+    lib_vlsu_whole(iss, rs1, vs3, 1, true);
 }
 
-static inline void lib_VSSE32V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    int i = VSTART;
-    while(i < VL*4){
-        if(!((i/4)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/4)/8],bin);
-        }
-        if(!(!(vm) && !bin[((i/4)+0)%8])){
-            data[0] = iss->spatz.vregfile.vregs[vd][i+0];
-            data[1] = iss->spatz.vregfile.vregs[vd][i+1];
-            data[2] = iss->spatz.vregfile.vregs[vd][i+2];
-            data[3] = iss->spatz.vregfile.vregs[vd][i+3];
-            iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-        }
-        start_add += rs2;
-        i+=4;
-    }
+static inline void lib_VS2RV (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
+    lib_vlsu_whole(iss, rs1, vs3, 2, true);
 }
 
-static inline void lib_VSSE64V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    int flag = 0;
-    int i = VSTART;
-    while(i < VL*8){
-        if(!((i/8)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/8)/8],bin);
-        }
-        if(!(!(vm) && !bin[((i/8)+0)%8])){
-            data[0] = iss->spatz.vregfile.vregs[vd][i+0];
-            data[1] = iss->spatz.vregfile.vregs[vd][i+1];
-            data[2] = iss->spatz.vregfile.vregs[vd][i+2];
-            data[3] = iss->spatz.vregfile.vregs[vd][i+3];
-            if(flag){
-                flag = 0;
-                iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+4),4,data,true);
-                start_add += rs2;
-            }else{
-                flag = 1;
-                iss->spatz.vlsu.Vlsu_io_access(iss, start_add,4,data,true);
-            }
-        }else{
-            if(flag){
-                start_add += rs2;
-                flag = 0;
-            }else{
-                flag = 1;
-            }
-        }
-        i+=4;
-    }
+static inline void lib_VS4RV (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
+    lib_vlsu_whole(iss, rs1, vs3, 4, true);
 }
 
+static inline void lib_VS8RV (Iss *iss, iss_reg_t rs1, int vs3, bool vm){
+    lib_vlsu_whole(iss, rs1, vs3, 8, true);
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//                                                            INDEXED LOAD/STORE
+//                                                            STRIDED LOAD/STORE
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static inline void lib_VLUXEI8V  (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, float r){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    uint8_t index;
-    int i = VSTART;
-    while(i < VL){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        index = iss->spatz.vregfile.vregs[vs2][int(i/r) - VSTART];
-        iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index),4,data,false);
-
-        if(!(!(vm) && !bin[(i+0)%8])){
-            iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-        }
-        i++;
-    }
+// The stride is signed, wrapping around the register width gives the right address
+static inline void lib_vlsu_strided(Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd, bool vm, int eew, bool is_write){
+    lib_vlsu_access(iss, vd, eew, vm, is_write, [&](int i) {
+        return (uint64_t)(iss_reg_t)(rs1 + (iss_reg_t)i * rs2);
+    });
 }
 
-static inline void lib_VLUXEI16V (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm , float r){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    uint8_t index;
-    
-    int i = VSTART;
-
-    while(i < VL*2){
-        if(!((i/2)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/2)/8],bin);
-        }
-        index = iss->spatz.vregfile.vregs[vs2][int(i/r) - VSTART];
-        iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index),4,data,false);
-        if(!(!(vm) && !bin[(i/2+0)%8])){
-            iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-        }
-        i+=2;
-    }
+static inline void lib_VLSE8V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
+    lib_vlsu_strided(iss, rs1, rs2, vd, vm, 8, false);
 }
 
-static inline void lib_VLUXEI32V (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, float r){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    uint8_t index;
-    
-    int i = VSTART;
-
-    while(i < VL*4){
-        if(!((i/4)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/4)/8],bin);
-        }
-    
-        index = iss->spatz.vregfile.vregs[vs2][int(i/r) - VSTART];
-
-        iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index),4,data,false);
-
-        if(!(!(vm) && !bin[(i/4+0)%8])){
-            iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-            iss->spatz.vregfile.vregs[vd][i+2] = data[2];
-            iss->spatz.vregfile.vregs[vd][i+3] = data[3];
-        }
-        i+=4;
-    }
+static inline void lib_VLSE16V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
+    lib_vlsu_strided(iss, rs1, rs2, vd, vm, 16, false);
 }
 
-static inline void lib_VLUXEI64V (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, float r){
-
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    uint8_t index;
-    int flag = 0;
-    int i = VSTART;
-
-    while(i < VL*8){
-        if(!((i/8)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/8)/8],bin);
-        }
-    
-        if(flag){
-            flag = 0;
-            iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index+4),4,data,false);
-    
-        }else{
-            flag = 1;
-            index = iss->spatz.vregfile.vregs[vs2][int(i/r) - VSTART];
-            iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index),4,data,false);
-        }
-        if(!(!(vm) && !bin[(i/8+0)%8])){
-            iss->spatz.vregfile.vregs[vd][i+0] = data[0];
-            iss->spatz.vregfile.vregs[vd][i+1] = data[1];
-            iss->spatz.vregfile.vregs[vd][i+2] = data[2];
-            iss->spatz.vregfile.vregs[vd][i+3] = data[3];
-        }
-        i+=4;
-    }
+static inline void lib_VLSE32V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
+    lib_vlsu_strided(iss, rs1, rs2, vd, vm, 32, false);
 }
 
-static inline void lib_VLUXEIV  (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, int EEW){
-    float temp = float(SEW)/float(EEW);
-    if(SEW == 8){
-        lib_VLUXEI8V   (iss, rs1, vs2, vd , vm, temp);
-    }else if(SEW == 16){
-        lib_VLUXEI16V  (iss, rs1, vs2, vd , vm, temp);
-    }else if(SEW == 32){
-        lib_VLUXEI32V  (iss, rs1, vs2, vd , vm, temp);
-    }else if(SEW == 64){
-        lib_VLUXEI64V  (iss, rs1, vs2, vd , vm, temp);
-    }
+static inline void lib_VLSE64V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
+    lib_vlsu_strided(iss, rs1, rs2, vd, vm, 64, false);
 }
 
-
-static inline void lib_VSUXEI8V  (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, float r){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    uint8_t index;
-    int i = VSTART;
-    while(i < VL){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        index = iss->spatz.vregfile.vregs[vs2][int(i/r) - VSTART];
-        if(!(!(vm) && !bin[(i+0)%8])){
-            data[0] = iss->spatz.vregfile.vregs[vd][i+0];
-            iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index),1,data,true);
-        }
-        i++;
-    }
+static inline void lib_VSSE8V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
+    lib_vlsu_strided(iss, rs1, rs2, vd, vm, 8, true);
 }
 
-static inline void lib_VSUXEI16V (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, float r){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    uint8_t index;
-    int i = VSTART;
-    while(i < VL*2){
-        if(!((i/2)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/2)/8],bin);
-        }
-        index = iss->spatz.vregfile.vregs[vs2][int(i/r) - VSTART];
-        if(!(!(vm) && !bin[(i/2+0)%8])){
-            data[0] = iss->spatz.vregfile.vregs[vd][i+0];
-            data[1] = iss->spatz.vregfile.vregs[vd][i+1];
-            iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index),2,data,true);
-        }
-        i+=2;
-    }
+static inline void lib_VSSE16V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
+    lib_vlsu_strided(iss, rs1, rs2, vd, vm, 16, true);
 }
 
-static inline void lib_VSUXEI32V (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, float r){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    uint8_t index;
-    int i = VSTART;
-    while(i < VL*4){
-        if(!((i/4)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/4)/8],bin);
-        }
-        index = iss->spatz.vregfile.vregs[vs2][int(i/r) - VSTART];
-        if(!(!(vm) && !bin[(i/4+0)%8])){
-            data[0] = iss->spatz.vregfile.vregs[vd][i+0];
-            data[1] = iss->spatz.vregfile.vregs[vd][i+1];
-            data[2] = iss->spatz.vregfile.vregs[vd][i+2];
-            data[3] = iss->spatz.vregfile.vregs[vd][i+3];
-            iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index),4,data,true);
-        }
-        i+=4;
-    }
+static inline void lib_VSSE32V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
+    lib_vlsu_strided(iss, rs1, rs2, vd, vm, 32, true);
 }
 
-static inline void lib_VSUXEI64V (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, float r){
-    uint64_t start_add = rs1;
-    uint8_t data[4];
-    bool bin[8];
-    uint8_t index;
-    int i = VSTART;
-    int flag = 0;
-    while(i < VL*8){
-        if(!((i/8)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i/8)/8],bin);
-        }
+static inline void lib_VSSE64V (Iss *iss, iss_reg_t rs1, iss_reg_t rs2, int vd , bool vm){
+    lib_vlsu_strided(iss, rs1, rs2, vd, vm, 64, true);
+}
 
-        if(!(!(vm) && !bin[(i/8+0)%8])){
-            data[0] = iss->spatz.vregfile.vregs[vd][i+0];
-            data[1] = iss->spatz.vregfile.vregs[vd][i+1];
-            data[2] = iss->spatz.vregfile.vregs[vd][i+2];
-            data[3] = iss->spatz.vregfile.vregs[vd][i+3];
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                            INDEXED LOAD/STORE
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-            if(flag){
-                flag = 0;
-                iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index+4),4,data,true);
-        
-            }else{
-                flag = 1;
-                index = iss->spatz.vregfile.vregs[vs2][int(i/r) - VSTART];
-                iss->spatz.vlsu.Vlsu_io_access(iss, (start_add+index),4,data,true);
-            }
+// Element i of vs2 is the unsigned offset of element i, on EEW bits, while data elements have SEW bits
+static inline void lib_vlsu_indexed(Iss *iss, iss_reg_t rs1, int vs2, int vd, bool vm, int EEW, bool is_write){
+    lib_vlsu_access(iss, vd, SEW, vm, is_write, [&](int i) {
+        uint64_t index;
+        switch (EEW){
+            case 8:  index = lib_vget<uint8_t>(iss, vs2, i); break;
+            case 16: index = lib_vget<uint16_t>(iss, vs2, i); break;
+            case 32: index = lib_vget<uint32_t>(iss, vs2, i); break;
+            default: index = lib_vget<uint64_t>(iss, vs2, i); break;
         }
-        i+=4;
-    }
+        return (uint64_t)(iss_reg_t)(rs1 + index);
+    });
+}
+
+static inline void lib_VLUXEIV  (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, int EEW){
+    lib_vlsu_indexed(iss, rs1, vs2, vd, vm, EEW, false);
 }
 
 static inline void lib_VSUXEIV  (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool vm, int EEW){
-    float temp = float(SEW)/float(EEW);
-
-    if(SEW == 8){
-        lib_VSUXEI8V   (iss, rs1, vs2, vd , vm, temp);
-    }else if(SEW == 16){
-        lib_VSUXEI16V  (iss, rs1, vs2, vd , vm, temp);
-    }else if(SEW == 32){
-        lib_VSUXEI32V  (iss, rs1, vs2, vd , vm, temp);
-    }else if(SEW == 64){
-        lib_VSUXEI64V  (iss, rs1, vs2, vd , vm, temp);
-    }
+    lib_vlsu_indexed(iss, rs1, vs2, vd, vm, EEW, true);
 }
 
 
@@ -6879,7 +3716,7 @@ static inline void lib_VSUXEIV  (Iss *iss, iss_reg_t rs1, int vs2, int vd , bool
 static inline iss_reg_t lib_VSETVLI(Iss *iss, int idxRs1, int idxRd, int rs1, iss_uim_t lmul, iss_uim_t sew, iss_uim_t vtype){
     uint32_t AVL;
 
-    if((int)(vtype/pow(2,31))){
+    if(vtype >> 31){
         iss->csr.vtype.value = 0x8000000000000000;
         VL = 0;
         AVL = 0;
@@ -6918,7 +3755,7 @@ static inline iss_reg_t lib_VSETVL(Iss *iss, int idxRs1, int idxRd, int rs1, int
     iss->csr.vtype.value = rs2;
     int sew = (rs2/8)%8;
     int lmul = rs2%8;
-    if((int)(rs2/pow(2,31))){
+    if(rs2 / (1LL << 31)){
         iss->csr.vtype.value = 0x8000000000000000;
         VL = 0;
         AVL = 0;
@@ -29,7 +29,6 @@ void update_external_pccr(Iss *iss, int id, unsigned int pcer, unsigned int pcmr
 
 void iss_trace_save_args(Iss *iss, iss_insn_t *insn, iss_insn_arg_t saved_args[], bool save_out);
 void iss_trace_dump(Iss *iss, iss_insn_t *insn, iss_reg_t pc);
-void iss_trace_init(Iss *iss);
 
 iss_reg_t iss_exec_insn_with_trace(Iss *iss, iss_insn_t *insn, iss_reg_t pc);
 
@@ -37,16 +36,12 @@ void iss_reset(Iss *iss, int active);
 
 iss_decoder_item_t *iss_isa_get(Iss *iss);
 
-void iss_register_debug_info(Iss *iss, const char *binary);
-
 iss_reg_t iss_decode_pc_handler(Iss *cpu, iss_insn_t *insn, iss_reg_t pc);
 
 bool iss_csr_read(Iss *iss, iss_reg_t reg, iss_reg_t *value);
 std::string iss_csr_name(Iss *iss, iss_reg_t reg);
 bool iss_csr_write(Iss *iss, iss_reg_t reg, iss_reg_t value);
 
-int iss_trace_pc_info(iss_addr_t addr, const char **func, const char **inline_func, const char **file, int *line);
-
 extern iss_isa_set_t __iss_isa_set;
 
 static inline iss_isa_set_t *iss_get_isa_set()
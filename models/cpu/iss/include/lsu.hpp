@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cpu/iss/include/types.hpp>
+#include <cpu/iss/include/dmi_cache.hpp>
 
 #ifndef CONFIG_GVSOC_ISS_SNITCH
 #define ADDR_MASK (~(ISS_REG_WIDTH / 8 - 1))
@@ -48,6 +49,7 @@ public:
     static void exec_misaligned(vp::Block *__this, vp::ClockEvent *event);
     static void data_grant(vp::Block *__this, vp::IoReq *req);
     static void data_response(vp::Block *__this, vp::IoReq *req);
+    static void data_dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size);
 
     template<typename T>
     inline bool store(iss_insn_t *insn, iss_addr_t addr, int size, int reg);
@@ -86,6 +88,12 @@ public:
 
     inline void stack_access_check(int reg, iss_addr_t addr);
 
+    // Watch the stores of the core to a range of physical addresses. The callback is called
+    // each time a store overlapping the range is issued, and again when it completes if it was
+    // asynchronous. Only one range can be watched.
+    void store_watch_set(iss_addr_t base, iss_addr_t size, std::function<void()> callback);
+    inline void store_watch_check(iss_addr_t addr, iss_addr_t size);
+
     Iss &iss;
 
     vp::Trace trace;
@@ -95,6 +103,10 @@ public:
     vp::IoMaster data;
     vp::WireMaster<void *> meminfo;
     vp::IoReq io_req;
+#ifdef ISS_HAS_DMI
+    // Direct accesses granted on the data interface
+    DmiCache dmi_cache;
+#endif
     int misaligned_size;
     uint8_t *misaligned_data;
     uint8_t *misaligned_memcheck_data;
@@ -120,4 +132,9 @@ private:
     static void load_float_resume(Lsu *lsu);
 
     int64_t pending_latency;
+
+    // Watched range, empty if there is none
+    iss_addr_t store_watch_base = 0;
+    iss_addr_t store_watch_end = 0;
+    std::function<void()> store_watch_callback;
 };
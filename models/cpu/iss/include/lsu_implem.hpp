@@ -195,6 +195,8 @@ inline bool Lsu::store(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 
     if (use_mem_array)
     {
+        this->iss.insn_cache.store_check(phys_addr, size);
+        this->store_watch_check(phys_addr, size);
         *(T *)&this->mem_array[phys_addr - this->memory_start] = this->iss.regfile.get_reg(reg);
 
         return false;
@@ -298,6 +300,14 @@ inline void Lsu::stack_access_check(int reg, iss_addr_t addr)
     }
 }
 
+inline void Lsu::store_watch_check(iss_addr_t addr, iss_addr_t size)
+{
+    if (unlikely(addr < this->store_watch_end && addr + size > this->store_watch_base))
+    {
+        this->store_watch_callback();
+    }
+}
+
 template<typename T>
 inline bool Lsu::load_float(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
@@ -371,6 +381,8 @@ inline bool Lsu::store_float(iss_insn_t *insn, iss_addr_t addr, int size, int re
 
     if (use_mem_array)
     {
+        this->iss.insn_cache.store_check(phys_addr, size);
+        this->store_watch_check(phys_addr, size);
         *(T *)&this->mem_array[phys_addr - this->memory_start] = this->iss.regfile.get_freg(reg);
 
         return false;
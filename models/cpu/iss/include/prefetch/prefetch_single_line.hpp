@@ -23,6 +23,7 @@
 
 #include <vp/vp.hpp>
 #include <cpu/iss/include/types.hpp>
+#include <cpu/iss/include/dmi_cache.hpp>
 
 class Prefetcher
 {
@@ -41,6 +42,9 @@ public:
     // Response callback for the refill
     static void fetch_response(vp::Block *__this, vp::IoReq *req);
 
+    // Called when direct accesses granted on the refill interface are revoked
+    static void fetch_dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size);
+
     // Refill interface
     vp::IoMaster fetch_itf;
 
@@ -82,6 +86,11 @@ private:
     // Request used for sending fetch request to the fetch interface
     vp::IoReq fetch_req;
 
+#ifdef ISS_HAS_DMI
+    // Direct accesses granted on the refill interface
+    DmiCache dmi_cache;
+#endif
+
     // Callback called when a pending fetch response is received
     void (*fetch_stall_callback)(Prefetcher *_this);
 
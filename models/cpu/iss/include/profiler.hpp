@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cpu/iss/include/types.hpp>
+
+// Maximum depth of the call stack. Calls going deeper are attributed to the deepest function,
+// which prevents unbalanced calls, for example from context switches, from growing the tree
+// forever
+#define PROFILER_MAX_DEPTH 1024
+
+// Node of the calling-context tree, which is a function called from a specific call stack
+class ProfilerNode
+{
+public:
+    ProfilerNode(ProfilerNode *parent, iss_reg_t addr) : parent(parent), addr(addr) {}
+
+    ProfilerNode *parent;
+    // Entry point of the function
+    iss_reg_t addr;
+    // Number of times the function was entered from this call stack
+    uint64_t calls = 0;
+    // Exclusive cost, spent in the function itself
+    int64_t cycles = 0;
+    int64_t insns = 0;
+    std::unordered_map<iss_reg_t, std::unique_ptr<ProfilerNode>> children;
+};
+
+typedef struct
+{
+    ProfilerNode *node;
+    // Address the function is expected to return to, or -1 if it is unknown
+    iss_reg_t return_addr;
+    // True if the function was entered through an exception or an interrupt
+    bool is_trap;
+} profiler_frame_t;
+
+// Function profiler, attributing cycles and retired instructions to the functions of the
+// executed code.
+//
+// Calls and returns are detected from the instructions changing the control flow, using the
+// RISC-V link register conventions, and exceptions and interrupts are handled as calls to their
+// handler. The costs are accumulated in a calling-context tree, so that both exclusive and
+// inclusive costs can be reported, and are dumped in callgrind or pprof format at the end of the
+// simulation or when requested through the proxy.
+//
+// Costs are only accounted when the current function changes, so that the only per-instruction
+// cost is a counter increment and a comparison with the expected pc.
+class Profiler
+{
+public:
+    Profiler(Iss &iss);
+
+    void build();
+    void reset(bool active);
+    void stop();
+    std::string handle_command(std::vector<std::string> args);
+
+    // Must be called after each executed instruction, with the address of the next one
+    inline void insn_exec(iss_insn_t *insn, iss_reg_t pc, iss_reg_t next_pc);
+
+    bool active = false;
+
+private:
+    void control_flow(iss_insn_t *insn, iss_reg_t pc, iss_reg_t next_pc);
+    void account(int64_t insns);
+    void call(iss_reg_t addr, iss_reg_t return_addr, bool is_trap);
+    void ret(iss_reg_t addr);
+    void trap_ret();
+    bool dump(std::string path);
+    bool dump_callgrind(FILE *file);
+    bool dump_pprof(FILE *file);
+    std::string get_default_path();
+
+    Iss &iss;
+    vp::Trace trace;
+    std::string format;
+
+    // Root of the calling-context tree, which is not a function, its children are the functions
+    // the core was executing when the call stack was empty
+    ProfilerNode root;
+    std::vector<profiler_frame_t> stack;
+    // Number of calls which were not pushed because the stack was full
+    int overflow_depth;
+    // Number of retired instructions
+    int64_t insns;
+    // Cycles and instructions when the costs were last accounted to the current function
+    int64_t last_cycles;
+    int64_t last_insns;
+    // Address of the last instruction and of the one expected after it, used to detect
+    // asynchronous redirections of the control flow
+    iss_reg_t last_pc;
+    iss_reg_t expected_pc;
+};
+
+inline void Profiler::insn_exec(iss_insn_t *insn, iss_reg_t pc, iss_reg_t next_pc)
+{
+    this->insns++;
+
+    if (unlikely(pc != this->expected_pc || next_pc != pc + insn->size))
+    {
+        this->control_flow(insn, pc, next_pc);
+    }
+
+    this->last_pc = pc;
+    this->expected_pc = next_pc;
+}
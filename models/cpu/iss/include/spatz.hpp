@@ -2,6 +2,7 @@
 #define SPATZ_HPP
 
 #include "cpu/iss/include/types.hpp"
+#include "cpu/iss/include/dmi_cache.hpp"
 #include "math.h"
 //#include "isa_lib/vint.h"
 
@@ -75,18 +76,37 @@ private:
 
 };
 
+// Number of memory ports of the VLSU
+#define VLSU_NB_PORTS 4
+// Number of bytes each port can transfer per cycle
+#define VLSU_PORT_WIDTH 4
+
 class Vlsu {
 public:
+    // Access a contiguous memory area. It is split into bursts of at most VLEN/8 bytes, aligned on
+    // this size, which are done directly on host memory when the target grants it.
+    // If the target accepts vectored requests, the other bursts are only recorded, and are sent
+    // together as a single vectored request at the end of the instruction. Once a burst has been
+    // recorded, the next ones of the instruction are recorded too to keep them in order.
+    // Returns 0 if all the bursts succeeded.
     inline int Vlsu_io_access(Iss *iss, uint64_t addr, int size, uint8_t *data, bool is_write);
 
     inline void handle_pending_io_access(Iss *iss);
     static void data_response(vp::Block *__this, vp::IoReq *req);
+    static void dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size);
 
+    // Must be called before the accesses of a vector instruction, it also clears io_retval
+    inline void insn_start();
+    // Must be called after the accesses of a vector instruction to account its timing. It is
+    // derived from the slowest access and from the number of cycles the ports need to transfer
+    // all the data, not from the number of requests. A failure of the vectored request is
+    // reported in io_retval.
+    inline void insn_end(Iss *iss);
 
     Vlsu(Iss &iss);
     void build();
 
-    vp::IoMaster io_itf[4];
+    vp::IoMaster io_itf[VLSU_NB_PORTS];
     vp::IoReq io_req;
     vp::ClockEvent *event;
     int io_retval;
@@ -95,9 +115,17 @@ public:
     uint8_t *io_pending_data;
     bool io_pending_is_write;
     bool waiting_io_response;
+    // Highest latency of the accesses of the current instruction
+    int64_t insn_latency;
+    // Number of port words accessed by the current instruction
+    int64_t insn_words;
+    // Bursts of the current instruction to be sent as a vectored request
+    std::vector<vp::IoReqSegment> io_segments;
+    bool io_segments_is_write;
 
 private:
     Iss &iss;
+    DmiCache dmi_cache;
 
 };
 // define a new class named SPATZ like ISS in class.hpp
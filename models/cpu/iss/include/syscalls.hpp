@@ -29,6 +29,27 @@
 
 class IssWrapper;
 
+// Maximum size of the buffers copied at once between the guest and the host by file accesses
+#define SYSCALLS_CHUNK_SIZE (64 * 1024)
+
+// Size of the chunks read when looking for the end of a guest string
+#define SYSCALLS_STRING_CHUNK_SIZE 128
+
+// Size of the console buffer, which is flushed when it is full whatever the policy
+#define SYSCALLS_CONSOLE_SIZE 4096
+
+// When the console output is flushed to the host
+typedef enum
+{
+    // At each write, the output is not buffered
+    SYSCALLS_CONSOLE_FLUSH_ALWAYS,
+    // At each end of line
+    SYSCALLS_CONSOLE_FLUSH_LINE,
+    // Only when the buffer is full, when the guest reads the console input, and when the
+    // simulation ends
+    SYSCALLS_CONSOLE_FLUSH_FULL,
+} syscalls_console_flush_e;
+
 
 class Syscalls
 {
@@ -37,6 +58,7 @@ public:
 
     void build();
     void reset(bool active);
+    void stop();
 
     void handle_ebreak();
     void handle_riscv_ebreak();
@@ -44,6 +66,13 @@ public:
     bool user_access(iss_addr_t addr, uint8_t *data, iss_addr_t size, bool is_write);
     std::string read_user_string(iss_addr_t addr, int len = -1);
 
+    // Write guest output to the host console, which is either stdout or stderr, following the
+    // flush policy
+    ssize_t console_write(int fd, const uint8_t *data, size_t size);
+    // Flush the console output, must be called before anything else can be printed by the host
+    // in response to the guest, for example when it reads the console input
+    void console_flush();
+
     vp::Trace trace;
 
     Iss_pcer_info_t pcer_info[32];
@@ -52,6 +81,13 @@ public:
     Htif htif;
 
 private:
+    int user_access_chunk(iss_addr_t addr, uint8_t *data, iss_addr_t &size, bool is_write);
+
     Iss &iss;
     int64_t latency;
+
+    syscalls_console_flush_e console_flush_policy;
+    // Host file descriptor of the buffered output, or -1 if the buffer is empty
+    int console_fd;
+    std::vector<uint8_t> console_buffer;
 };
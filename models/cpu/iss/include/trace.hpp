@@ -24,8 +24,10 @@
 
 #include <vp/vp.hpp>
 #include <cpu/iss/include/types.hpp>
+#include <cpu/iss/include/debug_info.hpp>
 
 
+class InsnTraceBinStream;
 
 class Trace
 {
@@ -37,6 +39,14 @@ public:
 
     void insn_trace_callback();
     void dump_debug_traces();
+    // Add the debug information of a binary, from the text file generated from its ELF
+    void register_debug_info(std::string path);
+    // Get the debug information of the address, returns false if there is none
+    bool get_pc_info(iss_addr_t addr, const char **func, const char **inline_func, const char **file, int *line);
+    // Dump the instruction to the binary instruction trace, once its output registers are saved
+    void dump_binary(iss_insn_t *insn, iss_reg_t pc);
+    // Stop the simulation if the binary instruction trace can not be dumped to the file
+    void check_binary_file(FILE *file);
 
     // This will skip the dump of the current instruction. This is set back to false
     // immediately after current instruction is executed so that only once instruction dump
@@ -54,8 +64,16 @@ public:
     iss_reg_t reg_dump;
     bool has_str_dump = false;
     std::string str_dump;
+    // True if debug binaries were given, in which case instruction traces show debug information
+    bool has_debug_info = false;
 
 private:
 
     Iss &iss;
+    // Stream of the binary instruction trace, created when the first instruction is dumped
+    InsnTraceBinStream *bin_stream = NULL;
+    std::vector<std::shared_ptr<DebugInfo>> debug_infos;
+    // Range found by the last lookup, checked first as consecutive lookups are usually in it
+    DebugInfo *last_debug_info = NULL;
+    const debug_info_range_t *last_debug_range = NULL;
 };
@@ -351,29 +351,34 @@ typedef struct iss_decoder_item_s
             int width;
             int nb_groups;
             iss_decoder_item_t **groups;
+            // Item selected when no other item of the group matches, or NULL
+            iss_decoder_item_t *others;
+            // Items indexed by the opcode field, of size 1 << width, or NULL if the field is too
+            // wide, in which case groups must be scanned
+            iss_decoder_item_t **table;
         } group;
     } u;
 
 } iss_decoder_item_t;
 
-typedef struct iss_insn_s
+// Debug information of an instruction, like the arguments used for the instruction trace or the
+// breakpoints. This is only allocated when one of its fields is needed, so that instruction pages
+// can be created and instructions decoded without constructing it.
+typedef struct iss_insn_debug_s
+{
+    iss_insn_arg_t args[ISS_MAX_DECODE_ARGS];
+    std::vector<iss_reg_t>  breakpoints;
+    int in_spregs[6];
+    // Identifier of the descriptor dumped to the binary instruction trace, -1 if not dumped yet
+    int trace_desc;
+} iss_insn_debug_t;
+
+// Cold part of a decoded instruction, with the handlers saved when the executed ones are patched
+// for stalls, hardware loops, resources, traces and breakpoints, the decoder information and the
+// Snitch offload state. Instruction pages keep it in a separate array so that the hot parts of
+// consecutive instructions are contiguous.
+typedef struct iss_insn_cold_s
 {
-    iss_reg_t (*fast_handler)(Iss *, iss_insn_t *, iss_reg_t);
-    unsigned char out_regs[ISS_MAX_NB_OUT_REGS];
-#ifdef CONFIG_GVSOC_ISS_SNITCH
-    bool out_regs_fp[ISS_MAX_NB_OUT_REGS];
-#endif
-    unsigned char in_regs[ISS_MAX_NB_IN_REGS];
-#ifdef CONFIG_GVSOC_ISS_SNITCH
-    bool in_regs_fp[ISS_MAX_NB_IN_REGS];
-#endif
-    void *out_regs_ref[ISS_MAX_NB_OUT_REGS];
-    void *in_regs_ref[ISS_MAX_NB_IN_REGS];
-    iss_uim_t uim[ISS_MAX_IMMEDIATES];
-    iss_sim_t sim[ISS_MAX_IMMEDIATES];
-    iss_addr_t addr;
-    iss_reg_t opcode;
-    iss_reg_t (*handler)(Iss *, iss_insn_t *, iss_reg_t);
     iss_reg_t (*resource_handler)(Iss *, iss_insn_t *, iss_reg_t); // Handler called when an instruction with an associated resource is executed. The handler will take care of simulating the timing of the resource.
 #if defined(CONFIG_GVSOC_ISS_RI5KY)
     iss_reg_t (*hwloop_handler)(Iss *, iss_insn_t *, iss_reg_t);
@@ -382,25 +387,21 @@ typedef struct iss_insn_s
     iss_reg_t (*stall_fast_handler)(Iss *, iss_insn_t *, iss_reg_t);
     iss_reg_t (*breakpoint_saved_handler)(Iss *, iss_insn_t *, iss_reg_t);
     iss_reg_t (*breakpoint_saved_fast_handler)(Iss *, iss_insn_t *, iss_reg_t);
-    int size;
+    iss_reg_t (*saved_handler)(Iss *, iss_insn_t *, iss_reg_t);
+
+    iss_decoder_insn_t *desc;
+    iss_insn_t *expand_table;
+    iss_decoder_item_t *decoder_item;
     int nb_out_reg;
     int nb_in_reg;
-    iss_insn_arg_t args[ISS_MAX_DECODE_ARGS];
-    iss_decoder_item_t *decoder_item;
     int resource_id;        // Identifier of the resource associated to this instruction
     int resource_latency;   // Time required to get the result when accessing the resource
     int resource_bandwidth; // Time required to accept the next access when accessing the resource
-
-    iss_reg_t (*saved_handler)(Iss *, iss_insn_t *, iss_reg_t);
-
-    int in_spregs[6];
-
-    int latency;
-    std::vector<iss_reg_t>  breakpoints;
-
-    iss_insn_t *expand_table;
     bool is_macro_op;
+
 #ifdef CONFIG_GVSOC_ISS_SNITCH
+    bool out_regs_fp[ISS_MAX_NB_OUT_REGS];
+    bool in_regs_fp[ISS_MAX_NB_IN_REGS];
     bool is_outer;
     iss_reg_t max_rpt;
 
@@ -416,11 +417,29 @@ typedef struct iss_insn_s
     // TODO this have been put here since fp ss is taking handlers from main core while it
     // should not
     unsigned int fmode;
-
 #endif
 
-    iss_decoder_insn_t *desc;
+    // Debug information, NULL until one of its fields is needed
+    iss_insn_debug_t *debug;
+} iss_insn_cold_t;
 
+// Decoded instruction, containing only the handlers executing it and their operands. Everything
+// else is in its cold part.
+typedef struct iss_insn_s
+{
+    iss_reg_t (*fast_handler)(Iss *, iss_insn_t *, iss_reg_t);
+    iss_reg_t (*handler)(Iss *, iss_insn_t *, iss_reg_t);
+    iss_insn_cold_t *cold;
+    unsigned char out_regs[ISS_MAX_NB_OUT_REGS];
+    unsigned char in_regs[ISS_MAX_NB_IN_REGS];
+    int size;
+    int latency;
+    iss_uim_t uim[ISS_MAX_IMMEDIATES];
+    iss_sim_t sim[ISS_MAX_IMMEDIATES];
+    void *out_regs_ref[ISS_MAX_NB_OUT_REGS];
+    void *in_regs_ref[ISS_MAX_NB_IN_REGS];
+    iss_addr_t addr;
+    iss_reg_t opcode;
 } iss_insn_t;
 
 
@@ -22,6 +22,10 @@
 import collections
 
 
+# Maximum width of a group opcode field for which a directly-indexed decoding table is generated.
+# Wider fields are only found in groups with very few sub-items, which are scanned instead.
+DECODER_TABLE_MAX_WIDTH = 8
+
 
 def dump(isaFile, str, level=0):
     for i in range(0, level):
@@ -515,6 +519,25 @@ class DecodeTree(object):
 
                 dump(isaFile, ' };\n')
 
+                others_name = 'NULL'
+                if self.subtrees.get('OTHERS') is not None:
+                    others_name = '&%s' % self.subtrees['OTHERS'].get_name()
+
+                # Groups with a small opcode field get a table directly indexed by the opcode
+                # so that decoding does not need to scan the group
+                table_name = 'NULL'
+                if self.opcode_width <= DECODER_TABLE_MAX_WIDTH:
+                    table_name = '%s_table' % self.get_name()
+                    table = [others_name] * (1 << self.opcode_width)
+                    for opcode, subtree in self.subtrees.items():
+                        if opcode != 'OTHERS':
+                            table[int(opcode, 2)] = '&%s' % subtree.get_name()
+
+                    dump(isaFile, 'static iss_decoder_item_t *%s[] = {\n' % table_name)
+                    for index in range(0, len(table), 8):
+                        dump(isaFile, '  %s,\n' % ', '.join(table[index:index+8]))
+                    dump(isaFile, '};\n')
+
                 dump(isaFile, 'static iss_decoder_item_t %s = {\n' % (self.get_name()))
                 dump(isaFile, '  .is_insn=false,\n')
                 dump(isaFile, '  .is_active=false,\n')
@@ -525,7 +548,9 @@ class DecodeTree(object):
                 dump(isaFile, '      .bit=%d,\n' % self.firstBit)
                 dump(isaFile, '      .width=%d,\n' % self.opcode_width)
                 dump(isaFile, '      .nb_groups=%d,\n' % len(self.subtrees))
-                dump(isaFile, '      .groups=%s_groups\n' % self.get_name())
+                dump(isaFile, '      .groups=%s_groups,\n' % self.get_name())
+                dump(isaFile, '      .others=%s,\n' % others_name)
+                dump(isaFile, '      .table=%s\n' % table_name)
                 dump(isaFile, '    }\n')
                 dump(isaFile, '  }\n')
                 dump(isaFile, '};\n')
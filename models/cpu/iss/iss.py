@@ -103,6 +103,8 @@ class Iss(st.Component):
             'core_id': core_id,
             'fetch_enable': fetch_enable,
             'boot_addr': boot_addr,
+            'profiler': { 'enabled': False, 'format': 'callgrind' },
+            'console_flush': 'always',
         })
 
         if core == 'ri5ky':
@@ -57,6 +57,32 @@ class RiscvCommon(st.Component):
         starts it (default: False).
     boot_addr : int, optional
         Address of the first instruction (default: 0)
+    batch_insns : int, optional
+        Enables temporal decoupling when greater than 1. The core then executes up to this number of
+        instructions per clock event and synchronizes with the engine only at the end of the batch or
+        when it stalls, gets an interrupt or does an IO which is not handled synchronously (default: 1).
+    batch_quantum : int, optional
+        Maximum number of cycles the core can run ahead of the engine during a batch, 0 means no
+        limit (default: 0).
+    jit : bool, optional
+        True if hot blocks executed in batch mode should have their runs of base integer ALU
+        instructions translated to host code. Branches, loads and stores are still interpreted, so
+        this mostly speeds up compute loops, while code dominated by memory accesses and branches
+        is not faster. This is only supported for untimed 32-bit cores on x86-64 hosts
+        (default: False).
+    jit_threshold : int, optional
+        Number of executions after which a block is translated to host code (default: 64).
+    insn_cache_store_tracking : bool, optional
+        True if only the pages of decoded instructions modified by the core stores, atomics, vector
+        stores, semihosting and GDB writes should be invalidated, so that fence.i keeps the
+        instruction cache. Code written by other initiators (DMAs, other cores) must then be
+        signalled through the flush_cache port, which flushes the whole cache, or through the
+        flush_cache_line port. False makes fence.i flush the whole cache and disables the store
+        checks, for platforms where such writers can not signal their writes (default: True).
+    insn_page_bits : int, optional
+        Number of address bits covered by a page of decoded instructions. Bigger pages make calls
+        and branches leave the current page less often, at the cost of more memory for sparse code.
+        This can't be more than 12 for cores with an MMU (default: None, which uses 9).
 
     """
 
@@ -94,7 +120,13 @@ class RiscvCommon(st.Component):
             external_pccr=False,
             htif=False,
             custom_sources=False,
-            memcheck_nb_memory=0):
+            memcheck_nb_memory=0,
+            batch_insns=1,
+            batch_quantum=0,
+            jit=False,
+            jit_threshold=64,
+            insn_cache_store_tracking=True,
+            insn_page_bits=None):
 
         super().__init__(parent, name)
 
@@ -127,6 +159,8 @@ class RiscvCommon(st.Component):
                 "cpu/iss/src/regfile.cpp",
                 "cpu/iss/src/resource.cpp",
                 "cpu/iss/src/trace.cpp",
+                "cpu/iss/src/debug_info.cpp",
+                "cpu/iss/src/profiler.cpp",
                 "cpu/iss/src/syscalls.cpp",
                 "cpu/iss/src/htif.cpp",
                 "cpu/iss/src/memcheck.cpp",
@@ -154,7 +188,14 @@ class RiscvCommon(st.Component):
             'fetch_enable': fetch_enable,
             'boot_addr': boot_addr,
             'has_double': isa.has_isa('rvd'),
-            'memcheck': { 'nb_memories': memcheck_nb_memory }
+            'memcheck': { 'nb_memories': memcheck_nb_memory },
+            'batch_insns': batch_insns,
+            'batch_quantum': batch_quantum,
+            'jit': jit,
+            'jit_threshold': jit_threshold,
+            'insn_cache_store_tracking': insn_cache_store_tracking,
+            'profiler': { 'enabled': False, 'format': 'callgrind' },
+            'console_flush': 'always',
         })
 
         fp_size = 64 if isa.has_isa('rvd') else 32
@@ -169,6 +210,9 @@ class RiscvCommon(st.Component):
             })
 
 
+        if insn_page_bits is not None:
+            self.add_c_flags([f'-DCONFIG_GVSOC_ISS_INSN_PAGE_BITS={insn_page_bits}'])
+
         if cflags is not None:
             self.add_c_flags(cflags)
 
@@ -213,6 +257,10 @@ class RiscvCommon(st.Component):
         if htif:
             self.add_c_flags(['-DCONFIG_GVSOC_ISS_HTIF=1'])
 
+            # tohost is checked when the core writes it, unless polling is enabled, in which
+            # case it is read periodically
+            self.add_property('htif_polling', False)
+
 
             for binary in binaries:
                 binary_info = binaries_info.get(binary)
@@ -237,7 +285,7 @@ class RiscvCommon(st.Component):
                     tohost_addr, fromhost_addr = binary_info
 
                 if fromhost_addr is not None:
-                    self.add_property('htif_tohost', f'0x{fromhost_addr:x}')
+                    self.add_property('htif_fromhost', f'0x{fromhost_addr:x}')
 
                 if tohost_addr is not None:
                     self.add_property('htif_tohost', f'0x{tohost_addr:x}')
@@ -20,10 +20,14 @@
  */
 
 #include "cpu/iss/include/iss.hpp"
+#include "cpu/iss/include/isa_lib/int.h"
 
 Csr::Csr(Iss &iss)
     : iss(iss)
 {
+    memset(this->regs, 0, sizeof(this->regs));
+    memset(this->flags, 0, sizeof(this->flags));
+
     // Unprivileged Counter/Timers
     this->declare_csr(&this->cycle,  "cycle",   0xC00); this->cycle.write_illegal = true;
     this->declare_csr(&this->time,     "time",      0xC01);
@@ -108,6 +112,31 @@ Csr::Csr(Iss &iss)
         this->declare_csr(&this->pmpaddr[i],  "pmpaddr" + std::to_string(i),  0x3B0 + i);
     }
 #endif
+
+    // Interrupt enables, pending interrupts and delegation
+    for (iss_reg_t address: {0x100, 0x104, 0x144, 0x300, 0x303, 0x304, 0x344})
+    {
+        this->set_flags(address, CSR_FLAG_FULL_MODE);
+    }
+    // Address translation and ISA
+    this->set_flags(0x180, CSR_FLAG_FULL_MODE);
+    this->set_flags(0x301, CSR_FLAG_FULL_MODE);
+    // Triggers and debug mode, step mode is checked by the full handler
+    for (iss_reg_t address: {0x7A0, 0x7A1, 0x7A2, 0x7A3, 0x7B0})
+    {
+        this->set_flags(address, CSR_FLAG_FULL_MODE);
+    }
+#if defined(ISS_HAS_PERF_COUNTERS)
+    // Performance counters are only incremented by the full handler
+    this->set_flags(CSR_PCER, CSR_FLAG_FULL_MODE);
+    this->set_flags(CSR_PCMR, CSR_FLAG_FULL_MODE);
+#endif
+#if defined(CONFIG_GVSOC_ISS_RI5KY)
+    for (iss_reg_t address=CSR_HWLOOP0_START; address<=CSR_HWLOOP1_COUNTER; address++)
+    {
+        this->set_flags(address, CSR_FLAG_FULL_MODE);
+    }
+#endif
 }
 
 void Csr::reset(bool active)
@@ -123,13 +152,14 @@ void Csr::reset(bool active)
     #endif
         this->stack_conf = 0;
         this->dcsr = 4 << 28;
+        lib_ff_flags_sync();
         this->fcsr.raw = 0;
 
-        for (auto reg: this->regs)
+        for (CsrAbtractReg *reg: this->regs)
         {
-            if (reg.second)
+            if (reg)
             {
-                reg.second->reset(active);
+                reg->reset(active);
             }
         }
 
@@ -151,10 +181,19 @@ void Csr::declare_pcer(int index, std::string name, std::string help)
     this->iss.syscalls.pcer_info[index].help = help;
 }
 
+static void lib_ff_flags_flush()
+{
+    lib_ff_flags_sync();
+}
+
 void Csr::build()
 {
     iss.top.traces.new_trace("csr", &this->trace, vp::DEBUG);
 
+    // FP exceptions accumulated in the host FPU must be merged by the thread which executed
+    // the instructions, before other threads can look at fflags
+    vp::TimeEngine::thread_flush_register(&lib_ff_flags_flush);
+
     this->declare_pcer(CSR_PCER_CYCLES, "Cycles", "Count the number of cycles the core was running");
     this->declare_pcer(CSR_PCER_INSTR, "instr", "Count the number of instructions executed");
     this->declare_pcer(CSR_PCER_LD_STALL, "ld_stall", "Number of load use hazards");
@@ -336,12 +375,15 @@ static bool uip_write(Iss *iss, unsigned int value)
 
 static bool fflags_read(Iss *iss, iss_reg_t *value)
 {
+    // Get the exceptions of the last FP operations which are still pending in the host
+    lib_ff_flags_sync();
     *value = iss->csr.fcsr.fflags;
     return false;
 }
 
 static bool fflags_write(Iss *iss, unsigned int value)
 {
+    lib_ff_flags_sync();
     iss->csr.fcsr.fflags = value;
     return false;
 }
@@ -360,12 +402,14 @@ static bool frm_write(Iss *iss, unsigned int value)
 
 static bool fcsr_read(Iss *iss, iss_reg_t *value)
 {
+    lib_ff_flags_sync();
     *value = iss->csr.fcsr.raw;
     return false;
 }
 
 static bool fcsr_write(Iss *iss, unsigned int value)
 {
+    lib_ff_flags_sync();
     iss->csr.fcsr.raw = value & 0xff;
     return false;
 }
@@ -856,8 +900,11 @@ bool iss_csr_read(Iss *iss, iss_reg_t reg, iss_reg_t *value)
 {
     bool status = true;
 
-    iss->csr.trace.msg("Reading CSR (reg: 0x%x, name: %s)\n",
-        reg, iss_csr_name(iss, reg).c_str());
+    if (iss->csr.trace.get_active())
+    {
+        iss->csr.trace.msg("Reading CSR (reg: 0x%x, name: %s)\n",
+            reg, iss_csr_name(iss, reg).c_str());
+    }
 
 #if 0
   // First check permissions
@@ -1248,12 +1295,18 @@ bool iss_csr_read(Iss *iss, iss_reg_t reg, iss_reg_t *value)
 
 bool iss_csr_write(Iss *iss, iss_reg_t reg, iss_reg_t value)
 {
-    iss->csr.trace.msg("Writing CSR (reg: 0x%x, name: %s, value: 0x%x)\n",
-        reg, iss_csr_name(iss, reg).c_str(), value);
+    if (iss->csr.trace.get_active())
+    {
+        iss->csr.trace.msg("Writing CSR (reg: 0x%x, name: %s, value: 0x%x)\n",
+            reg, iss_csr_name(iss, reg).c_str(), value);
+    }
 
-    // If there is any write to a CSR, switch to full check instruction handler
-    // in case something special happened (like HW counting become active)
-    iss->exec.switch_to_full_mode();
+    // Switch to full check instruction handler only if the CSR may change something it checks,
+    // like HW counting becoming active or an interrupt being enabled
+    if (iss->csr.get_flags(reg) & CSR_FLAG_FULL_MODE)
+    {
+        iss->exec.switch_to_full_mode();
+    }
 
 #if 0
   // First check permissions
@@ -1740,7 +1793,14 @@ void CsrAbtractReg::register_callback(std::function<bool(bool, iss_reg_t &)> cal
 void Csr::declare_csr(CsrAbtractReg *reg, std::string name, iss_reg_t address, iss_reg_t reset_val,
     iss_reg_t write_mask)
 {
-    if (this->regs.find(address) != this->regs.end())
+    if (address >= ISS_NB_CSRS)
+    {
+        this->trace.force_warning("Registering CSR at invalid address (name: %s, address: 0x%x)\n",
+            name.c_str(), address);
+        return;
+    }
+
+    if (this->regs[address] != NULL)
     {
         this->trace.force_warning("Registering CSR at already occupied address (name: %s, address: 0x%x)\n",
             name.c_str(), address);
@@ -1753,9 +1813,9 @@ void Csr::declare_csr(CsrAbtractReg *reg, std::string name, iss_reg_t address, i
     reg->reset_val = reset_val;
 }
 
-CsrAbtractReg *Csr::get_csr(iss_reg_t address)
+void Csr::set_flags(iss_reg_t address, uint8_t flags)
 {
-    return this->regs[address];
+    this->flags[address] = flags;
 }
 
 bool Csr::access(bool is_write, iss_reg_t address, iss_reg_t &value)
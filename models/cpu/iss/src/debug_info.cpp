@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include "cpu/iss/include/debug_info.hpp"
+
+#define DEBUG_INFO_MAGIC "GVDBGIDX"
+#define DEBUG_INFO_VERSION 1
+
+// Addresses are merged into the same range if they are at most this far apart, which is the
+// biggest instruction size
+#define DEBUG_INFO_MAX_GAP 4
+
+// Header of the index file, followed by the ranges and the strings
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t nb_ranges;
+    uint64_t strings_size;
+    // Size and modification time of the text file the index was built from
+    uint64_t source_size;
+    int64_t source_mtime;
+} debug_info_header_t;
+
+static bool debug_info_source_stat(std::string path, uint64_t *size, int64_t *mtime)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+    {
+        return false;
+    }
+    *size = st.st_size;
+    *mtime = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+    return true;
+}
+
+std::shared_ptr<DebugInfo> DebugInfo::get(std::string path)
+{
+    static std::map<std::string, std::weak_ptr<DebugInfo>> indexes;
+
+    std::shared_ptr<DebugInfo> index = indexes[path].lock();
+    if (index == NULL)
+    {
+        index = std::make_shared<DebugInfo>();
+        std::string index_path = path + ".index";
+
+        if (!index->load(path, index_path) && !index->build(path, index_path))
+        {
+            return NULL;
+        }
+
+        indexes[path] = index;
+    }
+
+    return index;
+}
+
+DebugInfo::~DebugInfo()
+{
+    if (this->map)
+    {
+        munmap(this->map, this->map_size);
+    }
+}
+
+const debug_info_range_t *DebugInfo::find(uint64_t addr)
+{
+    const debug_info_range_t *end = this->ranges + this->nb_ranges;
+    const debug_info_range_t *range = std::upper_bound(this->ranges, end, addr,
+        [](uint64_t addr, const debug_info_range_t &range) { return addr < range.base; });
+
+    if (range == this->ranges || addr >= (range - 1)->end)
+    {
+        return NULL;
+    }
+
+    return range - 1;
+}
+
+bool DebugInfo::load(std::string path, std::string index_path)
+{
+    uint64_t source_size;
+    int64_t source_mtime;
+    if (!debug_info_source_stat(path, &source_size, &source_mtime))
+    {
+        return false;
+    }
+
+    int fd = open(index_path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(debug_info_header_t))
+    {
+        map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        return false;
+    }
+
+    // Only keep the index if it was built from the current text file and is consistent
+    debug_info_header_t *header = (debug_info_header_t *)map;
+    uint64_t ranges_size = (uint64_t)header->nb_ranges * sizeof(debug_info_range_t);
+    const char *strings = (const char *)map + sizeof(debug_info_header_t) + ranges_size;
+    bool valid = memcmp(header->magic, DEBUG_INFO_MAGIC, sizeof(header->magic)) == 0 &&
+        header->version == DEBUG_INFO_VERSION &&
+        header->source_size == source_size && header->source_mtime == source_mtime &&
+        header->strings_size > 0 &&
+        sizeof(debug_info_header_t) + ranges_size + header->strings_size == (uint64_t)st.st_size &&
+        strings[header->strings_size - 1] == 0;
+
+    const debug_info_range_t *ranges = (const debug_info_range_t *)(header + 1);
+    for (uint32_t i = 0; valid && i < header->nb_ranges; i++)
+    {
+        valid = ranges[i].func < header->strings_size &&
+            ranges[i].inline_func < header->strings_size &&
+            ranges[i].file < header->strings_size &&
+            (i == 0 || ranges[i].base >= ranges[i - 1].end);
+    }
+
+    if (!valid)
+    {
+        munmap(map, st.st_size);
+        return false;
+    }
+
+    this->map = map;
+    this->map_size = st.st_size;
+    this->ranges = ranges;
+    this->nb_ranges = header->nb_ranges;
+    this->strings = strings;
+
+    return true;
+}
+
+bool DebugInfo::build(std::string path, std::string index_path)
+{
+    debug_info_header_t header = {};
+    if (!debug_info_source_stat(path, &header.source_size, &header.source_mtime))
+    {
+        return false;
+    }
+
+    FILE *file = fopen(path.c_str(), "r");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    std::string content(header.source_size, 0);
+    content.resize(fread(&content[0], 1, content.size(), file));
+    fclose(file);
+
+    // Each line is made of the address, the function, the inline function, the file and the
+    // line, separated by spaces
+    std::string strings;
+    std::unordered_map<std::string, uint32_t> string_offsets;
+    auto get_string = [&](std::string str) {
+        auto it = string_offsets.find(str);
+        if (it != string_offsets.end())
+        {
+            return it->second;
+        }
+        uint32_t offset = strings.size();
+        strings.append(str.c_str(), str.size() + 1);
+        string_offsets[str] = offset;
+        return offset;
+    };
+
+    std::vector<debug_info_range_t> entries;
+    size_t pos = 0;
+    while (pos < content.size())
+    {
+        size_t line_end = content.find('\n', pos);
+        if (line_end == std::string::npos)
+        {
+            line_end = content.size();
+        }
+
+        std::vector<std::string> tokens;
+        size_t current = pos;
+        while (current < line_end && tokens.size() <= 5)
+        {
+            size_t token_end = content.find(' ', current);
+            if (token_end == std::string::npos || token_end > line_end)
+            {
+                token_end = line_end;
+            }
+            if (token_end != current)
+            {
+                tokens.push_back(content.substr(current, token_end - current));
+            }
+            current = token_end + 1;
+        }
+
+        if (tokens.size() == 5)
+        {
+            debug_info_range_t entry;
+            entry.base = strtoull(tokens[0].c_str(), NULL, 16);
+            entry.end = entry.base + 1;
+            entry.func = get_string(tokens[1]);
+            entry.inline_func = get_string(tokens[2]);
+            entry.file = get_string(tokens[3]);
+            entry.line = atoi(tokens[4].c_str());
+            entries.push_back(entry);
+        }
+
+        pos = line_end + 1;
+    }
+
+    // The last information given for an address is the one which is kept
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const debug_info_range_t &a, const debug_info_range_t &b) { return a.base < b.base; });
+
+    std::vector<debug_info_range_t> ranges;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (i + 1 < entries.size() && entries[i + 1].base == entries[i].base)
+        {
+            continue;
+        }
+
+        debug_info_range_t *entry = &entries[i];
+        debug_info_range_t *last = ranges.size() ? &ranges.back() : NULL;
+        if (last && entry->base - (last->end - 1) <= DEBUG_INFO_MAX_GAP &&
+            entry->func == last->func && entry->inline_func == last->inline_func &&
+            entry->file == last->file && entry->line == last->line)
+        {
+            last->end = entry->end;
+        }
+        else
+        {
+            ranges.push_back(*entry);
+        }
+    }
+
+    if (strings.size() == 0)
+    {
+        strings.push_back(0);
+    }
+
+    memcpy(header.magic, DEBUG_INFO_MAGIC, sizeof(header.magic));
+    header.version = DEBUG_INFO_VERSION;
+    header.nb_ranges = ranges.size();
+    header.strings_size = strings.size();
+
+    size_t ranges_size = ranges.size() * sizeof(debug_info_range_t);
+    this->buffer.resize(sizeof(header) + ranges_size + strings.size());
+    memcpy(this->buffer.data(), &header, sizeof(header));
+    memcpy(this->buffer.data() + sizeof(header), ranges.data(), ranges_size);
+    memcpy(this->buffer.data() + sizeof(header) + ranges_size, strings.data(), strings.size());
+
+    this->ranges = (const debug_info_range_t *)(this->buffer.data() + sizeof(header));
+    this->nb_ranges = ranges.size();
+    this->strings = (const char *)this->buffer.data() + sizeof(header) + ranges_size;
+
+    // Save the index for the next runs. This is written to a temporary file first so that
+    // simulations running in parallel never see a partial index. Failing to save it is not an
+    // error, it is just built again next time.
+    std::string tmp_path = index_path + "." + std::to_string(getpid());
+    FILE *index_file = fopen(tmp_path.c_str(), "w");
+    if (index_file != NULL)
+    {
+        bool written = fwrite(this->buffer.data(), 1, this->buffer.size(), index_file) ==
+            this->buffer.size();
+        written = fclose(index_file) == 0 && written;
+        if (!written || rename(tmp_path.c_str(), index_path.c_str()) != 0)
+        {
+            unlink(tmp_path.c_str());
+        }
+    }
+
+    return true;
+}
@@ -31,8 +31,16 @@ Decode::Decode(Iss &iss)
 void Decode::build()
 {
     iss.top.traces.new_trace("decoder", &this->trace, vp::DEBUG);
+    this->nb_decoded_insns = 0;
+    this->nb_group_lookups = 0;
+    iss.top.traces.new_trace_event("decoder/decoded_insns", &this->decoded_insns_event, 64);
+    iss.top.traces.new_trace_event("decoder/group_lookups", &this->group_lookups_event, 64);
     this->flush_cache_itf.set_sync_meth(&Decode::flush_cache_sync);
     this->iss.top.new_slave_port("flush_cache", &this->flush_cache_itf, (vp::Block *)this);
+    this->flush_cache_line_itf.set_sync_meth(&Decode::flush_cache_line_sync);
+    this->iss.top.new_slave_port("flush_cache_line", &this->flush_cache_line_itf, (vp::Block *)this);
+    this->flush_cache_line_addr_itf.set_sync_meth(&Decode::flush_cache_line_addr_sync);
+    this->iss.top.new_slave_port("flush_cache_line_addr", &this->flush_cache_line_addr_itf, (vp::Block *)this);
     string isa = this->iss.top.get_js_config()->get_child_str("isa");
     this->isa = strdup(isa.c_str());
     this->has_double = this->iss.top.get_js_config()->get_child_bool("has_double");
@@ -84,22 +92,82 @@ int Decode::decode_info(iss_insn_t *insn, iss_opcode_t opcode, iss_decoder_arg_i
     return 0;
 }
 
+void Decode::decode_arg(iss_insn_t *insn, iss_opcode_t opcode, iss_decoder_arg_t *darg, iss_insn_arg_t *arg)
+{
+    arg->type = darg->type;
+    arg->flags = darg->flags;
+
+    switch (darg->type)
+    {
+    case ISS_DECODER_ARG_TYPE_IN_REG:
+    case ISS_DECODER_ARG_TYPE_OUT_REG:
+        arg->u.reg.index = this->decode_info(insn, opcode, &darg->u.reg.info, false);
+        if (darg->flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
+            arg->u.reg.index += 8;
+        break;
+
+    case ISS_DECODER_ARG_TYPE_UIMM:
+        arg->u.uim.value = this->decode_ranges(opcode, &darg->u.uimm.info.u.range_set, darg->u.uimm.is_signed);
+        break;
+
+    case ISS_DECODER_ARG_TYPE_SIMM:
+        arg->u.sim.value = this->decode_ranges(opcode, &darg->u.simm.info.u.range_set, darg->u.simm.is_signed);
+        break;
+
+    case ISS_DECODER_ARG_TYPE_INDIRECT_IMM:
+        arg->u.indirect_imm.reg_index = this->decode_info(insn, opcode, &darg->u.indirect_imm.reg.info, false);
+        if (darg->u.indirect_imm.reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
+            arg->u.indirect_imm.reg_index += 8;
+        arg->u.indirect_imm.imm = this->decode_info(insn, opcode, &darg->u.indirect_imm.imm.info, darg->u.indirect_imm.imm.is_signed);
+        break;
+
+    case ISS_DECODER_ARG_TYPE_INDIRECT_REG:
+        arg->u.indirect_reg.base_reg_index = this->decode_info(insn, opcode, &darg->u.indirect_reg.base_reg.info, false);
+        if (darg->u.indirect_reg.base_reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
+            arg->u.indirect_reg.base_reg_index += 8;
+        arg->u.indirect_reg.offset_reg_index = this->decode_info(insn, opcode, &darg->u.indirect_reg.offset_reg.info, false);
+        if (darg->u.indirect_reg.offset_reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
+            arg->u.indirect_reg.offset_reg_index += 8;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void Decode::decode_args(iss_insn_t *insn, iss_insn_arg_t *args)
+{
+    iss_decoder_item_t *item = insn->cold->decoder_item;
+
+    for (int i = 0; i < item->u.insn.nb_args; i++)
+    {
+        this->decode_arg(insn, insn->opcode, &item->u.insn.args[i], &args[i]);
+    }
+}
+
 int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss_decoder_item_t *item)
 {
     if (!item->is_active)
         return -1;
 
-    insn->desc = &item->u.insn;
-    insn->expand_table = NULL;
+    // The debug record is only allocated when one of its fields is needed, the arguments are
+    // then decoded into it, otherwise in a scratch area only used to fill the instruction fields
+    if (insn->cold->debug)
+    {
+        insn->cold->debug->trace_desc = -1;
+    }
+
+    insn->cold->desc = &item->u.insn;
+    insn->cold->expand_table = NULL;
     insn->latency = 0;
-    insn->resource_id = item->u.insn.resource_id;
-    insn->resource_latency = item->u.insn.resource_latency;
-    insn->resource_bandwidth = item->u.insn.resource_bandwidth;
+    insn->cold->resource_id = item->u.insn.resource_id;
+    insn->cold->resource_latency = item->u.insn.resource_latency;
+    insn->cold->resource_bandwidth = item->u.insn.resource_bandwidth;
 
-    insn->decoder_item = item;
+    insn->cold->decoder_item = item;
     insn->size = item->u.insn.size;
-    insn->nb_out_reg = 0;
-    insn->nb_in_reg = 0;
+    insn->cold->nb_out_reg = 0;
+    insn->cold->nb_in_reg = 0;
     insn->latency = item->u.insn.latency;
 
     for (int i = 0; i < item->u.insn.nb_args; i++)
@@ -111,23 +179,17 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
     for (int i = 0; i < item->u.insn.nb_args; i++)
     {
         iss_decoder_arg_t *darg = &item->u.insn.args[i];
-        iss_insn_arg_t *arg = &insn->args[i];
-        arg->type = darg->type;
-        arg->flags = darg->flags;
+        iss_insn_arg_t *arg = insn->cold->debug ? &insn->cold->debug->args[i] : &this->args[i];
+        this->decode_arg(insn, opcode, darg, arg);
 
         switch (darg->type)
         {
         case ISS_DECODER_ARG_TYPE_IN_REG:
         case ISS_DECODER_ARG_TYPE_OUT_REG:
-            arg->u.reg.index = this->decode_info(insn, opcode, &darg->u.reg.info, false);
-
-            if (darg->flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
-                arg->u.reg.index += 8;
-
             if (darg->type == ISS_DECODER_ARG_TYPE_IN_REG)
             {
-                if (darg->u.reg.id >= insn->nb_in_reg)
-                    insn->nb_in_reg = darg->u.reg.id + 1;
+                if (darg->u.reg.id >= insn->cold->nb_in_reg)
+                    insn->cold->nb_in_reg = darg->u.reg.id + 1;
 
                 insn->in_regs[darg->u.reg.id] = arg->u.reg.index;
 
@@ -142,8 +204,8 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
             }
             else
             {
-                if (darg->u.reg.id >= insn->nb_out_reg)
-                    insn->nb_out_reg = darg->u.reg.id + 1;
+                if (darg->u.reg.id >= insn->cold->nb_out_reg)
+                    insn->cold->nb_out_reg = darg->u.reg.id + 1;
 
 #ifdef ISS_SINGLE_REGFILE
                 if (arg->u.reg.index == 0)
@@ -192,8 +254,8 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
                 // If no dependency was found, apply the one for the pipeline stages
                 if (darg->u.reg.latency != 0)
                 {
-                    insn->stall_handler = insn->handler;
-                    insn->stall_fast_handler = insn->fast_handler;
+                    insn->cold->stall_handler = insn->handler;
+                    insn->cold->stall_fast_handler = insn->fast_handler;
                     insn->handler = this->iss.exec.insn_stalled_callback_get();
                     insn->fast_handler = this->iss.exec.insn_stalled_fast_callback_get();
                 }
@@ -203,43 +265,31 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
             break;
 
         case ISS_DECODER_ARG_TYPE_UIMM:
-            arg->u.uim.value = this->decode_ranges(opcode, &darg->u.uimm.info.u.range_set, darg->u.uimm.is_signed);
             insn->uim[darg->u.uimm.id] = arg->u.uim.value;
             break;
 
         case ISS_DECODER_ARG_TYPE_SIMM:
-            arg->u.sim.value = this->decode_ranges(opcode, &darg->u.simm.info.u.range_set, darg->u.simm.is_signed);
             insn->sim[darg->u.simm.id] = arg->u.sim.value;
             break;
 
         case ISS_DECODER_ARG_TYPE_INDIRECT_IMM:
-            arg->u.indirect_imm.reg_index = this->decode_info(insn, opcode, &darg->u.indirect_imm.reg.info, false);
-            if (darg->u.indirect_imm.reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
-                arg->u.indirect_imm.reg_index += 8;
             insn->in_regs[darg->u.indirect_imm.reg.id] = arg->u.indirect_imm.reg_index;
             insn->in_regs_ref[darg->u.indirect_imm.reg.id] = this->iss.regfile.reg_ref(arg->u.indirect_imm.reg_index);
-            if (darg->u.indirect_imm.reg.id >= insn->nb_in_reg)
-                insn->nb_in_reg = darg->u.indirect_imm.reg.id + 1;
-            arg->u.indirect_imm.imm = this->decode_info(insn, opcode, &darg->u.indirect_imm.imm.info, darg->u.indirect_imm.imm.is_signed);
+            if (darg->u.indirect_imm.reg.id >= insn->cold->nb_in_reg)
+                insn->cold->nb_in_reg = darg->u.indirect_imm.reg.id + 1;
             insn->sim[darg->u.indirect_imm.imm.id] = arg->u.indirect_imm.imm;
             break;
 
         case ISS_DECODER_ARG_TYPE_INDIRECT_REG:
-            arg->u.indirect_reg.base_reg_index = this->decode_info(insn, opcode, &darg->u.indirect_reg.base_reg.info, false);
-            if (darg->u.indirect_reg.base_reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
-                arg->u.indirect_reg.base_reg_index += 8;
             insn->in_regs[darg->u.indirect_reg.base_reg.id] = arg->u.indirect_reg.base_reg_index;
             insn->in_regs_ref[darg->u.indirect_reg.base_reg.id] = this->iss.regfile.reg_ref(arg->u.indirect_reg.base_reg_index);
-            if (darg->u.indirect_reg.base_reg.id >= insn->nb_in_reg)
-                insn->nb_in_reg = darg->u.indirect_reg.base_reg.id + 1;
+            if (darg->u.indirect_reg.base_reg.id >= insn->cold->nb_in_reg)
+                insn->cold->nb_in_reg = darg->u.indirect_reg.base_reg.id + 1;
 
-            arg->u.indirect_reg.offset_reg_index = this->decode_info(insn, opcode, &darg->u.indirect_reg.offset_reg.info, false);
-            if (darg->u.indirect_reg.offset_reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
-                arg->u.indirect_reg.offset_reg_index += 8;
             insn->in_regs[darg->u.indirect_reg.offset_reg.id] = arg->u.indirect_reg.offset_reg_index;
             insn->in_regs_ref[darg->u.indirect_reg.offset_reg.id] = this->iss.regfile.reg_ref(arg->u.indirect_reg.offset_reg_index);
-            if (darg->u.indirect_reg.offset_reg.id >= insn->nb_in_reg)
-                insn->nb_in_reg = darg->u.indirect_reg.offset_reg.id + 1;
+            if (darg->u.indirect_reg.offset_reg.id >= insn->cold->nb_in_reg)
+                insn->cold->nb_in_reg = darg->u.indirect_reg.offset_reg.id + 1;
 
             break;
 
@@ -252,10 +302,10 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
     insn->handler = item->u.insn.handler;
 
 #if defined(CONFIG_GVSOC_ISS_RI5KY)
-    if (insn->hwloop_handler != NULL)
+    if (insn->cold->hwloop_handler != NULL)
     {
-        iss_reg_t (*hwloop_handler)(Iss *, iss_insn_t *, iss_reg_t pc) = insn->hwloop_handler;
-        insn->hwloop_handler = insn->handler;
+        iss_reg_t (*hwloop_handler)(Iss *, iss_insn_t *, iss_reg_t pc) = insn->cold->hwloop_handler;
+        insn->cold->hwloop_handler = insn->handler;
         insn->handler = hwloop_handler;
         insn->fast_handler = hwloop_handler;
     }
@@ -267,13 +317,13 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
 #if defined(CONFIG_GVSOC_ISS_TIMED)
     if (item->u.insn.resource_id != -1)
     {
-        insn->resource_handler = insn->handler;
+        insn->cold->resource_handler = insn->handler;
         insn->fast_handler = iss_resource_offload;
         insn->handler = iss_resource_offload;
     }
 #endif
 
-    insn->is_macro_op = item->u.insn.is_macro_op;
+    insn->cold->is_macro_op = item->u.insn.is_macro_op;
 
     if (item->u.insn.decode != NULL)
     {
@@ -283,8 +333,8 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
 #if defined(CONFIG_GVSOC_ISS_TIMED)
     if (insn->latency)
     {
-        insn->stall_handler = insn->handler;
-        insn->stall_fast_handler = insn->fast_handler;
+        insn->cold->stall_handler = insn->handler;
+        insn->cold->stall_fast_handler = insn->fast_handler;
         insn->handler = this->iss.exec.insn_stalled_callback_get();
         insn->fast_handler = this->iss.exec.insn_stalled_fast_callback_get();
     }
@@ -295,22 +345,10 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
 
 int Decode::decode_opcode_group(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss_decoder_item_t *item)
 {
-    iss_opcode_t group_opcode = (opcode >> item->u.group.bit) & ((1ULL << item->u.group.width) - 1);
-    iss_decoder_item_t *group_item_other = NULL;
-
-    for (int i = 0; i < item->u.group.nb_groups; i++)
-    {
-        iss_decoder_item_t *group_item = item->u.group.groups[i];
-        if (group_opcode == group_item->opcode && !group_item->opcode_others)
-        {
-            return this->decode_item(insn, pc, opcode, group_item);
-        }
-        if (group_item->opcode_others)
-            group_item_other = group_item;
-    }
+    iss_decoder_item_t *group_item = iss_decoder_group_get(item, opcode, this->nb_group_lookups);
 
-    if (group_item_other)
-        return this->decode_item(insn, pc, opcode, group_item_other);
+    if (group_item)
+        return this->decode_item(insn, pc, opcode, group_item);
 
     return -1;
 }
@@ -352,7 +390,27 @@ void Decode::decode_pc(iss_insn_t *insn, iss_reg_t pc)
 
     this->trace.msg("Got opcode (opcode: 0x%lx)\n", opcode);
 
-    if (this->decode_opcode(insn, pc, opcode))
+    bool trace_active = iss.trace.insn_trace.get_active() || iss.timing.insn_trace_event.get_event_active();
+
+    // Instruction traces dump the decoded arguments, which are only kept in the debug record
+    if (trace_active)
+    {
+        this->iss.insn_cache.insn_debug_get(insn);
+    }
+
+    int error = this->decode_opcode(insn, pc, opcode);
+
+    this->nb_decoded_insns++;
+    if (this->decoded_insns_event.get_event_active())
+    {
+        this->decoded_insns_event.event((uint8_t *)&this->nb_decoded_insns);
+    }
+    if (this->group_lookups_event.get_event_active())
+    {
+        this->group_lookups_event.event((uint8_t *)&this->nb_group_lookups);
+    }
+
+    if (error)
     {
         this->trace.msg("Unknown instruction\n");
         insn->handler = iss_exec_insn_illegal;
@@ -362,9 +420,9 @@ void Decode::decode_pc(iss_insn_t *insn, iss_reg_t pc)
 
     insn->opcode = opcode;
 
-    if (iss.trace.insn_trace.get_active() || iss.timing.insn_trace_event.get_event_active())
+    if (trace_active)
     {
-        insn->saved_handler = insn->handler;
+        insn->cold->saved_handler = insn->handler;
         insn->handler = this->iss.exec.insn_trace_callback_get();
         insn->fast_handler = this->iss.exec.insn_trace_callback_get();
     }
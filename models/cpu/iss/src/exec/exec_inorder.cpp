@@ -72,6 +72,16 @@ void Exec::build()
 
     this->bootaddr_offset = this->iss.top.get_js_config()->get_child_int("bootaddr_offset");
 
+    this->batch_insns = this->iss.top.get_js_config()->get_child_int("batch_insns");
+    this->batch_quantum = this->iss.top.get_js_config()->get_child_int("batch_quantum");
+    this->batch_cycles = 0;
+    this->batch_stop = false;
+    if (this->batch_insns > 1)
+    {
+        this->trace.msg(vp::Trace::LEVEL_INFO, "Enabling temporal decoupling (batch_insns: %ld, batch_quantum: %ld)\n",
+            this->batch_insns, this->batch_quantum);
+    }
+
 
     this->current_insn = 0;
     this->stall_insn = 0;
@@ -98,6 +108,7 @@ void Exec::reset(bool active)
         this->irq_locked = 0;
         this->insn_on_hold = false;
         this->stall_cycles = 0;
+        this->batch_cycles = 0;
         this->cache_sync = false;
 
         // Always increase the stall when reset is asserted since stall count is set to 0
@@ -129,9 +140,14 @@ void Exec::icache_flush()
         this->flush_cache_req_itf.sync(true);
     }
 
-    // Delay the flush to the next instruction in case we are in the middle of an instruction
-    this->pending_flush = true;
-    this->switch_to_full_mode();
+    // The whole cache is only flushed if store tracking is disabled, otherwise the writers of
+    // code have already invalidated the decoded instructions they modified
+    if (this->iss.insn_cache.full_flush)
+    {
+        // Delay the flush to the next instruction in case we are in the middle of an instruction
+        this->pending_flush = true;
+        this->switch_to_full_mode();
+    }
 }
 
 #include <unistd.h>
@@ -182,6 +198,11 @@ void Exec::exec_instr(vp::Block *__this, vp::ClockEvent *event)
         // Execute the instruction and replace the current one with the new one
         iss->exec.current_insn = insn->fast_handler(iss, insn, pc);
 
+        if (unlikely(iss->profiler.active))
+        {
+            iss->profiler.insn_exec(insn, pc, iss->exec.current_insn);
+        }
+
         // Since power instruction information is filled when the instruction is decoded,
         // make sure we account it only after the instruction is executed
         iss->exec.insn_exec_power(insn);
@@ -192,6 +213,174 @@ void Exec::exec_instr(vp::Block *__this, vp::ClockEvent *event)
 }
 
 
+
+void Exec::exec_instr_batch(vp::Block *__this, vp::ClockEvent *event)
+{
+    Iss *const iss = (Iss *)__this;
+    Exec *_this = &iss->exec;
+
+    if (_this->handle_stall_cycles()) return;
+
+    _this->trace.msg(vp::Trace::LEVEL_TRACE, "Handling instruction batch with fast handler\n");
+
+    _this->batch_stop = false;
+
+    int64_t nb_insns = 0;
+    iss_reg_t pc = _this->current_insn;
+    InsnBlock *block = NULL;
+
+#if defined(ISS_HAS_JIT)
+    // Translated code does not go through the per-instruction profiling and power accounting,
+    // only use it when they are not active
+    bool jit_active = iss->insn_cache.jit_enabled && !_this->insn_exec_profiling_active() &&
+        !iss->top.power.get_power_trace()->get_active();
+    // Instructions of this batch executed through translated code
+    int64_t nb_jit_insns = 0;
+#endif
+
+    // Instructions are executed through translated blocks, so that straight-line code and loops
+    // run without any instruction cache lookup. Each iteration of this loop executes one block,
+    // and fills it if it is executed for the first time.
+    while (1)
+    {
+        block = iss->insn_cache.block_get(block, pc);
+
+#if defined(ISS_HAS_JIT)
+        // The JIT gets disabled if its code buffer could not be protected while translating
+        if (unlikely(iss->insn_cache.block_jit_check(block)))
+        {
+            jit_active = jit_active && iss->insn_cache.jit_enabled;
+        }
+#endif
+
+        for (int i=0; ; i++)
+        {
+            iss_insn_t *insn;
+
+#if defined(CONFIG_GVSOC_ISS_TIMED)
+            if (!iss->prefetcher.fetch(pc)) goto end;
+#endif
+
+            if (likely(i < block->nb_insns))
+            {
+#if defined(ISS_HAS_JIT)
+                if (block->jit_runs && jit_active)
+                {
+                    InsnJitRun *run = &block->jit_runs[i];
+
+                    // Only execute the run if it does not go beyond the end of the batch
+                    if (run->code != NULL && nb_insns + run->nb_insns < _this->batch_insns &&
+                        (_this->batch_quantum == 0 ||
+                         _this->batch_cycles + _this->stall_cycles + run->nb_insns < _this->batch_quantum))
+                    {
+                        _this->batch_cycles += nb_insns > 0 ? run->nb_insns : run->nb_insns - 1;
+                        run->code(iss->regfile.regs);
+                        nb_insns += run->nb_insns;
+                        nb_jit_insns += run->nb_insns;
+                        pc += run->size;
+                        _this->current_insn = pc;
+                        // The loop increment will skip the last instruction of the run
+                        i += run->nb_insns - 1;
+                        continue;
+                    }
+                }
+#endif
+                insn = block->insns[i];
+            }
+            else
+            {
+                if (block->complete)
+                {
+                    // Continue with the next block
+                    break;
+                }
+
+                if (block->nb_insns == INSN_BLOCK_MAX_INSNS ||
+                    (pc >> INSN_PAGE_BITS) != (block->pc >> INSN_PAGE_BITS))
+                {
+                    block->complete = true;
+                    break;
+                }
+
+                iss_reg_t index;
+                insn = iss->insn_cache.get_insn(pc, index);
+                if (insn == NULL) goto end;
+
+                block->insns[block->nb_insns++] = insn;
+            }
+
+            // Each instruction after the first one executes one cycle ahead of the engine
+            if (nb_insns > 0)
+            {
+                _this->batch_cycles++;
+            }
+
+            iss->exec.insn_exec_profiling();
+
+            iss_reg_t next_pc = insn->fast_handler(iss, insn, pc);
+            _this->current_insn = next_pc;
+
+            if (unlikely(iss->profiler.active))
+            {
+                iss->profiler.insn_exec(insn, pc, next_pc);
+            }
+
+            iss->exec.insn_exec_power(insn);
+
+            iss->regfile.memcheck_fault();
+
+            nb_insns++;
+
+            // The size is only known once the instruction has been decoded, which may happen
+            // when it is executed for the first time, so this must be checked after execution
+            bool fallthrough = next_pc == pc + insn->size;
+            pc = next_pc;
+
+            // Stop as soon as the engine needs to see the core, for example because an IO could
+            // not be handled synchronously and stalled the core, or an interrupt is pending
+            if (_this->batch_stop || nb_insns >= _this->batch_insns)
+            {
+                goto end;
+            }
+
+            // Pending stall cycles are also part of the local time when checking the quantum,
+            // they are still consumed one by one by the normal stall mechanism once the batch
+            // is over.
+            if (_this->batch_quantum > 0 &&
+                _this->batch_cycles + _this->stall_cycles + 1 >= _this->batch_quantum)
+            {
+                goto end;
+            }
+
+            if (!fallthrough)
+            {
+                // A block being filled ends with the first instruction branching somewhere else
+                if (i + 1 == block->nb_insns)
+                {
+                    block->complete = true;
+                }
+                break;
+            }
+        }
+    }
+
+end:
+    // Synchronize back with the engine by stalling the event for the cycles we ran ahead
+    if (_this->batch_cycles > 0)
+    {
+        _this->instr_event.stall_cycle_inc(_this->batch_cycles);
+        _this->batch_cycles = 0;
+    }
+
+#if defined(ISS_HAS_JIT)
+    if (nb_jit_insns > 0)
+    {
+        iss->insn_cache.jit_native_account(nb_jit_insns);
+    }
+#endif
+}
+
+
 #if defined(CONFIG_GVSOC_ISS_RI5KY)
 
 // TODO HW loop methods could be moved to ri5cy specific code by using inheritance
@@ -204,9 +393,9 @@ void Exec::hwloop_set_start(int index, iss_reg_t pc)
 
 void Exec::hwloop_stub_insert(iss_insn_t *insn, iss_reg_t pc)
 {
-    if (insn->hwloop_handler == NULL)
+    if (insn->cold->hwloop_handler == NULL)
     {
-        insn->hwloop_handler = insn->handler;
+        insn->cold->hwloop_handler = insn->handler;
 
 #ifdef CONFIG_GVSOC_ISS_RI5KY
         insn->handler = hwloop_check_exec;
@@ -265,6 +454,11 @@ void Exec::exec_instr_check_all(vp::Block *__this, vp::ClockEvent *event)
         _this->pending_flush = false;
     }
 
+    if (iss->insn_cache.invalidate_pending)
+    {
+        iss->insn_cache.invalidate_apply();
+    }
+
     if (_this->has_exception)
     {
         _this->current_insn = _this->exception_pc;
@@ -275,7 +469,7 @@ void Exec::exec_instr_check_all(vp::Block *__this, vp::ClockEvent *event)
     // if HW counters are disabled as they are checked with the slow handler
     if (_this->can_switch_to_fast_mode())
     {
-        _this->instr_event.set_callback(&Exec::exec_instr);
+        _this->instr_event.set_callback(_this->batch_insns > 1 ? &Exec::exec_instr_batch : &Exec::exec_instr);
     }
 
     _this->insn_exec_profiling();
@@ -301,6 +495,11 @@ void Exec::exec_instr_check_all(vp::Block *__this, vp::ClockEvent *event)
 
         _this->current_insn = _this->insn_exec(insn, pc);
 
+        if (unlikely(_this->iss.profiler.active))
+        {
+            _this->iss.profiler.insn_exec(insn, pc, _this->current_insn);
+        }
+
         _this->iss.timing.insn_account();
 
         _this->insn_exec_power(insn);
@@ -219,7 +219,8 @@ int Gdbserver::gdbserver_state()
 
 static inline iss_reg_t breakpoint_check_exec(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 {
-    if (std::count(insn->breakpoints.begin(), insn->breakpoints.end(), pc) > 0)
+    std::vector<iss_reg_t> &breakpoints = insn->cold->debug->breakpoints;
+    if (std::count(breakpoints.begin(), breakpoints.end(), pc) > 0)
     {
         iss->exec.stalled_inc();
         iss->exec.halted.set(true);
@@ -236,27 +237,37 @@ static inline iss_reg_t breakpoint_check_exec(Iss *iss, iss_insn_t *insn, iss_re
 
 void Gdbserver::breakpoint_stub_insert(iss_insn_t *insn, iss_reg_t pc)
 {
-    if (insn->breakpoints.size() == 0)
+    iss_insn_cold_t *cold = insn->cold;
+    iss_insn_debug_t *debug = this->iss.insn_cache.insn_debug_get(insn);
+
+    if (debug->breakpoints.size() == 0)
     {
-        insn->breakpoint_saved_handler = insn->handler;
-        insn->breakpoint_saved_fast_handler = insn->fast_handler;
+        cold->breakpoint_saved_handler = insn->handler;
+        cold->breakpoint_saved_fast_handler = insn->fast_handler;
         insn->handler = breakpoint_check_exec;
         insn->fast_handler = breakpoint_check_exec;
     }
 
-    insn->breakpoints.push_back(pc);
+    debug->breakpoints.push_back(pc);
 }
 
 
 
 void Gdbserver::breakpoint_stub_remove(iss_insn_t *insn, iss_reg_t pc)
 {
-    insn->breakpoints.erase(std::remove(insn->breakpoints.begin(), insn->breakpoints.end(), pc), insn->breakpoints.end());
+    iss_insn_cold_t *cold = insn->cold;
+    iss_insn_debug_t *debug = cold->debug;
+    if (debug == NULL)
+    {
+        return;
+    }
+
+    debug->breakpoints.erase(std::remove(debug->breakpoints.begin(), debug->breakpoints.end(), pc), debug->breakpoints.end());
 
-    if (insn->breakpoints.size() == 0)
+    if (debug->breakpoints.size() == 0)
     {
-        insn->handler = insn->breakpoint_saved_handler;
-        insn->fast_handler = insn->breakpoint_saved_fast_handler;
+        insn->handler = cold->breakpoint_saved_handler;
+        insn->fast_handler = cold->breakpoint_saved_fast_handler;
     }
 }
 
@@ -445,6 +456,11 @@ void Gdbserver::handle_pending_io_access()
         this->trace.msg(vp::Trace::LEVEL_DEBUG, "Sending request to interface (addr: 0x%lx, size: 0x%x, is_write: %d)\n",
             addr, size, this->io_pending_is_write);
 
+        if (this->io_pending_is_write)
+        {
+            this->iss.insn_cache.store_check(addr, size);
+        }
+
         // Initialize the request
         req->init();
         req->set_addr(addr);
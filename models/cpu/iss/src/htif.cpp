@@ -88,9 +88,25 @@ void Htif::build()
 #ifdef CONFIG_GVSOC_ISS_HTIF
     this->tohost_addr = this->iss.top.get_js_config()->get_uint("htif_tohost");
     this->fromhost_addr = this->iss.top.get_js_config()->get_uint("htif_fromhost");
+    this->polling = this->iss.top.get_js_config()->get_child_bool("htif_polling");
+
+    if (!this->polling && this->tohost_addr != 0)
+    {
+        this->iss.lsu.store_watch_set(this->tohost_addr, sizeof(iss_reg_t),
+            std::bind(&Htif::tohost_written, this));
+    }
 #endif
 }
 
+void Htif::tohost_written()
+{
+    // Check the command once the store is done
+    if (!this->htif_event.is_enqueued())
+    {
+        this->htif_event.enqueue(1);
+    }
+}
+
 void Htif::data_response(vp::Block *__this, vp::IoReq *req)
 {
 
@@ -101,6 +117,7 @@ void Htif::handle_syscall(uint64_t cmd)
 {
     if (cmd & 1) // test pass/fail
     {
+        this->iss.syscalls.console_flush();
         this->iss.top.time.get_engine()->quit(cmd >> 1);
     }
     else
@@ -135,6 +152,8 @@ void Htif::dispatch(uint64_t cmd)
 
 void Htif::target_access(iss_reg_t addr, int size, bool is_write, uint8_t *data)
 {
+    // Go through the same bulk accesses as semihosting, which use direct memory accesses when
+    // possible
     this->iss.syscalls.user_access(addr, data, size, is_write);
 }
 
@@ -268,6 +287,11 @@ iss_reg_t Htif::sys_lseek(iss_reg_t fd, iss_reg_t ptr, iss_reg_t dir, iss_reg_t
 
 iss_reg_t Htif::sys_read(iss_reg_t fd, iss_reg_t pbuf, iss_reg_t len, iss_reg_t a3, iss_reg_t a4, iss_reg_t a5, iss_reg_t a6)
 {
+    if (fd == 0)
+    {
+        this->iss.syscalls.console_flush();
+    }
+
     std::vector<char> buf(len);
     ssize_t ret = read(fds.lookup(fd), buf.data(), len);
     iss_reg_t ret_errno = sysret_errno(ret);
@@ -314,6 +338,12 @@ iss_reg_t Htif::sys_write(iss_reg_t fd, iss_reg_t pbuf, iss_reg_t len, iss_reg_t
     std::vector<char> buf(len);
     this->target_access(pbuf, len, false, (uint8_t *)buf.data());
 
+    // The guest console is a duplicate of the host stdout
+    if (fd == 1 || fd == 2)
+    {
+        return sysret_errno(this->iss.syscalls.console_write(fds.lookup(fd), (uint8_t *)buf.data(), len));
+    }
+
     iss_reg_t ret = sysret_errno(write(fds.lookup(fd), buf.data(), len));
     return ret;
 }
@@ -366,6 +396,7 @@ iss_reg_t Htif::sys_lstat(iss_reg_t pname, iss_reg_t len, iss_reg_t pbuf, iss_re
 
 iss_reg_t Htif::sys_exit(iss_reg_t code, iss_reg_t a1, iss_reg_t a2, iss_reg_t a3, iss_reg_t a4, iss_reg_t a5, iss_reg_t a6)
 {
+    this->iss.syscalls.console_flush();
     this->iss.top.time.get_engine()->quit(code);
     return 0;
 }
@@ -450,7 +481,7 @@ void Htif::reset(bool active)
     if (active)
     {
 #ifdef CONFIG_GVSOC_ISS_HTIF
-        if (this->tohost_addr != 0)
+        if (this->polling && this->tohost_addr != 0)
         {
             this->htif_event.enqueue();
         }
@@ -471,5 +502,8 @@ void Htif::htif_handler(vp::Block *__this, vp::ClockEvent *event)
         iss->syscalls.htif.handle_syscall(cmd);
     }
 
-    iss->syscalls.htif.htif_event.enqueue(100);
+    if (iss->syscalls.htif.polling)
+    {
+        iss->syscalls.htif.htif_event.enqueue(100);
+    }
 }
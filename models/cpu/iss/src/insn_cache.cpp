@@ -30,6 +30,47 @@ InsnCache::InsnCache(Iss &iss)
 void InsnCache::build()
 {
     this->current_insn_page_base = -1;
+    this->block_flush_pending = false;
+    this->invalidate_pending = false;
+    this->code_start = -1;
+    this->code_end = 0;
+    this->last_dir_index = -1;
+    this->last_dir = NULL;
+    this->page_lookups = 0;
+    this->page_misses = 0;
+    this->page_cache_flush();
+
+    this->iss.top.traces.new_trace_event_real("insn_cache/page_miss_rate", &this->page_miss_rate_event);
+    this->nb_debug_records = 0;
+    this->iss.top.traces.new_trace_event("insn_cache/debug_records", &this->debug_records_event, 64);
+    this->jit_translated_insns = 0;
+    this->iss.top.traces.new_trace_event("insn_cache/jit_translated_insns",
+        &this->jit_translated_insns_event, 64);
+    this->jit_native_insns = 0;
+    this->iss.top.traces.new_trace_event("insn_cache/jit_native_insns",
+        &this->jit_native_insns_event, 64);
+
+    js::Config *config = this->iss.top.get_js_config();
+    // Writes of the core invalidate the pages they modify. Other initiators, like DMAs or other
+    // cores, must signal their writes through the flush ports, unless the platform disables the
+    // store tracking, in which case fence.i flushes the whole cache
+    this->full_flush = !config->get_child_bool("insn_cache_store_tracking");
+    this->jit_enabled = config->get_child_bool("jit");
+    this->jit_threshold = config->get_child_int("jit_threshold");
+
+    if (this->jit_enabled)
+    {
+#if defined(ISS_HAS_JIT)
+        if (!this->jit.init(INSN_JIT_BUFFER_SIZE))
+        {
+            this->iss.exec.trace.force_warning_no_error("Failed to allocate JIT code buffer, disabling JIT\n");
+            this->jit_enabled = false;
+        }
+#else
+        this->iss.exec.trace.force_warning_no_error("JIT is not supported for this core or host, disabling it\n");
+        this->jit_enabled = false;
+#endif
+    }
 }
 
 bool InsnCache::insn_is_decoded(iss_insn_t *insn)
@@ -43,29 +84,171 @@ void InsnCache::flush()
 {
     this->iss.prefetcher.flush();
 
-    for (auto page: this->pages)
+    // Blocks are pointing to the instructions of the pages, they must be flushed first
+    this->block_flush();
+
+    for (auto dir: this->page_dirs)
     {
-        delete page.second;
+        for (int i=0; i<INSN_TABLE_LEVEL_SIZE; i++)
+        {
+            InsnPageTable *table = dir.second->tables[i];
+            if (table != NULL)
+            {
+                for (int j=0; j<INSN_TABLE_LEVEL_SIZE; j++)
+                {
+                    delete table->pages[j];
+                }
+                delete table;
+            }
+        }
+        delete dir.second;
     }
 
-    this->pages.clear();
+    this->page_dirs.clear();
+    this->last_dir_index = -1;
+    this->last_dir = NULL;
+    this->page_cache_flush();
+    this->invalidate_pages.clear();
+    this->invalidate_pending = false;
+    this->code_start = -1;
+    this->code_end = 0;
 
     this->mode_flush();
 
-    for (auto insn_table: this->iss.decode.insn_tables)
+    for (InsnTable &table: this->insn_tables)
     {
-        delete[] insn_table;
+        for (int i=0; i<table.nb_insns; i++)
+        {
+            delete table.cold[i].debug;
+        }
+        delete[] table.insns;
+        delete[] table.cold;
     }
 
-    this->iss.decode.insn_tables.clear();
+    this->insn_tables.clear();
     this->iss.gdbserver.enable_all_breakpoints();
 
     this->iss.irq.cache_flush();
 }
 
+void InsnCache::invalidate(iss_addr_t paddr, iss_addr_t size)
+{
+    if (this->full_flush)
+    {
+        this->iss.exec.pending_flush = true;
+        this->iss.exec.switch_to_full_mode();
+        return;
+    }
+
+    bool found = false;
+    for (iss_reg_t index = paddr >> INSN_PAGE_BITS; index <= (paddr + size - 1) >> INSN_PAGE_BITS; index++)
+    {
+        if (this->page_find(index) != NULL)
+        {
+            this->invalidate_pages.push_back(index);
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        this->iss.decode.trace.msg(vp::Trace::LEVEL_DEBUG,
+            "Invalidating decoded instructions (addr: 0x%lx, size: 0x%lx)\n", paddr, size);
+        // The instruction doing the store may be part of the invalidated pages, delay the
+        // invalidation to the next instruction
+        this->invalidate_pending = true;
+        this->iss.exec.switch_to_full_mode();
+    }
+}
+
+void InsnCache::invalidate_apply()
+{
+    this->invalidate_pending = false;
+
+    // The prefetch buffer may contain the old opcodes, and blocks are pointing to the
+    // instructions of the pages
+    this->iss.prefetcher.flush();
+    this->block_flush();
+
+    for (iss_reg_t index: this->invalidate_pages)
+    {
+        this->page_remove(index);
+    }
+
+    this->invalidate_pages.clear();
+    this->current_insn_page_base = -1;
+}
+
 void InsnCache::mode_flush()
 {
     this->current_insn_page_base = -1;
+
+#ifdef CONFIG_GVSOC_ISS_MMU
+    // Blocks are indexed by virtual address, they are not valid anymore if the translation
+    // changed. Since this can be called from an instruction of a block being executed, just
+    // stop the current batch and flush them when the next block is looked up.
+    this->block_flush_pending = true;
+    this->iss.exec.batch_break();
+#endif
+}
+
+
+
+void InsnCache::block_flush()
+{
+    for (auto block: this->blocks)
+    {
+        delete[] block.second->jit_runs;
+        delete block.second;
+    }
+
+    this->blocks.clear();
+    this->block_flush_pending = false;
+
+#if defined(ISS_HAS_JIT)
+    // All blocks are gone, their code can be overwritten
+    this->jit.reset();
+#endif
+}
+
+
+
+InsnBlock *InsnCache::block_get_from_table(InsnBlock *prev, iss_reg_t pc)
+{
+    if (this->block_flush_pending)
+    {
+        // The previous block is part of the flushed ones, it can't be used for chaining
+        this->block_flush();
+        prev = NULL;
+    }
+
+    InsnBlock *block = this->blocks[pc];
+    if (block == NULL)
+    {
+        block = new InsnBlock;
+        block->pc = pc;
+        block->nb_insns = 0;
+        block->complete = false;
+        block->next_victim = 0;
+        block->nb_exec = 0;
+        block->jit_done = false;
+        block->jit_runs = NULL;
+        for (int i=0; i<INSN_BLOCK_NB_NEXT; i++)
+        {
+            block->next[i] = NULL;
+        }
+
+        this->blocks[pc] = block;
+    }
+
+    if (prev != NULL)
+    {
+        prev->next_pc[prev->next_victim] = pc;
+        prev->next[prev->next_victim] = block;
+        prev->next_victim = (prev->next_victim + 1) % INSN_BLOCK_NB_NEXT;
+    }
+
+    return block;
 }
 
 
@@ -77,28 +260,191 @@ void Decode::flush_cache_sync(vp::Block *__this, bool active)
     _this->iss.exec.switch_to_full_mode();
 }
 
+void Decode::flush_cache_line_sync(vp::Block *__this, bool active)
+{
+    Decode *_this = (Decode *)__this;
+    if (active)
+    {
+        // Cache lines are aligned and smaller than pages, invalidating the page containing the
+        // line address is enough
+        _this->iss.insn_cache.invalidate(_this->flush_cache_line_addr, 1);
+    }
+}
+
+void Decode::flush_cache_line_addr_sync(vp::Block *__this, uint32_t addr)
+{
+    Decode *_this = (Decode *)__this;
+    _this->flush_cache_line_addr = addr;
+}
+
 
 
+InsnPage **InsnCache::page_slot(iss_reg_t index, bool alloc)
+{
+    iss_reg_t dir_index = index >> (2 * INSN_TABLE_LEVEL_BITS);
+    InsnPageDir *dir = this->last_dir;
+
+    if (dir == NULL || dir_index != this->last_dir_index)
+    {
+        auto it = this->page_dirs.find(dir_index);
+        if (it != this->page_dirs.end())
+        {
+            dir = it->second;
+        }
+        else
+        {
+            if (!alloc)
+            {
+                return NULL;
+            }
+            dir = new InsnPageDir();
+            this->page_dirs[dir_index] = dir;
+        }
+
+        this->last_dir_index = dir_index;
+        this->last_dir = dir;
+    }
+
+    InsnPageTable **table = &dir->tables[(index >> INSN_TABLE_LEVEL_BITS) & INSN_TABLE_LEVEL_MASK];
+    if (*table == NULL)
+    {
+        if (!alloc)
+        {
+            return NULL;
+        }
+        *table = new InsnPageTable();
+    }
+
+    return &(*table)->pages[index & INSN_TABLE_LEVEL_MASK];
+}
+
+
+
+InsnPage *InsnCache::page_find(iss_reg_t index)
+{
+    InsnPage **slot = this->page_slot(index, false);
+    return slot ? *slot : NULL;
+}
+
+
+
+void InsnCache::page_remove(iss_reg_t index)
+{
+    InsnPage **slot = this->page_slot(index, false);
+    if (slot != NULL && *slot != NULL)
+    {
+        delete *slot;
+        *slot = NULL;
+
+        int cache_index = index % INSN_PAGE_CACHE_SIZE;
+        if (this->page_cache_index[cache_index] == index)
+        {
+            this->page_cache_index[cache_index] = -1;
+        }
+    }
+}
+
+
+
+void InsnCache::page_cache_flush()
+{
+    for (int i=0; i<INSN_PAGE_CACHE_SIZE; i++)
+    {
+        this->page_cache_index[i] = -1;
+        this->page_cache[i] = NULL;
+    }
+}
+
+
+
+iss_insn_t *InsnCache::insn_table_alloc(int nb_insns)
+{
+    InsnTable table = { new iss_insn_t[nb_insns], new iss_insn_cold_t[nb_insns], nb_insns };
+
+    for (int i=0; i<nb_insns; i++)
+    {
+        this->insn_init(&table.insns[i], &table.cold[i], 0);
+    }
+
+    this->insn_tables.push_back(table);
+
+    return table.insns;
+}
+
+iss_insn_debug_t *InsnCache::insn_debug_alloc(iss_insn_t *insn)
+{
+    iss_insn_debug_t *debug = new iss_insn_debug_t();
+    debug->trace_desc = -1;
+
+    // The arguments of an instruction which is already decoded were only used to fill the
+    // instruction fields, they must be decoded again
+    if (insn->cold->decoder_item != NULL)
+    {
+        this->iss.decode.decode_args(insn, debug->args);
+    }
+
+    this->nb_debug_records++;
+    if (this->debug_records_event.get_event_active())
+    {
+        this->debug_records_event.event((uint8_t *)&this->nb_debug_records);
+    }
+
+    return debug;
+}
+
 InsnPage *InsnCache::page_get(iss_reg_t paddr)
 {
     iss_reg_t index = paddr >> INSN_PAGE_BITS;
-    InsnPage *page = this->pages[index];
-    if (page != NULL)
+    int cache_index = index % INSN_PAGE_CACHE_SIZE;
+
+    // Lookups and misses are only counted while the event is active, so that the first dump
+    // after it is enabled only covers the period where it is active
+    bool stats_active = this->page_miss_rate_event.get_event_active();
+    if (unlikely(stats_active))
     {
-        return page;
+        if (++this->page_lookups == INSN_PAGE_CACHE_STATS_PERIOD)
+        {
+            this->page_miss_rate_event.event_real((double)this->page_misses / this->page_lookups);
+            this->page_lookups = 0;
+            this->page_misses = 0;
+        }
     }
 
-    page = new InsnPage;
+    if (likely(this->page_cache_index[cache_index] == index))
+    {
+        return this->page_cache[cache_index];
+    }
 
-    this->pages[index] = page;
+    if (unlikely(stats_active))
+    {
+        this->page_misses++;
+    }
 
-    iss_reg_t addr = index << INSN_PAGE_BITS;
-    for (int i=0; i<INSN_PAGE_SIZE; i++)
+    InsnPage **slot = this->page_slot(index, true);
+    InsnPage *page = *slot;
+    if (page == NULL)
     {
-        insn_init(&page->insns[i], addr);
-        addr += 2;
+        page = new InsnPage;
+        *slot = page;
+
+        iss_reg_t addr = index << INSN_PAGE_BITS;
+
+        if (!this->full_flush)
+        {
+            this->code_start = std::min(this->code_start, (iss_addr_t)addr);
+            this->code_end = std::max(this->code_end, (iss_addr_t)(addr + (1 << INSN_PAGE_BITS)));
+        }
+
+        for (int i=0; i<INSN_PAGE_SIZE; i++)
+        {
+            insn_init(&page->insns[i], &page->cold[i], addr);
+            addr += 2;
+        }
     }
 
+    this->page_cache_index[cache_index] = index;
+    this->page_cache[cache_index] = page;
+
     return page;
 }
 
@@ -121,4 +467,70 @@ iss_insn_t *InsnCache::get_insn_from_cache(iss_reg_t vaddr, iss_reg_t &index)
     this->current_insn_page_base = (vaddr >> INSN_PAGE_BITS) << INSN_PAGE_BITS;
 
     return this->get_insn(vaddr, index);
-}
\ No newline at end of file
+}
+
+
+void InsnCache::block_jit_translate(InsnBlock *block)
+{
+#if defined(ISS_HAS_JIT)
+    block->jit_done = true;
+
+    if (!this->jit_enabled)
+    {
+        return;
+    }
+
+    InsnJitRun *runs = NULL;
+    iss_reg_t pc = block->pc;
+    int index = 0;
+
+    // Look for runs of consecutive instructions which can all be translated
+    while (index < block->nb_insns)
+    {
+        int first = index;
+        iss_reg_t first_pc = pc;
+
+        while (index < block->nb_insns && this->jit.insn_op(block->insns[index]) != InsnJit::OP_NONE)
+        {
+            pc += block->insns[index]->size;
+            index++;
+        }
+
+        if (index - first >= INSN_JIT_MIN_RUN)
+        {
+            InsnJitCode code = this->jit.run_translate(&block->insns[first], index - first, first_pc);
+            if (code == NULL)
+            {
+                if (this->jit.failed)
+                {
+                    this->iss.exec.trace.force_warning_no_error("Failed to protect JIT code buffer, disabling JIT\n");
+                    this->jit_enabled = false;
+                }
+                // Code buffer is full, just keep interpreting until next flush
+                break;
+            }
+
+            if (runs == NULL)
+            {
+                runs = new InsnJitRun[INSN_BLOCK_MAX_INSNS]();
+            }
+
+            runs[first] = { code, index - first, (int)(pc - first_pc) };
+
+            this->jit_translated_insns += index - first;
+            if (this->jit_translated_insns_event.get_event_active())
+            {
+                this->jit_translated_insns_event.event((uint8_t *)&this->jit_translated_insns);
+            }
+        }
+
+        if (index == first)
+        {
+            pc += block->insns[index]->size;
+            index++;
+        }
+    }
+
+    block->jit_runs = runs;
+#endif
+}
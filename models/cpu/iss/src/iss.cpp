@@ -41,6 +41,27 @@ void IssWrapper::start()
 
 
 
+void IssWrapper::stop()
+{
+    this->iss.profiler.stop();
+    this->iss.syscalls.stop();
+}
+
+
+
+std::string IssWrapper::handle_command(gv::GvProxy *proxy, FILE *req_file, FILE *reply_file,
+    std::vector<std::string> args, std::string req)
+{
+    if (args[0] == "profiler")
+    {
+        return this->iss.profiler.handle_command(args);
+    }
+
+    return "err=1;msg=unsupported command";
+}
+
+
+
 void IssWrapper::reset(bool active)
 {
     this->iss.prefetcher.reset(active);
@@ -57,6 +78,7 @@ void IssWrapper::reset(bool active)
     this->iss.decode.reset(active);
     this->iss.gdbserver.reset(active);
     this->iss.syscalls.reset(active);
+    this->iss.profiler.reset(active);
 #if defined(CONFIG_GVSOC_ISS_INC_SPATZ)
     this->iss.spatz.reset(active);
 #endif
@@ -81,6 +103,7 @@ IssWrapper::IssWrapper(vp::ComponentConf &config)
     this->iss.pmp.build();
     this->iss.exception.build();
     this->iss.prefetcher.build();
+    this->iss.profiler.build();
 
 
 #if defined(CONFIG_GVSOC_ISS_INC_SPATZ)
@@ -124,6 +124,11 @@ void Lsu::data_response(vp::Block *__this, vp::IoReq *req)
 
     _this->trace.msg("Received data response (stalled: %d)\n", iss->exec.stalled.get());
 
+    if (req->get_is_write())
+    {
+        _this->store_watch_check(req->get_addr(), req->get_size());
+    }
+
     // First call the ISS to finish the instruction
     _this->pending_latency = req->get_latency() + 1;
 
@@ -135,9 +140,26 @@ void Lsu::data_response(vp::Block *__this, vp::IoReq *req)
     }
 }
 
+void Lsu::data_dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size)
+{
+#ifdef ISS_HAS_DMI
+    Lsu *_this = (Lsu *)__this;
+    _this->trace.msg(vp::Trace::LEVEL_DEBUG, "Invalidating direct accesses (base: 0x%lx, size: 0x%lx)\n",
+        base, size);
+    _this->dmi_cache.invalidate(base, size);
+#endif
+}
+
 int Lsu::data_req_aligned(iss_addr_t addr, uint8_t *data_ptr, uint8_t *memcheck_data, int size, bool is_write, int64_t &latency)
 {
     this->trace.msg("Data request (addr: 0x%lx, size: 0x%x, is_write: %d)\n", addr, size, is_write);
+#ifdef ISS_HAS_DMI
+    if (this->dmi_cache.access(addr, data_ptr, size, is_write, latency))
+    {
+        latency += 1;
+        return 0;
+    }
+#endif
     vp::IoReq *req = &this->io_req;
     req->init();
     req->set_addr(addr);
@@ -206,6 +228,12 @@ int Lsu::data_req_aligned(iss_addr_t addr, uint8_t *data_ptr, uint8_t *memcheck_
 
 int Lsu::data_req(iss_addr_t addr, uint8_t *data_ptr, uint8_t *memcheck_data, int size, bool is_write, int64_t &latency)
 {
+    if (is_write)
+    {
+        this->iss.insn_cache.store_check(addr, size);
+        this->store_watch_check(addr, size);
+    }
+
 #if !defined(CONFIG_GVSOC_ISS_HANDLE_MISALIGNED)
 
     return this->data_req_aligned(addr, data_ptr, memcheck_data, size, is_write, latency);
@@ -233,7 +261,11 @@ int Lsu::data_req(iss_addr_t addr, uint8_t *data_ptr, uint8_t *memcheck_data, in
 }
 
 Lsu::Lsu(Iss &iss)
+#ifdef ISS_HAS_DMI
+    : iss(iss), dmi_cache(this->data)
+#else
     : iss(iss)
+#endif
 {
 }
 
@@ -242,6 +274,7 @@ void Lsu::build()
     iss.top.traces.new_trace("lsu", &this->trace, vp::DEBUG);
     data.set_resp_meth(&Lsu::data_response);
     data.set_grant_meth(&Lsu::data_grant);
+    data.set_dmi_invalidate_meth(&Lsu::data_dmi_invalidate);
     this->iss.top.new_master_port("data", &data, (vp::Block *)this);
     this->iss.top.new_master_port("meminfo", &this->meminfo, (vp::Block *)this);
 
@@ -265,6 +298,13 @@ void Lsu::start()
 #endif
 }
 
+void Lsu::store_watch_set(iss_addr_t base, iss_addr_t size, std::function<void()> callback)
+{
+    this->store_watch_base = base;
+    this->store_watch_end = base + size;
+    this->store_watch_callback = callback;
+}
+
 void Lsu::store_resume(Lsu *lsu)
 {
     // For now we don't have to do anything as the register was written directly
@@ -360,6 +400,9 @@ void Lsu::atomic(iss_insn_t *insn, iss_addr_t addr, int size, int reg_in, int re
         {
             return;
         }
+
+        this->iss.insn_cache.store_check(phys_addr, size);
+        this->store_watch_check(phys_addr, size);
     }
 
     req->init();
@@ -23,7 +23,11 @@
 #include <cpu/iss/include/iss.hpp>
 
 Prefetcher::Prefetcher(Iss &iss)
+#ifdef ISS_HAS_DMI
+    : iss(iss), dmi_cache(this->fetch_itf)
+#else
     : iss(iss)
+#endif
 {
 }
 
@@ -31,6 +35,7 @@ void Prefetcher::build()
 {
     this->iss.top.traces.new_trace("prefetcher", &this->trace, vp::DEBUG);
     this->fetch_itf.set_resp_meth(&Prefetcher::fetch_response);
+    this->fetch_itf.set_dmi_invalidate_meth(&Prefetcher::fetch_dmi_invalidate);
     this->iss.top.new_master_port("fetch", &fetch_itf, (vp::Block *)this);
 }
 
@@ -154,6 +159,15 @@ int Prefetcher::send_fetch_req(uint64_t addr, uint8_t *data, uint64_t size, bool
 
     this->trace.msg(vp::Trace::LEVEL_TRACE, "Fetch request (addr: 0x%lx, size: 0x%lx)\n", addr, size);
 
+#ifdef ISS_HAS_DMI
+    int64_t latency;
+    if (this->dmi_cache.access(addr, data, size, is_write, latency))
+    {
+        this->iss.timing.stall_fetch_account(latency);
+        return 0;
+    }
+#endif
+
     req->init();
     req->set_addr(addr);
     req->set_size(size);
@@ -189,6 +203,14 @@ int Prefetcher::fill(iss_addr_t addr)
     return this->send_fetch_req(aligned_addr, this->data, ISS_PREFETCHER_SIZE, false);
 }
 
+void Prefetcher::fetch_dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size)
+{
+#ifdef ISS_HAS_DMI
+    Prefetcher *_this = (Prefetcher *)__this;
+    _this->dmi_cache.invalidate(base, size);
+#endif
+}
+
 void Prefetcher::fetch_response(vp::Block *__this, vp::IoReq *req)
 {
     Prefetcher *_this = (Prefetcher *)__this;
@@ -0,0 +1,695 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#include <stdio.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include "cpu/iss/include/iss.hpp"
+
+// How an instruction changed the control flow
+typedef enum
+{
+    PROFILER_JUMP,
+    PROFILER_CALL,
+    PROFILER_RETURN,
+    PROFILER_TRAP,
+    PROFILER_TRAP_RETURN,
+} profiler_flow_e;
+
+static inline bool profiler_is_link_reg(int reg)
+{
+    return reg == 1 || reg == 5;
+}
+
+// Classify an instruction which did not continue with the next one, following the hints given
+// by the link registers in the RISC-V specification
+static profiler_flow_e profiler_classify(iss_insn_t *insn)
+{
+    uint32_t opcode = insn->opcode;
+
+    if (insn->size == 2)
+    {
+        int quadrant = opcode & 0x3;
+        int funct3 = (opcode >> 13) & 0x7;
+
+        if (quadrant == 1)
+        {
+            // c.jal, which only exists on rv32, c.j, c.beqz and c.bnez
+            if (funct3 == 1)
+            {
+                return PROFILER_CALL;
+            }
+            if (funct3 == 5 || funct3 == 6 || funct3 == 7)
+            {
+                return PROFILER_JUMP;
+            }
+        }
+        else if (quadrant == 2)
+        {
+            int rs1 = (opcode >> 7) & 0x1f;
+            int rs2 = (opcode >> 2) & 0x1f;
+
+            if (funct3 == 4 && rs2 == 0 && rs1 != 0)
+            {
+                // c.jalr or c.jr
+                if ((opcode >> 12) & 1)
+                {
+                    return PROFILER_CALL;
+                }
+                return profiler_is_link_reg(rs1) ? PROFILER_RETURN : PROFILER_JUMP;
+            }
+
+            if (funct3 == 5)
+            {
+                // cm.popret and cm.popretz
+                if ((opcode & 0xff03) == 0xbe02 || (opcode & 0xff03) == 0xbc02)
+                {
+                    return PROFILER_RETURN;
+                }
+                // cm.jalt for table entries linking the return address, cm.jt otherwise
+                if ((opcode & 0xfc03) == 0xa002)
+                {
+                    return ((opcode >> 2) & 0xff) >= 32 ? PROFILER_CALL : PROFILER_JUMP;
+                }
+            }
+        }
+
+        return PROFILER_TRAP;
+    }
+
+    int rd = (opcode >> 7) & 0x1f;
+    int rs1 = (opcode >> 15) & 0x1f;
+
+    switch (opcode & 0x7f)
+    {
+        case 0x6f:
+            // jal
+            return profiler_is_link_reg(rd) ? PROFILER_CALL : PROFILER_JUMP;
+
+        case 0x67:
+            // jalr
+            if (profiler_is_link_reg(rd))
+            {
+                return PROFILER_CALL;
+            }
+            return rd == 0 && profiler_is_link_reg(rs1) ? PROFILER_RETURN : PROFILER_JUMP;
+
+        case 0x63:
+            // Conditional branches
+            return PROFILER_JUMP;
+    }
+
+    // mret, sret, uret and dret
+    if (opcode == 0x30200073 || opcode == 0x10200073 || opcode == 0x00200073 ||
+        opcode == 0x7b200073)
+    {
+        return PROFILER_TRAP_RETURN;
+    }
+
+#if defined(CONFIG_GVSOC_ISS_RI5KY)
+    // Hardware loops jump back to the start of the loop at the end of their last instruction
+    if (insn->cold->hwloop_handler != NULL)
+    {
+        return PROFILER_JUMP;
+    }
+#endif
+
+    // Any other instruction can only change the control flow by raising an exception
+    return PROFILER_TRAP;
+}
+
+
+Profiler::Profiler(Iss &iss)
+    : iss(iss), root(NULL, 0)
+{
+}
+
+void Profiler::build()
+{
+    this->iss.top.traces.new_trace("profiler", &this->trace, vp::DEBUG);
+
+    this->format = "callgrind";
+    this->insns = 0;
+
+    js::Config *config = this->iss.top.get_js_config()->get("profiler");
+    if (config != NULL)
+    {
+        this->active = config->get_child_bool("enabled");
+        if (config->get_child_str("format") != "")
+        {
+            this->format = config->get_child_str("format");
+        }
+    }
+}
+
+void Profiler::reset(bool active)
+{
+    if (active)
+    {
+        // The call stack is built again from the first instruction executed after reset, while
+        // the costs gathered so far are kept
+        this->stack.clear();
+        this->overflow_depth = 0;
+        this->last_pc = -1;
+        this->expected_pc = -1;
+    }
+}
+
+void Profiler::stop()
+{
+    if (this->root.children.size() > 0)
+    {
+        this->dump(this->get_default_path());
+    }
+}
+
+std::string Profiler::handle_command(std::vector<std::string> args)
+{
+    if (args.size() >= 2 && args[1] == "dump")
+    {
+        std::string path = args.size() >= 3 ? args[2] : this->get_default_path();
+        if (!this->dump(path))
+        {
+            return "err=1;msg=failed to open file: " + path;
+        }
+        return "err=0";
+    }
+    else if (args.size() >= 2 && (args[1] == "start" || args[1] == "stop"))
+    {
+        if (this->active && this->stack.size() > 0)
+        {
+            this->account(this->insns);
+        }
+        this->active = args[1] == "start";
+        this->reset(true);
+        return "err=0";
+    }
+    else if (args.size() >= 2 && args[1] == "clear")
+    {
+        this->root.children.clear();
+        this->reset(true);
+        return "err=0";
+    }
+
+    return "err=1;msg=unsupported profiler command";
+}
+
+void Profiler::control_flow(iss_insn_t *insn, iss_reg_t pc, iss_reg_t next_pc)
+{
+    if (this->stack.size() == 0)
+    {
+        // First instruction since the profiler was started, this is the starting point of the
+        // call stack
+        this->last_cycles = this->iss.exec.get_cycles();
+        this->last_insns = this->insns - 1;
+        this->call(pc, -1, false);
+    }
+    else if (pc != this->expected_pc && pc != this->last_pc)
+    {
+        // The core was redirected without executing any instruction, which happens when an
+        // interrupt or a debug request is taken. The instruction is the first one of the handler.
+        this->account(this->insns - 1);
+        this->call(pc, -1, true);
+    }
+
+    // Instructions which are replayed, for example after a stall, are executed again with the
+    // same address
+    if (next_pc == pc + insn->size || next_pc == pc)
+    {
+        return;
+    }
+
+    switch (profiler_classify(insn))
+    {
+        case PROFILER_JUMP:
+            break;
+
+        case PROFILER_CALL:
+            this->account(this->insns);
+            this->call(next_pc, pc + insn->size, false);
+            break;
+
+        case PROFILER_RETURN:
+            this->account(this->insns);
+            this->ret(next_pc);
+            break;
+
+        case PROFILER_TRAP:
+            this->account(this->insns);
+            this->call(next_pc, -1, true);
+            break;
+
+        case PROFILER_TRAP_RETURN:
+            this->account(this->insns);
+            this->trap_ret();
+            break;
+    }
+}
+
+void Profiler::account(int64_t insns)
+{
+    int64_t cycles = this->iss.exec.get_cycles();
+    ProfilerNode *node = this->stack.back().node;
+
+    node->cycles += cycles - this->last_cycles;
+    node->insns += insns - this->last_insns;
+
+    this->last_cycles = cycles;
+    this->last_insns = insns;
+}
+
+void Profiler::call(iss_reg_t addr, iss_reg_t return_addr, bool is_trap)
+{
+    if (this->stack.size() >= PROFILER_MAX_DEPTH)
+    {
+        this->overflow_depth++;
+        return;
+    }
+
+    ProfilerNode *parent = this->stack.size() > 0 ? this->stack.back().node : &this->root;
+    std::unique_ptr<ProfilerNode> &node = parent->children[addr];
+    if (node == NULL)
+    {
+        node = std::make_unique<ProfilerNode>(parent, addr);
+    }
+
+    node->calls++;
+    this->stack.push_back({ node.get(), return_addr, is_trap });
+}
+
+void Profiler::ret(iss_reg_t addr)
+{
+    if (this->overflow_depth > 0)
+    {
+        this->overflow_depth--;
+        return;
+    }
+
+    // The function returning is usually the last one, but it can also be a deeper one if
+    // some functions were left without returning, like with longjmp. Nothing is popped if no
+    // function returns to this address, since this is probably not a real return.
+    for (int i = this->stack.size() - 1; i > 0; i--)
+    {
+        if (this->stack[i].is_trap)
+        {
+            break;
+        }
+
+        if (this->stack[i].return_addr == addr)
+        {
+            this->stack.resize(i);
+            return;
+        }
+    }
+}
+
+void Profiler::trap_ret()
+{
+    if (this->overflow_depth > 0)
+    {
+        this->overflow_depth--;
+        return;
+    }
+
+    // Returning from a trap which was not seen, for example to switch to a lower privilege mode
+    // at boot, is just a jump
+    for (int i = this->stack.size() - 1; i > 0; i--)
+    {
+        if (this->stack[i].is_trap)
+        {
+            this->stack.resize(i);
+            return;
+        }
+    }
+}
+
+std::string Profiler::get_default_path()
+{
+    std::string name = this->iss.top.get_path();
+    if (name.size() > 0 && name[0] == '/')
+    {
+        name = name.substr(1);
+    }
+    std::replace(name.begin(), name.end(), '/', '.');
+
+    if (this->format == "pprof")
+    {
+        return "pprof." + name + ".pb";
+    }
+    return "callgrind.out." + name;
+}
+
+bool Profiler::dump(std::string path)
+{
+    // Account the costs of the current function so that the dump is up to date
+    if (this->active && this->stack.size() > 0)
+    {
+        this->account(this->insns);
+    }
+
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == NULL)
+    {
+        this->trace.force_warning("Failed to open profile file (path: %s)\n", path.c_str());
+        return false;
+    }
+
+    this->trace.msg(vp::Trace::LEVEL_INFO, "Dumping profile (path: %s, format: %s)\n",
+        path.c_str(), this->format.c_str());
+
+    bool result = this->format == "pprof" ? this->dump_pprof(file) : this->dump_callgrind(file);
+
+    return fclose(file) == 0 && result;
+}
+
+
+// Costs of a function or of the calls from a function to another one
+typedef struct
+{
+    uint64_t calls;
+    int64_t cycles;
+    int64_t insns;
+    int64_t stalls;
+} profiler_cost_t;
+
+// Costs of a function gathered from all the call stacks it was called from
+typedef struct
+{
+    profiler_cost_t self;
+    std::map<iss_reg_t, profiler_cost_t> callees;
+} profiler_func_t;
+
+static inline int64_t profiler_node_stalls(ProfilerNode *node)
+{
+    return node->cycles > node->insns ? node->cycles - node->insns : 0;
+}
+
+// Gather the costs of the node into the functions and return the inclusive cost of the node
+static profiler_cost_t profiler_gather(ProfilerNode *node, std::map<iss_reg_t, profiler_func_t> &funcs)
+{
+    profiler_cost_t inclusive = { node->calls, node->cycles, node->insns, profiler_node_stalls(node) };
+
+    profiler_func_t &func = funcs[node->addr];
+    func.self.calls += node->calls;
+    func.self.cycles += node->cycles;
+    func.self.insns += node->insns;
+    func.self.stalls += profiler_node_stalls(node);
+
+    for (auto &child : node->children)
+    {
+        profiler_cost_t child_cost = profiler_gather(child.second.get(), funcs);
+
+        profiler_cost_t &callee = func.callees[child.first];
+        callee.calls += child_cost.calls;
+        callee.cycles += child_cost.cycles;
+        callee.insns += child_cost.insns;
+        callee.stalls += child_cost.stalls;
+
+        inclusive.cycles += child_cost.cycles;
+        inclusive.insns += child_cost.insns;
+        inclusive.stalls += child_cost.stalls;
+    }
+
+    return inclusive;
+}
+
+bool Profiler::dump_callgrind(FILE *file)
+{
+    std::map<iss_reg_t, profiler_func_t> funcs;
+    profiler_cost_t total = {};
+
+    for (auto &child : this->root.children)
+    {
+        profiler_cost_t cost = profiler_gather(child.second.get(), funcs);
+        total.cycles += cost.cycles;
+        total.insns += cost.insns;
+        total.stalls += cost.stalls;
+    }
+
+    fprintf(file, "# callgrind format\n");
+    fprintf(file, "version: 1\n");
+    fprintf(file, "creator: gvsoc\n");
+    fprintf(file, "cmd: %s\n", this->iss.top.get_path().c_str());
+    fprintf(file, "positions: line\n");
+    fprintf(file, "events: Cycles Instructions Stalls\n");
+    fprintf(file, "summary: %ld %ld %ld\n\n", total.cycles, total.insns, total.stalls);
+
+    // Names are compressed, they are only dumped the first time, with an identifier which is then
+    // used alone
+    std::map<iss_reg_t, int> func_ids;
+    std::map<std::string, int> file_ids;
+
+    auto get_info = [&](iss_reg_t addr, std::string &fl, std::string &fn, int &line) {
+        const char *func_name, *inline_func, *file_name;
+        if (this->iss.trace.get_pc_info(addr, &func_name, &inline_func, &file_name, &line))
+        {
+            fn = func_name;
+            fl = file_name;
+        }
+        else
+        {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "0x%lx", (uint64_t)addr);
+            fn = buffer;
+            fl = "???";
+            line = 0;
+        }
+    };
+
+    auto dump_file = [&](const char *key, std::string fl) {
+        auto it = file_ids.find(fl);
+        if (it != file_ids.end())
+        {
+            fprintf(file, "%s=(%d)\n", key, it->second);
+        }
+        else
+        {
+            int id = file_ids.size() + 1;
+            file_ids[fl] = id;
+            fprintf(file, "%s=(%d) %s\n", key, id, fl.c_str());
+        }
+    };
+
+    auto dump_func = [&](const char *key, iss_reg_t addr, std::string fn) {
+        auto it = func_ids.find(addr);
+        if (it != func_ids.end())
+        {
+            fprintf(file, "%s=(%d)\n", key, it->second);
+        }
+        else
+        {
+            int id = func_ids.size() + 1;
+            func_ids[addr] = id;
+            fprintf(file, "%s=(%d) %s\n", key, id, fn.c_str());
+        }
+    };
+
+    for (auto &it : funcs)
+    {
+        std::string fl, fn;
+        int line;
+        get_info(it.first, fl, fn, line);
+
+        dump_file("fl", fl);
+        dump_func("fn", it.first, fn);
+        fprintf(file, "%d %ld %ld %ld\n", line, it.second.self.cycles, it.second.self.insns,
+            it.second.self.stalls);
+
+        for (auto &callee : it.second.callees)
+        {
+            std::string callee_fl, callee_fn;
+            int callee_line;
+            get_info(callee.first, callee_fl, callee_fn, callee_line);
+
+            dump_file("cfl", callee_fl);
+            dump_func("cfn", callee.first, callee_fn);
+            fprintf(file, "calls=%ld %d\n", callee.second.calls, callee_line);
+            fprintf(file, "%d %ld %ld %ld\n", line, callee.second.cycles, callee.second.insns,
+                callee.second.stalls);
+        }
+
+        fprintf(file, "\n");
+    }
+
+    return !ferror(file);
+}
+
+
+// Minimal protobuf encoder, for the messages of the pprof profile format
+class ProfilerProto
+{
+public:
+    void varint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            this->buffer.push_back((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        this->buffer.push_back(value);
+    }
+
+    void field_int(int field, uint64_t value)
+    {
+        this->varint(field << 3);
+        this->varint(value);
+    }
+
+    void field_bytes(int field, const std::string &value)
+    {
+        this->varint((field << 3) | 2);
+        this->varint(value.size());
+        this->buffer += value;
+    }
+
+    void field_packed(int field, const std::vector<uint64_t> &values)
+    {
+        ProfilerProto packed;
+        for (uint64_t value : values)
+        {
+            packed.varint(value);
+        }
+        this->field_bytes(field, packed.buffer);
+    }
+
+    std::string buffer;
+};
+
+bool Profiler::dump_pprof(FILE *file)
+{
+    ProfilerProto profile;
+    std::vector<std::string> strings = { "" };
+    std::map<std::string, int> string_ids = { { "", 0 } };
+
+    auto get_string = [&](std::string str) {
+        auto it = string_ids.find(str);
+        if (it != string_ids.end())
+        {
+            return it->second;
+        }
+        int id = strings.size();
+        strings.push_back(str);
+        string_ids[str] = id;
+        return id;
+    };
+
+    // Sample types, which give the values of each sample
+    const char *sample_types[] = { "cycles", "instructions", "stall_cycles" };
+    for (const char *type : sample_types)
+    {
+        ProfilerProto value_type;
+        value_type.field_int(1, get_string(type));
+        value_type.field_int(2, get_string("count"));
+        profile.field_bytes(1, value_type.buffer);
+    }
+
+    // One sample per node of the calling-context tree, with the exclusive costs of the node and
+    // the call stack as locations, from the node to the root. Each function has one location
+    // with the same identifier.
+    std::map<iss_reg_t, int> func_ids;
+    std::vector<ProfilerNode *> nodes;
+    for (auto &child : this->root.children)
+    {
+        nodes.push_back(child.second.get());
+    }
+
+    while (nodes.size() > 0)
+    {
+        ProfilerNode *node = nodes.back();
+        nodes.pop_back();
+
+        for (auto &child : node->children)
+        {
+            nodes.push_back(child.second.get());
+        }
+
+        std::vector<uint64_t> locations;
+        for (ProfilerNode *current = node; current != &this->root; current = current->parent)
+        {
+            auto it = func_ids.find(current->addr);
+            int id;
+            if (it != func_ids.end())
+            {
+                id = it->second;
+            }
+            else
+            {
+                id = func_ids.size() + 1;
+                func_ids[current->addr] = id;
+            }
+            locations.push_back(id);
+        }
+
+        ProfilerProto sample;
+        sample.field_packed(1, locations);
+        sample.field_packed(2, { (uint64_t)node->cycles, (uint64_t)node->insns,
+            (uint64_t)profiler_node_stalls(node) });
+        profile.field_bytes(2, sample.buffer);
+    }
+
+    for (auto &it : func_ids)
+    {
+        const char *func_name, *inline_func, *file_name;
+        int line;
+        std::string name, file_str;
+        if (this->iss.trace.get_pc_info(it.first, &func_name, &inline_func, &file_name, &line))
+        {
+            name = func_name;
+            file_str = file_name;
+        }
+        else
+        {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "0x%lx", (uint64_t)it.first);
+            name = buffer;
+            line = 0;
+        }
+
+        ProfilerProto line_msg;
+        line_msg.field_int(1, it.second);
+        line_msg.field_int(2, line);
+
+        ProfilerProto location;
+        location.field_int(1, it.second);
+        location.field_int(3, it.first);
+        location.field_bytes(4, line_msg.buffer);
+        profile.field_bytes(4, location.buffer);
+
+        ProfilerProto function;
+        function.field_int(1, it.second);
+        function.field_int(2, get_string(name));
+        function.field_int(3, get_string(name));
+        function.field_int(4, get_string(file_str));
+        function.field_int(5, line);
+        profile.field_bytes(5, function.buffer);
+    }
+
+    // Cycles are the default sample type
+    profile.field_int(14, get_string("cycles"));
+
+    for (std::string &str : strings)
+    {
+        profile.field_bytes(6, str);
+    }
+
+    return fwrite(profile.buffer.data(), 1, profile.buffer.size(), file) == profile.buffer.size();
+}
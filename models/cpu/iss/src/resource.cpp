@@ -24,7 +24,7 @@ static std::vector<std::vector<iss_resource_instance_t>> resources;
 iss_reg_t iss_resource_offload(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 {
     // First get the instance associated to this core for the resource associated to this instruction
-    iss_resource_instance_t *instance = iss->exec.resources[insn->resource_id];
+    iss_resource_instance_t *instance = iss->exec.resources[insn->cold->resource_id];
 
     // Check if the instance is ready to accept an access
     if (iss->exec.get_cycles() < instance->cycles)
@@ -37,21 +37,21 @@ iss_reg_t iss_resource_offload(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
         iss->timing.stall_insn_account(bw_cycles);
 
         // And account the access on the instance. The time taken by the access is indicated by the instruction bandwidth
-        instance->cycles += insn->resource_bandwidth;
+        instance->cycles += insn->cold->resource_bandwidth;
     }
     else
     {
         // The instance is available, just account the time taken by the access, indicated by the instruction bandwidth
-        instance->cycles = iss->exec.get_cycles() + insn->resource_bandwidth;
+        instance->cycles = iss->exec.get_cycles() + insn->cold->resource_bandwidth;
     }
 
     // Now that timing is modeled, execute the instruction
-    iss_reg_t retval = insn->resource_handler(iss, insn, pc);
+    iss_reg_t retval = insn->cold->resource_handler(iss, insn, pc);
 
     // Account the latency of the resource on the core, as the result is available after the instruction latency
-    if (insn->resource_latency > 1)
+    if (insn->cold->resource_latency > 1)
     {
-        int64_t latency_cycles = insn->resource_latency;
+        int64_t latency_cycles = insn->cold->resource_latency;
 
 #if defined(CONFIG_GVSOC_ISS_SCOREBOARD)
         iss->regfile.scoreboard_reg_set_timestamp(insn->out_regs[0], latency_cycles, -1);
@@ -32,8 +32,16 @@ Decode::Decode(Iss &iss)
 void Decode::build()
 {
     iss.top.traces.new_trace("decoder", &this->trace, vp::DEBUG);
+    this->nb_decoded_insns = 0;
+    this->nb_group_lookups = 0;
+    iss.top.traces.new_trace_event("decoder/decoded_insns", &this->decoded_insns_event, 64);
+    iss.top.traces.new_trace_event("decoder/group_lookups", &this->group_lookups_event, 64);
     this->flush_cache_itf.set_sync_meth(&Decode::flush_cache_sync);
     this->iss.top.new_slave_port("flush_cache", &this->flush_cache_itf, (vp::Block *)this);
+    this->flush_cache_line_itf.set_sync_meth(&Decode::flush_cache_line_sync);
+    this->iss.top.new_slave_port("flush_cache_line", &this->flush_cache_line_itf, (vp::Block *)this);
+    this->flush_cache_line_addr_itf.set_sync_meth(&Decode::flush_cache_line_addr_sync);
+    this->iss.top.new_slave_port("flush_cache_line_addr", &this->flush_cache_line_addr_itf, (vp::Block *)this);
     string isa = this->iss.top.get_js_config()->get_child_str("isa");
     this->isa = strdup(isa.c_str());
     this->has_double = this->iss.top.get_js_config()->get_child_bool("has_double");
@@ -100,16 +108,16 @@ static inline iss_reg_t fp_offload_exec(Iss *iss, iss_insn_t *insn, iss_reg_t pc
         // Scoreboard stall if there's integer operand data dependency.
         if (REG_IN(0) != 0xFF)
         {
-            insn->data_arga = REG_GET(0);
+            insn->cold->data_arga = REG_GET(0);
         }
-        // insn->data_argb = REG_GET(1);
+        // insn->cold->data_argb = REG_GET(1);
 
         // Record the memory addess for offloaded load/store instrution, 
         // stall the following instruction which gets access to same memory block.
-        bool lsu_label = strstr(insn->decoder_item->u.insn.label, "flw")
-                    || strstr(insn->decoder_item->u.insn.label, "fsw")
-                    || strstr(insn->decoder_item->u.insn.label, "fld")
-                    || strstr(insn->decoder_item->u.insn.label, "fsd");
+        bool lsu_label = strstr(insn->cold->decoder_item->u.insn.label, "flw")
+                    || strstr(insn->cold->decoder_item->u.insn.label, "fsw")
+                    || strstr(insn->cold->decoder_item->u.insn.label, "fld")
+                    || strstr(insn->cold->decoder_item->u.insn.label, "fsd");
         if (lsu_label)
         {
             iss->mem_map = REG_GET(0) + SIM_GET(0);
@@ -137,13 +145,13 @@ static inline iss_reg_t fp_offload_exec(Iss *iss, iss_insn_t *insn, iss_reg_t pc
         {
             // Pass value related to integer regfile from integer core to subsystem.
             // Store the pointer of integer register file and scoreboard inside the instruction.
-            insn->reg_addr = &iss->regfile.regs[0];
+            insn->cold->reg_addr = &iss->regfile.regs[0];
             #ifdef CONFIG_GVSOC_ISS_SCOREBOARD
-            insn->scoreboard_reg_timestamp_addr = &iss->regfile.scoreboard_reg_timestamp[0];
+            insn->cold->scoreboard_reg_timestamp_addr = &iss->regfile.scoreboard_reg_timestamp[0];
             #endif
 
             // Set the integer register to invalid for data dependency, if it's the output of offloading fp instruction.
-            if (!insn->out_regs_fp[0] && insn->out_regs[0] != 0xFF)
+            if (!insn->cold->out_regs_fp[0] && insn->out_regs[0] != 0xFF)
             {
                 #if defined(CONFIG_GVSOC_ISS_SCOREBOARD)
                 iss->regfile.scoreboard_reg_valid[insn->out_regs[0]] = false;
@@ -172,12 +180,12 @@ static inline iss_reg_t int_offload_exec(Iss *iss, iss_insn_t *insn, iss_reg_t p
     {
         // Check availability in memory access.
         iss_addr_t mem_map;
-        if(!insn->desc->tags[ISA_TAG_FP_OP_ID])
+        if(!insn->cold->desc->tags[ISA_TAG_FP_OP_ID])
         {
-            bool lsu_label = strstr(insn->decoder_item->u.insn.label, "lw")
-                    || strstr(insn->decoder_item->u.insn.label, "sw")
-                    || strstr(insn->decoder_item->u.insn.label, "ld")
-                    || strstr(insn->decoder_item->u.insn.label, "sd");
+            bool lsu_label = strstr(insn->cold->decoder_item->u.insn.label, "lw")
+                    || strstr(insn->cold->decoder_item->u.insn.label, "sw")
+                    || strstr(insn->cold->decoder_item->u.insn.label, "ld")
+                    || strstr(insn->cold->decoder_item->u.insn.label, "sd");
             if (lsu_label)
             {
                 // Get memory address in the load/store instruction
@@ -193,18 +201,28 @@ static inline iss_reg_t int_offload_exec(Iss *iss, iss_insn_t *insn, iss_reg_t p
         }
 
         // Check availability in register operands.
-        if(!insn->desc->tags[ISA_TAG_FP_OP_ID])
+        if(!insn->cold->desc->tags[ISA_TAG_FP_OP_ID])
         {
             bool src_ready = true;
             bool dst_ready = true;
             bool operands_ready;
 
-            int nb_args = insn->decoder_item->u.insn.nb_args;
+            int nb_args = insn->cold->decoder_item->u.insn.nb_args;
             for (int i = 0; i < nb_args; i++)
             {
-                iss_decoder_arg_t *arg = &insn->decoder_item->u.insn.args[i];
-                iss_insn_arg_t *insn_arg = &insn->args[i];
-                if ((arg->type == ISS_DECODER_ARG_TYPE_OUT_REG || arg->type == ISS_DECODER_ARG_TYPE_IN_REG) && (insn_arg->u.reg.index != 0 || arg->flags & ISS_DECODER_ARG_FLAG_FREG))
+                iss_decoder_arg_t *arg = &insn->cold->decoder_item->u.insn.args[i];
+                // The register index is taken from the instruction fields so that the debug record
+                // is not needed, a write to x0 is decoded as ISS_NB_REGS
+                int reg_index = 0;
+                if (arg->type == ISS_DECODER_ARG_TYPE_OUT_REG)
+                {
+                    reg_index = insn->out_regs[arg->u.reg.id] == ISS_NB_REGS ? 0 : insn->out_regs[arg->u.reg.id];
+                }
+                else if (arg->type == ISS_DECODER_ARG_TYPE_IN_REG)
+                {
+                    reg_index = insn->in_regs[arg->u.reg.id];
+                }
+                if ((arg->type == ISS_DECODER_ARG_TYPE_OUT_REG || arg->type == ISS_DECODER_ARG_TYPE_IN_REG) && (reg_index != 0 || arg->flags & ISS_DECODER_ARG_FLAG_FREG))
                 {
                     if (arg->type == ISS_DECODER_ARG_TYPE_OUT_REG)
                     {
@@ -232,29 +250,89 @@ static inline iss_reg_t int_offload_exec(Iss *iss, iss_insn_t *insn, iss_reg_t p
             }
         }
 
-        return insn->resource_handler(iss, insn, pc);
+        return insn->cold->resource_handler(iss, insn, pc);
     }
     return iss_insn_next(iss, insn, pc);
 
 }
 #endif
 
+void Decode::decode_arg(iss_insn_t *insn, iss_opcode_t opcode, iss_decoder_arg_t *darg, iss_insn_arg_t *arg)
+{
+    arg->type = darg->type;
+    arg->flags = darg->flags;
+
+    switch (darg->type)
+    {
+    case ISS_DECODER_ARG_TYPE_IN_REG:
+    case ISS_DECODER_ARG_TYPE_OUT_REG:
+        arg->u.reg.index = this->decode_info(insn, opcode, &darg->u.reg.info, false);
+        if (darg->flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
+            arg->u.reg.index += 8;
+        break;
+
+    case ISS_DECODER_ARG_TYPE_UIMM:
+        arg->u.uim.value = this->decode_ranges(opcode, &darg->u.uimm.info.u.range_set, darg->u.uimm.is_signed);
+        break;
+
+    case ISS_DECODER_ARG_TYPE_SIMM:
+        arg->u.sim.value = this->decode_ranges(opcode, &darg->u.simm.info.u.range_set, darg->u.simm.is_signed);
+        break;
+
+    case ISS_DECODER_ARG_TYPE_INDIRECT_IMM:
+        arg->u.indirect_imm.reg_index = this->decode_info(insn, opcode, &darg->u.indirect_imm.reg.info, false);
+        if (darg->u.indirect_imm.reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
+            arg->u.indirect_imm.reg_index += 8;
+        arg->u.indirect_imm.imm = this->decode_info(insn, opcode, &darg->u.indirect_imm.imm.info, darg->u.indirect_imm.imm.is_signed);
+        break;
+
+    case ISS_DECODER_ARG_TYPE_INDIRECT_REG:
+        arg->u.indirect_reg.base_reg_index = this->decode_info(insn, opcode, &darg->u.indirect_reg.base_reg.info, false);
+        if (darg->u.indirect_reg.base_reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
+            arg->u.indirect_reg.base_reg_index += 8;
+        arg->u.indirect_reg.offset_reg_index = this->decode_info(insn, opcode, &darg->u.indirect_reg.offset_reg.info, false);
+        if (darg->u.indirect_reg.offset_reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
+            arg->u.indirect_reg.offset_reg_index += 8;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void Decode::decode_args(iss_insn_t *insn, iss_insn_arg_t *args)
+{
+    iss_decoder_item_t *item = insn->cold->decoder_item;
+
+    for (int i = 0; i < item->u.insn.nb_args; i++)
+    {
+        this->decode_arg(insn, insn->opcode, &item->u.insn.args[i], &args[i]);
+    }
+}
+
 int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss_decoder_item_t *item)
 {
     if (!item->is_active)
         return -1;
 
-    insn->desc = &item->u.insn;
-    insn->expand_table = NULL;
+    // The debug record is only allocated when one of its fields is needed, the arguments are
+    // then decoded into it, otherwise in a scratch area only used to fill the instruction fields
+    if (insn->cold->debug)
+    {
+        insn->cold->debug->trace_desc = -1;
+    }
+
+    insn->cold->desc = &item->u.insn;
+    insn->cold->expand_table = NULL;
     insn->latency = 0;
-    insn->resource_id = item->u.insn.resource_id;
-    insn->resource_latency = item->u.insn.resource_latency;
-    insn->resource_bandwidth = item->u.insn.resource_bandwidth;
+    insn->cold->resource_id = item->u.insn.resource_id;
+    insn->cold->resource_latency = item->u.insn.resource_latency;
+    insn->cold->resource_bandwidth = item->u.insn.resource_bandwidth;
 
-    insn->decoder_item = item;
+    insn->cold->decoder_item = item;
     insn->size = item->u.insn.size;
-    insn->nb_out_reg = 0;
-    insn->nb_in_reg = 0;
+    insn->cold->nb_out_reg = 0;
+    insn->cold->nb_in_reg = 0;
     insn->latency = item->u.insn.latency;
 
     for (int i = 0; i < item->u.insn.nb_args; i++)
@@ -264,34 +342,28 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
     }
 
 #ifdef CONFIG_GVSOC_ISS_SNITCH
-    insn->in_regs_fp[0] = false;
-    insn->in_regs_fp[1] = false;
-    insn->in_regs_fp[2] = false;
-    insn->out_regs_fp[0] = false;
-    insn->out_regs_fp[1] = false;
-    insn->out_regs_fp[2] = false;
+    insn->cold->in_regs_fp[0] = false;
+    insn->cold->in_regs_fp[1] = false;
+    insn->cold->in_regs_fp[2] = false;
+    insn->cold->out_regs_fp[0] = false;
+    insn->cold->out_regs_fp[1] = false;
+    insn->cold->out_regs_fp[2] = false;
 #endif
 
     for (int i = 0; i < item->u.insn.nb_args; i++)
     {
         iss_decoder_arg_t *darg = &item->u.insn.args[i];
-        iss_insn_arg_t *arg = &insn->args[i];
-        arg->type = darg->type;
-        arg->flags = darg->flags;
+        iss_insn_arg_t *arg = insn->cold->debug ? &insn->cold->debug->args[i] : &this->args[i];
+        this->decode_arg(insn, opcode, darg, arg);
 
         switch (darg->type)
         {
         case ISS_DECODER_ARG_TYPE_IN_REG:
         case ISS_DECODER_ARG_TYPE_OUT_REG:
-            arg->u.reg.index = this->decode_info(insn, opcode, &darg->u.reg.info, false);
-
-            if (darg->flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
-                arg->u.reg.index += 8;
-
             if (darg->type == ISS_DECODER_ARG_TYPE_IN_REG)
             {
-                if (darg->u.reg.id >= insn->nb_in_reg)
-                    insn->nb_in_reg = darg->u.reg.id + 1;
+                if (darg->u.reg.id >= insn->cold->nb_in_reg)
+                    insn->cold->nb_in_reg = darg->u.reg.id + 1;
 
                 insn->in_regs[darg->u.reg.id] = arg->u.reg.index;
 
@@ -299,21 +371,21 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
                 {
                     insn->in_regs_ref[darg->u.reg.id] = this->iss.regfile.freg_ref(arg->u.reg.index);
                     #ifdef CONFIG_GVSOC_ISS_SNITCH
-                    insn->in_regs_fp[darg->u.reg.id] = true;
+                    insn->cold->in_regs_fp[darg->u.reg.id] = true;
                     #endif
                 }
                 else
                 {
                     insn->in_regs_ref[darg->u.reg.id] = this->iss.regfile.reg_ref(arg->u.reg.index);
                     #ifdef CONFIG_GVSOC_ISS_SNITCH
-                    insn->in_regs_fp[darg->u.reg.id] = false;
+                    insn->cold->in_regs_fp[darg->u.reg.id] = false;
                     #endif
                 }
             }
             else
             {
-                if (darg->u.reg.id >= insn->nb_out_reg)
-                    insn->nb_out_reg = darg->u.reg.id + 1;
+                if (darg->u.reg.id >= insn->cold->nb_out_reg)
+                    insn->cold->nb_out_reg = darg->u.reg.id + 1;
 
                 if (arg->u.reg.index == 0 && !(darg->flags & ISS_DECODER_ARG_FLAG_FREG)
                      && !(darg->flags & ISS_DECODER_ARG_FLAG_VREG))
@@ -329,7 +401,7 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
                 {
                     insn->out_regs_ref[darg->u.reg.id] = this->iss.regfile.freg_store_ref(arg->u.reg.index);
                     #ifdef CONFIG_GVSOC_ISS_SNITCH
-                    insn->out_regs_fp[darg->u.reg.id] = true;
+                    insn->cold->out_regs_fp[darg->u.reg.id] = true;
                     #endif
                 }
                 else
@@ -338,14 +410,14 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
                     {
                         insn->out_regs_ref[darg->u.reg.id] = this->iss.regfile.reg_store_ref(arg->u.reg.index);
                         #ifdef CONFIG_GVSOC_ISS_SNITCH
-                        insn->out_regs_fp[darg->u.reg.id] = false;
+                        insn->cold->out_regs_fp[darg->u.reg.id] = false;
                         #endif
                     }
                     else
                     {
                         insn->out_regs_ref[darg->u.reg.id] = &null_reg;
                         #ifdef CONFIG_GVSOC_ISS_SNITCH
-                        insn->out_regs_fp[darg->u.reg.id] = false;
+                        insn->cold->out_regs_fp[darg->u.reg.id] = false;
                         #endif
                     }
                 }
@@ -367,8 +439,8 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
                 // If no dependency was found, apply the one for the pipeline stages
                 if (darg->u.reg.latency != 0)
                 {
-                    insn->stall_handler = insn->handler;
-                    insn->stall_fast_handler = insn->fast_handler;
+                    insn->cold->stall_handler = insn->handler;
+                    insn->cold->stall_fast_handler = insn->fast_handler;
                     insn->handler = this->iss.exec.insn_stalled_callback_get();
                     insn->fast_handler = this->iss.exec.insn_stalled_fast_callback_get();
                 }
@@ -378,43 +450,31 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
             break;
 
         case ISS_DECODER_ARG_TYPE_UIMM:
-            arg->u.uim.value = this->decode_ranges(opcode, &darg->u.uimm.info.u.range_set, darg->u.uimm.is_signed);
             insn->uim[darg->u.uimm.id] = arg->u.uim.value;
             break;
 
         case ISS_DECODER_ARG_TYPE_SIMM:
-            arg->u.sim.value = this->decode_ranges(opcode, &darg->u.simm.info.u.range_set, darg->u.simm.is_signed);
             insn->sim[darg->u.simm.id] = arg->u.sim.value;
             break;
 
         case ISS_DECODER_ARG_TYPE_INDIRECT_IMM:
-            arg->u.indirect_imm.reg_index = this->decode_info(insn, opcode, &darg->u.indirect_imm.reg.info, false);
-            if (darg->u.indirect_imm.reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
-                arg->u.indirect_imm.reg_index += 8;
             insn->in_regs[darg->u.indirect_imm.reg.id] = arg->u.indirect_imm.reg_index;
             insn->in_regs_ref[darg->u.indirect_imm.reg.id] = this->iss.regfile.reg_ref(arg->u.indirect_imm.reg_index);
-            if (darg->u.indirect_imm.reg.id >= insn->nb_in_reg)
-                insn->nb_in_reg = darg->u.indirect_imm.reg.id + 1;
-            arg->u.indirect_imm.imm = this->decode_info(insn, opcode, &darg->u.indirect_imm.imm.info, darg->u.indirect_imm.imm.is_signed);
+            if (darg->u.indirect_imm.reg.id >= insn->cold->nb_in_reg)
+                insn->cold->nb_in_reg = darg->u.indirect_imm.reg.id + 1;
             insn->sim[darg->u.indirect_imm.imm.id] = arg->u.indirect_imm.imm;
             break;
 
         case ISS_DECODER_ARG_TYPE_INDIRECT_REG:
-            arg->u.indirect_reg.base_reg_index = this->decode_info(insn, opcode, &darg->u.indirect_reg.base_reg.info, false);
-            if (darg->u.indirect_reg.base_reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
-                arg->u.indirect_reg.base_reg_index += 8;
             insn->in_regs[darg->u.indirect_reg.base_reg.id] = arg->u.indirect_reg.base_reg_index;
             insn->in_regs_ref[darg->u.indirect_reg.base_reg.id] = this->iss.regfile.reg_ref(arg->u.indirect_reg.base_reg_index);
-            if (darg->u.indirect_reg.base_reg.id >= insn->nb_in_reg)
-                insn->nb_in_reg = darg->u.indirect_reg.base_reg.id + 1;
+            if (darg->u.indirect_reg.base_reg.id >= insn->cold->nb_in_reg)
+                insn->cold->nb_in_reg = darg->u.indirect_reg.base_reg.id + 1;
 
-            arg->u.indirect_reg.offset_reg_index = this->decode_info(insn, opcode, &darg->u.indirect_reg.offset_reg.info, false);
-            if (darg->u.indirect_reg.offset_reg.flags & ISS_DECODER_ARG_FLAG_COMPRESSED)
-                arg->u.indirect_reg.offset_reg_index += 8;
             insn->in_regs[darg->u.indirect_reg.offset_reg.id] = arg->u.indirect_reg.offset_reg_index;
             insn->in_regs_ref[darg->u.indirect_reg.offset_reg.id] = this->iss.regfile.reg_ref(arg->u.indirect_reg.offset_reg_index);
-            if (darg->u.indirect_reg.offset_reg.id >= insn->nb_in_reg)
-                insn->nb_in_reg = darg->u.indirect_reg.offset_reg.id + 1;
+            if (darg->u.indirect_reg.offset_reg.id >= insn->cold->nb_in_reg)
+                insn->cold->nb_in_reg = darg->u.indirect_reg.offset_reg.id + 1;
 
             break;
 
@@ -427,10 +487,10 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
     insn->handler = item->u.insn.handler;
 
 #if defined(CONFIG_GVSOC_ISS_RI5KY)
-    if (insn->hwloop_handler != NULL)
+    if (insn->cold->hwloop_handler != NULL)
     {
-        iss_reg_t (*hwloop_handler)(Iss *, iss_insn_t *, iss_reg_t pc) = insn->hwloop_handler;
-        insn->hwloop_handler = insn->handler;
+        iss_reg_t (*hwloop_handler)(Iss *, iss_insn_t *, iss_reg_t pc) = insn->cold->hwloop_handler;
+        insn->cold->hwloop_handler = insn->handler;
         insn->handler = hwloop_handler;
         insn->fast_handler = hwloop_handler;
     }
@@ -442,7 +502,7 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
 #if defined(CONFIG_GVSOC_ISS_TIMED)
     if (item->u.insn.resource_id != -1)
     {
-        insn->resource_handler = insn->handler;
+        insn->cold->resource_handler = insn->handler;
         insn->fast_handler = iss_resource_offload;
         insn->handler = iss_resource_offload;
     }
@@ -452,8 +512,8 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
 #ifdef CONFIG_GVSOC_ISS_SNITCH
     if (this->iss.snitch & !this->iss.fp_ss)
     {
-        insn->resource_handler = insn->handler;
-        if(insn->desc->tags[ISA_TAG_FP_OP_ID])
+        insn->cold->resource_handler = insn->handler;
+        if(insn->cold->desc->tags[ISA_TAG_FP_OP_ID])
         {
             insn->fast_handler = fp_offload_exec;
             insn->handler = fp_offload_exec;
@@ -466,7 +526,7 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
     }
 #endif
 
-    insn->is_macro_op = item->u.insn.is_macro_op;
+    insn->cold->is_macro_op = item->u.insn.is_macro_op;
 
     if (item->u.insn.decode != NULL)
     {
@@ -476,8 +536,8 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
 #if defined(CONFIG_GVSOC_ISS_TIMED)
     if (insn->latency)
     {
-        insn->stall_handler = insn->handler;
-        insn->stall_fast_handler = insn->fast_handler;
+        insn->cold->stall_handler = insn->handler;
+        insn->cold->stall_fast_handler = insn->fast_handler;
         insn->handler = this->iss.exec.insn_stalled_callback_get();
         insn->fast_handler = this->iss.exec.insn_stalled_fast_callback_get();
     }
@@ -488,22 +548,10 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
 
 int Decode::decode_opcode_group(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss_decoder_item_t *item)
 {
-    iss_opcode_t group_opcode = (opcode >> item->u.group.bit) & ((1ULL << item->u.group.width) - 1);
-    iss_decoder_item_t *group_item_other = NULL;
+    iss_decoder_item_t *group_item = iss_decoder_group_get(item, opcode, this->nb_group_lookups);
 
-    for (int i = 0; i < item->u.group.nb_groups; i++)
-    {
-        iss_decoder_item_t *group_item = item->u.group.groups[i];
-        if (group_opcode == group_item->opcode && !group_item->opcode_others)
-        {
-            return this->decode_item(insn, pc, opcode, group_item);
-        }
-        if (group_item->opcode_others)
-            group_item_other = group_item;
-    }
-
-    if (group_item_other)
-        return this->decode_item(insn, pc, opcode, group_item_other);
+    if (group_item)
+        return this->decode_item(insn, pc, opcode, group_item);
 
     return -1;
 }
@@ -545,7 +593,27 @@ void Decode::decode_pc(iss_insn_t *insn, iss_reg_t pc)
 
     this->trace.msg("Got opcode (opcode: 0x%lx)\n", opcode);
 
-    if (this->decode_opcode(insn, pc, opcode))
+    bool trace_active = iss.trace.insn_trace.get_active() || iss.timing.insn_trace_event.get_event_active();
+
+    // Instruction traces dump the decoded arguments, which are only kept in the debug record
+    if (trace_active)
+    {
+        this->iss.insn_cache.insn_debug_get(insn);
+    }
+
+    int error = this->decode_opcode(insn, pc, opcode);
+
+    this->nb_decoded_insns++;
+    if (this->decoded_insns_event.get_event_active())
+    {
+        this->decoded_insns_event.event((uint8_t *)&this->nb_decoded_insns);
+    }
+    if (this->group_lookups_event.get_event_active())
+    {
+        this->group_lookups_event.event((uint8_t *)&this->nb_group_lookups);
+    }
+
+    if (error)
     {
         this->trace.msg("Unknown instruction\n");
         insn->handler = iss_exec_insn_illegal;
@@ -555,9 +623,9 @@ void Decode::decode_pc(iss_insn_t *insn, iss_reg_t pc)
 
     insn->opcode = opcode;
 
-    if (iss.trace.insn_trace.get_active() || iss.timing.insn_trace_event.get_event_active())
+    if (trace_active)
     {
-        insn->saved_handler = insn->handler;
+        insn->cold->saved_handler = insn->handler;
         insn->handler = this->iss.exec.insn_trace_callback_get();
         insn->fast_handler = this->iss.exec.insn_trace_callback_get();
     }
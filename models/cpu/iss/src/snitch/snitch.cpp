@@ -21,12 +21,13 @@
  */
 
 #include "cpu/iss/include/iss.hpp"
+#include "cpu/iss/include/isa_lib/int.h"
 #include <string.h>
 
 
 Iss::Iss(IssWrapper &top)
     : prefetcher(*this), exec(top, *this), insn_cache(*this), decode(*this), timing(*this), core(*this), irq(*this),
-      gdbserver(*this), lsu(*this), dbgunit(*this), syscalls(top, *this), trace(*this), csr(*this),
+      gdbserver(*this), lsu(*this), dbgunit(*this), syscalls(top, *this), trace(*this), profiler(*this), csr(*this),
       regfile(top, *this), mmu(*this), pmp(*this), exception(*this), ssr(*this), memcheck(top, *this), top(top)
 #if defined(CONFIG_GVSOC_ISS_INC_SPATZ)
       , spatz(*this)
@@ -38,6 +39,8 @@ Iss::Iss(IssWrapper &top)
     this->csr.declare_csr(&this->csr_ssr, "ssr", 0x7C0);
     this->csr_ssr.register_callback(std::bind(&Iss::ssr_access, this, std::placeholders::_1,
         std::placeholders::_2));
+    // Enabling or disabling SSRs changes how register accesses are handled
+    this->csr.set_flags(0x7C0, CSR_FLAG_FULL_MODE);
     this->csr.declare_csr(&this->csr_fmode, "fmode", 0x800);
 
     this->barrier_ack_itf.set_sync_meth(&Iss::barrier_sync);
@@ -124,7 +127,7 @@ bool Iss::check_state(iss_insn_t *insn)
 
     // Set the request is_write bit to differentiate whether it's a sequenceable instruction.
     // This is important because the handshaking methods and instruction lanes in the sequencer are different. 
-    if (insn->desc->tags[ISA_TAG_NSEQ_ID])
+    if (insn->cold->desc->tags[ISA_TAG_NSEQ_ID])
     {
         // Instructions in bypass lane
         this->check_req.set_is_write(false);
@@ -158,13 +161,19 @@ bool Iss::handle_req(iss_insn_t *insn, iss_reg_t pc, bool is_write)
     this->trace_iss.msg("Send offload request (opcode: 0x%lx, pc: 0x%lx)\n", opcode, pc);
     
     // Assign arguments to request.
+    // The instruction is copied with its cold part, so that the subsystem can modify it. Its
+    // debug record is allocated first so that the copies share the one owned by the cache.
+    this->insn_cache.insn_debug_get(insn);
     this->insn = *((iss_insn_t *)insn);
+    this->insn_cold = *insn->cold;
+    this->insn.cold = &this->insn_cold;
     this->pc = pc;
     this->is_write=is_write;
     this->frm = this->csr.fcsr.frm;
 
     // Assign arguments to request.
-    this->acc_req = { .pc=pc, .insn=this->insn, .is_write=is_write, .frm =frm, .fmode=this->csr_fmode.value };
+    this->acc_req = { .pc=pc, .insn=this->insn, .insn_cold=this->insn_cold, .is_write=is_write, .frm =frm, .fmode=this->csr_fmode.value };
+    this->acc_req.insn.cold = &this->acc_req.insn_cold;
 
     // Offload request if the port is connected
     if (this->acc_req_itf.is_bound())
@@ -177,7 +186,7 @@ bool Iss::handle_req(iss_insn_t *insn, iss_reg_t pc, bool is_write)
     // And the following instruction with data dependency will execute scoreboard_reg_check when loading the operands,
     // which will call stall_load_dependency_account.
     // Assign timestamp as the lower bound of latency, which will be updated to the exact value after the instruction is executed.
-    if (!this->insn.out_regs_fp[0] & this->insn.out_regs[0] != 0xFF)
+    if (!this->insn.cold->out_regs_fp[0] & this->insn.out_regs[0] != 0xFF)
     {
     #if defined(CONFIG_GVSOC_ISS_SCOREBOARD)
         this->regfile.scoreboard_reg_set_timestamp(insn->out_regs[0], insn->latency, -1);
@@ -194,7 +203,8 @@ void Iss::handle_event(vp::Block *__this, vp::ClockEvent *event)
     Iss *_this = (Iss *)__this;
 
     // Assign arguments to request.
-    _this->acc_req = { .pc=_this->pc, .insn=_this->insn, .is_write=_this->is_write, .frm =_this->frm, .fmode=_this->csr_fmode.value };
+    _this->acc_req = { .pc=_this->pc, .insn=_this->insn, .insn_cold=_this->insn_cold, .is_write=_this->is_write, .frm =_this->frm, .fmode=_this->csr_fmode.value };
+    _this->acc_req.insn.cold = &_this->acc_req.insn_cold;
 
     // Offload request if the port is connected
     if (_this->acc_req_itf.is_bound())
@@ -210,23 +220,23 @@ void Iss::handle_result(vp::Block *__this, OffloadRsp *result)
     Iss *_this = (Iss *)__this;
 
     // Store dependent input integer register value when we receive the response from fp subsystem.
-    if (!result->insn.out_regs_fp[0] & result->insn.out_regs[0] != 0xFF)
+    if (!result->insn.cold->out_regs_fp[0] & result->insn.out_regs[0] != 0xFF)
     {
         _this->regfile.set_reg(result->rd, result->data);
     }
 
     // Set scoreboard valid when the instruction finishes execution.
-    if (!result->insn.out_regs_fp[0] && result->insn.out_regs[0] != 0xFF)
+    if (!result->insn.cold->out_regs_fp[0] && result->insn.out_regs[0] != 0xFF)
     {
         #if defined(CONFIG_GVSOC_ISS_SCOREBOARD)
         _this->regfile.scoreboard_reg_valid[result->insn.out_regs[0]] = true;
         #endif   
     }
     // Reset memory address when the instruction finishes execution.
-    bool lsu_label = strstr(result->insn.decoder_item->u.insn.label, "flw")
-                    || strstr(result->insn.decoder_item->u.insn.label, "fsw")
-                    || strstr(result->insn.decoder_item->u.insn.label, "fld")
-                    || strstr(result->insn.decoder_item->u.insn.label, "fsd");
+    bool lsu_label = strstr(result->insn.cold->decoder_item->u.insn.label, "flw")
+                    || strstr(result->insn.cold->decoder_item->u.insn.label, "fsw")
+                    || strstr(result->insn.cold->decoder_item->u.insn.label, "fld")
+                    || strstr(result->insn.cold->decoder_item->u.insn.label, "fsd");
     if (lsu_label & result->pc==_this->mem_pc)
     {
         _this->mem_map = 0x0;
@@ -235,14 +245,15 @@ void Iss::handle_result(vp::Block *__this, OffloadRsp *result)
     // Post-processing of result.
     // Update fflags in integer core after fp instruction.
     // Hardward doesn't stall CSR_FFLAGS when the fp instruction hasn't responded correct status value.
+    lib_ff_flags_sync();
     _this->csr.fcsr.fflags = result->fflags;
 
     // for (int i=0; i<3; i++)
     // {
-    //     if (result->insn.out_regs_fp[0])
+    //     if (result->insn.cold->out_regs_fp[0])
     //     {
     //         int reg = result->insn.out_regs[i];
-    //         _this->regfile.set_freg(reg, *((iss_freg_t *)(result->insn.freg_addr)+reg));
+    //         _this->regfile.set_freg(reg, *((iss_freg_t *)(result->insn.cold->freg_addr)+reg));
     //     }
     // }
 
@@ -250,7 +261,7 @@ void Iss::handle_result(vp::Block *__this, OffloadRsp *result)
     // Assign results here because we use fp register value only for trace, not for later computation.
     for (int i=0; i<ISS_NB_REGS; i++)
     {
-        _this->regfile.set_freg(i, *((iss_freg_t *)(result->insn.freg_addr)+i));
+        _this->regfile.set_freg(i, *((iss_freg_t *)(result->insn.cold->freg_addr)+i));
     }
 
     // Output instruction trace for debugging.
@@ -284,9 +295,9 @@ bool Iss::ssr_access(bool is_write, iss_reg_t &value)
         else
         {
             // If ready, send offload request.
-            insn->reg_addr = &this->regfile.regs[0];
+            insn->cold->reg_addr = &this->regfile.regs[0];
             #ifdef CONFIG_GVSOC_ISS_SCOREBOARD
-            insn->scoreboard_reg_timestamp_addr = &this->regfile.scoreboard_reg_timestamp[0];
+            insn->cold->scoreboard_reg_timestamp_addr = &this->regfile.scoreboard_reg_timestamp[0];
             #endif
             int stall = this->handle_req(insn, pc, false);
         }
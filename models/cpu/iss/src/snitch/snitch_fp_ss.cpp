@@ -21,6 +21,7 @@
  */
 
 #include "cpu/iss/include/iss.hpp"
+#include "cpu/iss/include/isa_lib/int.h"
 #include <string.h>
 
 #define MAX_OF_THREE(a, b, c) ((a) > (b) ? ((a) > (c) ? (a) : (c)) : ((b) > (c) ? (b) : (c)))
@@ -39,6 +40,8 @@ Iss::Iss(IssWrapper &top)
     this->csr.declare_csr(&this->csr_ssr,   "ssr",    0x7C0);
     this->csr_ssr.register_callback(std::bind(&Iss::ssr_access, this, std::placeholders::_1,
         std::placeholders::_2));
+    // Enabling or disabling SSRs changes how register accesses are handled
+    this->csr.set_flags(0x7C0, CSR_FLAG_FULL_MODE);
 
     this->barrier_ack_itf.set_sync_meth(&Iss::barrier_sync);
     this->top.new_slave_port("barrier_ack", &this->barrier_ack_itf, (vp::Block *)this);
@@ -125,11 +128,13 @@ void Iss::handle_notif(vp::Block *__this, OffloadReq *req)
     iss_reg_t pc = req->pc;
     bool isRead = !req->is_write;
     iss_insn_t insn = req->insn;
+    iss_insn_cold_t insn_cold = req->insn_cold;
+    insn.cold = &insn_cold;
     unsigned int frm = req->frm;
-    insn.fmode = req->fmode;
+    insn.cold->fmode = req->fmode;
 
     iss_opcode_t opcode = insn.opcode;
-    insn.freg_addr = &_this->regfile.fregs[0];
+    insn.cold->freg_addr = &_this->regfile.fregs[0];
     _this->trace_iss.msg("Received IO request (opcode: 0x%llx, pc: 0x%llx, isRead: %d)\n", opcode, pc, isRead);
 
     // Change address of input and ouput floating point registers.
@@ -138,19 +143,19 @@ void Iss::handle_notif(vp::Block *__this, OffloadReq *req)
     int rs2 = insn.in_regs[1];
     int rs3 = insn.in_regs[2];
     _this->trace_iss.msg(vp::Trace::LEVEL_TRACE, "rd index: %d, rs1 index: %d, rs2 index: %d, rs3 index: %d\n", rd, rs1, rs2, rs3);
-    if (insn.in_regs_fp[0])
+    if (insn.cold->in_regs_fp[0])
     {
         insn.in_regs_ref[0] = _this->regfile.freg_store_ref(rs1);
     }
-    if (insn.in_regs_fp[1])
+    if (insn.cold->in_regs_fp[1])
     {
         insn.in_regs_ref[1] = _this->regfile.freg_store_ref(rs2);
     }
-    if (insn.in_regs_fp[2])
+    if (insn.cold->in_regs_fp[2])
     {
         insn.in_regs_ref[2] = _this->regfile.freg_store_ref(rs3);
     }
-    if (insn.out_regs_fp[0])
+    if (insn.cold->out_regs_fp[0])
     {
         insn.out_regs_ref[0] = _this->regfile.freg_store_ref(rd);
     }
@@ -159,13 +164,13 @@ void Iss::handle_notif(vp::Block *__this, OffloadReq *req)
     // useful when one of the input operand is integer register.
     for (int i=0; i<ISS_NB_REGS; i++)
     {
-        _this->regfile.set_reg(i, *((iss_reg_t *)(insn.reg_addr)+i));
+        _this->regfile.set_reg(i, *((iss_reg_t *)(insn.cold->reg_addr)+i));
     }
     // Or only assign operands of needed register
     // Rewrite value of data_arga, because there's WAR in integer register if the sequencer is added.
-    if (!insn.in_regs_fp[0] & insn.in_regs[0] != 0xFF)
+    if (!insn.cold->in_regs_fp[0] & insn.in_regs[0] != 0xFF)
     {
-        _this->regfile.set_reg(rs1, insn.data_arga); 
+        _this->regfile.set_reg(rs1, insn.cold->data_arga); 
     }
 
     // Update csr frm in subsystem
@@ -181,7 +186,7 @@ void Iss::handle_notif(vp::Block *__this, OffloadReq *req)
     // Use sync computing, execute instruction immediately and give back response after certain latency.
     _this->trace_iss.msg(vp::Trace::LEVEL_TRACE, "Execute instruction and accumulate latency\n");
     _this->trace.priv_mode = _this->core.mode_get();
-    insn.resource_handler(_this, &insn, pc);
+    insn.cold->resource_handler(_this, &insn, pc);
 
     // Clear dm_read and dm_write flag after execution
     _this->ssr.clear_flags();
@@ -218,6 +223,8 @@ void Iss::handle_notif(vp::Block *__this, OffloadReq *req)
     // in order to realize the parallelism between master and slave.
     _this->acc_req.pc = pc;
     _this->acc_req.insn = insn;
+    _this->acc_req.insn_cold = insn_cold;
+    _this->acc_req.insn.cold = &_this->acc_req.insn_cold;
     _this->trace_iss.msg(vp::Trace::LEVEL_TRACE, "Enqueue the finished offloaded instruction\n");
     // Todo: Add insn.latency after stall_insn_dependency_account in corresponding handler function.
     if (!_this->event->is_enqueued())
@@ -229,13 +236,13 @@ void Iss::handle_notif(vp::Block *__this, OffloadReq *req)
     // Assign int register output to input regfile in integer core.
     // Todo: differentiate between reg and reg64
     iss_reg_t data;
-    if (!insn.out_regs_fp[0] & insn.out_regs[0] != 0xFF)
+    if (!insn.cold->out_regs_fp[0] & insn.out_regs[0] != 0xFF)
     {
         data = _this->regfile.get_reg(rd);
-        *((iss_reg_t *)(insn.reg_addr)+rd) = data;
+        *((iss_reg_t *)(insn.cold->reg_addr)+rd) = data;
 
         #if defined(CONFIG_GVSOC_ISS_SCOREBOARD)
-        insn.scoreboard_reg_timestamp_addr[rd] = _this->top.clock.get_cycles() + insn.latency;
+        insn.cold->scoreboard_reg_timestamp_addr[rd] = _this->top.clock.get_cycles() + insn.latency;
         #endif   
     }
 
@@ -251,6 +258,8 @@ void Iss::handle_event(vp::Block *__this, vp::ClockEvent *event)
     iss_reg_t pc = _this->acc_req.pc;
     bool isRead = !_this->acc_req.is_write;
     iss_insn_t insn = _this->acc_req.insn;
+    iss_insn_cold_t insn_cold = _this->acc_req.insn_cold;
+    insn.cold = &insn_cold;
     iss_opcode_t opcode = insn.opcode;
 
     bool error;
@@ -285,8 +294,10 @@ void Iss::handle_event(vp::Block *__this, vp::ClockEvent *event)
      
     // Assign arguments to result.
     data = _this->regfile.get_reg(rd);
+    lib_ff_flags_sync();
     fflags = _this->csr.fcsr.fflags;
-    _this->acc_rsp = { .rd=rd, .error=error, .data=data, .fflags=fflags, .pc=pc, .insn=insn };
+    _this->acc_rsp = { .rd=rd, .error=error, .data=data, .fflags=fflags, .pc=pc, .insn=insn, .insn_cold=insn_cold };
+    _this->acc_rsp.insn.cold = &_this->acc_rsp.insn_cold;
     
     // Send back response of the result
     if (_this->acc_rsp_itf.is_bound())
@@ -323,47 +334,47 @@ int Iss::get_latency(iss_insn_t insn, iss_reg_t pc, int timestamp)
     int rs1 = insn.in_regs[0];
     int rs2 = insn.in_regs[1];
     int rs3 = insn.in_regs[2];
-    if (!insn.in_regs_fp[0])
+    if (!insn.cold->in_regs_fp[0])
     {
         rs1 = -1;
     }
-    if (!insn.in_regs_fp[1])
+    if (!insn.cold->in_regs_fp[1])
     {
         rs2 = -1;
     }
-    if (!insn.in_regs_fp[2])
+    if (!insn.cold->in_regs_fp[2])
     {
         rs3 = -1;
     }
 
     // Determine operation groups dependent on the label of instruction
-    bool fma_label = strstr(insn.decoder_item->u.insn.label, "add")
-                    || strstr(insn.decoder_item->u.insn.label, "sub")
-                    || strstr(insn.decoder_item->u.insn.label, "mul")
-                    || strstr(insn.decoder_item->u.insn.label, "mac");
-
-    bool divsqrt_label = strstr(insn.decoder_item->u.insn.label, "div")
-                        || strstr(insn.decoder_item->u.insn.label, "sqrt");
-
-    bool noncomp_label = strstr(insn.decoder_item->u.insn.label, "sgnj")
-                        || strstr(insn.decoder_item->u.insn.label, "min")
-                        || strstr(insn.decoder_item->u.insn.label, "max");
-
-    bool conv_label = strstr(insn.decoder_item->u.insn.label, "fmv")
-                    || strstr(insn.decoder_item->u.insn.label, "fcvt")
-                    || strstr(insn.decoder_item->u.insn.label, "fcpka")
-                    || strstr(insn.decoder_item->u.insn.label, "feq")
-                    || strstr(insn.decoder_item->u.insn.label, "fle")
-                    || strstr(insn.decoder_item->u.insn.label, "flt")
-                    || strstr(insn.decoder_item->u.insn.label, "class");
-
-    bool dotp_label = strstr(insn.decoder_item->u.insn.label, "dotp")
-                    || strstr(insn.decoder_item->u.insn.label, "sum");
-
-    bool lsu_label = strstr(insn.decoder_item->u.insn.label, "flw")
-                    || strstr(insn.decoder_item->u.insn.label, "fsw")
-                    || strstr(insn.decoder_item->u.insn.label, "fld")
-                    || strstr(insn.decoder_item->u.insn.label, "fsd");
+    bool fma_label = strstr(insn.cold->decoder_item->u.insn.label, "add")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "sub")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "mul")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "mac");
+
+    bool divsqrt_label = strstr(insn.cold->decoder_item->u.insn.label, "div")
+                        || strstr(insn.cold->decoder_item->u.insn.label, "sqrt");
+
+    bool noncomp_label = strstr(insn.cold->decoder_item->u.insn.label, "sgnj")
+                        || strstr(insn.cold->decoder_item->u.insn.label, "min")
+                        || strstr(insn.cold->decoder_item->u.insn.label, "max");
+
+    bool conv_label = strstr(insn.cold->decoder_item->u.insn.label, "fmv")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "fcvt")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "fcpka")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "feq")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "fle")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "flt")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "class");
+
+    bool dotp_label = strstr(insn.cold->decoder_item->u.insn.label, "dotp")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "sum");
+
+    bool lsu_label = strstr(insn.cold->decoder_item->u.insn.label, "flw")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "fsw")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "fld")
+                    || strstr(insn.cold->decoder_item->u.insn.label, "fsd");
 
     int latency = insn.latency;
     int latency_pipe = 0;
@@ -402,7 +413,7 @@ int Iss::get_latency(iss_insn_t insn, iss_reg_t pc, int timestamp)
 
     // Store finished instruction as new entry inside its own operation group FIFO
     int rd = insn.out_regs[0];
-    if (!insn.out_regs_fp[0])
+    if (!insn.cold->out_regs_fp[0])
     {
         rd = -1;
     }
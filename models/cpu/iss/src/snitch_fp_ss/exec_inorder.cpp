@@ -128,9 +128,14 @@ void Exec::icache_flush()
         this->flush_cache_req_itf.sync(true);
     }
 
-    // Delay the flush to the next instruction in case we are in the middle of an instruction
-    this->pending_flush = true;
-    this->switch_to_full_mode();
+    // The whole cache is only flushed if store tracking is disabled, otherwise the writers of
+    // code have already invalidated the decoded instructions they modified
+    if (this->iss.insn_cache.full_flush)
+    {
+        // Delay the flush to the next instruction in case we are in the middle of an instruction
+        this->pending_flush = true;
+        this->switch_to_full_mode();
+    }
 }
 
 #include <unistd.h>
@@ -200,9 +205,9 @@ void Exec::hwloop_set_start(int index, iss_reg_t pc)
 
 void Exec::hwloop_stub_insert(iss_insn_t *insn, iss_reg_t pc)
 {
-    if (insn->hwloop_handler == NULL)
+    if (insn->cold->hwloop_handler == NULL)
     {
-        insn->hwloop_handler = insn->handler;
+        insn->cold->hwloop_handler = insn->handler;
 
 #ifdef CONFIG_GVSOC_ISS_RI5KY
         insn->handler = hwloop_check_exec;
@@ -261,6 +266,11 @@ void Exec::exec_instr_check_all(vp::Block *__this, vp::ClockEvent *event)
         _this->pending_flush = false;
     }
 
+    if (iss->insn_cache.invalidate_pending)
+    {
+        iss->insn_cache.invalidate_apply();
+    }
+
     if (_this->has_exception)
     {
         _this->current_insn = _this->exception_pc;
@@ -31,16 +31,25 @@ void Vlsu::data_response(vp::Block *__this, vp::IoReq *req)
 {
 }
 
+void Vlsu::dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size)
+{
+#ifdef ISS_HAS_DMI
+    Vlsu *_this = (Vlsu *)__this;
+    _this->dmi_cache.invalidate(base, size);
+#endif
+}
+
 
-Vlsu::Vlsu(Iss &iss) : iss(iss)
+Vlsu::Vlsu(Iss &iss) : iss(iss), dmi_cache(this->io_itf[0])
 {
 }
 
 void Vlsu::build()
 {
-    for (int i=0; i<4; i++)
+    for (int i=0; i<VLSU_NB_PORTS; i++)
     {
         this->io_itf[i].set_resp_meth(&Vlsu::data_response);
+        this->io_itf[i].set_dmi_invalidate_meth(&Vlsu::dmi_invalidate);
         this->iss.top.new_master_port("vlsu_" + std::to_string(i), &this->io_itf[i], (vp::Block *)this);
     }
 
@@ -58,7 +67,7 @@ inline void VRegfile::reset(bool active){
 
 Iss::Iss(IssWrapper &top)
     : prefetcher(*this), exec(top, *this), insn_cache(*this), decode(*this), timing(*this), core(*this), irq(*this),
-      gdbserver(*this), lsu(*this), dbgunit(*this), syscalls(top, *this), trace(*this), csr(*this),
+      gdbserver(*this), lsu(*this), dbgunit(*this), syscalls(top, *this), trace(*this), profiler(*this), csr(*this),
       regfile(top, *this), mmu(*this), pmp(*this), exception(*this), spatz(*this), memcheck(top, *this), top(top)
 {
 }
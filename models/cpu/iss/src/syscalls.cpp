@@ -49,6 +49,27 @@ void Syscalls::build()
     }
 
     this->htif.build();
+
+    this->console_fd = -1;
+    this->console_flush_policy = SYSCALLS_CONSOLE_FLUSH_ALWAYS;
+
+    js::Config *console_flush = this->iss.top.get_js_config()->get("console_flush");
+    if (console_flush != NULL)
+    {
+        std::string policy = console_flush->get_str();
+        if (policy == "line")
+        {
+            this->console_flush_policy = SYSCALLS_CONSOLE_FLUSH_LINE;
+        }
+        else if (policy == "full")
+        {
+            this->console_flush_policy = SYSCALLS_CONSOLE_FLUSH_FULL;
+        }
+        else if (policy != "always")
+        {
+            this->trace.force_warning("Unknown console flush policy (policy: %s)\n", policy.c_str());
+        }
+    }
 }
 
 void Syscalls::reset(bool active)
@@ -56,6 +77,11 @@ void Syscalls::reset(bool active)
   this->htif.reset(active);
 }
 
+void Syscalls::stop()
+{
+    this->console_flush();
+}
+
 
 void Syscalls::handle_ebreak()
 {
@@ -113,19 +139,74 @@ void Syscalls::handle_ebreak()
     }
 }
 
-bool Syscalls::user_access(iss_addr_t addr, uint8_t *buffer, iss_addr_t size, bool is_write)
+// Access a part of the guest memory which does not cross a DMI page. The access is done directly
+// if the memory granted it, otherwise with a single debug request, which is split into byte
+// accesses if it is refused, for example because the target does not support bigger accesses or
+// because the area is not fully mapped. In case of error, size is updated with the number of
+// bytes which could be accessed.
+int Syscalls::user_access_chunk(iss_addr_t addr, uint8_t *buffer, iss_addr_t &size, bool is_write)
 {
     vp::IoReq *req = &this->iss.lsu.io_req;
-    std::string str = "";
-    while (size != 0)
+    int64_t latency;
+
+#ifdef ISS_HAS_DMI
+    if (this->iss.lsu.dmi_cache.access(addr, buffer, size, is_write, latency))
+    {
+        if (latency > this->latency)
+        {
+            this->latency = latency;
+        }
+        return vp::IO_REQ_OK;
+    }
+#endif
+
+    iss_addr_t req_size = size;
+    for (iss_addr_t offset = 0; offset < size; offset += req_size)
     {
         req->init();
         req->set_debug(true);
-        req->set_addr(addr);
-        req->set_size(1);
+        req->set_addr(addr + offset);
+        req->set_size(req_size);
         req->set_is_write(is_write);
-        req->set_data(buffer);
+        req->set_data(buffer + offset);
         int err = this->iss.lsu.data.req(req);
+
+        if (err == vp::IO_REQ_INVALID && req_size > 1)
+        {
+            req_size = 1;
+            offset -= req_size;
+            continue;
+        }
+
+        if (err != vp::IO_REQ_OK)
+        {
+            size = offset;
+            return err;
+        }
+
+        latency = req->get_full_latency();
+        if (latency > this->latency)
+        {
+            this->latency = latency;
+        }
+    }
+
+    return vp::IO_REQ_OK;
+}
+
+bool Syscalls::user_access(iss_addr_t addr, uint8_t *buffer, iss_addr_t size, bool is_write)
+{
+    if (is_write && size > 0)
+    {
+        this->iss.insn_cache.store_check(addr, size);
+    }
+
+    while (size != 0)
+    {
+        iss_addr_t chunk_size = std::min(size,
+            (1 << ISS_DMI_PAGE_BITS) - (addr & ((1 << ISS_DMI_PAGE_BITS) - 1)));
+
+        int err = this->user_access_chunk(addr, buffer, chunk_size, is_write);
         if (err != vp::IO_REQ_OK)
         {
             if (err == vp::IO_REQ_INVALID)
@@ -136,15 +217,9 @@ bool Syscalls::user_access(iss_addr_t addr, uint8_t *buffer, iss_addr_t size, bo
             return true;
         }
 
-        int64_t latency = req->get_full_latency();
-        if (latency > this->latency)
-        {
-            this->latency = latency;
-        }
-
-        addr++;
-        size--;
-        buffer++;
+        addr += chunk_size;
+        size -= chunk_size;
+        buffer += chunk_size;
     }
 
     return false;
@@ -152,39 +227,92 @@ bool Syscalls::user_access(iss_addr_t addr, uint8_t *buffer, iss_addr_t size, bo
 
 std::string Syscalls::read_user_string(iss_addr_t addr, int size)
 {
-    vp::IoReq *req = &this->iss.lsu.io_req;
     std::string str = "";
+    uint8_t buffer[SYSCALLS_STRING_CHUNK_SIZE];
+
     while (size != 0)
     {
-        uint8_t buffer;
-        req->init();
-        req->set_debug(true);
-        req->set_addr(addr);
-        req->set_size(1);
-        req->set_is_write(false);
-        req->set_data(&buffer);
-        int err = this->iss.lsu.data.req(req);
-        if (err != vp::IO_REQ_OK)
+        // Read the string by chunks which do not cross pages, so that memory beyond the end of
+        // the string is only read if it is likely to be mapped
+        iss_addr_t chunk_size = std::min((iss_addr_t)SYSCALLS_STRING_CHUNK_SIZE,
+            (1 << ISS_DMI_PAGE_BITS) - (addr & ((1 << ISS_DMI_PAGE_BITS) - 1)));
+        if (size > 0 && (iss_addr_t)size < chunk_size)
         {
-            if (err == vp::IO_REQ_INVALID)
-                return "";
-            else
-                this->trace.fatal("Pending IO response during debug request\n");
+            chunk_size = size;
+        }
+
+        int err = this->user_access_chunk(addr, buffer, chunk_size, false);
+        if (err == vp::IO_REQ_PENDING)
+        {
+            this->trace.fatal("Pending IO response during debug request\n");
         }
 
-        if (buffer == 0)
+        uint8_t *end = (uint8_t *)memchr(buffer, 0, chunk_size);
+        if (end != NULL)
+        {
+            str.append((char *)buffer, end - buffer);
             return str;
+        }
 
-        str += buffer;
-        addr++;
+        if (err != vp::IO_REQ_OK)
+        {
+            return "";
+        }
+
+        str.append((char *)buffer, chunk_size);
+        addr += chunk_size;
 
         if (size > 0)
-            size--;
+            size -= chunk_size;
     }
 
     return str;
 }
 
+ssize_t Syscalls::console_write(int fd, const uint8_t *data, size_t size)
+{
+    if (this->console_flush_policy == SYSCALLS_CONSOLE_FLUSH_ALWAYS)
+    {
+        return write(fd, data, size);
+    }
+
+    // The buffer only holds the output of one file descriptor, so that the order between
+    // stdout and stderr is kept
+    if (this->console_fd != fd || this->console_buffer.size() + size > SYSCALLS_CONSOLE_SIZE)
+    {
+        this->console_flush();
+    }
+
+    if (size > SYSCALLS_CONSOLE_SIZE)
+    {
+        return write(fd, data, size);
+    }
+
+    this->console_fd = fd;
+    this->console_buffer.insert(this->console_buffer.end(), data, data + size);
+
+    if (this->console_flush_policy == SYSCALLS_CONSOLE_FLUSH_LINE && memchr(data, '\n', size))
+    {
+        this->console_flush();
+    }
+
+    return size;
+}
+
+void Syscalls::console_flush()
+{
+    if (this->console_fd != -1)
+    {
+        size_t size = this->console_buffer.size();
+        if (write(this->console_fd, this->console_buffer.data(), size) != (ssize_t)size)
+        {
+            this->trace.force_warning("Failed to write console output\n");
+        }
+        this->console_buffer.clear();
+        this->console_fd = -1;
+    }
+}
+
 static const int open_modeflags[12] = {
     O_RDONLY,
     O_RDONLY | O_BINARY,
@@ -209,7 +337,14 @@ void Syscalls::handle_riscv_ebreak()
     case 0x4:
     {
         std::string path = this->read_user_string(this->iss.regfile.regs[11]);
-        printf("%s", path.c_str());
+        if (this->console_flush_policy == SYSCALLS_CONSOLE_FLUSH_ALWAYS)
+        {
+            printf("%s", path.c_str());
+        }
+        else
+        {
+            this->console_write(STDOUT_FILENO, (uint8_t *)path.c_str(), path.size());
+        }
         break;
     }
 
@@ -249,25 +384,31 @@ void Syscalls::handle_riscv_ebreak()
             return;
         }
 
-        uint8_t buffer[1024];
-        int size = args[2];
+        iss_reg_t size = args[2];
         iss_reg_t addr = args[1];
+        std::vector<uint8_t> buffer(std::min(size, (iss_reg_t)SYSCALLS_CHUNK_SIZE));
         while (size)
         {
-            int iter_size = 1024;
-            if (size < 1024)
-                iter_size = size;
+            iss_reg_t iter_size = std::min(size, (iss_reg_t)SYSCALLS_CHUNK_SIZE);
 
-            if (this->user_access(addr, buffer, iter_size, false))
+            if (this->user_access(addr, buffer.data(), iter_size, false))
             {
                 this->iss.regfile.regs[10] = -1;
                 return;
             }
 
-            if (write(args[0], (void *)(long)buffer, iter_size) != iter_size)
-                break;
+            ssize_t written;
+            if (args[0] == STDOUT_FILENO || args[0] == STDERR_FILENO)
+            {
+                written = this->console_write(args[0], buffer.data(), iter_size);
+            }
+            else
+            {
+                written = write(args[0], buffer.data(), iter_size);
+            }
 
-            fsync(args[0]);
+            if (written != (ssize_t)iter_size)
+                break;
 
             size -= iter_size;
             addr += iter_size;
@@ -286,16 +427,19 @@ void Syscalls::handle_riscv_ebreak()
             return;
         }
 
-        uint8_t buffer[1024];
-        int size = args[2];
+        if (args[0] == STDIN_FILENO)
+        {
+            this->console_flush();
+        }
+
+        iss_reg_t size = args[2];
         iss_reg_t addr = args[1];
+        std::vector<uint8_t> buffer(std::min(size, (iss_reg_t)SYSCALLS_CHUNK_SIZE));
         while (size)
         {
-            int iter_size = 1024;
-            if (size < 1024)
-                iter_size = size;
+            iss_reg_t iter_size = std::min(size, (iss_reg_t)SYSCALLS_CHUNK_SIZE);
 
-            int read_size = read(args[0], (void *)(long)buffer, iter_size);
+            int read_size = read(args[0], buffer.data(), iter_size);
 
             if (read_size <= 0)
             {
@@ -310,7 +454,7 @@ void Syscalls::handle_riscv_ebreak()
                 }
             }
 
-            if (this->user_access(addr, buffer, read_size, true))
+            if (this->user_access(addr, buffer.data(), read_size, true))
             {
                 this->iss.regfile.regs[10] = -1;
                 return;
@@ -333,12 +477,21 @@ void Syscalls::handle_riscv_ebreak()
             this->iss.regfile.regs[10] = -1;
             return;
         }
-        putchar(args[0]);
+        if (this->console_flush_policy == SYSCALLS_CONSOLE_FLUSH_ALWAYS)
+        {
+            putchar(args[0]);
+        }
+        else
+        {
+            uint8_t c = args[0];
+            this->console_write(STDOUT_FILENO, &c, 1);
+        }
         break;
     }
 
     case 0x7:
     {
+        this->console_flush();
         this->iss.regfile.regs[10] = getchar();
         break;
     }
@@ -361,6 +514,8 @@ void Syscalls::handle_riscv_ebreak()
     {
         int status = this->iss.regfile.regs[11] == 0x20026 ? 0 : 1;
 
+        this->console_flush();
+
         this->iss.top.time.get_engine()->quit(status & 0x7fffffff);
 
         break;
@@ -20,9 +20,15 @@
  */
 
 #include "cpu/iss/include/iss.hpp"
+#include "cpu/iss/include/insn_trace_bin.hpp"
 #include <string.h>
 #include <algorithm>
 #include <vector>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 
 Trace::Trace(Iss &iss)
     : iss(iss)
@@ -34,11 +40,10 @@ void Trace::build()
 {
     this->iss.top.traces.new_trace("insn", &this->insn_trace, vp::DEBUG);
     this->insn_trace.register_callback(std::bind(&Trace::insn_trace_callback, this));
-    iss_trace_init(&this->iss);
 
     for (auto x : this->iss.top.get_js_config()->get("**/debug_binaries")->get_elems())
     {
-        iss_register_debug_info(&this->iss, x->get_str().c_str());
+        this->register_debug_info(x->get_str());
     }
 
 }
@@ -52,95 +57,55 @@ void Trace::reset(bool active)
     }
 }
 
-#define PC_INFO_ARRAY_SIZE (64 * 1024)
-
 #define MAX_DEBUG_INFO_WIDTH 32
 
-class iss_pc_info
-{
-public:
-    unsigned int base;
-    char *func;
-    char *inline_func;
-    char *file;
-    int line;
-    iss_pc_info *next;
-};
-
-static bool pc_infos_is_init = false;
-static iss_pc_info *pc_infos[PC_INFO_ARRAY_SIZE];
-static std::vector<std::string> binaries;
-
-static void add_pc_info(unsigned int base, char *func, char *inline_func, char *file, int line)
+void Trace::register_debug_info(std::string path)
 {
-    iss_pc_info *pc_info = new iss_pc_info();
-
-    int index = base & (PC_INFO_ARRAY_SIZE - 1);
-    pc_info->next = pc_infos[index];
-    pc_infos[index] = pc_info;
-
-    pc_info->base = base;
-    pc_info->func = strdup(func);
-    pc_info->inline_func = strdup(inline_func);
-    pc_info->file = strdup(file);
-    pc_info->line = line;
-}
-
-static iss_pc_info *get_pc_info(unsigned int base)
-{
-    int index = base & (PC_INFO_ARRAY_SIZE - 1);
-
-    iss_pc_info *pc_info = pc_infos[index];
+    this->has_debug_info = true;
 
-    while (pc_info && pc_info->base != base)
+    std::shared_ptr<DebugInfo> debug_info = DebugInfo::get(path);
+    if (debug_info != NULL &&
+        std::find(this->debug_infos.begin(), this->debug_infos.end(), debug_info) == this->debug_infos.end())
     {
-        pc_info = pc_info->next;
+        this->debug_infos.push_back(debug_info);
     }
-
-    return pc_info;
 }
 
-int iss_trace_pc_info(iss_addr_t addr, const char **func, const char **inline_func, const char **file, int *line)
+bool Trace::get_pc_info(iss_addr_t addr, const char **func, const char **inline_func, const char **file, int *line)
 {
-    iss_pc_info *info = get_pc_info(addr);
-    if (info == NULL)
-        return -1;
-
-    *func = info->func;
-    *inline_func = info->inline_func;
-    *file = info->file;
-    *line = info->line;
-
-    return 0;
-}
-
-void iss_register_debug_info(Iss *iss, const char *binary)
-{
-    if (std::find(binaries.begin(), binaries.end(), std::string(binary)) != binaries.end())
-        return;
+    DebugInfo *debug_info = this->last_debug_info;
+    const debug_info_range_t *range = this->last_debug_range;
 
-    binaries.push_back(std::string(binary));
-
-    FILE *file = fopen(binary, "r");
-    if (file != NULL)
+    if (range == NULL || addr < range->base || addr >= range->end)
     {
-        char *line = NULL;
-        size_t len = 0;
-        ssize_t read;
-        while ((read = getline(&line, &len, file)) != -1)
+        range = NULL;
+
+        // The last registered binary has priority if several of them give the same address
+        for (auto it = this->debug_infos.rbegin(); it != this->debug_infos.rend(); it++)
         {
-            char *token = strtok(line, " ");
-            char *tokens[5];
-            int index = 0;
-            while (token)
+            range = (*it)->find(addr);
+            if (range != NULL)
             {
-                tokens[index++] = token;
-                token = strtok(NULL, " ");
+                debug_info = it->get();
+                break;
             }
-            if (index == 5)
-                add_pc_info(strtol(tokens[0], NULL, 16), tokens[1], tokens[2], tokens[3], atoi(tokens[4]));
         }
+
+        if (range == NULL)
+        {
+            return false;
+        }
+
+        this->last_debug_info = debug_info;
+        this->last_debug_range = range;
     }
+
+    *func = debug_info->get_str(range->func);
+    *inline_func = debug_info->get_str(range->inline_func);
+    *file = debug_info->get_str(range->file);
+    *line = range->line;
+
+    return true;
 }
 
 static inline char iss_trace_get_mode(int mode)
@@ -413,18 +378,11 @@ static char *iss_trace_dump_arg(Iss *iss, iss_insn_t *insn, char *buff, iss_insn
 
 static char *trace_dump_debug(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *buff)
 {
-    char *name = (char *)"-";
-    char *file = (char *)"-";
-    uint32_t line = 0;
-    char *inline_func = (char *)"-";
-    iss_pc_info *pc_info = get_pc_info(pc);
-    if (pc_info)
-    {
-        name = pc_info->func;
-        file = pc_info->file;
-        line = pc_info->line;
-        inline_func = pc_info->inline_func;
-    }
+    const char *name = "-";
+    const char *file = "-";
+    int line = 0;
+    const char *inline_func = "-";
+    iss->trace.get_pc_info(pc, &name, &inline_func, &file, &line);
 
     int line_len = sprintf(buff, ":%d", line);
     if (line_len > 5)
@@ -452,6 +410,7 @@ static char *trace_dump_debug(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *bu
 
 static void iss_trace_dump_insn(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *buff, int buffer_size, iss_insn_arg_t *saved_args, bool is_long, int mode, bool is_event)
 {
+    iss_insn_debug_t *debug = iss->insn_cache.insn_debug_get(insn);
 
     char *init_buff = buff;
     static int max_len = 20;
@@ -460,7 +419,7 @@ static void iss_trace_dump_insn(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *
 
     if (is_long)
     {
-        if (binaries.size())
+        if (iss->trace.has_debug_info)
             buff = trace_dump_debug(iss, insn, pc, buff);
     }
 
@@ -486,7 +445,7 @@ static void iss_trace_dump_insn(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *
 
     char *start_buff = buff;
 
-    buff += sprintf(buff, "%s ", insn->decoder_item->u.insn.label);
+    buff += sprintf(buff, "%s ", insn->cold->decoder_item->u.insn.label);
 
     if (is_long)
     {
@@ -503,10 +462,10 @@ static void iss_trace_dump_insn(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *
 
     iss_decoder_arg_t *prev_arg = NULL;
     start_buff = buff;
-    int nb_args = insn->decoder_item->u.insn.nb_args;
+    int nb_args = insn->cold->decoder_item->u.insn.nb_args;
     for (int i = 0; i < nb_args; i++)
     {
-        buff = iss_trace_dump_arg(iss, insn, buff, &insn->args[i], &insn->decoder_item->u.insn.args[i], &prev_arg, is_long);
+        buff = iss_trace_dump_arg(iss, insn, buff, &debug->args[i], &insn->cold->decoder_item->u.insn.args[i], &prev_arg, is_long);
     }
     if (nb_args != 0)
         buff += sprintf(buff, " ");
@@ -529,11 +488,11 @@ static void iss_trace_dump_insn(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *
         prev_arg = NULL;
         for (int i = 0; i < nb_args; i++)
         {
-            buff = iss_trace_dump_arg_value(iss, insn, buff, &insn->args[i], &insn->decoder_item->u.insn.args[i], &saved_args[i], &prev_arg, 1, is_long);
+            buff = iss_trace_dump_arg_value(iss, insn, buff, &debug->args[i], &insn->cold->decoder_item->u.insn.args[i], &saved_args[i], &prev_arg, 1, is_long);
         }
         for (int i = 0; i < nb_args; i++)
         {
-            buff = iss_trace_dump_arg_value(iss, insn, buff, &insn->args[i], &insn->decoder_item->u.insn.args[i], &saved_args[i], &prev_arg, 0, is_long);
+            buff = iss_trace_dump_arg_value(iss, insn, buff, &debug->args[i], &insn->cold->decoder_item->u.insn.args[i], &saved_args[i], &prev_arg, 0, is_long);
         }
 
         buff += sprintf(buff, "\n");
@@ -591,16 +550,29 @@ static void iss_trace_save_arg(Iss *iss, iss_insn_t *insn, iss_insn_arg_t *insn_
 
 void iss_trace_save_args(Iss *iss, iss_insn_t *insn, iss_insn_arg_t saved_args[], bool save_out)
 {
-    for (int i = 0; i < insn->decoder_item->u.insn.nb_args; i++)
+    iss_insn_debug_t *debug = iss->insn_cache.insn_debug_get(insn);
+
+    for (int i = 0; i < insn->cold->decoder_item->u.insn.nb_args; i++)
     {
-        iss_decoder_arg_t *arg = &insn->decoder_item->u.insn.args[i];
-        iss_trace_save_arg(iss, insn, &insn->args[i], arg, &saved_args[i], save_out);
+        iss_decoder_arg_t *arg = &insn->cold->decoder_item->u.insn.args[i];
+        iss_trace_save_arg(iss, insn, &debug->args[i], arg, &saved_args[i], save_out);
     }
 }
 
 void iss_trace_dump(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 {
-    if (!insn->is_macro_op || iss->top.traces.get_trace_engine()->get_format() == TRACE_FORMAT_LONG)
+    int format = iss->top.traces.get_trace_engine()->get_format();
+
+    if (format == TRACE_FORMAT_BINARY)
+    {
+        // Macro ops are dumped with a flag, the decoder decides whether they are displayed
+        if (iss->trace.insn_trace.get_active(vp::Trace::LEVEL_DEBUG))
+        {
+            iss_trace_save_args(iss, insn, iss->trace.saved_args, true);
+            iss->trace.dump_binary(insn, pc);
+        }
+    }
+    else if (!insn->cold->is_macro_op || format == TRACE_FORMAT_LONG)
     {
         char buffer[1024];
 
@@ -646,7 +618,7 @@ iss_reg_t iss_exec_insn_with_trace(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 
         iss_trace_save_args(iss, insn, iss->trace.saved_args, false);
 
-        next_insn = insn->saved_handler(iss, insn, pc);
+        next_insn = insn->cold->saved_handler(iss, insn, pc);
 
         if (!iss->exec.is_stalled() && iss->trace.dump_trace_enabled && !iss->trace.skip_insn_dump)
             iss_trace_dump(iss, insn, pc);
@@ -655,19 +627,488 @@ iss_reg_t iss_exec_insn_with_trace(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
     }
     else
     {
-        next_insn = insn->saved_handler(iss, insn, pc);
+        next_insn = insn->cold->saved_handler(iss, insn, pc);
     }
 
     return next_insn;
 }
 
-void iss_trace_init(Iss *iss)
+// The binary format uses the same argument encoding as the decoder, so that argument types
+// and flags can be dumped as they are
+static_assert(ISS_DECODER_ARG_TYPE_OUT_REG == INSN_TRACE_BIN_ARG_OUT_REG &&
+    ISS_DECODER_ARG_TYPE_IN_REG == INSN_TRACE_BIN_ARG_IN_REG &&
+    ISS_DECODER_ARG_TYPE_UIMM == INSN_TRACE_BIN_ARG_UIMM &&
+    ISS_DECODER_ARG_TYPE_SIMM == INSN_TRACE_BIN_ARG_SIMM &&
+    ISS_DECODER_ARG_TYPE_INDIRECT_IMM == INSN_TRACE_BIN_ARG_INDIRECT_IMM &&
+    ISS_DECODER_ARG_TYPE_INDIRECT_REG == INSN_TRACE_BIN_ARG_INDIRECT_REG &&
+    ISS_DECODER_ARG_TYPE_FLAG == INSN_TRACE_BIN_ARG_FLAG, "Wrong argument type encoding");
+static_assert(ISS_DECODER_ARG_FLAG_POSTINC == INSN_TRACE_BIN_ARG_FLAG_POSTINC &&
+    ISS_DECODER_ARG_FLAG_PREINC == INSN_TRACE_BIN_ARG_FLAG_PREINC &&
+    ISS_DECODER_ARG_FLAG_FREG == INSN_TRACE_BIN_ARG_FLAG_FREG &&
+    ISS_DECODER_ARG_FLAG_REG64 == INSN_TRACE_BIN_ARG_FLAG_REG64, "Wrong argument flag encoding");
+
+// Number of chunks of each stream. One is filled by the core while the others are being
+// written, the core only waits for the file when all of them are pending.
+#define INSN_TRACE_BIN_NB_CHUNKS 4
+
+class InsnTraceBinStream;
+
+class InsnTraceBinChunk
 {
-    if (!pc_infos_is_init)
+public:
+    InsnTraceBinStream *stream;
+    std::vector<uint8_t> data;
+    size_t size;
+};
+
+// Binary trace file, shared by all the streams dumped to the same file. Chunks are written by a
+// background thread so that the simulation does not wait for the file system.
+class InsnTraceBinFile
+{
+public:
+    InsnTraceBinFile(FILE *file);
+    void push(InsnTraceBinChunk *chunk);
+    void close();
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    int nb_streams = 0;
+
+private:
+    void writer_routine();
+
+    FILE *file;
+    std::thread *thread;
+    std::deque<InsnTraceBinChunk *> pending_chunks;
+    bool closing = false;
+};
+
+// Records of one core, gathered into chunks which are sent to the file when they are full
+class InsnTraceBinStream
+{
+public:
+    InsnTraceBinStream(InsnTraceBinFile *file);
+
+    // Get room for a record of the specified maximum size
+    inline uint8_t *reserve(size_t size);
+    // Account the record which has been written up to the specified pointer
+    inline void commit(uint8_t *end);
+    // Send the current chunk to the file and get a free one, waiting if needed
+    void flush();
+
+    int id;
+    int nb_descs = 0;
+    iss_reg_t pc = 0;
+    int64_t time = 0;
+    int64_t cycles = 0;
+
+    // Chunks which can be filled, protected by the file mutex
+    std::vector<InsnTraceBinChunk *> free_chunks;
+
+private:
+    InsnTraceBinFile *file;
+    InsnTraceBinChunk *current;
+};
+
+// Shared by the cores of all the engines, which may run in different threads
+static std::mutex bin_mutex;
+static std::map<FILE *, InsnTraceBinFile *> bin_files;
+static std::vector<InsnTraceBinStream *> bin_streams;
+
+static void iss_trace_bin_close()
+{
+    std::unique_lock<std::mutex> lock(bin_mutex);
+
+    for (InsnTraceBinStream *stream : bin_streams)
+    {
+        stream->flush();
+    }
+
+    for (auto &x : bin_files)
+    {
+        x.second->close();
+    }
+}
+
+InsnTraceBinFile::InsnTraceBinFile(FILE *file)
+    : file(file)
+{
+    uint32_t version = INSN_TRACE_BIN_VERSION;
+    fwrite(INSN_TRACE_BIN_MAGIC, 1, INSN_TRACE_BIN_MAGIC_SIZE, this->file);
+    fwrite(&version, 1, sizeof(version), this->file);
+
+    this->thread = new std::thread(&InsnTraceBinFile::writer_routine, this);
+}
+
+void InsnTraceBinFile::push(InsnTraceBinChunk *chunk)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->pending_chunks.push_back(chunk);
+    this->cond.notify_all();
+}
+
+void InsnTraceBinFile::close()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->closing = true;
+    this->cond.notify_all();
+    lock.unlock();
+
+    this->thread->join();
+    fflush(this->file);
+}
+
+void InsnTraceBinFile::writer_routine()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (1)
+    {
+        while (this->pending_chunks.size() == 0 && !this->closing)
+        {
+            this->cond.wait(lock);
+        }
+
+        if (this->pending_chunks.size() == 0)
+        {
+            break;
+        }
+
+        InsnTraceBinChunk *chunk = this->pending_chunks.front();
+        this->pending_chunks.pop_front();
+
+        lock.unlock();
+
+        uint32_t header[2] = { (uint32_t)chunk->stream->id, (uint32_t)chunk->size };
+        fwrite(header, 1, sizeof(header), this->file);
+        fwrite(chunk->data.data(), 1, chunk->size, this->file);
+
+        lock.lock();
+
+        chunk->size = 0;
+        chunk->stream->free_chunks.push_back(chunk);
+        this->cond.notify_all();
+    }
+}
+
+InsnTraceBinStream::InsnTraceBinStream(InsnTraceBinFile *file)
+    : file(file)
+{
+    this->id = file->nb_streams++;
+
+    for (int i = 0; i < INSN_TRACE_BIN_NB_CHUNKS; i++)
     {
-        pc_infos_is_init = true;
-        memset(pc_infos, 0, sizeof(pc_infos));
+        InsnTraceBinChunk *chunk = new InsnTraceBinChunk();
+        chunk->stream = this;
+        chunk->data.resize(INSN_TRACE_BIN_CHUNK_SIZE);
+        chunk->size = 0;
+        this->free_chunks.push_back(chunk);
     }
+
+    this->current = this->free_chunks.back();
+    this->free_chunks.pop_back();
+}
+
+inline uint8_t *InsnTraceBinStream::reserve(size_t size)
+{
+    if (this->current->data.size() - this->current->size < size)
+    {
+        this->flush();
+
+        // Only records with huge strings can be bigger than a chunk
+        if (this->current->data.size() < size)
+        {
+            this->current->data.resize(size);
+        }
+    }
+
+    return this->current->data.data() + this->current->size;
+}
+
+inline void InsnTraceBinStream::commit(uint8_t *end)
+{
+    this->current->size = end - this->current->data.data();
+}
+
+void InsnTraceBinStream::flush()
+{
+    if (this->current->size == 0)
+    {
+        return;
+    }
+
+    this->file->push(this->current);
+
+    std::unique_lock<std::mutex> lock(this->file->mutex);
+    while (this->free_chunks.size() == 0)
+    {
+        this->file->cond.wait(lock);
+    }
+
+    this->current = this->free_chunks.back();
+    this->free_chunks.pop_back();
+}
+
+// The validity is given inverted, so that valid bits are 0
+static inline uint8_t *iss_trace_bin_put_reg(uint8_t *buff, bool memcheck, uint64_t value,
+    uint64_t invalid)
+{
+    buff = insn_trace_bin_put(buff, value);
+    if (memcheck)
+    {
+        buff = insn_trace_bin_put(buff, invalid);
+    }
+    return buff;
+}
+
+// Records would be interleaved with the text of the other traces, which are only allowed if they
+// are also instruction traces, since they are then dumped in binary too
+void Trace::check_binary_file(FILE *file)
+{
+    if (file == stdout || file == stderr)
+    {
+        this->iss.top.get_trace()->fatal("The binary instruction trace must be dumped to a file "
+            "(e.g. --trace=insn:insn.bin)\n");
+    }
+
+    for (vp::Trace *trace : this->iss.top.traces.get_trace_engine()->get_file_traces(file))
+    {
+        std::string path = trace->get_full_path();
+        if (path.size() < 5 || path.compare(path.size() - 5, 5, "/insn") != 0)
+        {
+            this->iss.top.get_trace()->fatal("The binary instruction trace can not be dumped to "
+                "the same file as text trace %s\n", path.c_str());
+        }
+    }
+}
+
+void Trace::dump_binary(iss_insn_t *insn, iss_reg_t pc)
+{
+    InsnTraceBinStream *stream = this->bin_stream;
+    bool memcheck = this->iss.top.traces.get_trace_engine()->is_memcheck_enabled();
+    iss_insn_debug_t *debug = this->iss.insn_cache.insn_debug_get(insn);
+    iss_decoder_item_t *item = insn->cold->decoder_item;
+    int nb_args = item->u.insn.nb_args;
+    uint8_t *buff;
+
+    if (stream == NULL)
+    {
+        FILE *trace_file = this->insn_trace.trace_file;
+        std::unique_lock<std::mutex> lock(bin_mutex);
+
+        InsnTraceBinFile *file;
+        auto it = bin_files.find(trace_file);
+        if (it != bin_files.end())
+        {
+            file = it->second;
+        }
+        else
+        {
+            this->check_binary_file(trace_file);
+
+            if (bin_files.size() == 0)
+            {
+                atexit(iss_trace_bin_close);
+            }
+
+            file = new InsnTraceBinFile(trace_file);
+            bin_files[trace_file] = file;
+        }
+
+        stream = new InsnTraceBinStream(file);
+        bin_streams.push_back(stream);
+        this->bin_stream = stream;
+        lock.unlock();
+
+        std::string path = this->insn_trace.get_full_path();
+        int flags = 0;
+        if (memcheck)
+            flags |= INSN_TRACE_BIN_STREAM_MEMCHECK;
+        if (this->iss.decode.has_double)
+            flags |= INSN_TRACE_BIN_STREAM_DOUBLE;
+#ifdef ISS_SINGLE_REGFILE
+        flags |= INSN_TRACE_BIN_STREAM_SINGLE_REGFILE;
+#endif
+
+        buff = stream->reserve(1 + INSN_TRACE_BIN_INT_SIZE * 4 + path.size());
+        *buff++ = INSN_TRACE_BIN_STREAM;
+        buff = insn_trace_bin_put_str(buff, path.c_str());
+        buff = insn_trace_bin_put(buff, this->iss.top.traces.get_trace_engine()->get_max_path_len());
+        buff = insn_trace_bin_put(buff, ISS_REG_WIDTH);
+        buff = insn_trace_bin_put(buff, flags);
+        stream->commit(buff);
+    }
+
+    // Static information is only dumped the first time the instruction is executed
+    if (debug->trace_desc == -1)
+    {
+        debug->trace_desc = stream->nb_descs++;
+
+        const char *func = "-";
+        const char *inline_func = "-";
+        const char *file = "-";
+        int line = 0;
+        this->get_pc_info(pc, &func, &inline_func, &file, &line);
+        size_t size = 1 + INSN_TRACE_BIN_INT_SIZE * 7 + strlen(inline_func) +
+            strlen(item->u.insn.label);
+        for (int i = 0; i < nb_args; i++)
+        {
+            size += INSN_TRACE_BIN_INT_SIZE * 6 + debug->args[i].name.size();
+        }
+
+        int flags = 0;
+        if (insn->cold->is_macro_op)
+            flags |= INSN_TRACE_BIN_DESC_MACRO_OP;
+        if (this->has_debug_info)
+            flags |= INSN_TRACE_BIN_DESC_DEBUG;
+
+        buff = stream->reserve(size);
+        *buff++ = INSN_TRACE_BIN_DESC;
+        buff = insn_trace_bin_put(buff, debug->trace_desc);
+        buff = insn_trace_bin_put(buff, insn->opcode);
+        buff = insn_trace_bin_put(buff, flags);
+        if (this->has_debug_info)
+        {
+            buff = insn_trace_bin_put_str(buff, inline_func);
+            buff = insn_trace_bin_put(buff, line);
+        }
+        buff = insn_trace_bin_put_str(buff, item->u.insn.label);
+        buff = insn_trace_bin_put(buff, nb_args);
+
+        for (int i = 0; i < nb_args; i++)
+        {
+            iss_decoder_arg_t *arg = &item->u.insn.args[i];
+            iss_insn_arg_t *insn_arg = &debug->args[i];
+            int attrs = 0;
+
+            if ((arg->type == ISS_DECODER_ARG_TYPE_OUT_REG || arg->type == ISS_DECODER_ARG_TYPE_IN_REG) &&
+                arg->u.reg.dump_name)
+                attrs |= INSN_TRACE_BIN_ARG_DUMP_REG;
+            if ((arg->type == ISS_DECODER_ARG_TYPE_UIMM || arg->type == ISS_DECODER_ARG_TYPE_SIMM) &&
+                insn_arg->flags & ISS_DECODER_ARG_FLAG_DUMP_NAME)
+                attrs |= INSN_TRACE_BIN_ARG_NAME;
+
+            *buff++ = arg->type;
+            buff = insn_trace_bin_put(buff, arg->flags);
+            buff = insn_trace_bin_put(buff, attrs);
+            if (attrs & INSN_TRACE_BIN_ARG_NAME)
+            {
+                buff = insn_trace_bin_put_str(buff, insn_arg->name.c_str());
+            }
+
+            switch (arg->type)
+            {
+                case ISS_DECODER_ARG_TYPE_OUT_REG:
+                case ISS_DECODER_ARG_TYPE_IN_REG:
+                    buff = insn_trace_bin_put(buff, insn_arg->u.reg.index);
+                    break;
+                case ISS_DECODER_ARG_TYPE_UIMM:
+                    buff = insn_trace_bin_put(buff, insn_arg->u.uim.value);
+                    break;
+                case ISS_DECODER_ARG_TYPE_SIMM:
+                    buff = insn_trace_bin_put_signed(buff, insn_arg->u.sim.value);
+                    break;
+                case ISS_DECODER_ARG_TYPE_INDIRECT_IMM:
+                    buff = insn_trace_bin_put(buff, insn_arg->u.indirect_imm.reg_index);
+                    buff = insn_trace_bin_put_signed(buff, insn_arg->u.indirect_imm.imm);
+                    break;
+                case ISS_DECODER_ARG_TYPE_INDIRECT_REG:
+                    buff = insn_trace_bin_put(buff, insn_arg->u.indirect_reg.offset_reg_index);
+                    buff = insn_trace_bin_put(buff, insn_arg->u.indirect_reg.base_reg_index);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        stream->commit(buff);
+    }
+
+    int64_t time = -1;
+    int64_t cycles = -1;
+    if (this->iss.top.clock.get_engine())
+    {
+        cycles = this->iss.top.clock.get_engine()->get_cycles();
+    }
+    if (this->iss.top.time.get_engine())
+    {
+        time = this->iss.top.time.get_engine()->get_time();
+    }
+
+    int flags = 0;
+    size_t size = 1 + INSN_TRACE_BIN_INT_SIZE * (7 + nb_args * 4);
+    if (this->has_reg_dump)
+    {
+        flags |= INSN_TRACE_BIN_INSN_REG_DUMP;
+    }
+    if (this->has_str_dump)
+    {
+        flags |= INSN_TRACE_BIN_INSN_STR_DUMP;
+        size += INSN_TRACE_BIN_INT_SIZE + this->str_dump.size();
+    }
+
+    buff = stream->reserve(size);
+    *buff++ = INSN_TRACE_BIN_INSN;
+    buff = insn_trace_bin_put(buff, debug->trace_desc);
+    buff = insn_trace_bin_put(buff, flags);
+    buff = insn_trace_bin_put_signed(buff, (int64_t)pc - (int64_t)stream->pc);
+    buff = insn_trace_bin_put_signed(buff, time - stream->time);
+    buff = insn_trace_bin_put_signed(buff, cycles - stream->cycles);
+    buff = insn_trace_bin_put(buff, this->priv_mode);
+    if (this->has_reg_dump)
+    {
+        buff = insn_trace_bin_put(buff, this->reg_dump);
+    }
+    if (this->has_str_dump)
+    {
+        buff = insn_trace_bin_put_str(buff, this->str_dump.c_str());
+    }
+
+    stream->pc = pc;
+    stream->time = time;
+    stream->cycles = cycles;
+
+    for (int i = 0; i < nb_args; i++)
+    {
+        iss_decoder_arg_t *arg = &item->u.insn.args[i];
+        iss_insn_arg_t *insn_arg = &debug->args[i];
+        iss_insn_arg_t *saved_arg = &this->saved_args[i];
+
+        if (arg->type == ISS_DECODER_ARG_TYPE_OUT_REG || arg->type == ISS_DECODER_ARG_TYPE_IN_REG)
+        {
+            if (arg->flags & ISS_DECODER_ARG_FLAG_FREG)
+            {
+                buff = insn_trace_bin_put(buff, saved_arg->u.reg.value_64);
+            }
+            else if (insn_arg->u.reg.index != 0)
+            {
+                if (arg->flags & ISS_DECODER_ARG_FLAG_REG64)
+                {
+                    buff = iss_trace_bin_put_reg(buff, memcheck, saved_arg->u.reg.value_64,
+                        ~saved_arg->u.reg.memcheck_value_64);
+                }
+                else
+                {
+                    buff = iss_trace_bin_put_reg(buff, memcheck, saved_arg->u.reg.value,
+                        (iss_reg_t)~saved_arg->u.reg.memcheck_value);
+                }
+            }
+        }
+        else if (arg->type == ISS_DECODER_ARG_TYPE_INDIRECT_IMM)
+        {
+            buff = iss_trace_bin_put_reg(buff, memcheck, saved_arg->u.indirect_imm.reg_value,
+                (iss_reg_t)~saved_arg->u.indirect_imm.memcheck_reg_value);
+        }
+        else if (arg->type == ISS_DECODER_ARG_TYPE_INDIRECT_REG)
+        {
+            buff = iss_trace_bin_put_reg(buff, memcheck, saved_arg->u.indirect_reg.offset_reg_value,
+                (iss_reg_t)~saved_arg->u.indirect_reg.memcheck_offset_reg_value);
+            buff = iss_trace_bin_put_reg(buff, memcheck, saved_arg->u.indirect_reg.base_reg_value,
+                (iss_reg_t)~saved_arg->u.indirect_reg.memcheck_base_reg_value);
+        }
+    }
+
+    stream->commit(buff);
 }
 
 void Trace::dump_debug_traces()
@@ -675,7 +1116,7 @@ void Trace::dump_debug_traces()
     const char *func, *inline_func, *file;
     int line;
 
-    if (!iss_trace_pc_info(this->iss.exec.current_insn, &func, &inline_func, &file, &line))
+    if (this->get_pc_info(this->iss.exec.current_insn, &func, &inline_func, &file, &line))
     {
         this->iss.timing.func_trace_event.event_string(func);
         this->iss.timing.inline_trace_event.event_string(inline_func);
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Decode-throughput benchmark of the decoder trees generated by isa_gen, run over every supported
+// ISA combination, see decode_bench_gen.py.
+// For each ISA, opcodes are decoded with the group lookup of the decoder, which reads the
+// generated tables, and with the previous lookup, which scans every group and keeps track of its
+// OTHERS item. Both must find the same instruction for every opcode. Two opcode mixes are
+// decoded: valid opcodes, generated from the encodings of randomly chosen instructions, and
+// random 32-bit words, most of which are illegal for small ISAs. The host time per decoded opcode
+// and the number of group entries read per opcode are reported for both lookups.
+//
+// Usage: gvsoc_decode_bench [<opcodes per mix> [<passes>]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include <cpu/iss/tools/decode_bench.hpp>
+
+static uint64_t rand_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t rand_get()
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+    return rand_state;
+}
+
+iss_reg_t decode_bench_exec(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
+{
+    return pc;
+}
+
+// Same walk as the decoder, returns the instruction or NULL if the opcode is illegal
+static inline iss_decoder_item_t *decode_table(iss_decoder_item_t *item, iss_opcode_t opcode,
+    int64_t &nb_lookups)
+{
+    while (item != NULL && !item->is_insn)
+    {
+        item = iss_decoder_group_get(item, opcode, nb_lookups);
+    }
+
+    return item != NULL && item->is_active ? item : NULL;
+}
+
+// Previous walk, scanning all the items of each group
+static inline iss_decoder_item_t *decode_scan(iss_decoder_item_t *item, iss_opcode_t opcode,
+    int64_t &nb_lookups)
+{
+    while (item != NULL && !item->is_insn)
+    {
+        iss_opcode_t group_opcode = (opcode >> item->u.group.bit) & ((1ULL << item->u.group.width) - 1);
+        iss_decoder_item_t *group_item = NULL;
+        iss_decoder_item_t *group_item_other = NULL;
+
+        for (int i = 0; i < item->u.group.nb_groups; i++)
+        {
+            iss_decoder_item_t *current = item->u.group.groups[i];
+            nb_lookups++;
+            if (group_opcode == current->opcode && !current->opcode_others)
+            {
+                group_item = current;
+                break;
+            }
+            if (current->opcode_others)
+                group_item_other = current;
+        }
+
+        item = group_item ? group_item : group_item_other;
+    }
+
+    return item != NULL && item->is_active ? item : NULL;
+}
+
+template<typename F>
+static double bench_ns(std::vector<iss_opcode_t> &opcodes, int nb_passes, F decode,
+    int64_t *nb_lookups)
+{
+    uintptr_t checksum = 0;
+    *nb_lookups = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < nb_passes; pass++)
+    {
+        for (iss_opcode_t opcode: opcodes)
+        {
+            checksum += (uintptr_t)decode(opcode, *nb_lookups);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Keeps the decoding from being optimized away
+    if (checksum == 1)
+    {
+        printf("\n");
+    }
+
+    *nb_lookups /= nb_passes;
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / nb_passes /
+        opcodes.size();
+}
+
+// Decode the opcodes with both lookups, returns the number of opcodes decoded differently
+static int bench_mix(decode_bench_isa_t *isa, const char *mix, std::vector<iss_opcode_t> &opcodes,
+    int nb_passes)
+{
+    int errors = 0;
+    int64_t nb_illegal = 0;
+    int64_t dummy = 0;
+
+    for (iss_opcode_t opcode: opcodes)
+    {
+        iss_decoder_item_t *item = decode_table(isa->tree, opcode, dummy);
+        iss_decoder_item_t *ref_item = decode_scan(isa->tree, opcode, dummy);
+        if (item != ref_item)
+        {
+            if (errors < 8)
+            {
+                printf("Error on %s, opcode 0x%08lx decoded as %s with tables and as %s by scanning\n",
+                    isa->name, (unsigned long)opcode, item ? item->u.insn.label : "illegal",
+                    ref_item ? ref_item->u.insn.label : "illegal");
+            }
+            errors++;
+        }
+        nb_illegal += item == NULL;
+    }
+
+    int64_t table_lookups, scan_lookups;
+    double table_ns = bench_ns(opcodes, nb_passes, [isa](iss_opcode_t opcode, int64_t &nb_lookups)
+        { return decode_table(isa->tree, opcode, nb_lookups); }, &table_lookups);
+    double scan_ns = bench_ns(opcodes, nb_passes, [isa](iss_opcode_t opcode, int64_t &nb_lookups)
+        { return decode_scan(isa->tree, opcode, nb_lookups); }, &scan_lookups);
+
+    printf("%-42s %5d %-6s %7.1f%% %8.2f %8.2f %7.2fx %7.2f %7.2f\n", isa->name, isa->nb_insns,
+        mix, 100.0 * nb_illegal / opcodes.size(), table_ns, scan_ns, scan_ns / table_ns,
+        (double)table_lookups / opcodes.size(), (double)scan_lookups / opcodes.size());
+
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    int nb_opcodes = argc > 1 ? strtol(argv[1], NULL, 0) : 1 << 20;
+    int nb_passes = argc > 2 ? strtol(argv[2], NULL, 0) : 8;
+    int errors = 0;
+
+    printf("%d opcodes per mix, %d passes, time in ns and group entries read per opcode\n",
+        nb_opcodes, nb_passes);
+    printf("%-42s %5s %-6s %8s %8s %8s %8s %7s %7s\n", "isa", "insns", "mix", "illegal",
+        "table", "scan", "speedup", "table", "scan");
+
+    std::vector<iss_opcode_t> valid_opcodes(nb_opcodes);
+    std::vector<iss_opcode_t> random_opcodes(nb_opcodes);
+
+    for (int i = 0; i < decode_bench_nb_isas; i++)
+    {
+        decode_bench_isa_t *isa = &decode_bench_isas[i];
+
+        for (int j = 0; j < nb_opcodes; j++)
+        {
+            decode_bench_encoding_t *encoding = &isa->encodings[rand_get() % isa->nb_encodings];
+            valid_opcodes[j] = ((uint32_t)rand_get() & ~encoding->mask) | encoding->match;
+            random_opcodes[j] = (uint32_t)rand_get();
+        }
+
+        errors += bench_mix(isa, "valid", valid_opcodes, nb_passes);
+        errors += bench_mix(isa, "random", random_opcodes, nb_passes);
+    }
+
+    if (errors)
+    {
+        printf("%d opcodes decoded differently with tables and by scanning\n", errors);
+    }
+
+    return errors ? 1 : 0;
+}
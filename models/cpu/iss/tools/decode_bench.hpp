@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Interface between decode_bench.cpp and the decoder trees generated by decode_bench_gen.py for
+// every supported ISA combination.
+
+#pragma once
+
+#include <cpu/iss/include/types.hpp>
+#include <cpu/iss/include/decode.hpp>
+
+// Encoding of an instruction, an opcode is this instruction if (opcode & mask) == match
+typedef struct
+{
+    uint32_t mask;
+    uint32_t match;
+} decode_bench_encoding_t;
+
+typedef struct
+{
+    const char *name;
+    iss_decoder_item_t *tree;
+    int nb_insns;
+    // Encodings of the active instructions
+    decode_bench_encoding_t *encodings;
+    int nb_encodings;
+} decode_bench_isa_t;
+
+// Handler of all the generated instructions, which are never executed
+iss_reg_t decode_bench_exec(Iss *iss, iss_insn_t *insn, iss_reg_t pc);
+
+extern decode_bench_isa_t decode_bench_isas[];
+extern int decode_bench_nb_isas;
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+
+#
+# Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+#                    University of Bologna
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+#
+# Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+#
+
+# Generates the decoder trees used by the decode-throughput benchmark, one for every ISA
+# combination which isa_gen accepts. The base ISAs are generated alone, and every combination of
+# the extensions is generated on top of rv32imafdc. Combinations whose instructions have the same
+# opcode, like PULP v2 and CORE-V, are not supported by isa_gen and are skipped.
+# The trees are generated by isa_gen as for the cores, except that the instructions point to a
+# single handler and have no arguments, since the benchmark only walks the trees. Each tree is
+# generated in its own namespace, together with the encodings of its active instructions, which
+# are used to generate valid opcodes.
+
+import argparse
+import io
+import itertools
+import os.path
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..'))
+
+from cpu.iss.isa_gen.isa_gen import *
+from cpu.iss.isa_gen.isa_riscv_gen import *
+from cpu.iss.isa_gen.isa_pulpv2 import *
+from cpu.iss.isa_gen.isa_pulpnn import *
+from cpu.iss.isa_gen.isa_rnnext import *
+from cpu.iss.isa_gen.isa_corev import *
+from cpu.iss.isa_gen.isa_rvv import *
+from cpu.iss.isa_gen.isa_smallfloats import *
+
+
+base_isas = ['rv32imac', 'rv32imafdc', 'rv64imafdc']
+
+# Extensions, with the other extensions they require
+extensions = {
+    'pulpv2': ([], lambda: [PulpV2()]),
+    'pulpnn': (['pulpv2'], lambda: [PulpNn(), RnnExt()]),
+    'corev': ([], lambda: [CoreV()]),
+    'rvv': ([], lambda: [Rv32v()]),
+    'smallfloat': ([], lambda: [Xf16(), Xf16alt(), Xf8(), Xfvec(), Xfaux()]),
+    'zcmp': ([], lambda: [Zcmp()]),
+}
+
+
+def get_combinations():
+    result = [(isa, isa, []) for isa in base_isas]
+
+    for nb_extensions in range(1, len(extensions) + 1):
+        for names in itertools.combinations(extensions.keys(), nb_extensions):
+            if any(dep not in names for name in names for dep in extensions[name][0]):
+                continue
+            result.append(('rv32imafdc_' + '_'.join(names), 'rv32imafdc', names))
+
+    return result
+
+
+def gen_isa(name, isa_string, extension_names):
+    subsets = []
+    for extension in extension_names:
+        subsets += extensions[extension][1]()
+
+    isa = RiscvIsa(name, isa_string, extensions=subsets)
+
+    insns = isa.get_insns()
+    for insn in insns:
+        insn.exec_func = 'decode_bench_exec'
+        insn.exec_func_fast = 'decode_bench_exec'
+        insn.decode = None
+        insn.args_format = []
+
+    # This raises an exception if several instructions have the same opcode
+    tree = DecodeTree(isa, insns)
+
+    source = io.StringIO()
+    source.write(f'namespace decode_bench_{name}\n{{\n\n')
+    tree.gen(source, isa)
+
+    source.write('static decode_bench_encoding_t encodings[] = {\n')
+    nb_encodings = 0
+    for insn in insns:
+        if not insn.active:
+            continue
+        mask = 0
+        match = 0
+        for bit in range(0, insn.len):
+            if insn.encoding[bit] in ['0', '1']:
+                mask |= 1 << bit
+                if insn.encoding[bit] == '1':
+                    match |= 1 << bit
+        source.write(f'    {{ 0x{mask:08x}, 0x{match:08x} }}, // {insn.label}\n')
+        nb_encodings += 1
+    source.write('};\n\n')
+    source.write('}\n\n')
+
+    return source.getvalue(), tree.get_name(), len(insns), nb_encodings
+
+
+parser = argparse.ArgumentParser(description='Generate the decoder trees of the decode benchmark')
+
+parser.add_argument("--source-file", dest="source_file", required=True, metavar="PATH",
+    help="Specify source output file")
+
+args = parser.parse_args()
+
+isas = []
+
+with open(args.source_file, 'w') as output:
+    output.write('#include <cpu/iss/tools/decode_bench.hpp>\n\n')
+
+    for name, isa_string, extension_names in get_combinations():
+        try:
+            source, tree_name, nb_insns, nb_encodings = gen_isa(name, isa_string, extension_names)
+        except Exception as e:
+            print(f'Skipping unsupported ISA {name}: {str(e).splitlines()[0]}')
+            continue
+
+        output.write(source)
+        isas.append((name, tree_name, nb_insns, nb_encodings))
+
+    output.write('decode_bench_isa_t decode_bench_isas[] = {\n')
+    for name, tree_name, nb_insns, nb_encodings in isas:
+        output.write(f'    {{ "{name}", &decode_bench_{name}::{tree_name}, {nb_insns}, '
+            f'decode_bench_{name}::encodings, {nb_encodings} }},\n')
+    output.write('};\n\n')
+    output.write(f'int decode_bench_nb_isas = {len(isas)};\n')
@@ -0,0 +1,806 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Decoder of the binary instruction traces dumped by the ISS with --trace-format=binary.
+// It prints the same text as the long or short instruction traces, with the instructions of all
+// the cores ordered by time, or gives the number of executions and the total duration in cycles
+// of each instruction label.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <inttypes.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <map>
+#include <queue>
+#include "insn_trace_bin.hpp"
+
+#define MAX_DEBUG_INFO_WIDTH 32
+
+class Arg
+{
+public:
+    int type;
+    int flags;
+    int attrs;
+    std::string name;
+    uint64_t index;
+    uint64_t index2;
+    int64_t imm;
+};
+
+class Desc
+{
+public:
+    uint64_t opcode;
+    int flags;
+    std::string debug;
+    std::string label;
+    std::vector<Arg> args;
+};
+
+// Register values used by an argument of an executed instruction
+class ArgValue
+{
+public:
+    uint64_t value[2];
+    uint64_t check[2];
+};
+
+class Insn
+{
+public:
+    Desc *desc;
+    int flags;
+    uint64_t pc;
+    int64_t time;
+    int64_t cycles;
+    int mode;
+    uint64_t reg_dump;
+    std::string str_dump;
+    ArgValue values[32];
+};
+
+class Stream
+{
+public:
+    Stream(int id) : id(id) {}
+
+    // Decode records until the next executed instruction, returns false at the end of the stream
+    bool next();
+
+    int id;
+    std::vector<uint8_t> data;
+    InsnTraceBinReader *reader = NULL;
+
+    std::string path;
+    int max_path_len = 0;
+    int reg_width = 32;
+    int flags = 0;
+    std::vector<Desc *> descs;
+    Insn insn = {};
+};
+
+class Decoder
+{
+public:
+    void dump_insn(Stream *stream, Insn *insn);
+
+    bool is_long = true;
+
+private:
+    std::string reg_name(Stream *stream, Arg *arg, uint64_t reg);
+    std::string reg_value(Stream *stream, Arg *arg, bool is_out, uint64_t reg, uint64_t value, uint64_t check);
+    std::string arg_value(Stream *stream, Arg *arg, ArgValue *value, bool dump_out);
+    std::string arg_str(Stream *stream, Arg *arg, Arg **prev_arg);
+
+    int max_len = 20;
+    int max_arg_len = 17;
+};
+
+static std::string format(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+static std::string format(const char *fmt, ...)
+{
+    char buffer[256];
+    va_list ap;
+    va_start(ap, fmt);
+    int len = vsnprintf(buffer, sizeof(buffer), fmt, ap);
+    va_end(ap);
+    return std::string(buffer, std::min(len, (int)sizeof(buffer) - 1));
+}
+
+static inline uint64_t reg_mask(Stream *stream)
+{
+    return stream->reg_width == 64 ? (uint64_t)-1 : ((uint64_t)1 << stream->reg_width) - 1;
+}
+
+static std::string full_reg(Stream *stream, uint64_t value)
+{
+    if (stream->reg_width == 64)
+    {
+        return format("%16.16" PRIx64, value);
+    }
+    return format("%8.8" PRIx32, (uint32_t)value);
+}
+
+static bool has_values(Arg *arg, uint64_t index)
+{
+    return index != 0 || arg->flags & INSN_TRACE_BIN_ARG_FLAG_FREG;
+}
+
+bool Stream::next()
+{
+    InsnTraceBinReader *reader = this->reader;
+
+    while (!reader->done() && !reader->error)
+    {
+        int type = reader->get_byte();
+
+        if (type == INSN_TRACE_BIN_STREAM)
+        {
+            this->path = reader->get_str();
+            this->max_path_len = reader->get();
+            this->reg_width = reader->get();
+            this->flags = reader->get();
+        }
+        else if (type == INSN_TRACE_BIN_DESC)
+        {
+            Desc *desc = new Desc();
+            uint64_t id = reader->get();
+            desc->opcode = reader->get();
+            desc->flags = reader->get();
+
+            if (desc->flags & INSN_TRACE_BIN_DESC_DEBUG)
+            {
+                std::string inline_func = reader->get_str();
+                uint64_t line = reader->get();
+
+                int line_len = std::min((int)format(":%" PRIu64, line).size(), 5);
+                int max_name_len = MAX_DEBUG_INFO_WIDTH - line_len;
+                desc->debug = inline_func.substr(0, max_name_len) + format(":%" PRIu64, line);
+                desc->debug.resize(MAX_DEBUG_INFO_WIDTH + 1, ' ');
+            }
+
+            desc->label = reader->get_str();
+            int nb_args = reader->get();
+            if (nb_args > 32)
+            {
+                reader->error = true;
+                break;
+            }
+
+            for (int i = 0; i < nb_args; i++)
+            {
+                Arg arg = {};
+                arg.type = reader->get_byte();
+                arg.flags = reader->get();
+                arg.attrs = reader->get();
+                if (arg.attrs & INSN_TRACE_BIN_ARG_NAME)
+                {
+                    arg.name = reader->get_str();
+                }
+
+                switch (arg.type)
+                {
+                    case INSN_TRACE_BIN_ARG_OUT_REG:
+                    case INSN_TRACE_BIN_ARG_IN_REG:
+                        arg.index = reader->get();
+                        break;
+                    case INSN_TRACE_BIN_ARG_UIMM:
+                        arg.imm = reader->get();
+                        break;
+                    case INSN_TRACE_BIN_ARG_SIMM:
+                        arg.imm = reader->get_signed();
+                        break;
+                    case INSN_TRACE_BIN_ARG_INDIRECT_IMM:
+                        arg.index = reader->get();
+                        arg.imm = reader->get_signed();
+                        break;
+                    case INSN_TRACE_BIN_ARG_INDIRECT_REG:
+                        arg.index = reader->get();
+                        arg.index2 = reader->get();
+                        break;
+                }
+                desc->args.push_back(arg);
+            }
+
+            if (id >= this->descs.size())
+            {
+                this->descs.resize(id + 1);
+            }
+            this->descs[id] = desc;
+        }
+        else if (type == INSN_TRACE_BIN_INSN)
+        {
+            Insn *insn = &this->insn;
+            bool memcheck = this->flags & INSN_TRACE_BIN_STREAM_MEMCHECK;
+
+            uint64_t id = reader->get();
+            if (id >= this->descs.size() || this->descs[id] == NULL)
+            {
+                reader->error = true;
+                break;
+            }
+
+            insn->desc = this->descs[id];
+            insn->flags = reader->get();
+            insn->pc += reader->get_signed();
+            insn->time += reader->get_signed();
+            insn->cycles += reader->get_signed();
+            insn->mode = reader->get();
+            if (insn->flags & INSN_TRACE_BIN_INSN_REG_DUMP)
+            {
+                insn->reg_dump = reader->get();
+            }
+            if (insn->flags & INSN_TRACE_BIN_INSN_STR_DUMP)
+            {
+                insn->str_dump = reader->get_str();
+            }
+
+            for (size_t i = 0; i < insn->desc->args.size(); i++)
+            {
+                Arg *arg = &insn->desc->args[i];
+                ArgValue *value = &insn->values[i];
+                int nb_values = 0;
+
+                if (arg->type == INSN_TRACE_BIN_ARG_OUT_REG || arg->type == INSN_TRACE_BIN_ARG_IN_REG)
+                {
+                    nb_values = has_values(arg, arg->index) ? 1 : 0;
+                }
+                else if (arg->type == INSN_TRACE_BIN_ARG_INDIRECT_IMM)
+                {
+                    nb_values = 1;
+                }
+                else if (arg->type == INSN_TRACE_BIN_ARG_INDIRECT_REG)
+                {
+                    nb_values = 2;
+                }
+
+                for (int j = 0; j < nb_values; j++)
+                {
+                    value->value[j] = reader->get();
+                    value->check[j] = (uint64_t)-1;
+                    // Only the validity of floating-point registers is not dumped, and only the one of
+                    // 64-bit registers is wider than the integer registers
+                    if (memcheck && !(nb_values == 1 && arg->flags & INSN_TRACE_BIN_ARG_FLAG_FREG &&
+                        arg->type != INSN_TRACE_BIN_ARG_INDIRECT_IMM))
+                    {
+                        value->check[j] = ~reader->get();
+                        if (!(arg->flags & INSN_TRACE_BIN_ARG_FLAG_REG64) || nb_values != 1 ||
+                            arg->type == INSN_TRACE_BIN_ARG_INDIRECT_IMM)
+                        {
+                            value->check[j] &= reg_mask(this);
+                        }
+                    }
+                }
+            }
+
+            return !reader->error;
+        }
+        else
+        {
+            reader->error = true;
+        }
+    }
+
+    return false;
+}
+
+std::string Decoder::reg_name(Stream *stream, Arg *arg, uint64_t reg)
+{
+    if (this->is_long)
+    {
+        if (arg->flags & INSN_TRACE_BIN_ARG_FLAG_FREG &&
+            !(stream->flags & INSN_TRACE_BIN_STREAM_SINGLE_REGFILE))
+        {
+            return format("f%d", (int)reg);
+        }
+        else if (reg == 0)
+        {
+            return "0";
+        }
+        else if (reg == 1)
+        {
+            return "ra";
+        }
+        else if (reg == 2)
+        {
+            return "sp";
+        }
+        else if (reg >= 8 && reg <= 9)
+        {
+            return format("s%d", (int)reg - 8);
+        }
+        else if (reg >= 18 && reg <= 27)
+        {
+            return format("s%d", (int)reg - 16);
+        }
+        else if (reg == 4)
+        {
+            return "tp";
+        }
+        else if (reg >= 10 && reg <= 17)
+        {
+            return format("a%d", (int)reg - 10);
+        }
+        else if (reg >= 5 && reg <= 7)
+        {
+            return format("t%d", (int)reg - 5);
+        }
+        else if (reg >= 28 && reg <= 31)
+        {
+            return format("t%d", (int)reg - 25);
+        }
+        else if (reg == 3)
+        {
+            return "gp";
+        }
+        else if (reg >= 32)
+        {
+            return format("f%d", (int)reg - 32);
+        }
+    }
+
+    return format("x%d", (int)reg);
+}
+
+static std::string reg_value_check(int size, uint64_t value, uint64_t check)
+{
+    std::string result;
+    for (int i = size * 2 - 1; i >= 0; i--)
+    {
+        if (((check >> (i * 4)) & 0xF) == 0xF)
+        {
+            result += format("%1.1x", (unsigned int)(value >> (i * 4)) & 0xF);
+        }
+        else
+        {
+            result += "X";
+        }
+    }
+    return result + " ";
+}
+
+std::string Decoder::reg_value(Stream *stream, Arg *arg, bool is_out, uint64_t reg, uint64_t value, uint64_t check)
+{
+    bool memcheck = stream->flags & INSN_TRACE_BIN_STREAM_MEMCHECK;
+    bool is_valid = (check & reg_mask(stream)) == reg_mask(stream);
+    std::string name = this->reg_name(stream, arg, reg);
+    std::string result = this->is_long ? format("%3.3s", name.c_str()) : name;
+
+    result += is_out ? "=" : ":";
+
+    if (arg->flags & INSN_TRACE_BIN_ARG_FLAG_REG64)
+    {
+        if (memcheck && !is_valid)
+        {
+            result += reg_value_check(8, value, check);
+        }
+        else
+        {
+            result += format("%16.16" PRIx64 " ", value);
+        }
+    }
+    else if (arg->flags & INSN_TRACE_BIN_ARG_FLAG_FREG)
+    {
+        if (stream->flags & INSN_TRACE_BIN_STREAM_DOUBLE)
+        {
+            result += format("%16.16" PRIx64 " ", value);
+        }
+        else
+        {
+            result += format("%8.8" PRIx32 " ", (uint32_t)value);
+        }
+    }
+    else
+    {
+        if (memcheck && !is_valid)
+        {
+            result += reg_value_check(stream->reg_width / 8, value, check);
+        }
+        else
+        {
+            result += full_reg(stream, value) + " ";
+        }
+    }
+
+    return result;
+}
+
+std::string Decoder::arg_value(Stream *stream, Arg *arg, ArgValue *value, bool dump_out)
+{
+    std::string result;
+
+    if ((arg->type == INSN_TRACE_BIN_ARG_OUT_REG || arg->type == INSN_TRACE_BIN_ARG_IN_REG) &&
+        has_values(arg, arg->index))
+    {
+        if ((dump_out && arg->type == INSN_TRACE_BIN_ARG_OUT_REG) ||
+            (!dump_out && arg->type == INSN_TRACE_BIN_ARG_IN_REG))
+        {
+            result += this->reg_value(stream, arg, arg->type == INSN_TRACE_BIN_ARG_OUT_REG,
+                arg->index, value->value[0], value->check[0]);
+        }
+    }
+    else if (arg->type == INSN_TRACE_BIN_ARG_INDIRECT_IMM ||
+        arg->type == INSN_TRACE_BIN_ARG_INDIRECT_REG)
+    {
+        bool is_imm = arg->type == INSN_TRACE_BIN_ARG_INDIRECT_IMM;
+        // Index and value of the base register
+        uint64_t base_reg = is_imm ? arg->index : arg->index2;
+        uint64_t base = is_imm ? value->value[0] : value->value[1];
+        uint64_t offset = is_imm ? arg->imm : value->value[0];
+        uint64_t offset_check = value->check[0];
+
+        if (!dump_out)
+        {
+            if (!is_imm)
+            {
+                result += this->reg_value(stream, arg, false, arg->index, value->value[0], value->check[0]);
+            }
+            result += this->reg_value(stream, arg, false, base_reg, base, is_imm ? value->check[0] : value->check[1]);
+        }
+
+        uint64_t addr;
+        if (arg->flags & INSN_TRACE_BIN_ARG_FLAG_POSTINC)
+        {
+            addr = base;
+            if (dump_out)
+            {
+                result += this->reg_value(stream, arg, true, base_reg,
+                    (addr + offset) & reg_mask(stream), offset_check);
+            }
+        }
+        else
+        {
+            addr = (base + offset) & reg_mask(stream);
+        }
+
+        if (!dump_out)
+        {
+            result += " PA:" + full_reg(stream, addr) + " ";
+        }
+    }
+
+    return result;
+}
+
+std::string Decoder::arg_str(Stream *stream, Arg *arg, Arg **prev_arg)
+{
+    std::string result;
+    bool is_reg = arg->type == INSN_TRACE_BIN_ARG_IN_REG || arg->type == INSN_TRACE_BIN_ARG_OUT_REG;
+
+    if (*prev_arg != NULL && (*prev_arg)->type != INSN_TRACE_BIN_ARG_NONE &&
+        (*prev_arg)->type != INSN_TRACE_BIN_ARG_FLAG && (!is_reg || arg->attrs & INSN_TRACE_BIN_ARG_DUMP_REG))
+    {
+        result += this->is_long ? ", " : ",";
+    }
+
+    if (arg->type == INSN_TRACE_BIN_ARG_NONE)
+    {
+        return result;
+    }
+
+    if (is_reg)
+    {
+        if (arg->attrs & INSN_TRACE_BIN_ARG_DUMP_REG)
+        {
+            result += this->reg_name(stream, arg, arg->index);
+        }
+    }
+    else if (arg->type == INSN_TRACE_BIN_ARG_UIMM || arg->type == INSN_TRACE_BIN_ARG_SIMM)
+    {
+        if (arg->attrs & INSN_TRACE_BIN_ARG_NAME)
+        {
+            result += arg->name;
+        }
+        else if (arg->type == INSN_TRACE_BIN_ARG_UIMM)
+        {
+            result += format("0x%" PRIx64, (uint64_t)arg->imm & reg_mask(stream));
+        }
+        else if (stream->reg_width == 64)
+        {
+            result += format("%" PRIx64, (uint64_t)arg->imm);
+        }
+        else
+        {
+            result += format("%" PRId32, (int32_t)arg->imm);
+        }
+    }
+    else if (arg->type == INSN_TRACE_BIN_ARG_INDIRECT_IMM || arg->type == INSN_TRACE_BIN_ARG_INDIRECT_REG)
+    {
+        if (arg->type == INSN_TRACE_BIN_ARG_INDIRECT_IMM)
+        {
+            if (stream->reg_width == 64)
+            {
+                result += format("%" PRIx64 "(", (uint64_t)arg->imm);
+            }
+            else
+            {
+                result += format("%" PRId32 "(", (int32_t)arg->imm);
+            }
+        }
+        else
+        {
+            result += this->reg_name(stream, arg, arg->index) + "(";
+        }
+        if (arg->flags & INSN_TRACE_BIN_ARG_FLAG_PREINC)
+        {
+            result += "!";
+        }
+        result += this->reg_name(stream, arg,
+            arg->type == INSN_TRACE_BIN_ARG_INDIRECT_IMM ? arg->index : arg->index2);
+        if (arg->flags & INSN_TRACE_BIN_ARG_FLAG_POSTINC)
+        {
+            result += "!";
+        }
+        result += ")";
+    }
+
+    *prev_arg = arg;
+    return result;
+}
+
+void Decoder::dump_insn(Stream *stream, Insn *insn)
+{
+    static const char modes[] = { 'U', 'S', 'H', 'M' };
+    Desc *desc = insn->desc;
+    std::string line;
+
+    if (this->is_long)
+    {
+        line = format("%" PRId64 ": %" PRId64 ": [\033[34m%-*.*s\033[0m] ", insn->time, insn->cycles,
+            stream->max_path_len, stream->max_path_len, stream->path.c_str());
+        line += desc->debug;
+    }
+    else
+    {
+        line = format("%" PRId64 "ps %" PRId64 " ", insn->time, insn->cycles);
+    }
+
+    if (insn->flags & INSN_TRACE_BIN_INSN_REG_DUMP)
+    {
+        line += full_reg(stream, insn->reg_dump) + " ";
+    }
+
+    if (insn->flags & INSN_TRACE_BIN_INSN_STR_DUMP)
+    {
+        line += insn->str_dump + " ";
+    }
+
+    line += format("%c ", insn->mode >= 0 && insn->mode < 4 ? modes[insn->mode] : ' ');
+    line += full_reg(stream, insn->pc) + " ";
+
+    if (!this->is_long)
+    {
+        line += full_reg(stream, desc->opcode) + " ";
+    }
+
+    std::string label = desc->label + " ";
+    if (this->is_long)
+    {
+        if ((int)label.size() > this->max_len)
+            this->max_len = label.size();
+        else
+            label.resize(this->max_len, ' ');
+    }
+    line += label;
+
+    Arg *prev_arg = NULL;
+    std::string args;
+    for (Arg &arg : desc->args)
+    {
+        args += this->arg_str(stream, &arg, &prev_arg);
+    }
+    if (desc->args.size() != 0)
+    {
+        args += " ";
+    }
+
+    if ((int)args.size() > this->max_arg_len)
+        this->max_arg_len = args.size();
+    else
+        args.resize(this->max_arg_len, ' ');
+    line += args;
+
+    for (size_t i = 0; i < desc->args.size(); i++)
+    {
+        line += this->arg_value(stream, &desc->args[i], &insn->values[i], true);
+    }
+    for (size_t i = 0; i < desc->args.size(); i++)
+    {
+        line += this->arg_value(stream, &desc->args[i], &insn->values[i], false);
+    }
+
+    line += "\n";
+
+    fwrite(line.c_str(), 1, line.size(), stdout);
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [--format=long|short] [--stats] <trace file>\n", name);
+    fprintf(stderr, "  --format=long|short  Format of the text trace (default: long)\n");
+    fprintf(stderr, "  --stats              Dump the number of executions and the total duration in cycles of each instruction label\n");
+}
+
+int main(int argc, char *argv[])
+{
+    Decoder decoder;
+    bool stats = false;
+    const char *path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--format=long")
+        {
+            decoder.is_long = true;
+        }
+        else if (arg == "--format=short")
+        {
+            decoder.is_long = false;
+        }
+        else if (arg == "--stats")
+        {
+            stats = true;
+        }
+        else if (arg[0] != '-' && path == NULL)
+        {
+            path = argv[i];
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (path == NULL)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Unable to open file: %s\n", path);
+        return 1;
+    }
+
+    char magic[INSN_TRACE_BIN_MAGIC_SIZE];
+    uint32_t version;
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, INSN_TRACE_BIN_MAGIC, INSN_TRACE_BIN_MAGIC_SIZE) != 0 ||
+        fread(&version, 1, sizeof(version), file) != sizeof(version))
+    {
+        fprintf(stderr, "Not a binary instruction trace: %s\n", path);
+        return 1;
+    }
+
+    if (version != INSN_TRACE_BIN_VERSION)
+    {
+        fprintf(stderr, "Unsupported binary instruction trace version (file: %s, version: %d)\n", path, version);
+        return 1;
+    }
+
+    // Gather the chunks of each stream so that their records can be decoded in sequence
+    std::vector<Stream *> streams;
+    uint32_t header[2];
+    while (fread(header, 1, sizeof(header), file) == sizeof(header))
+    {
+        uint32_t id = header[0];
+        if (id >= streams.size())
+        {
+            for (uint32_t i = streams.size(); i <= id; i++)
+            {
+                streams.push_back(new Stream(i));
+            }
+        }
+
+        std::vector<uint8_t> &data = streams[id]->data;
+        size_t size = data.size();
+        data.resize(size + header[1]);
+        if (fread(data.data() + size, 1, header[1], file) != header[1])
+        {
+            fprintf(stderr, "Truncated binary instruction trace, ignoring last chunk\n");
+            data.resize(size);
+            break;
+        }
+    }
+
+    fclose(file);
+
+    // Instructions of the different streams are dumped in time order, and in stream order for
+    // the same time
+    auto later = [](Stream *a, Stream *b) {
+        return a->insn.time > b->insn.time || (a->insn.time == b->insn.time && a->id > b->id);
+    };
+    std::priority_queue<Stream *, std::vector<Stream *>, decltype(later)> pending(later);
+
+    for (Stream *stream : streams)
+    {
+        stream->reader = new InsnTraceBinReader(stream->data.data(), stream->data.size());
+        if (stream->next())
+        {
+            pending.push(stream);
+        }
+    }
+
+    // Number of executions and total duration, per label
+    std::map<std::string, std::pair<uint64_t, int64_t>> labels;
+
+    while (!pending.empty())
+    {
+        Stream *stream = pending.top();
+        pending.pop();
+
+        if (stats)
+        {
+            // The duration of an instruction is given by the start of the next one
+            Desc *desc = stream->insn.desc;
+            int64_t cycles = stream->insn.cycles;
+            bool has_next = stream->next();
+            std::pair<uint64_t, int64_t> &label = labels[desc->label];
+            label.first++;
+            label.second += has_next ? stream->insn.cycles - cycles : 1;
+            if (has_next)
+            {
+                pending.push(stream);
+            }
+        }
+        else
+        {
+            // Macro ops are only dumped in the long format
+            if (decoder.is_long || !(stream->insn.desc->flags & INSN_TRACE_BIN_DESC_MACRO_OP))
+            {
+                decoder.dump_insn(stream, &stream->insn);
+            }
+            if (stream->next())
+            {
+                pending.push(stream);
+            }
+        }
+    }
+
+    if (stats)
+    {
+        for (auto &x : labels)
+        {
+            printf("%s %" PRIu64 " %" PRId64 "\n", x.first.c_str(), x.second.first, x.second.second);
+        }
+    }
+
+    int status = 0;
+    for (Stream *stream : streams)
+    {
+        if (stream->reader->error)
+        {
+            fprintf(stderr, "Invalid record in binary instruction trace (stream: %d)\n", stream->id);
+            status = 1;
+        }
+    }
+
+    return status;
+}
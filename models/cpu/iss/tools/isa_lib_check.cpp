@@ -0,0 +1,904 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Bit-exact comparison of the ISA library against reference implementations, see
+// isa_lib_check_ref.cpp:
+// - The scalar FP operations executed with host floats are compared with a software reference
+//   following IEEE 754 and the RISC-V specification, on NaNs, infinities, zeros, denormals and
+//   random values, for all the supported rounding modes. The result and the fflags must be
+//   identical. flexfloat, used when the host can not compute an operation, is run on the same
+//   operations and only its differences with the software reference are counted, except for its
+//   known bugs which are pinned to an exact operation in fp_pinned and must be reproduced.
+// - On Snitch, the packed binary32 operations of the FP subsystem are compared lane by lane with
+//   the software reference.
+// - On Spatz, the integer vector kernels are compared with the previous bit array implementation
+//   on random register contents, SEW, LMUL, vl, vstart, masks and scalars. The inputs are
+//   restricted to the cases where the previous implementation was correct: scalars fit in SEW-1
+//   bits, divisors are neither 0 nor -1, masked runs start on a multiple of 8 elements, and
+//   vslide1up.vx is only checked unmasked with vl > 0.
+// The time spent per operation by the ISA library and by flexfloat or the previous integer vector
+// kernels is then reported, on vadd.vv, on a dependent fmadd chain, on a matrix multiplication
+// and on an FFT. The FP kernels are timed with the host exceptions merged into fflags once at the
+// end, as the cores do when fflags is read, and also merged after each operation, to show what
+// merging them at the end of each execution event would cost in the default mode.
+//
+// Usage: gvsoc_isa_lib_check [<iterations per kernel> [<seed>]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "isa_lib_check.hpp"
+
+#if defined(CONFIG_GVSOC_ISS_INC_SPATZ)
+#define ISA_LIB_CHECK_VINT_NEW(name, kind) ISA_LIB_CHECK_VINT_ENTRY(lib_, name, kind)
+
+static const isa_lib_check_vint_t isa_lib_check_vint_new[] = {
+    ISA_LIB_CHECK_VINT_KERNELS(ISA_LIB_CHECK_VINT_NEW)
+    { NULL }
+};
+#endif
+
+static const char *fp_op_names[] = {
+    "fadd", "fsub", "fmul", "fdiv", "fsqrt", "fmadd", "fmsub", "fnmadd", "fnmsub"
+};
+
+static uint64_t rand_state;
+
+static uint64_t rand_get()
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+    return rand_state;
+}
+
+static int64_t rand_range(int64_t min, int64_t max)
+{
+    return min + (int64_t)(rand_get() % (uint64_t)(max - min + 1));
+}
+
+// The kernels only access the vector state, the FP CSR and the scalar fields of the core, which
+// are all plain data, so the core is not built, only zero-filled
+static Iss *iss_alloc()
+{
+    void *area;
+    if (posix_memalign(&area, 64, sizeof(Iss)))
+    {
+        abort();
+    }
+    memset(area, 0, sizeof(Iss));
+    return (Iss *)area;
+}
+
+#if defined(CONFIG_GVSOC_ISS_INC_SPATZ)
+static void iss_set_vtype(Iss *iss, int sew, int lmul, int vl, int vstart)
+{
+    iss->spatz.SEW_t = sew;
+    iss->spatz.LMUL_t = lmul;
+    iss->spatz.VLEN = 256;
+    iss->csr.vl.value = vl;
+    iss->csr.vstart.value = vstart;
+}
+
+static void vint_exec(const isa_lib_check_vint_t *kernel, Iss *iss, int vs1, int vs2, int64_t x,
+    int vd, bool vm)
+{
+    switch (kernel->kind)
+    {
+        case ISA_LIB_CHECK_VV:
+        case ISA_LIB_CHECK_WVV:
+        case ISA_LIB_CHECK_RED:
+        case ISA_LIB_CHECK_DIVVV:
+            ((isa_lib_check_vv_t)kernel->kernel)(iss, vs1, vs2, vd, vm);
+            break;
+        default:
+            ((isa_lib_check_vx_t)kernel->kernel)(iss, vs2, x, vd, vm);
+            break;
+    }
+}
+
+// Replace the divisors which make the reference trap or give wrong results
+static void vint_fix_divisors(Iss *iss, int vs, int sew, int lmul)
+{
+    uint8_t *reg = (uint8_t *)iss->spatz.vregfile.vregs[vs];
+    int size = sew / 8;
+    for (int i = 0; i < (int)sizeof(iss->spatz.vregfile.vregs[0]) * lmul / size; i++)
+    {
+        uint64_t value = 0;
+        memcpy(&value, reg + i * size, size);
+        uint64_t mask = sew == 64 ? (uint64_t)-1 : (1ULL << sew) - 1;
+        if (value == 0 || value == mask)
+        {
+            value = 1;
+            memcpy(reg + i * size, &value, size);
+        }
+    }
+}
+
+static int vint_check(const isa_lib_check_vint_t *kernel_new, const isa_lib_check_vint_t *kernel_ref,
+    Iss *iss_new, Iss *iss_ref, int iterations)
+{
+    int errors = 0;
+    isa_lib_check_kind_e kind = kernel_new->kind;
+    bool widening = kind == ISA_LIB_CHECK_WVV || kind == ISA_LIB_CHECK_WVX;
+
+    for (int it = 0; it < iterations; it++)
+    {
+        int sew = 8 << rand_range(0, widening ? 2 : 3);
+        int lmul = 1 << rand_range(0, widening ? 2 : 3);
+        int vlmax = 2048 * lmul / sew;
+        int vl = rand_range(0, vlmax);
+        int vstart = rand_range(0, 1) ? 0 : rand_range(0, vl);
+        bool vm = rand_range(0, 1);
+        // The reference only loads the mask bits at element indexes which are multiples of 8
+        if (!vm)
+        {
+            vstart &= ~7;
+        }
+
+        // The register groups never overlap, and never overlap the mask
+        int slots[3] = { 8, 16, 24 };
+        for (int i = 2; i > 0; i--)
+        {
+            std::swap(slots[i], slots[rand_range(0, i)]);
+        }
+        int vs1 = slots[0], vs2 = slots[1], vd = slots[2];
+
+        int64_t x;
+        int64_t scalar_max = sew == 64 ? INT64_MAX : (1LL << (sew - 1)) - 1;
+        switch (kind)
+        {
+            case ISA_LIB_CHECK_VI: x = rand_range(-16, 15); break;
+            case ISA_LIB_CHECK_SLIDEI: x = rand_range(0, 31); break;
+            case ISA_LIB_CHECK_SLIDEX: x = rand_range(0, vlmax + 2); break;
+            case ISA_LIB_CHECK_DIVVX: x = rand_range(1, scalar_max); break;
+            default: x = rand_range(0, 3) ? rand_range(0, scalar_max) : rand_range(0, 16); break;
+        }
+
+        // vmv.s.x has no masked encoding
+        if (kernel_new->kernel == (void (*)())&lib_MVSX)
+        {
+            vm = true;
+        }
+
+        if (kind == ISA_LIB_CHECK_SLIDE1 && kernel_new->kernel == (void (*)())&lib_SLIDE1UVX)
+        {
+            vm = true;
+            if (vl == 0)
+            {
+                vl = 1;
+                vstart = 0;
+            }
+        }
+
+        for (int i = 0; i < ISS_NB_VREGS; i++)
+        {
+            for (int j = 0; j < (int)sizeof(iss_new->spatz.vregfile.vregs[0]); j++)
+            {
+                iss_new->spatz.vregfile.vregs[i][j] = rand_get();
+            }
+        }
+
+        if (kind == ISA_LIB_CHECK_DIVVV)
+        {
+            vint_fix_divisors(iss_new, vs1, sew, lmul);
+        }
+
+        memcpy(iss_ref->spatz.vregfile.vregs, iss_new->spatz.vregfile.vregs,
+            sizeof(iss_new->spatz.vregfile.vregs));
+
+        iss_set_vtype(iss_new, sew, lmul, vl, vstart);
+        iss_set_vtype(iss_ref, sew, lmul, vl, vstart);
+
+        vint_exec(kernel_new, iss_new, vs1, vs2, x, vd, vm);
+        vint_exec(kernel_ref, iss_ref, vs1, vs2, x, vd, vm);
+
+        if (memcmp(iss_ref->spatz.vregfile.vregs, iss_new->spatz.vregfile.vregs,
+            sizeof(iss_new->spatz.vregfile.vregs)))
+        {
+            if (errors < 4)
+            {
+                int offset = 0;
+                uint8_t *regs_new = (uint8_t *)iss_new->spatz.vregfile.vregs;
+                uint8_t *regs_ref = (uint8_t *)iss_ref->spatz.vregfile.vregs;
+                while (regs_new[offset] == regs_ref[offset])
+                {
+                    offset++;
+                }
+                int reg_size = sizeof(iss_new->spatz.vregfile.vregs[0]);
+                printf("%s: mismatch (sew: %d, lmul: %d, vl: %d, vstart: %d, vm: %d, vs1: %d, "
+                    "vs2: %d, vd: %d, x: 0x%llx) at v%d byte %d: 0x%2.2x instead of 0x%2.2x\n",
+                    kernel_new->name, sew, lmul, vl, vstart, vm, vs1, vs2, vd, (long long)x,
+                    offset / reg_size, offset % reg_size, regs_new[offset], regs_ref[offset]);
+            }
+            errors++;
+        }
+    }
+
+    return errors;
+}
+#endif
+
+// Interesting values of a format with e exponent bits and m mantissa bits
+static std::vector<uint64_t> fp_edge_values(int e, int m)
+{
+    uint64_t sign = 1ULL << (e + m);
+    uint64_t exp_max = ((1ULL << e) - 1) << m;
+    uint64_t one = ((1ULL << (e - 1)) - 1) << m;
+    uint64_t values[] = {
+        0,                              // Zero
+        1,                              // Smallest denormal
+        (1ULL << m) - 1,                // Biggest denormal
+        1ULL << m,                      // Smallest normal
+        (1ULL << m) + 1,
+        one,                            // 1.0
+        one + 1,                        // 1.0 + ulp
+        one - 1,                        // 1.0 - ulp
+        one | (1ULL << (m - 1)),        // 1.5
+        one + (2ULL << m),              // 4.0
+        exp_max - 1,                    // Biggest normal
+        exp_max - (1ULL << m),          // Biggest power of 2
+        exp_max,                        // Infinity
+        exp_max | (1ULL << (m - 1)),    // Quiet NaN
+        exp_max | 1,                    // Signaling NaN
+    };
+
+    std::vector<uint64_t> result;
+    for (uint64_t value: values)
+    {
+        result.push_back(value);
+        result.push_back(value | sign);
+    }
+    return result;
+}
+
+static uint64_t fp_random_value(int e, int m)
+{
+    uint64_t value = rand_get() & ((1ULL << (e + m + 1)) - 1);
+    // Keep most values close to 1.0 so that operations on them are neither overflows nor
+    // underflows and exercise the rounding
+    if (rand_range(0, 1))
+    {
+        uint64_t exp = (1ULL << (e - 1)) - 1 + rand_range(-4, 4);
+        value = (value & ~(((1ULL << e) - 1) << m)) | (exp << m);
+    }
+    return value;
+}
+
+static uint64_t fp_exec_new(Iss *iss, isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+    uint64_t c, uint8_t e, uint8_t m, int round, uint32_t *fflags)
+{
+    iss->csr.fcsr.fflags = 0;
+    uint64_t result = isa_lib_check_fp_exec(iss, op, a, b, c, e, m, round);
+    lib_ff_flags_sync();
+    *fflags = iss->csr.fcsr.fflags;
+    return result;
+}
+
+static uint64_t fp_exec_ref(Iss *iss, isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+    uint64_t c, uint8_t e, uint8_t m, int round, uint32_t *fflags)
+{
+    iss->csr.fcsr.fflags = 0;
+    uint64_t result = isa_lib_check_fp_ref(iss, op, a, b, c, e, m, round);
+    lib_ff_flags_sync();
+    *fflags = iss->csr.fcsr.fflags;
+    return result;
+}
+
+static uint64_t fp_mask(int e, int m)
+{
+    return e + m + 1 == 64 ? ~0ULL : (1ULL << (e + m + 1)) - 1;
+}
+
+// Differences between flexfloat and the software reference, which are only reported since the
+// ISA library is compared with the software reference
+static int fp_ref_deviations;
+
+static int fp_check_one(Iss *iss_new, Iss *iss_ref, isa_lib_check_fp_op_e op, uint64_t a,
+    uint64_t b, uint64_t c, uint8_t e, uint8_t m, int round, int *errors)
+{
+    int frm = rand_range(0, 3);
+    iss_new->csr.fcsr.frm = frm;
+    iss_ref->csr.fcsr.frm = frm;
+
+    uint32_t fflags_new, fflags_ref, fflags_soft;
+    uint64_t result_new = fp_exec_new(iss_new, op, a, b, c, e, m, round, &fflags_new);
+    uint64_t result_ref = fp_exec_ref(iss_ref, op, a, b, c, e, m, round, &fflags_ref);
+    uint64_t result_soft = isa_lib_check_fp_soft(op, a, b, c, e, m, round == 7 ? frm : round,
+        &fflags_soft);
+
+    // Binary32 results may come sign-extended, the handlers only keep the lower bits
+    result_new &= fp_mask(e, m);
+    result_ref &= fp_mask(e, m);
+
+    if (result_ref != result_soft || fflags_ref != fflags_soft)
+    {
+        fp_ref_deviations++;
+    }
+
+    if (result_new != result_soft || fflags_new != fflags_soft)
+    {
+        if (*errors < 16)
+        {
+            printf("%s.%s: mismatch (a: 0x%llx, b: 0x%llx, c: 0x%llx, rm: %d, frm: %d): "
+                "0x%llx/0x%x instead of 0x%llx/0x%x\n", fp_op_names[op], e == 8 ? "s" : "d",
+                (unsigned long long)a, (unsigned long long)b, (unsigned long long)c, round, frm,
+                (unsigned long long)result_new, fflags_new, (unsigned long long)result_soft,
+                fflags_soft);
+        }
+        (*errors)++;
+    }
+    return 1;
+}
+
+static int fp_check(Iss *iss_new, Iss *iss_ref, int iterations, int *nb_checks)
+{
+    static const int rounds[] = { 0, 1, 2, 3, 7 };
+    static const int formats[][2] = { { 8, 23 }, { 11, 52 } };
+    int errors = 0;
+
+    for (auto &format: formats)
+    {
+        int e = format[0], m = format[1];
+        std::vector<uint64_t> edges = fp_edge_values(e, m);
+
+        for (int op = 0; op < ISA_LIB_CHECK_NB_FP_OPS; op++)
+        {
+            bool is_fma = op >= ISA_LIB_CHECK_FMADD;
+            for (int round: rounds)
+            {
+                // All the combinations of edge values, the third operand of FMAs being either an
+                // edge or a random value
+                for (uint64_t a: edges)
+                {
+                    for (uint64_t b: edges)
+                    {
+                        *nb_checks += fp_check_one(iss_new, iss_ref, (isa_lib_check_fp_op_e)op,
+                            a, b, is_fma ? edges[rand_range(0, edges.size() - 1)] :
+                            fp_random_value(e, m), e, m, round, &errors);
+                    }
+                }
+
+                for (int it = 0; it < iterations; it++)
+                {
+                    *nb_checks += fp_check_one(iss_new, iss_ref, (isa_lib_check_fp_op_e)op,
+                        fp_random_value(e, m), fp_random_value(e, m), fp_random_value(e, m), e, m,
+                        round, &errors);
+                }
+            }
+        }
+    }
+
+    return errors;
+}
+
+// Known deviations of flexfloat from IEEE 754 and from the RISC-V specification, each one pinned
+// to an operation exhibiting it. The ISA library and the software reference must give the IEEE
+// result on it, and flexfloat exactly the wrong result it is known to give, so that a fix or a
+// change of the bug in flexfloat is noticed.
+typedef struct
+{
+    const char *name;
+    isa_lib_check_fp_op_e op;
+    uint8_t e;
+    uint8_t m;
+    // RISC-V rounding mode
+    int rm;
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+    // IEEE result and fflags
+    uint64_t result;
+    uint32_t fflags;
+    // flexfloat result and fflags
+    uint64_t ref_result;
+    uint32_t ref_fflags;
+} fp_pinned_t;
+
+static const fp_pinned_t fp_pinned[] = {
+    // Exact denormal result raising underflow
+    { "exact denormal", ISA_LIB_CHECK_FMUL, 8, 23, 0, 0x1, 0x3f800000, 0,
+        0x1, 0x0, 0x1, 0x2 },
+    // Exact infinity raising overflow
+    { "exact infinity", ISA_LIB_CHECK_FADD, 8, 23, 0, 0x0, 0x7f800000, 0,
+        0x7f800000, 0x0, 0x7f800000, 0x5 },
+    // Tiny inexact result rounded to the smallest normal without raising underflow
+    { "tiny result flags", ISA_LIB_CHECK_FMUL, 8, 23, 0, 0x800000, 0x3f7fffff, 0,
+        0x800000, 0x3, 0x800000, 0x1 },
+    // Result rounded to zero without raising inexact
+    { "result rounded to zero", ISA_LIB_CHECK_FMUL, 8, 23, 0, 0x1, 0x1, 0,
+        0x0, 0x3, 0x0, 0x2 },
+    // Tiny result rounded down to zero instead of the smallest denormal
+    { "tiny result rounding", ISA_LIB_CHECK_FMUL, 8, 23, 2, 0x1, 0x80000001, 0,
+        0x80000001, 0x3, 0x80000000, 0x2 },
+    // Overflow towards zero giving infinity instead of the biggest normal
+    { "huge result rounding", ISA_LIB_CHECK_FADD, 8, 23, 1, 0x7f7fffff, 0x7f7fffff, 0,
+        0x7f7fffff, 0x5, 0x7f800000, 0x5 },
+    // Fused multiply-add rounded twice
+    { "fma rounding", ISA_LIB_CHECK_FMADD, 8, 23, 0, 0xbf800001, 0x3fc00000, 0x800001,
+        0xbfc00001, 0x1, 0xbfc00002, 0x1 },
+    // Fused multiply-adds of zero by infinity with a quiet NaN addend not raising invalid
+    { "fma of zero by infinity", ISA_LIB_CHECK_FMADD, 8, 23, 1, 0xff800000, 0x80000000,
+        0xffc00000, 0x7fc00000, 0x10, 0x7fc00000, 0x0 },
+    { "fma of zero by infinity", ISA_LIB_CHECK_FMADD, 11, 52, 1, 0x8000000000000000ULL,
+        0xfff0000000000000ULL, 0xfff8000000000000ULL, 0x7ff8000000000000ULL, 0x10,
+        0x7ff8000000000000ULL, 0x0 },
+    // Binary64 denormal operands, which are not converted correctly
+    { "binary64 denormal", ISA_LIB_CHECK_FADD, 11, 52, 0, 0x1, 0x0, 0,
+        0x1, 0x0, 0xfcd0000000000000ULL, 0x0 },
+    // Binary64 fnmadd, which is computed as -(a * b) - c with 2 roundings
+    { "binary64 fnmadd", ISA_LIB_CHECK_FNMADD, 11, 52, 0, 0xbff0000000000001ULL,
+        0xbfefffffffffffffULL, 0xbff8000000000000ULL, 0x3fdffffffffffffeULL, 0x1,
+        0x3fe0000000000000ULL, 0x1 },
+};
+
+static int fp_pinned_check(Iss *iss_new, Iss *iss_ref)
+{
+    int errors = 0;
+
+    for (const fp_pinned_t &pinned: fp_pinned)
+    {
+        uint32_t fflags_new, fflags_ref, fflags_soft;
+        uint64_t result_new = fp_exec_new(iss_new, pinned.op, pinned.a, pinned.b, pinned.c,
+            pinned.e, pinned.m, pinned.rm, &fflags_new) & fp_mask(pinned.e, pinned.m);
+        uint64_t result_ref = fp_exec_ref(iss_ref, pinned.op, pinned.a, pinned.b, pinned.c,
+            pinned.e, pinned.m, pinned.rm, &fflags_ref) & fp_mask(pinned.e, pinned.m);
+        uint64_t result_soft = isa_lib_check_fp_soft(pinned.op, pinned.a, pinned.b, pinned.c,
+            pinned.e, pinned.m, pinned.rm, &fflags_soft);
+
+        if (result_new != pinned.result || fflags_new != pinned.fflags ||
+            result_soft != pinned.result || fflags_soft != pinned.fflags ||
+            result_ref != pinned.ref_result || fflags_ref != pinned.ref_fflags)
+        {
+            printf("%s.%s: pinned deviation on %s (a: 0x%llx, b: 0x%llx, c: 0x%llx, rm: %d) "
+                "not reproduced: 0x%llx/0x%x, software 0x%llx/0x%x, flexfloat 0x%llx/0x%x\n",
+                fp_op_names[pinned.op], pinned.e == 8 ? "s" : "d", pinned.name,
+                (unsigned long long)pinned.a, (unsigned long long)pinned.b,
+                (unsigned long long)pinned.c, pinned.rm, (unsigned long long)result_new,
+                fflags_new, (unsigned long long)result_soft, fflags_soft,
+                (unsigned long long)result_ref, fflags_ref);
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+#if defined(CONFIG_GVSOC_ISS_SNITCH)
+static bool vf_op_supported(isa_lib_check_fp_op_e op)
+{
+    return op != ISA_LIB_CHECK_FMSUB && op != ISA_LIB_CHECK_FNMADD;
+}
+
+// Packed binary32 operations of the Snitch FP subsystem, on registers made of edge and random
+// lanes. Each lane is compared with the software reference, and the fflags with the ones of all
+// the lanes.
+static int vf_check(Iss *iss_new, Iss *iss_ref, int iterations, int *nb_checks)
+{
+    const int nb_lanes = CONFIG_GVSOC_ISS_FP_WIDTH / 32;
+    std::vector<uint64_t> edges = fp_edge_values(8, 23);
+    int errors = 0;
+
+    for (int op = 0; op < ISA_LIB_CHECK_NB_FP_OPS; op++)
+    {
+        if (!vf_op_supported((isa_lib_check_fp_op_e)op))
+        {
+            continue;
+        }
+
+        for (int it = 0; it < iterations; it++)
+        {
+            uint64_t regs[3] = { 0, 0, 0 };
+            for (uint64_t &reg: regs)
+            {
+                for (int i = 0; i < nb_lanes; i++)
+                {
+                    uint64_t lane = rand_range(0, 3) ? fp_random_value(8, 23) :
+                        edges[rand_range(0, edges.size() - 1)];
+                    reg |= lane << (i * 32);
+                }
+            }
+
+            int frm = rand_range(0, 3);
+            iss_new->csr.fcsr.frm = frm;
+            iss_ref->csr.fcsr.frm = frm;
+
+            iss_new->csr.fcsr.fflags = 0;
+            uint64_t result_new = isa_lib_check_vf_exec(iss_new, (isa_lib_check_fp_op_e)op,
+                regs[0], regs[1], regs[2]);
+            lib_ff_flags_sync();
+            uint32_t fflags_new = iss_new->csr.fcsr.fflags;
+
+            iss_ref->csr.fcsr.fflags = 0;
+            uint64_t result_ref = isa_lib_check_vf_ref(iss_ref, (isa_lib_check_fp_op_e)op,
+                regs[0], regs[1], regs[2]);
+            lib_ff_flags_sync();
+            uint32_t fflags_ref = iss_ref->csr.fcsr.fflags;
+
+            uint64_t result_soft = 0;
+            uint32_t fflags_soft = 0;
+            for (int i = 0; i < nb_lanes; i++)
+            {
+                uint32_t fflags;
+                result_soft |= isa_lib_check_fp_soft((isa_lib_check_fp_op_e)op,
+                    regs[0] >> (i * 32), regs[1] >> (i * 32), regs[2] >> (i * 32), 8, 23, frm,
+                    &fflags) << (i * 32);
+                fflags_soft |= fflags;
+            }
+
+            if (result_ref != result_soft || fflags_ref != fflags_soft)
+            {
+                fp_ref_deviations++;
+            }
+
+            if (result_new != result_soft || fflags_new != fflags_soft)
+            {
+                if (errors < 16)
+                {
+                    printf("%s.vf.s: mismatch (a: 0x%llx, b: 0x%llx, c: 0x%llx, frm: %d): "
+                        "0x%llx/0x%x instead of 0x%llx/0x%x\n", fp_op_names[op],
+                        (unsigned long long)regs[0], (unsigned long long)regs[1],
+                        (unsigned long long)regs[2], frm, (unsigned long long)result_new,
+                        fflags_new, (unsigned long long)result_soft, fflags_soft);
+                }
+                errors++;
+            }
+            (*nb_checks)++;
+        }
+    }
+
+    return errors;
+}
+#endif
+
+template<typename F>
+static double bench_ns(int64_t nb_ops, F func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / nb_ops;
+}
+
+// Executes an FP operation with the ISA library, as a core executing one instruction per event
+// would if the host exceptions were merged into fflags at the end of each event. Otherwise they
+// are only merged when fflags is read, as the cores do, which the benchmarks do once per kernel.
+static inline uint64_t fp_exec_bench(Iss *iss, isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+    uint64_t c, int e, int m, int rm, bool sync)
+{
+    uint64_t result = isa_lib_check_fp_exec(iss, op, a, b, c, e, m, rm);
+    if (sync)
+    {
+        lib_ff_flags_sync();
+    }
+    return result;
+}
+
+static uint64_t fp_from_double(double value, int e)
+{
+    if (e == 8)
+    {
+        float f32 = value;
+        uint32_t bits;
+        memcpy(&bits, &f32, sizeof(bits));
+        return bits;
+    }
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Radix-2 decimation in time FFT, in place on n complex values, with the butterflies of the Snitch
+// FFT kernels: each part of the twiddled value is a multiplication followed by a fused
+// multiply-add. exec(op, a, b, c) executes one FP operation.
+template<typename F>
+static void fft(std::vector<uint64_t> &re, std::vector<uint64_t> &im,
+    const std::vector<uint64_t> &w_re, const std::vector<uint64_t> &w_im, F exec)
+{
+    int n = re.size();
+
+    for (int i = 1, j = 0; i < n; i++)
+    {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+
+    for (int len = 2; len <= n; len <<= 1)
+    {
+        int half = len / 2;
+        for (int i = 0; i < n; i += len)
+        {
+            for (int k = 0; k < half; k++)
+            {
+                uint64_t wr = w_re[k * (n / len)], wi = w_im[k * (n / len)];
+                uint64_t xr = re[i + k + half], xi = im[i + k + half];
+                // t = w * x
+                uint64_t tr = exec(ISA_LIB_CHECK_FNMSUB, wi, xi,
+                    exec(ISA_LIB_CHECK_FMUL, wr, xr, 0));
+                uint64_t ti = exec(ISA_LIB_CHECK_FMADD, wi, xr,
+                    exec(ISA_LIB_CHECK_FMUL, wr, xi, 0));
+                re[i + k + half] = exec(ISA_LIB_CHECK_FSUB, re[i + k], tr, 0);
+                im[i + k + half] = exec(ISA_LIB_CHECK_FSUB, im[i + k], ti, 0);
+                re[i + k] = exec(ISA_LIB_CHECK_FADD, re[i + k], tr, 0);
+                im[i + k] = exec(ISA_LIB_CHECK_FADD, im[i + k], ti, 0);
+            }
+        }
+    }
+}
+
+// Number of FP operations of the FFT of n values
+static int64_t fft_nb_ops(int n)
+{
+    int64_t nb_ops = 0;
+    for (int len = 2; len <= n; len <<= 1)
+    {
+        nb_ops += 6 * (n / 2);
+    }
+    return nb_ops;
+}
+
+static void bench(Iss *iss_new, Iss *iss_ref)
+{
+#if defined(CONFIG_GVSOC_ISS_INC_SPATZ)
+    // vadd.vv on the biggest register groups
+    const int reps = 1000;
+    int vl = 2048 * 8 / 32;
+    iss_set_vtype(iss_new, 32, 8, vl, 0);
+    iss_set_vtype(iss_ref, 32, 8, vl, 0);
+    double vadd_new = bench_ns((int64_t)reps * vl, [&]() {
+        for (int i = 0; i < reps; i++) lib_ADDVV(iss_new, 8, 16, 24, true);
+    });
+    double vadd_ref = bench_ns((int64_t)reps / 100 * vl, [&]() {
+        for (int i = 0; i < reps / 100; i++)
+        {
+            ((isa_lib_check_vv_t)isa_lib_check_vint_ref[0].kernel)(iss_ref, 8, 16, 24, true);
+        }
+    });
+    printf("vadd.vv e32m8: %.2f ns/element, reference %.2f ns/element\n", vadd_new, vadd_ref);
+#endif
+
+
+    // Dependent fmadd chain, as in a dot product
+    const int nb_fma = 1000000;
+    static const int formats[][2] = { { 8, 23 }, { 11, 52 } };
+    for (auto &format: formats)
+    {
+        int e = format[0], m = format[1];
+        uint64_t one = ((1ULL << (e - 1)) - 1) << m;
+        uint64_t x = one | 1;
+        uint64_t acc_new = 0, acc_sync = 0, acc_ref = 0;
+        double fma_new = bench_ns(nb_fma, [&]() {
+            for (int i = 0; i < nb_fma; i++)
+                acc_new = fp_exec_bench(iss_new, ISA_LIB_CHECK_FMADD, x, x, acc_new, e, m, 7, false);
+            lib_ff_flags_sync();
+        });
+        double fma_sync = bench_ns(nb_fma, [&]() {
+            for (int i = 0; i < nb_fma; i++)
+                acc_sync = fp_exec_bench(iss_new, ISA_LIB_CHECK_FMADD, x, x, acc_sync, e, m, 7, true);
+        });
+        double fma_ref = bench_ns(nb_fma, [&]() {
+            for (int i = 0; i < nb_fma; i++)
+                acc_ref = isa_lib_check_fp_ref(iss_ref, ISA_LIB_CHECK_FMADD, x, x, acc_ref, e, m, 7);
+        });
+        printf("fmadd.%s: %.2f ns/op, %.2f ns/op merging fflags per instruction, reference "
+            "%.2f ns/op%s\n", e == 8 ? "s" : "d", fma_new, fma_sync, fma_ref,
+            acc_new != acc_ref || acc_sync != acc_ref ? " (results differ)" : "");
+    }
+
+    // Matrix multiplication kernel, with one fmadd per inner loop iteration, on values in [1, 2[
+    const int n = 32;
+    for (auto &format: formats)
+    {
+        int e = format[0], m = format[1];
+        uint64_t one = ((1ULL << (e - 1)) - 1) << m;
+        std::vector<uint64_t> ma(n * n), mb(n * n), mc_new(n * n), mc_sync(n * n), mc_ref(n * n);
+        for (int i = 0; i < n * n; i++)
+        {
+            ma[i] = one | (rand_get() & ((1ULL << m) - 1));
+            mb[i] = one | (rand_get() & ((1ULL << m) - 1));
+        }
+        auto matmul = [&](Iss *iss, std::vector<uint64_t> &mc, bool ref, bool sync) {
+            for (int i = 0; i < n; i++)
+            {
+                for (int j = 0; j < n; j++)
+                {
+                    uint64_t acc = 0;
+                    for (int k = 0; k < n; k++)
+                    {
+                        uint64_t a = ma[i * n + k], b = mb[k * n + j];
+                        acc = ref ?
+                            isa_lib_check_fp_ref(iss, ISA_LIB_CHECK_FMADD, a, b, acc, e, m, 7) :
+                            fp_exec_bench(iss, ISA_LIB_CHECK_FMADD, a, b, acc, e, m, 7, sync);
+                    }
+                    mc[i * n + j] = acc;
+                }
+            }
+        };
+        double matmul_new = bench_ns(n * n * n, [&]() {
+            matmul(iss_new, mc_new, false, false);
+            lib_ff_flags_sync();
+        });
+        double matmul_sync = bench_ns(n * n * n, [&]() { matmul(iss_new, mc_sync, false, true); });
+        double matmul_ref = bench_ns(n * n * n, [&]() { matmul(iss_ref, mc_ref, true, false); });
+        printf("matmul %dx%d.%s: %.2f ns/fmadd, %.2f ns/fmadd merging fflags per instruction, "
+            "reference %.2f ns/fmadd%s\n", n, n, e == 8 ? "s" : "d", matmul_new, matmul_sync,
+            matmul_ref, mc_new != mc_ref || mc_sync != mc_ref ? " (results differ)" : "");
+    }
+
+    // FFT on random values in [-1, 1[, with the twiddle factors computed on the host
+    const int fft_n = 256;
+    int64_t fft_ops = fft_nb_ops(fft_n);
+    std::vector<double> fft_input(2 * fft_n);
+    for (double &value: fft_input)
+    {
+        value = (double)(rand_get() % 2000000) / 1000000 - 1;
+    }
+    for (auto &format: formats)
+    {
+        int e = format[0], m = format[1];
+        std::vector<uint64_t> w_re(fft_n / 2), w_im(fft_n / 2);
+        std::vector<uint64_t> re(fft_n), im(fft_n);
+        for (int k = 0; k < fft_n / 2; k++)
+        {
+            w_re[k] = fp_from_double(std::cos(2 * M_PI * k / fft_n), e);
+            w_im[k] = fp_from_double(-std::sin(2 * M_PI * k / fft_n), e);
+        }
+        for (int i = 0; i < fft_n; i++)
+        {
+            re[i] = fp_from_double(fft_input[2 * i], e);
+            im[i] = fp_from_double(fft_input[2 * i + 1], e);
+        }
+
+        std::vector<uint64_t> re_new = re, im_new = im, re_sync = re, im_sync = im;
+        std::vector<uint64_t> re_ref = re, im_ref = im;
+        double fft_new = bench_ns(fft_ops, [&]() {
+            fft(re_new, im_new, w_re, w_im, [&](isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+                uint64_t c) { return fp_exec_bench(iss_new, op, a, b, c, e, m, 7, false); });
+            lib_ff_flags_sync();
+        });
+        double fft_sync = bench_ns(fft_ops, [&]() {
+            fft(re_sync, im_sync, w_re, w_im, [&](isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+                uint64_t c) { return fp_exec_bench(iss_new, op, a, b, c, e, m, 7, true); });
+        });
+        double fft_ref = bench_ns(fft_ops, [&]() {
+            fft(re_ref, im_ref, w_re, w_im, [&](isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+                uint64_t c) { return isa_lib_check_fp_ref(iss_ref, op, a, b, c, e, m, 7); });
+        });
+        printf("fft %d.%s: %.2f ns/op, %.2f ns/op merging fflags per instruction, reference "
+            "%.2f ns/op%s\n", fft_n, e == 8 ? "s" : "d", fft_new, fft_sync, fft_ref,
+            re_new != re_ref || im_new != im_ref || re_sync != re_ref || im_sync != im_ref ?
+            " (results differ)" : "");
+    }
+
+#if defined(CONFIG_GVSOC_ISS_SNITCH)
+    // Same FFT with the packed binary32 operations, each lane computing the FFT of a different
+    // input
+    {
+        const int nb_lanes = CONFIG_GVSOC_ISS_FP_WIDTH / 32;
+        std::vector<uint64_t> w_re(fft_n / 2), w_im(fft_n / 2);
+        std::vector<uint64_t> re(fft_n), im(fft_n);
+        for (int k = 0; k < fft_n / 2; k++)
+        {
+            for (int i = 0; i < nb_lanes; i++)
+            {
+                w_re[k] |= fp_from_double(std::cos(2 * M_PI * k / fft_n), 8) << (i * 32);
+                w_im[k] |= fp_from_double(-std::sin(2 * M_PI * k / fft_n), 8) << (i * 32);
+            }
+        }
+        for (int j = 0; j < fft_n; j++)
+        {
+            for (int i = 0; i < nb_lanes; i++)
+            {
+                int index = (j + i * fft_n / nb_lanes) % fft_n;
+                re[j] |= fp_from_double(fft_input[2 * index], 8) << (i * 32);
+                im[j] |= fp_from_double(fft_input[2 * index + 1], 8) << (i * 32);
+            }
+        }
+
+        std::vector<uint64_t> re_new = re, im_new = im, re_sync = re, im_sync = im;
+        std::vector<uint64_t> re_ref = re, im_ref = im;
+        double fft_new = bench_ns(fft_ops * nb_lanes, [&]() {
+            fft(re_new, im_new, w_re, w_im, [&](isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+                uint64_t c) { return isa_lib_check_vf_exec(iss_new, op, a, b, c); });
+            lib_ff_flags_sync();
+        });
+        double fft_sync = bench_ns(fft_ops * nb_lanes, [&]() {
+            fft(re_sync, im_sync, w_re, w_im, [&](isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+                uint64_t c) {
+                uint64_t result = isa_lib_check_vf_exec(iss_new, op, a, b, c);
+                lib_ff_flags_sync();
+                return result;
+            });
+        });
+        double fft_ref = bench_ns(fft_ops * nb_lanes, [&]() {
+            fft(re_ref, im_ref, w_re, w_im, [&](isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+                uint64_t c) { return isa_lib_check_vf_ref(iss_ref, op, a, b, c); });
+        });
+        printf("fft %d.vf.s: %.2f ns/lane op, %.2f ns/lane op merging fflags per instruction, "
+            "reference %.2f ns/lane op%s\n", fft_n, fft_new, fft_sync, fft_ref,
+            re_new != re_ref || im_new != im_ref || re_sync != re_ref || im_sync != im_ref ?
+            " (results differ)" : "");
+    }
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+    rand_state = argc > 2 ? strtoull(argv[2], NULL, 0) : 0x9e3779b97f4a7c15ULL;
+    if (rand_state == 0)
+    {
+        rand_state = 1;
+    }
+
+    Iss *iss_new = iss_alloc();
+    Iss *iss_ref = iss_alloc();
+    int errors = 0;
+
+#if defined(CONFIG_GVSOC_ISS_INC_SPATZ)
+    int nb_kernels = 0;
+    int vint_errors = 0;
+    for (int i = 0; isa_lib_check_vint_new[i].name != NULL; i++)
+    {
+        vint_errors += vint_check(&isa_lib_check_vint_new[i], &isa_lib_check_vint_ref[i], iss_new,
+            iss_ref, iterations);
+        nb_kernels++;
+    }
+    printf("vint: %d kernels, %d runs each, %d mismatches\n", nb_kernels, iterations, vint_errors);
+    errors += vint_errors;
+#endif
+
+    int nb_checks = 0;
+    int fp_errors = fp_check(iss_new, iss_ref, iterations, &nb_checks);
+    printf("fp: %d operations, %d mismatches\n", nb_checks, fp_errors);
+    errors += fp_errors;
+
+#if defined(CONFIG_GVSOC_ISS_SNITCH)
+    int nb_vf_checks = 0;
+    int vf_errors = vf_check(iss_new, iss_ref, iterations, &nb_vf_checks);
+    printf("vf: %d packed operations, %d mismatches\n", nb_vf_checks, vf_errors);
+    errors += vf_errors;
+#endif
+
+    int pinned_errors = fp_pinned_check(iss_new, iss_ref);
+    printf("fp: %d pinned flexfloat deviations, %d not reproduced\n",
+        (int)(sizeof(fp_pinned) / sizeof(fp_pinned[0])), pinned_errors);
+    printf("fp: %d differences between flexfloat and the software reference\n",
+        fp_ref_deviations);
+    errors += pinned_errors;
+
+    bench(iss_new, iss_ref);
+
+    return errors ? 1 : 0;
+}
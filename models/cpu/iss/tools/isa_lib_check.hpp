@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Interface between isa_lib_check.cpp, which uses the current ISA library, and
+// isa_lib_check_ref.cpp, which gives the reference implementations. Both are compiled against the
+// same ISS headers, the reference one with the native float path disabled and the integer vector
+// kernels taken from isa_lib_vint_ref.h. The integer vector kernels are only checked when the
+// core includes Spatz, and the packed FP operations when it is a Snitch.
+
+#pragma once
+
+#include <cpu/iss/include/iss.hpp>
+
+#if defined(CONFIG_GVSOC_ISS_INC_SPATZ)
+#include <cpu/iss/include/isa_lib/vint.h>
+
+// How the operands of a vector kernel are generated
+typedef enum
+{
+    // vd = op(vs2, vs1)
+    ISA_LIB_CHECK_VV,
+    // vd = op(vs2, scalar)
+    ISA_LIB_CHECK_VX,
+    // vd = op(vs2, 5-bit signed immediate)
+    ISA_LIB_CHECK_VI,
+    // Widening versions, vd is 2*SEW wide
+    ISA_LIB_CHECK_WVV,
+    ISA_LIB_CHECK_WVX,
+    // vd[0] = reduction of vs1[0] and vs2
+    ISA_LIB_CHECK_RED,
+    // Slide by a scalar or an immediate offset
+    ISA_LIB_CHECK_SLIDEX,
+    ISA_LIB_CHECK_SLIDEI,
+    // Slide by one element, inserting a scalar
+    ISA_LIB_CHECK_SLIDE1,
+    // Divisions, the reference traps on zero divisors and on signed overflows
+    ISA_LIB_CHECK_DIVVV,
+    ISA_LIB_CHECK_DIVVX,
+} isa_lib_check_kind_e;
+
+#define ISA_LIB_CHECK_VINT_KERNELS(K)                                                           \
+    K(ADDVV, VV) K(ADDVX, VX) K(ADDVI, VI) K(SUBVV, VV) K(SUBVX, VX) K(RSUBVX, VX)              \
+    K(RSUBVI, VI) K(ANDVV, VV) K(ANDVX, VX) K(ANDVI, VI) K(ORVV, VV) K(ORVX, VX) K(ORVI, VI)    \
+    K(XORVV, VV) K(XORVX, VX) K(XORVI, VI) K(MINVV, VV) K(MINVX, VX) K(MINUVV, VV)              \
+    K(MINUVX, VX) K(MAXVV, VV) K(MAXVX, VX) K(MAXUVV, VV) K(MAXUVX, VX) K(MULVV, VV)            \
+    K(MULVX, VX) K(MULHVV, VV) K(MULHVX, VX) K(MULHUVV, VV) K(MULHUVX, VX) K(MULHSUVV, VV)      \
+    K(MULHSUVX, VX) K(MVVV, VV) K(MVVX, VX) K(MVVI, VI) K(MVSX, VX) K(WMULVV, WVV)              \
+    K(WMULVX, WVX) K(WMULUVV, WVV) K(WMULUVX, WVX) K(WMULSUVV, WVV) K(WMULSUVX, WVX)           \
+    K(MACCVV, VV) K(MACCVX, VX) K(MADDVV, VV) K(MADDVX, VX) K(NMSACVV, VV) K(NMSACVX, VX)      \
+    K(NMSUBVV, VV) K(NMSUBVX, VX) K(WMACCVV, WVV) K(WMACCVX, WVX) K(WMACCUVV, WVV)             \
+    K(WMACCUVX, WVX) K(WMACCUSVX, WVX) K(WMACCSUVV, WVV) K(WMACCSUVX, WVX) K(REDSUMVS, RED)    \
+    K(REDANDVS, RED) K(REDORVS, RED) K(REDXORVS, RED) K(REDMINVS, RED) K(REDMINUVS, RED)       \
+    K(REDMAXVS, RED) K(REDMAXUVS, RED) K(SLIDEUPVX, SLIDEX) K(SLIDEUPVI, SLIDEI)               \
+    K(SLIDEDWVX, SLIDEX) K(SLIDEDWVI, SLIDEI) K(SLIDE1UVX, SLIDE1) K(SLIDE1DVX, SLIDE1)        \
+    K(DIVVV, DIVVV) K(DIVVX, DIVVX) K(DIVUVV, DIVVV) K(DIVUVX, DIVVX) K(REMVV, DIVVV)          \
+    K(REMVX, DIVVX) K(REMUVV, DIVVV) K(REMUVX, DIVVX)
+
+typedef void (*isa_lib_check_vv_t)(Iss *iss, int vs1, int vs2, int vd, bool vm);
+typedef void (*isa_lib_check_vx_t)(Iss *iss, int vs2, int64_t x, int vd, bool vm);
+
+typedef struct
+{
+    const char *name;
+    isa_lib_check_kind_e kind;
+    // Either an isa_lib_check_vv_t or an isa_lib_check_vx_t, depending on the kind
+    void (*kernel)();
+} isa_lib_check_vint_t;
+
+#define ISA_LIB_CHECK_VINT_ENTRY(prefix, name, kind) \
+    { #name, ISA_LIB_CHECK_##kind, (void (*)())&prefix##name },
+
+extern const isa_lib_check_vint_t isa_lib_check_vint_ref[];
+#endif
+
+typedef enum
+{
+    ISA_LIB_CHECK_FADD,
+    ISA_LIB_CHECK_FSUB,
+    ISA_LIB_CHECK_FMUL,
+    ISA_LIB_CHECK_FDIV,
+    ISA_LIB_CHECK_FSQRT,
+    ISA_LIB_CHECK_FMADD,
+    ISA_LIB_CHECK_FMSUB,
+    ISA_LIB_CHECK_FNMADD,
+    ISA_LIB_CHECK_FNMSUB,
+    ISA_LIB_CHECK_NB_FP_OPS
+} isa_lib_check_fp_op_e;
+
+// Execute a scalar FP operation through the ISA library of the translation unit, which is
+// compiled either with the native float path or with flexfloat only
+static inline uint64_t isa_lib_check_fp_exec(Iss *iss, isa_lib_check_fp_op_e op, uint64_t a,
+    uint64_t b, uint64_t c, uint8_t e, uint8_t m, int round)
+{
+    switch (op)
+    {
+        case ISA_LIB_CHECK_FADD: return lib_flexfloat_add_round(iss, a, b, e, m, round);
+        case ISA_LIB_CHECK_FSUB: return lib_flexfloat_sub_round(iss, a, b, e, m, round);
+        case ISA_LIB_CHECK_FMUL: return lib_flexfloat_mul_round(iss, a, b, e, m, round);
+        case ISA_LIB_CHECK_FDIV: return lib_flexfloat_div_round(iss, a, b, e, m, round);
+        case ISA_LIB_CHECK_FSQRT: return lib_flexfloat_sqrt_round(iss, a, e, m, round);
+        case ISA_LIB_CHECK_FMADD: return lib_flexfloat_madd_round(iss, a, b, c, e, m, round);
+        case ISA_LIB_CHECK_FMSUB: return lib_flexfloat_msub_round(iss, a, b, c, e, m, round);
+        case ISA_LIB_CHECK_FNMADD: return lib_flexfloat_nmadd_round(iss, a, b, c, e, m, round);
+        case ISA_LIB_CHECK_FNMSUB: return lib_flexfloat_nmsub_round(iss, a, b, c, e, m, round);
+        default: return 0;
+    }
+}
+
+#if defined(CONFIG_GVSOC_ISS_SNITCH)
+// Execute a packed binary32 operation on the 2 lanes of 64-bit FP registers, as the Xfvec
+// handlers of the Snitch FP subsystem do: each lane gets the register shifted down without
+// masking the upper bits, and uses the dynamic rounding mode. Only the operations which have a
+// packed instruction are supported, which are all of them except fmsub and fnmadd, fmadd being
+// vfmac.s and fnmsub vfmre.s.
+static inline uint64_t isa_lib_check_vf_exec(Iss *iss, isa_lib_check_fp_op_e op, uint64_t a,
+    uint64_t b, uint64_t c)
+{
+    uint64_t result = 0;
+    for (int i = 0; i < CONFIG_GVSOC_ISS_FP_WIDTH / 32; i++)
+    {
+        uint64_t lane = isa_lib_check_fp_exec(iss, op, a >> (i * 32), b >> (i * 32),
+            c >> (i * 32), 8, 23, 7);
+        result |= (lane & 0xFFFFFFFFULL) << (i * 32);
+    }
+    return result;
+}
+#endif
+
+// flexfloat implementation of the scalar FP operations
+uint64_t isa_lib_check_fp_ref(Iss *iss, isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+    uint64_t c, uint8_t e, uint8_t m, int round);
+#if defined(CONFIG_GVSOC_ISS_SNITCH)
+uint64_t isa_lib_check_vf_ref(Iss *iss, isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+    uint64_t c);
+#endif
+
+// Software implementation of the binary32 and binary64 operations, following IEEE 754 and the
+// RISC-V specification, for the RISC-V rounding mode rm between 0 and 3. The operations are
+// computed in software, and the fflags they raise are returned with the result.
+uint64_t isa_lib_check_fp_soft(isa_lib_check_fp_op_e op, uint64_t a, uint64_t b, uint64_t c,
+    uint8_t e, uint8_t m, int rm, uint32_t *fflags);
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Reference side of isa_lib_check. The FP operations go through flexfloat, and the integer vector
+// kernels are the previous bit array implementation. The software FP reference, to which both
+// the ISA library and flexfloat are compared, is also implemented here.
+
+#define CONFIG_GVSOC_ISS_USE_NATIVE_FLOAT 0
+
+#include <string.h>
+#include <cfenv>
+#include "isa_lib_check.hpp"
+
+#if defined(CONFIG_GVSOC_ISS_INC_SPATZ)
+#include "isa_lib_vint_ref.h"
+
+#define ISA_LIB_CHECK_VINT_REF(name, kind) ISA_LIB_CHECK_VINT_ENTRY(lib_ref_, name, kind)
+
+const isa_lib_check_vint_t isa_lib_check_vint_ref[] = {
+    ISA_LIB_CHECK_VINT_KERNELS(ISA_LIB_CHECK_VINT_REF)
+    { NULL }
+};
+#endif
+
+uint64_t isa_lib_check_fp_ref(Iss *iss, isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+    uint64_t c, uint8_t e, uint8_t m, int round)
+{
+    return isa_lib_check_fp_exec(iss, op, a, b, c, e, m, round);
+}
+
+#if defined(CONFIG_GVSOC_ISS_SNITCH)
+uint64_t isa_lib_check_vf_ref(Iss *iss, isa_lib_check_fp_op_e op, uint64_t a, uint64_t b,
+    uint64_t c)
+{
+    return isa_lib_check_vf_exec(iss, op, a, b, c);
+}
+#endif
+
+// The software reference computes on binary128 values, whose arithmetic is done in software by
+// libgcc. The operands are converted exactly, and the operation is first rounded towards zero,
+// with the least significant bit set if the result is inexact. This result rounded to odd has
+// more than 2 bits more than binary64, so rounding it to the target format in the requested mode
+// gives the correctly rounded result and flags, with tininess detected after rounding as on
+// RISC-V. Products of binary64 values are exact in binary128, so fused multiply-adds are only
+// rounded once, and a product of zero by infinity raises invalid whatever the addend.
+typedef __float128 soft_t;
+
+static soft_t soft_from_bits(uint64_t bits, int e)
+{
+    if (e == 8)
+    {
+        uint32_t value = bits;
+        float result;
+        memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+    double result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// Power of 2 in the normal range of binary128
+static soft_t soft_pow2(int exp)
+{
+    uint64_t bits[2] = { 0, (uint64_t)(exp + 16383) << 48 };
+    soft_t result;
+    memcpy(&result, bits, sizeof(result));
+    return result;
+}
+
+// Set the least significant bit of the mantissa, to round an inexact value to odd
+static soft_t soft_odd(soft_t value)
+{
+    uint64_t bits[2];
+    memcpy(bits, &value, sizeof(bits));
+    bits[0] |= 1;
+    memcpy(&value, bits, sizeof(bits));
+    return value;
+}
+
+static soft_t soft_exec(isa_lib_check_fp_op_e op, soft_t x, soft_t y, soft_t z)
+{
+    // Volatile so that the operation is executed in the current rounding mode
+    volatile soft_t vx = x, vy = y, vz = z;
+    volatile soft_t product;
+
+    switch (op)
+    {
+        case ISA_LIB_CHECK_FADD: return vx + vy;
+        case ISA_LIB_CHECK_FSUB: return vx - vy;
+        case ISA_LIB_CHECK_FMUL: return vx * vy;
+        case ISA_LIB_CHECK_FDIV: return vx / vy;
+        case ISA_LIB_CHECK_FMADD: product = vx * vy; return product + vz;
+        case ISA_LIB_CHECK_FMSUB: product = vx * vy; return product - vz;
+        case ISA_LIB_CHECK_FNMADD: product = vx * vy; return -product - vz;
+        case ISA_LIB_CHECK_FNMSUB: product = vx * vy; return -product + vz;
+        default: return 0;
+    }
+}
+
+// Square root rounded to odd, computed on integers from the mantissa and exponent of a
+static soft_t soft_sqrt(uint64_t a, int e, int m)
+{
+    soft_t value = soft_from_bits(a, e);
+
+    if (value != value)
+    {
+        return value;
+    }
+    if (value < 0)
+    {
+        feraiseexcept(FE_INVALID);
+        return __builtin_nanq("");
+    }
+    if (value == 0 || value > soft_pow2(16000))
+    {
+        // Zeros and infinity
+        return value;
+    }
+
+    int bias = (1 << (e - 1)) - 1;
+    int exp = (a >> m) & ((1 << e) - 1);
+    uint64_t mant = a & ((1ULL << m) - 1);
+    if (exp == 0)
+    {
+        exp = 1 - bias - m;
+    }
+    else
+    {
+        mant |= 1ULL << m;
+        exp -= bias + m;
+    }
+
+    // The value is mant * 2^exp, the exponent is made even and the mantissa is shifted by an
+    // even amount so that the integer root has more than 60 bits
+    if (exp & 1)
+    {
+        mant <<= 1;
+        exp--;
+    }
+    unsigned __int128 rem = mant;
+    while (rem < ((unsigned __int128)1 << 124))
+    {
+        rem <<= 2;
+        exp -= 2;
+    }
+
+    unsigned __int128 root = 0;
+    for (unsigned __int128 bit = (unsigned __int128)1 << 126; bit != 0; bit >>= 2)
+    {
+        if (rem >= root + bit)
+        {
+            rem -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+    }
+
+    soft_t result = (soft_t)(uint64_t)root * soft_pow2(exp / 2);
+    return rem != 0 ? soft_odd(result) : result;
+}
+
+uint64_t isa_lib_check_fp_soft(isa_lib_check_fp_op_e op, uint64_t a, uint64_t b, uint64_t c,
+    uint8_t e, uint8_t m, int rm, uint32_t *fflags)
+{
+    static const int modes[] = { FE_TONEAREST, FE_TOWARDZERO, FE_DOWNWARD, FE_UPWARD };
+    bool is_fma = op >= ISA_LIB_CHECK_FMADD;
+    int old = fegetround();
+    volatile soft_t result;
+
+    feclearexcept(FE_ALL_EXCEPT);
+    fesetround(FE_TOWARDZERO);
+
+    if (op == ISA_LIB_CHECK_FSQRT)
+    {
+        result = soft_sqrt(a, e, m);
+    }
+    else
+    {
+        // Unused operands are not converted since signaling NaNs raise invalid
+        soft_t x = soft_from_bits(a, e);
+        soft_t y = soft_from_bits(b, e);
+        soft_t z = is_fma ? soft_from_bits(c, e) : 0;
+
+        result = soft_exec(op, x, y, z);
+        if (fetestexcept(FE_INEXACT))
+        {
+            result = soft_odd(result);
+        }
+        else
+        {
+            // The result is exact, it is computed again in the requested mode for the sign of
+            // exact zeros
+            fesetround(modes[rm]);
+            result = soft_exec(op, x, y, z);
+        }
+    }
+
+    fesetround(modes[rm]);
+
+    uint64_t bits;
+    if (e == 8)
+    {
+        volatile float value = (float)result;
+        float f32 = value;
+        uint32_t f32_bits;
+        memcpy(&f32_bits, &f32, sizeof(f32_bits));
+        bits = f32 != f32 ? 0x7fc00000 : f32_bits;
+    }
+    else
+    {
+        volatile double value = (double)result;
+        double f64 = value;
+        memcpy(&bits, &f64, sizeof(bits));
+        bits = f64 != f64 ? 0x7ff8000000000000ULL : bits;
+    }
+
+    int ex = fetestexcept(FE_ALL_EXCEPT);
+    *fflags = !!(ex & FE_INEXACT) << 0 | !!(ex & FE_UNDERFLOW) << 1 | !!(ex & FE_OVERFLOW) << 2 |
+        !!(ex & FE_DIVBYZERO) << 3 | !!(ex & FE_INVALID) << 4;
+
+    fesetround(old);
+    feclearexcept(FE_ALL_EXCEPT);
+
+    return bits;
+}
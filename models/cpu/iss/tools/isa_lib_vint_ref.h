@@ -0,0 +1,2805 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Integer vector kernels as they were implemented before they were rewritten on native element
+// types, kept as the reference of isa_lib_check. They are renamed from lib_<NAME> to
+// lib_ref_<NAME> and use the bit array helpers which are still in vint.h.
+
+#pragma once
+
+#include "cpu/iss/include/isa_lib/vint.h"
+
+static inline void lib_ref_ADDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+        res = data1+data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_ADDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1+data2;
+
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_ADDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1+data2;
+
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_SUBVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data2 - data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_SUBVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data2 - data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_RSUBVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ 
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 - data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_RSUBVI   (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 - data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_ANDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 & data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_ANDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ 
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 & data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_ANDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){  
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 & data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_ORVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 | data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_ORVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 | data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_ORVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 | data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_XORVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 ^ data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_XORVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 ^ data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_XORVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 ^ data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MINVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = (data1 > data2)?data2:data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MINVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = (data1 > data2)?data2:data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MINUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbsU(iss, SEW, vs1, i, &data1);
+        myAbsU(iss, SEW, vs2, i, &data2);
+
+        res = (data1 > data2)?data2:data1;
+
+        intToBinU(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MINUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs2, i, &data2);
+        
+        res = (data1 > data2)?data2:data1;
+        
+        intToBinU(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MAXVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = (data1 > data2)?data1:data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MAXVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = (data1 > data2)?data1:data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MAXUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbsU(iss, SEW, vs1, i, &data1);
+        myAbsU(iss, SEW, vs2, i, &data2);
+
+        res = (data1 > data2)?data1:data2;
+
+        intToBinU(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MAXUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs2, i, &data2);
+        
+        res = (data1 > data2)?data1:data2;
+        
+        intToBinU(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MULVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MULVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MULHVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void lib_ref_MULHVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void lib_ref_MULHUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void lib_ref_MULHUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+
+    intToBin(64, rs1, data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void lib_ref_MULHSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void lib_ref_MULHSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, rs1, data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn == 1){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void lib_ref_MVVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, res;
+    bool bin[8];
+    bool resBin[64];
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        
+        res = data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MVVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t res;
+    bool bin[8];
+    bool resBin[64];
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        res = rs1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MVVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t res;
+    bool bin[8];
+    bool resBin[64];
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        
+        res = sim;
+        intToBin(SEW, abs(res), resBin);
+        if(sim < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MVSX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t res;
+    bool resBin[64];
+    res = rs1;
+    if(VSTART < VL){
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(vm){
+            writeToVReg(iss, SEW, vd, 0, resBin);
+        }else{
+            printf("MVSX VM=0 is RESERVED\n");
+        }
+    }
+}
+
+static inline iss_reg_t lib_ref_MVXS     (Iss *iss, int vs2, bool vm){
+
+    int64_t data1;
+
+    myAbs(iss, SEW, vs2, 0, &data1);
+
+    return iss_reg_t(data1);
+}
+
+static inline void lib_ref_WMULVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMULVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMULUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMULUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+
+    intToBin(64, rs1, data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMULSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMULSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, rs1, data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn == 1){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MACCVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW, vd , i, data3);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(sgn){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MACCVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW, vd , i, data3);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;
+        }
+
+        extend2x(SEW, data3, data3Ext, true);
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MADDVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vd , i, data2);
+        buildDataBin(iss, SEW, vs2, i, data3);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(sgn){
+            twosComplement(SEW*2,mulOutBin);
+            sgn = 0;
+        }
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_MADDVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vd , i, data2);
+        buildDataBin(iss, SEW, vs2 , i, data3);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+
+        extend2x(SEW, data3, data3Ext, true);
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_NMSACVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW, vd , i, data3);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(!sgn){//compare with VMACC
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_NMSACVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW, vd , i, data3);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(!((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1))){//compare with VMACC
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_NMSUBVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vd , i, data2);
+        buildDataBin(iss, SEW, vs2, i, data3);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(!sgn){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_NMSUBVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vd , i, data2);
+        buildDataBin(iss, SEW, vs2 , i, data3);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if(!((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1))){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMACCVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW  , vs1, i, data1);
+        buildDataBin(iss, SEW  , vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;            
+        }
+        // extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(sgn){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMACCVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;
+        }
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMACCUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        buildDataBin(iss, SEW  , vs1, i, data1);
+        buildDataBin(iss, SEW  , vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMACCUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMACCUSVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;
+        }
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if(sgn == 1){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMACCSUVV(Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW  , vs1, i, data1);
+        buildDataBin(iss, SEW  , vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;            
+        }
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(sgn){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_WMACCSUVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;
+        }
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_REDSUMVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res += data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void lib_ref_REDANDVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res &= data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void lib_ref_REDORVS  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res |= data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void lib_ref_REDXORVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res ^= data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void lib_ref_REDMINVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res = (res < data2)?res:data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void lib_ref_REDMINUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbsU(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbsU(iss, SEW, vs2, i, &data2);
+            res = (res < data2)?res:data2;
+        }
+    }
+    intToBinU(SEW, res, resBin);
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void lib_ref_REDMAXVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res = (res > data2)?res:data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void lib_ref_REDMAXUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbsU(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbsU(iss, SEW, vs2, i, &data2);
+            res = (res > data2)?res:data2;
+        }
+    }
+    intToBinU(SEW, res, resBin);
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void lib_ref_SLIDEUPVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    int64_t OFFSET;
+    bool bin[8];
+   
+    OFFSET = rs1;
+    int s = MAX(VSTART,OFFSET); 
+
+    for (int i = s; i < VL; i++){
+        intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+
+        if(!mask(vm,bin)){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-OFFSET)*t+j];
+            }
+        }
+    }
+}
+
+static inline void lib_ref_SLIDEUPVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    int64_t OFFSET;
+    bool bin[8];
+    OFFSET = sim;
+    int s = MAX(VSTART,OFFSET); 
+
+    for (int i = s; i < VL; i++){
+        intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        if(!mask(vm,bin)){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-OFFSET)*t+j];
+            }
+        }
+    }
+}
+
+static inline void lib_ref_SLIDEDWVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    int64_t OFFSET;
+    bool bin[8];
+    OFFSET = rs1;
+    int s = MAX(VSTART,OFFSET); 
+
+    for (int i = VSTART; i < VL; i++){
+        if(i+OFFSET >= VLMAX){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = 0;
+            }            
+        }else{
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+
+            if(!mask(vm,bin)){
+                for(int j = 0; j <  t ; j++){
+                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+OFFSET)*t+j];
+                }
+            }
+        }
+    }
+}
+
+static inline void lib_ref_SLIDEDWVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    int64_t OFFSET;
+    bool bin[8];
+    OFFSET = sim;
+
+    int s = MAX(VSTART,OFFSET); 
+
+    for (int i = VSTART; i < VL; i++){
+        if(i+OFFSET >= VLMAX){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = 0;
+            }            
+        }else{
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+            
+            if(!mask(vm,bin)){
+                for(int j = 0; j <  t ; j++){
+                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+OFFSET)*t+j];
+                }
+            }
+        }
+    }
+}
+
+static inline void lib_ref_SLIDE1UVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    bool bin[8];
+    bool data1[64];
+   
+    int s = MAX(VSTART,1); 
+    intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][0],bin);
+
+    int i = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+    if(rs1 < 0){
+        twosComplement(64,data1);
+    }
+    if(VSTART == 0){
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, 0, data1);
+        }
+    }
+    for (int i = s; i < VL; i++){
+        if(!((i-s)%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i-s)/8],bin);
+        }
+        
+        if(!mask(vm,bin)){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-1)*t+j];
+            }
+        }
+    }
+}
+
+static inline void lib_ref_SLIDE1DVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    bool bin[8];
+    bool data1[64];
+    
+    intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][0],bin);
+
+    int i = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+    if(rs1 < 0){
+        twosComplement(64,data1);
+    }
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            if(i == VL-1){
+                writeToVReg(iss, SEW, vd, VL-1, data1);   
+            }else{
+                for(int j = 0; j <  t ; j++){
+                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+1)*t+j];
+                }
+            }
+        }
+    }
+}
+
+static inline void lib_ref_DIVVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data2/data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_DIVVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data2/data1;
+
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_DIVUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs1, i, &data1);
+        myAbsU(iss, SEW, vs2, i, &data2);
+
+        res = data2/data1;
+
+        intToBin(SEW, res, resBin);
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_DIVUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs2, i, &data2);
+        
+        res = data2/data1;
+
+
+        intToBin(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_REMVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data2%data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_REMVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data2%data1;
+
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_REMUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2;
+    int64_t res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs1, i, &data1);
+        myAbsU(iss, SEW, vs2, i, &data2);
+
+        res = data2%data1;
+        intToBin(SEW, res, resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void lib_ref_REMUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    uint64_t data1, data2;
+    int64_t res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs2, i, &data2);
+        
+        res = data2%data1;
+
+
+        intToBin(SEW, res, resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
@@ -0,0 +1,415 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+// Throughput of the JIT tier against the batch interpreter, on the inner loops of common kernels.
+// Each kernel is a loop body, decoded by hand into a block of instructions which is executed the
+// same way as in the batch loop of the core, see Exec::exec_instr_batch: once with the instruction
+// handlers only, and once with the runs of ALU instructions translated by InsnJit, following the
+// same rule as InsnCache::block_jit_translate. Both must end with the same registers and memory.
+// The ALU instructions go through the handlers of the core, which only access the register file.
+// Loads, stores and branches, which are never translated, go through simplified handlers, which
+// are cheaper than the ones of the core, so the speedups are upper bounds.
+//
+// Usage: gvsoc_jit_bench [<instructions per kernel> [<batch instructions>]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <cpu/iss/include/iss.hpp>
+#include <cpu/iss/include/isa/rv32i.hpp>
+#include <cpu/iss/include/isa/rv32m.hpp>
+
+#if defined(ISS_HAS_JIT)
+
+// Memory accessed by the loads and stores, addresses are wrapped inside it
+#define JIT_BENCH_MEM_SIZE 4096
+// Number of times each kernel is run in each mode
+#define JIT_BENCH_NB_PASSES 3
+
+static uint8_t jit_bench_mem[JIT_BENCH_MEM_SIZE];
+
+static inline uint8_t *jit_bench_addr(Iss *iss, iss_insn_t *insn, int size)
+{
+    return &jit_bench_mem[(REG_GET(0) + SIM_GET(0)) & (JIT_BENCH_MEM_SIZE - size)];
+}
+
+static iss_reg_t jit_bench_lw(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
+{
+    uint32_t value;
+    memcpy(&value, jit_bench_addr(iss, insn, 4), 4);
+    REG_SET(0, value);
+    return iss_insn_next(iss, insn, pc);
+}
+
+static iss_reg_t jit_bench_lbu(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
+{
+    REG_SET(0, *jit_bench_addr(iss, insn, 1));
+    return iss_insn_next(iss, insn, pc);
+}
+
+static iss_reg_t jit_bench_sw(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
+{
+    uint32_t value = REG_GET(1);
+    memcpy(jit_bench_addr(iss, insn, 4), &value, 4);
+    return iss_insn_next(iss, insn, pc);
+}
+
+static iss_reg_t jit_bench_bne(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
+{
+    return REG_GET(0) != REG_GET(1) ? pc + SIM_GET(0) : iss_insn_next(iss, insn, pc);
+}
+
+// Instruction of a kernel. Loads and stores have the address register as first input, and the
+// stored register as second one. Branches go back to the beginning of the loop if taken.
+typedef struct
+{
+    const char *label;
+    iss_reg_t (*handler)(Iss *, iss_insn_t *, iss_reg_t);
+    int rd;
+    int rs1;
+    int rs2;
+    int32_t imm;
+} jit_bench_insn_t;
+
+enum { ZERO=0, T0=5, T1=6, T2=7, A0=10, A1=11, A2=12, A3=13, T3=28 };
+
+typedef struct
+{
+    const char *name;
+    std::vector<jit_bench_insn_t> insns;
+    // Initial values of the registers, the loop counters are big enough to never exit the loop
+    std::vector<std::pair<int, iss_reg_t>> regs;
+} jit_bench_kernel_t;
+
+static std::vector<jit_bench_kernel_t> jit_bench_kernels = {
+    // Bitwise CRC32, one bit per iteration
+    { "crc32", {
+        { "andi", andi_exec, T1, A0, 0, 1 },
+        { "sub", sub_exec, T1, ZERO, T1, 0 },
+        { "and", and_exec, T1, T1, A2, 0 },
+        { "srli", srli_exec, A0, A0, 0, 1 },
+        { "xor", xor_exec, A0, A0, T1, 0 },
+        { "addi", addi_exec, T0, T0, 0, -1 },
+        { "bne", jit_bench_bne, 0, T0, ZERO, 0 },
+    }, { { A0, 0x12345678 }, { A2, 0xEDB88320 }, { T0, 1 << 30 } } },
+    // Integer matrix multiplication, dot product of a line and a column
+    { "matmul", {
+        { "lw", jit_bench_lw, T1, A0, 0, 0 },
+        { "lw", jit_bench_lw, T2, A1, 0, 0 },
+        { "mul", mul_exec, T1, T1, T2, 0 },
+        { "add", add_exec, A2, A2, T1, 0 },
+        { "addi", addi_exec, A0, A0, 0, 4 },
+        { "add", add_exec, A1, A1, A3, 0 },
+        { "addi", addi_exec, T0, T0, 0, -1 },
+        { "bne", jit_bench_bne, 0, T0, ZERO, 0 },
+    }, { { A1, 1024 }, { A3, 64 }, { T0, 1 << 30 } } },
+    // FNV-1a hash, one byte per iteration
+    { "fnv1a", {
+        { "lbu", jit_bench_lbu, T1, A0, 0, 0 },
+        { "xor", xor_exec, A2, A2, T1, 0 },
+        { "mul", mul_exec, A2, A2, A3, 0 },
+        { "addi", addi_exec, A0, A0, 0, 1 },
+        { "bne", jit_bench_bne, 0, A0, A1, 0 },
+    }, { { A1, -1 }, { A2, 0x811C9DC5 }, { A3, 0x01000193 } } },
+    // Word copy
+    { "memcpy", {
+        { "lw", jit_bench_lw, T1, A0, 0, 0 },
+        { "sw", jit_bench_sw, 0, A1, T1, 0 },
+        { "addi", addi_exec, A0, A0, 0, 4 },
+        { "addi", addi_exec, A1, A1, 0, 4 },
+        { "bne", jit_bench_bne, 0, A0, A2, 0 },
+    }, { { A1, 2048 }, { A2, -4 } } },
+    // String length, the memory has no null byte
+    { "strlen", {
+        { "lbu", jit_bench_lbu, T1, A0, 0, 0 },
+        { "addi", addi_exec, A0, A0, 0, 1 },
+        { "bne", jit_bench_bne, 0, T1, ZERO, 0 },
+    }, { } },
+    // Control code mixing memory accesses, address computations and comparisons
+    { "mixed", {
+        { "lw", jit_bench_lw, T1, A0, 0, 0 },
+        { "addi", addi_exec, T1, T1, 0, 1 },
+        { "sw", jit_bench_sw, 0, A0, T1, 0 },
+        { "slli", slli_exec, T2, T1, 0, 2 },
+        { "add", add_exec, T2, T2, A1, 0 },
+        { "lw", jit_bench_lw, T3, T2, 0, 0 },
+        { "sltu", sltu_exec, T3, T3, T1, 0 },
+        { "add", add_exec, A2, A2, T3, 0 },
+        { "addi", addi_exec, A0, A0, 0, 4 },
+        { "addi", addi_exec, T0, T0, 0, -1 },
+        { "bne", jit_bench_bne, 0, T0, ZERO, 0 },
+    }, { { A1, 1024 }, { T0, 1 << 30 } } },
+};
+
+// Only the register file of the core is used, by the handlers and the translated code
+alignas(64) static char jit_bench_iss[sizeof(Iss)];
+// State updated by the batch loop in the core, kept in memory like there
+int64_t jit_bench_batch_cycles;
+iss_reg_t jit_bench_current_insn;
+
+// Decoded block of a kernel, with its translated runs
+typedef struct
+{
+    std::vector<iss_insn_t> insns;
+    std::vector<iss_insn_cold_t> cold;
+    std::vector<iss_decoder_item_t> items;
+    std::vector<InsnJitRun> runs;
+    int nb_jit_insns;
+} jit_bench_block_t;
+
+static void jit_bench_decode(jit_bench_kernel_t *kernel, jit_bench_block_t *block)
+{
+    int nb_insns = kernel->insns.size();
+
+    block->insns.assign(nb_insns, iss_insn_t());
+    block->cold.assign(nb_insns, iss_insn_cold_t());
+    block->items.assign(nb_insns, iss_decoder_item_t());
+
+    for (int i = 0; i < nb_insns; i++)
+    {
+        jit_bench_insn_t *desc = &kernel->insns[i];
+        iss_insn_t *insn = &block->insns[i];
+        iss_decoder_item_t *item = &block->items[i];
+
+        item->is_insn = true;
+        item->is_active = true;
+        item->u.insn.label = (char *)desc->label;
+        item->u.insn.handler = desc->handler;
+        item->u.insn.fast_handler = desc->handler;
+
+        insn->cold = &block->cold[i];
+        insn->cold->decoder_item = item;
+        insn->handler = desc->handler;
+        insn->fast_handler = desc->handler;
+        insn->size = 4;
+        insn->addr = i * 4;
+        if (desc->handler == jit_bench_sw || desc->handler == jit_bench_bne)
+        {
+            insn->in_regs[0] = desc->rs1;
+            insn->in_regs[1] = desc->rs2;
+        }
+        else
+        {
+            insn->out_regs[0] = desc->rd;
+            insn->in_regs[0] = desc->rs1;
+            insn->in_regs[1] = desc->rs2;
+        }
+        insn->sim[0] = desc->handler == jit_bench_bne ? -i * 4 : desc->imm;
+        insn->uim[0] = desc->imm;
+    }
+}
+
+// Same as InsnCache::block_jit_translate
+static void jit_bench_translate(InsnJit *jit, jit_bench_block_t *block)
+{
+    int nb_insns = block->insns.size();
+    std::vector<iss_insn_t *> insns(nb_insns);
+    int index = 0;
+
+    for (int i = 0; i < nb_insns; i++)
+    {
+        insns[i] = &block->insns[i];
+    }
+
+    block->runs.assign(nb_insns, InsnJitRun());
+    block->nb_jit_insns = 0;
+
+    while (index < nb_insns)
+    {
+        int first = index;
+
+        while (index < nb_insns && jit->insn_op(insns[index]) != InsnJit::OP_NONE)
+        {
+            index++;
+        }
+
+        if (index - first >= INSN_JIT_MIN_RUN)
+        {
+            InsnJitCode code = jit->run_translate(&insns[first], index - first, first * 4);
+            block->runs[first] = { code, index - first, (index - first) * 4 };
+            block->nb_jit_insns += index - first;
+        }
+
+        if (index == first)
+        {
+            index++;
+        }
+    }
+}
+
+// Same as the batch loop of the core, without the traces, profiling and instruction cache
+// lookups. The kernels are a single block, which is chained to itself.
+static void jit_bench_run(Iss *iss, jit_bench_block_t *block, int64_t nb_insns_total,
+    int64_t batch_insns, bool jit)
+{
+    iss_reg_t pc = 0;
+    int block_size = block->insns.size();
+    // Blocks without any translated run have no run table in the core
+    InsnJitRun *runs = jit && block->nb_jit_insns > 0 ? block->runs.data() : NULL;
+
+    for (int64_t total = 0; total < nb_insns_total; total += batch_insns)
+    {
+        int64_t nb_insns = 0;
+
+        while (1)
+        {
+            // A batch may have ended in the middle of the block
+            for (int i = pc / 4; ; i++)
+            {
+                if (runs != NULL)
+                {
+                    InsnJitRun *run = &runs[i];
+                    if (run->code != NULL && nb_insns + run->nb_insns < batch_insns)
+                    {
+                        jit_bench_batch_cycles += nb_insns > 0 ? run->nb_insns : run->nb_insns - 1;
+                        run->code(iss->regfile.regs);
+                        nb_insns += run->nb_insns;
+                        pc += run->size;
+                        jit_bench_current_insn = pc;
+                        i += run->nb_insns - 1;
+                        continue;
+                    }
+                }
+
+                iss_insn_t *insn = &block->insns[i];
+
+                if (nb_insns > 0)
+                {
+                    jit_bench_batch_cycles++;
+                }
+
+                iss_reg_t next_pc = insn->fast_handler(iss, insn, pc);
+                jit_bench_current_insn = next_pc;
+
+                nb_insns++;
+
+                bool fallthrough = next_pc == pc + insn->size;
+                pc = next_pc;
+
+                if (nb_insns >= batch_insns)
+                {
+                    goto end;
+                }
+
+                if (!fallthrough || i + 1 == block_size)
+                {
+                    break;
+                }
+            }
+
+            if (pc != 0)
+            {
+                fprintf(stderr, "Kernel left its loop at pc 0x%lx\n", (unsigned long)pc);
+                exit(1);
+            }
+        }
+
+end:
+        jit_bench_batch_cycles = 0;
+    }
+}
+
+// Run a kernel with both modes, returns 1 if they ended differently
+static int jit_bench_kernel(InsnJit *jit, jit_bench_kernel_t *kernel, int64_t nb_insns,
+    int64_t batch_insns)
+{
+    Iss *iss = (Iss *)jit_bench_iss;
+    jit_bench_block_t block;
+    iss_reg_t regs[2][ISS_NB_REGS+1];
+    uint8_t mem[2][JIT_BENCH_MEM_SIZE];
+    double mips[2] = { 0, 0 };
+
+    jit_bench_decode(kernel, &block);
+    jit_bench_translate(jit, &block);
+
+    // Both modes are run alternately several times and the best time is kept, to reduce the
+    // noise of the host
+    for (int pass = 0; pass < JIT_BENCH_NB_PASSES * 2; pass++)
+    {
+        int mode = pass & 1;
+
+        memset(iss->regfile.regs, 0, sizeof(iss->regfile.regs));
+        for (auto reg: kernel->regs)
+        {
+            iss->regfile.regs[reg.first] = reg.second;
+        }
+        for (int i = 0; i < JIT_BENCH_MEM_SIZE; i++)
+        {
+            jit_bench_mem[i] = (i * 31 + 7) | 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        jit_bench_run(iss, &block, nb_insns, batch_insns, mode == 1);
+        auto end = std::chrono::steady_clock::now();
+
+        mips[mode] = std::max(mips[mode],
+            nb_insns / std::chrono::duration<double, std::micro>(end - start).count());
+        memcpy(regs[mode], iss->regfile.regs, sizeof(regs[mode]));
+        memcpy(mem[mode], jit_bench_mem, sizeof(mem[mode]));
+    }
+
+    printf("%-8s %6d %7.1f%% %10.1f %10.1f %7.2fx\n", kernel->name, (int)block.insns.size(),
+        100.0 * block.nb_jit_insns / block.insns.size(), mips[0], mips[1], mips[1] / mips[0]);
+
+    if (memcmp(regs[0], regs[1], sizeof(regs[0])) || memcmp(mem[0], mem[1], sizeof(mem[0])))
+    {
+        printf("Error on %s, the translated code ended with a different state\n", kernel->name);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int64_t nb_insns = argc > 1 ? strtoll(argv[1], NULL, 0) : 100000000;
+    int64_t batch_insns = argc > 2 ? strtoll(argv[2], NULL, 0) : 10000;
+    InsnJit jit;
+    int errors = 0;
+
+    if (!jit.init(INSN_JIT_BUFFER_SIZE))
+    {
+        printf("Failed to allocate JIT code buffer\n");
+        return 1;
+    }
+
+    printf("%ld instructions per kernel, batches of %ld instructions\n", (long)nb_insns,
+        (long)batch_insns);
+    printf("%-8s %6s %8s %10s %10s %8s\n", "kernel", "insns", "jit", "interp MIPS", "jit MIPS",
+        "speedup");
+
+    for (jit_bench_kernel_t &kernel: jit_bench_kernels)
+    {
+        errors += jit_bench_kernel(&jit, &kernel, nb_insns, batch_insns);
+    }
+
+    return errors ? 1 : 0;
+}
+
+#else
+
+int main(int argc, char *argv[])
+{
+    printf("JIT is not supported on this host\n");
+    return 0;
+}
+
+#endif
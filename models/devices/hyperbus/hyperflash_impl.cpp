@@ -29,6 +29,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 
+#include <vp/mmap_file.hpp>
 #include <vp/itf/hyper.hpp>
 #include <vp/itf/wire.hpp>
 
@@ -89,7 +90,6 @@ protected:
 
   int size;
   uint8_t *data;
-  bool data_is_mmapped;
   uint8_t *reg_data;
 
   hyperflash_state_e state;
@@ -333,45 +333,17 @@ int Hyperflash::preload_file(char *path)
 {
   this->trace.msg(vp::Trace::LEVEL_INFO, "Preloading memory with stimuli file (path: %s)\n", path);
 
-  if (this->get_js_config()->get_child_bool("writeback"))
+  // The file is mapped instead of being read, so that only the pages which are accessed are
+  // loaded. With writeback, the flash content is persistent and written back to the file.
+  bool writeback = this->get_js_config()->get_child_bool("writeback");
+  int64_t mapped = vp::mmap_file(this->data, this->size, path, writeback);
+  if (mapped == -1)
   {
-    int fd = open(path, O_RDWR | O_CREAT, 0600);
-    if (fd < 0) {
-      printf("Unable to open writeback file (path: %s, error: %s)\n", path, strerror(errno));
-      return 0;
-    }
-
-    if (ftruncate(fd, this->size) < 0) {
-      printf("Unable to truncate writeback file (path: %s, error: %s)\n", path, strerror(errno));
-      close(fd);
-      return -1;
-    }
-    this->data = (uint8_t *) mmap(NULL, this->size, PROT_READ | PROT_WRITE, MAP_SHARED , fd, 0);
-    if (!this->data) {
-      printf("Unable to mmap writeback file (path: %s, error: %s)\n", path, strerror(errno));
-      close(fd);
-      return -1;
-    }
-
-    /*
-    * fd is even not useful anymore and can be closed.
-    * Data are automatically write back to the file
-    * at random time during execution (depending of the kernel cache behavior)
-    * and, anyway, at the termination of the application.
-    */
-    close(fd);
+    printf("Unable to map stimulus file (path: %s, error: %s)\n", path, strerror(errno));
+    return -1;
   }
-  else
-  {
-    FILE *file = fopen(path, "r");
-    if (file == NULL) {
-      printf("Unable to open stimulus file (path: %s, error: %s)\n", path, strerror(errno));
-      return -1;
-    }
 
-    if (fread(this->data, 1, this->size, file) == 0)
-      return -1;
-  }
+  memset(this->data + mapped, 0xff, this->size - mapped);
 
   return 0;
 }
@@ -395,7 +367,7 @@ int Hyperflash::setup_writeback_file(const char *path)
 	  return -1;
   }
   uint8_t *mmapped_data = (uint8_t *) mmap(NULL, this->size, PROT_READ | PROT_WRITE, MAP_SHARED , fd, 0);
-  if (!mmapped_data) {
+  if (mmapped_data == MAP_FAILED) {
 	  printf("Unable to mmap writeback file (path: %s, error: %s)\n", path, strerror(errno));
 	  close(fd);
 	  return -1;
@@ -403,9 +375,8 @@ int Hyperflash::setup_writeback_file(const char *path)
 
   /* copy the current data content into the mmap area and replace data pointer with the mmap pointer */
   memcpy(mmapped_data, this->data, this->size);
-  free(this->data);
+  vp::mmap_free(this->data, this->size);
   this->data = mmapped_data;
-  this->data_is_mmapped = true;
 
   /*
    * fd is even not useful anymore and can be closed.
@@ -434,9 +405,11 @@ Hyperflash::Hyperflash(vp::ComponentConf &config)
   this->size = conf->get("size")->get_int();
   this->trace.msg(vp::Trace::LEVEL_INFO, "Building flash (size: 0x%x)\n", this->size);
 
-  this->data = new uint8_t[this->size];
-  memset(this->data, 0xff, this->size);
-  this->data_is_mmapped = false;
+  this->data = (uint8_t *)vp::mmap_alloc(this->size);
+  if (this->data == NULL)
+  {
+    throw std::bad_alloc();
+  }
 
   this->reg_data = new uint8_t[REGS_AREA_SIZE];
   memset(this->reg_data, 0x57, REGS_AREA_SIZE);
@@ -460,6 +433,10 @@ Hyperflash::Hyperflash(vp::ComponentConf &config)
       return;
     }
   }
+  else
+  {
+    memset(this->data, 0xff, this->size);
+  }
 
   js::Config *writeback_file_conf = conf->get("writeback_file");
 
@@ -48,7 +48,9 @@ class Atxp032(st.Component):
 
         self.set_component('devices.spiflash.spiflash_impl')
 
-        self.add_property('writeback', True)
+        # The image is mapped copy-on-write unless writeback is set, in which case everything
+        # written to the flash ends up in the image file
+        self.add_property('writeback', False)
         self.add_property('size', size)
 
         # TODO this is needed by GAPY but is not aligned with the size given to model
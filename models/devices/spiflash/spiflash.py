@@ -38,7 +38,9 @@ class Spiflash(Flash):
 
         self.set_component('devices.spiflash.spiflash_impl')
 
-        self.add_property('writeback', True)
+        # The image is mapped copy-on-write unless writeback is set, in which case everything
+        # written to the flash ends up in the image file
+        self.add_property('writeback', False)
         self.add_property('size', size)
 
         self.add_property('preload_file', self.get_image_path())
@@ -22,6 +22,7 @@
 #include <vp/vp.hpp>
 #include <stdio.h>
 #include <string.h>
+#include <vp/mmap_file.hpp>
 #include <vp/itf/qspim.hpp>
 
 #define CMD_READ_ID       0x9f
@@ -463,9 +464,11 @@ spiflash::spiflash(vp::ComponentConf &config)
 
   this->size = this->get_js_config()->get_child_int("size");
 
-  this->mem_data = new uint8_t[this->size];
-
-  memset(this->mem_data, 0x57, this->size);
+  this->mem_data = (uint8_t *)vp::mmap_alloc(this->size);
+  if (this->mem_data == NULL)
+  {
+    throw std::bad_alloc();
+  }
 
   this->cr1.raw = 0;
   this->quad = false;
@@ -492,17 +495,21 @@ spiflash::spiflash(vp::ComponentConf &config)
     string path = stim_file_conf->get_str();
     this->trace.msg(vp::Trace::LEVEL_INFO, "Preloading memory with stimuli file (path: %s)\n", path.c_str());
 
-    FILE *file = fopen(path.c_str(), "rb");
-    if (file == NULL)
-    {
-      this->trace.fatal("Unable to open stim file: %s, %s\n", path.c_str(), strerror(errno));
-      return;
-    }
-    if (fread(this->mem_data, 1, size, file) == 0)
+    // The file is mapped instead of being read, so that only the pages which are accessed are
+    // loaded. With writeback, the flash content is persistent and written back to the file.
+    int64_t mapped = vp::mmap_file(this->mem_data, this->size, path,
+      this->get_js_config()->get_child_bool("writeback"));
+    if (mapped == -1)
     {
-      this->trace.fatal("Failed to read stim file: %s, %s\n", path.c_str(), strerror(errno));
+      this->trace.fatal("Unable to map stim file: %s, %s\n", path.c_str(), strerror(errno));
       return;
     }
+
+    memset(this->mem_data + mapped, 0x57, this->size - mapped);
+  }
+  else
+  {
+    memset(this->mem_data, 0x57, this->size);
   }
 
   js::Config *slm_stim_file_conf = this->get_js_config()->get("slm_stim_file");
@@ -53,6 +53,15 @@ def gen_config(args, config, working_dir, runner, cosim_mode):
     gvsoc_config.set('wunconnected-padfun', args.w_unconnected_padfun)
     gvsoc_config.set('memcheck', args.memcheck)
 
+    if args.parallel:
+        gvsoc_config.set('parallel/enabled', True)
+
+    if args.parallel_quantum is not None:
+        gvsoc_config.set('parallel/quantum', args.parallel_quantum)
+
+    if args.parallel_stats:
+        gvsoc_config.set('parallel/stats', True)
+
     for trace in args.traces:
         gvsoc_config.set('traces/include_regex', trace)
 
@@ -88,7 +97,12 @@ def gen_config(args, config, working_dir, runner, cosim_mode):
 
     gvsoc_config.set("debug-mode", debug_mode)
 
-    if debug_mode:
+    if args.profile is not None:
+        full_config.set('**/profiler/enabled', True)
+        full_config.set('**/profiler/format', args.profile)
+
+    # The profiler also needs the debug symbols to name the functions
+    if debug_mode or args.profile is not None:
         debug_binaries = []
 
         if args.binary is not None:
@@ -173,6 +187,12 @@ class Runner():
 
                     "include_dirs": args.install_dirs,
 
+                    "parallel": {
+                        "enabled": False,
+                        "quantum": 100000,
+                        "stats": False
+                    },
+
                     "runner_module": "gv.gvsoc",
                 
                     "cycles_to_seconds": "int(max(cycles * nb_cores / 5000000, 600))",
@@ -573,7 +593,12 @@ class Target(gapy.Target):
                 help="Specify trace level")
 
             parser.add_argument("--trace-format", dest="trace_format", default="long",
-                help="Specify trace format")
+                choices=["long", "short", "binary"],
+                help="Specify trace format, binary only applies to instruction traces, which must then be dumped to their own file")
+
+            parser.add_argument("--profile", dest="profile", default=None,
+                choices=["callgrind", "pprof"],
+                help="Profile the functions executed by the cores and dump one profile per core in the specified format at the end of the simulation")
 
             parser.add_argument("--vcd", dest="vcd", action="store_true", help="Activate VCD traces")
 
@@ -624,6 +649,15 @@ class Target(gapy.Target):
             parser.add_argument("--memcheck", dest="memcheck",
                 action="store_true", default=False, help="Enable memory checks")
 
+            parser.add_argument("--parallel", dest="parallel",
+                action="store_true", default=False, help="Execute time partitions in parallel")
+
+            parser.add_argument("--parallel-quantum", dest="parallel_quantum", default=None, type=int,
+                help="Specify in picoseconds the time quantum at which parallel partitions are synchronized")
+
+            parser.add_argument("--parallel-stats", dest="parallel_stats",
+                action="store_true", default=False, help="Dump the host time spent by each parallel partition")
+
             parser.add_argument("--wunconnected-device", dest="w_unconnected_device",
                 action="store_true", help="Activate warnings when updating padframe with no connected device")
             parser.add_argument("--wunconnected-padfun", dest="w_unconnected_padfun",
@@ -616,6 +616,15 @@ class Component(object):
         self.component = name
         self.add_property('vp_component', name)
 
+    def set_time_partition(self):
+        """Make this component a time partition.
+
+        When simulation is executed in parallel, the events of this component and of all its
+        sub-components are executed by a dedicated host thread. All bindings going out of the
+        partition must go through an interco.partition_bridge component.
+        """
+        self.add_property('time_partition', True)
+
     def get_generated_components(self):
         return generated_components
 
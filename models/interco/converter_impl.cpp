@@ -45,6 +45,10 @@ private:
 
   static void response(vp::Block *__this, vp::IoReq *req);
 
+  static bool dmi_req(vp::Block *__this, uint64_t addr, vp::IoDmi *dmi);
+
+  static void dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size);
+
   static void event_handler(vp::Block *__this, vp::ClockEvent *event);
 
   vp::IoReqStatus process_req(vp::IoReq *req);
@@ -78,10 +82,12 @@ converter::converter(vp::ComponentConf &config)
   traces.new_trace("trace", &trace, vp::DEBUG);
 
   in.set_req_meth(&converter::req);
+  in.set_dmi_meth(&converter::dmi_req);
   new_slave_port("input", &in);
 
   out.set_resp_meth(&converter::response);
   out.set_grant_meth(&converter::grant);
+  out.set_dmi_invalidate_meth(&converter::dmi_invalidate);
   new_master_port("out", &out);
 
   output_width = get_js_config()->get_child_int("output_width");
@@ -106,6 +112,7 @@ void converter::event_handler(vp::Block *__this, vp::ClockEvent *event)
   {
     _this->ready_cycle = _this->clock.get_cycles() + req->get_latency() + 1;
     _this->ongoing_size -= req->get_size();
+    _this->out.req_del(req);
     if (_this->ongoing_size == 0)
     {
       vp::IoReq *req = _this->ongoing_req;
@@ -234,6 +241,27 @@ void converter::response(vp::Block *__this, vp::IoReq *req)
 {
 }
 
+bool converter::dmi_req(vp::Block *__this, uint64_t addr, vp::IoDmi *dmi)
+{
+  converter *_this = (converter *)__this;
+
+  if (!_this->out.dmi_req(addr, dmi))
+  {
+    return false;
+  }
+
+  // Accesses are forwarded without conversion only if they fit the output alignment, so restrict
+  // the grant to the aligned chunk containing the address
+  uint64_t mask = _this->output_align - 1;
+  return dmi->clip(addr & ~mask, _this->output_align);
+}
+
+void converter::dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size)
+{
+  converter *_this = (converter *)__this;
+  _this->in.dmi_invalidate(base, size);
+}
+
 extern "C" vp::Component *gv_new(vp::ComponentConf &config)
 {
   return new converter(config);
@@ -33,11 +33,17 @@ public:
 
   static vp::IoReqStatus req(vp::Block *__this, vp::IoReq *req);
 
+  vp::IoReqStatus req_vectored(vp::IoReq *req);
+
 
   static void grant(vp::Block *__this, vp::IoReq *req);
 
   static void response(vp::Block *__this, vp::IoReq *req);
 
+  static bool dmi_req(vp::Block *__this, uint64_t addr, vp::IoDmi *dmi);
+
+  static void dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size);
+
 private:
   vp::Trace     trace;
 
@@ -51,6 +57,11 @@ private:
   int stage_bits;
   uint64_t offset_mask;
   uint64_t remove_offset;
+
+  // Segments of a vectored request going to each slave, and for each of them, the index of the
+  // input segment it comes from
+  std::vector<vp::IoReqSegment> *slave_segments;
+  std::vector<int> *slave_segments_parent;
 };
 
 interleaver::interleaver(vp::ComponentConf &config)
@@ -59,6 +70,8 @@ interleaver::interleaver(vp::ComponentConf &config)
   traces.new_trace("trace", &trace, vp::DEBUG);
 
   in.set_req_meth(&interleaver::req);
+  in.set_dmi_meth(&interleaver::dmi_req);
+  in.set_vectored(true);
   new_slave_port("input", &in);
 
   nb_slaves = get_js_config()->get_child_int("nb_slaves");
@@ -75,12 +88,16 @@ interleaver::interleaver(vp::ComponentConf &config)
   offset_mask = -1;
   offset_mask &= ~((1 << (interleaving_bits + stage_bits)) - 1);
 
+  slave_segments = new std::vector<vp::IoReqSegment>[nb_slaves];
+  slave_segments_parent = new std::vector<int>[nb_slaves];
+
   out = new vp::IoMaster *[nb_slaves];
   for (int i=0; i<nb_slaves; i++)
   {
     out[i] = new vp::IoMaster();
     out[i]->set_resp_meth(&interleaver::response);
     out[i]->set_grant_meth(&interleaver::grant);
+    out[i]->set_dmi_invalidate_meth(&interleaver::dmi_invalidate);
     new_master_port("out_" + std::to_string(i), out[i]);
   }
 
@@ -89,6 +106,8 @@ interleaver::interleaver(vp::ComponentConf &config)
   {
     masters_in[i] = new vp::IoSlave();
     masters_in[i]->set_req_meth(&interleaver::req);
+    masters_in[i]->set_dmi_meth(&interleaver::dmi_req);
+    masters_in[i]->set_vectored(true);
     new_slave_port("in_" + std::to_string(i), masters_in[i]);
   }
 
@@ -97,6 +116,12 @@ interleaver::interleaver(vp::ComponentConf &config)
 vp::IoReqStatus interleaver::req(vp::Block *__this, vp::IoReq *req)
 {
   interleaver *_this = (interleaver *)__this;
+
+  if (req->is_vectored())
+  {
+    return _this->req_vectored(req);
+  }
+
   uint64_t offset = req->get_addr();
   bool is_write = req->get_is_write();
   uint64_t size = req->get_size();
@@ -172,6 +197,73 @@ vp::IoReqStatus interleaver::req(vp::Block *__this, vp::IoReq *req)
   return vp::IO_REQ_OK;
 }
 
+vp::IoReqStatus interleaver::req_vectored(vp::IoReq *req)
+{
+  vp::IoReqSegment *segments = req->get_segments();
+  int nb_segments = req->get_nb_segments();
+  int port_size = 1<<this->interleaving_bits;
+  vp::IoReqStatus status = vp::IO_REQ_OK;
+
+  this->trace.msg("Received vectored IO req (nb_segments: %d, is_write: %d)\n", nb_segments, req->get_is_write());
+
+  // Split all the segments in one pass, the slices going to the same slave are gathered into
+  // a single vectored request for this slave
+  for (int i=0; i<nb_segments; i++)
+  {
+    vp::IoReqSegment *segment = &segments[i];
+    uint64_t offset = segment->addr - this->remove_offset;
+    uint64_t size = segment->size;
+    uint8_t *data = segment->data;
+
+    while (size)
+    {
+      uint64_t loop_size = port_size - (offset & (port_size - 1));
+      if (loop_size > size) loop_size = size;
+
+      int output_id = (offset >> this->interleaving_bits) & ((1 << this->stage_bits) - 1);
+      uint64_t new_offset = ((offset & this->offset_mask) >> this->stage_bits) + (offset & ((1<<this->interleaving_bits)-1));
+
+      this->slave_segments[output_id].push_back({ new_offset, loop_size, data });
+      this->slave_segments_parent[output_id].push_back(i);
+
+      size -= loop_size;
+      offset += loop_size;
+      if (data)
+        data += loop_size;
+    }
+  }
+
+  for (int i=0; i<this->nb_slaves; i++)
+  {
+    std::vector<vp::IoReqSegment> &slave_segments = this->slave_segments[i];
+    if (slave_segments.size() == 0) continue;
+
+    this->trace.msg("Forwarding vectored packet (port: %d, nb_segments: %d)\n", i, (int)slave_segments.size());
+
+    req->set_segments(slave_segments.data(), slave_segments.size());
+    if (this->out[i]->req_forward(req) != vp::IO_REQ_OK)
+    {
+      status = vp::IO_REQ_INVALID;
+    }
+
+    // Each input segment takes the timing of its slowest slice, as for scalar requests
+    for (size_t j=0; j<slave_segments.size(); j++)
+    {
+      vp::IoReqSegment *segment = &segments[this->slave_segments_parent[i][j]];
+      segment->latency = std::max(segment->latency, slave_segments[j].latency);
+      segment->duration = std::max(segment->duration, slave_segments[j].duration);
+    }
+
+    slave_segments.clear();
+    this->slave_segments_parent[i].clear();
+  }
+
+  req->set_segments(segments, nb_segments);
+  req->update_segments_timing();
+
+  return status;
+}
+
 void interleaver::grant(vp::Block *__this, vp::IoReq *req)
 {
 
@@ -181,6 +273,43 @@ void interleaver::response(vp::Block *__this, vp::IoReq *req)
 {
 }
 
+bool interleaver::dmi_req(vp::Block *__this, uint64_t addr, vp::IoDmi *dmi)
+{
+  interleaver *_this = (interleaver *)__this;
+
+  uint64_t offset = addr - _this->remove_offset;
+  int output_id = (offset >> _this->interleaving_bits) & ((1 << _this->stage_bits) - 1);
+  uint64_t new_offset = ((offset & _this->offset_mask) >> _this->stage_bits) + (offset & ((1<<_this->interleaving_bits)-1));
+
+  if (!_this->out[output_id]->dmi_req(new_offset, dmi))
+  {
+    return false;
+  }
+
+  // Only the interleaving chunk containing the address is contiguous in the bank, restrict the
+  // grant to it and convert it back to the input address space
+  uint64_t port_size = 1 << _this->interleaving_bits;
+  if (!dmi->clip(new_offset & ~(port_size - 1), port_size) || dmi->size != port_size)
+  {
+    return false;
+  }
+  dmi->base = addr & ~(port_size - 1);
+
+  return true;
+}
+
+void interleaver::dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size)
+{
+  interleaver *_this = (interleaver *)__this;
+
+  // Chunks of all banks are mixed in the input address space, just invalidate everything
+  _this->in.dmi_invalidate(0, (uint64_t)-1);
+  for (int i=0; i<_this->nb_masters; i++)
+  {
+    _this->masters_in[i]->dmi_invalidate(0, (uint64_t)-1);
+  }
+}
+
 extern "C" vp::Component *gv_new(vp::ComponentConf &config)
 {
   return new interleaver(config);
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#include <vp/vp.hpp>
+#include <vp/itf/io.hpp>
+#include <vp/itf/wire.hpp>
+
+/*
+ * This component must be put on all bindings going from one time partition to another.
+ * Since partitions are executed by different host threads, it forwards requests and wire
+ * values through the time engine, which executes them when all partitions are synchronized,
+ * at the end of the current time quantum.
+ * If simulation is not partitioned, everything is forwarded immediately, and requests are
+ * forwarded without going through the bridge for the response.
+ */
+class PartitionBridge : public vp::Component
+{
+public:
+    PartitionBridge(vp::ComponentConf &config);
+
+private:
+    static vp::IoReqStatus req(vp::Block *__this, vp::IoReq *req);
+    static void response(vp::Block *__this, vp::IoReq *req);
+    static void wire_sync(vp::Block *__this, bool value, int id);
+
+    static void req_forward(vp::Block *__this, void *arg);
+    static void resp_forward(vp::Block *__this, void *arg);
+    static void wire_forward(vp::Block *__this, void *arg);
+
+    vp::Trace trace;
+
+    vp::IoSlave input;
+    vp::IoMaster output;
+
+    std::vector<vp::WireSlave<bool>> wire_inputs;
+    std::vector<vp::WireMaster<bool>> wire_outputs;
+};
+
+
+PartitionBridge::PartitionBridge(vp::ComponentConf &config)
+    : vp::Component(config)
+{
+    this->traces.new_trace("trace", &this->trace, vp::DEBUG);
+
+    this->input.set_req_meth(&PartitionBridge::req);
+    this->new_slave_port("input", &this->input);
+
+    this->output.set_resp_meth(&PartitionBridge::response);
+    this->new_master_port("output", &this->output);
+
+    int nb_wires = this->get_js_config()->get_child_int("nb_wires");
+
+    this->wire_inputs.resize(nb_wires);
+    this->wire_outputs.resize(nb_wires);
+
+    for (int i=0; i<nb_wires; i++)
+    {
+        this->wire_inputs[i].set_sync_meth_muxed(&PartitionBridge::wire_sync, i);
+        this->new_slave_port("wire_input_" + std::to_string(i), &this->wire_inputs[i]);
+        this->new_master_port("wire_output_" + std::to_string(i), &this->wire_outputs[i]);
+    }
+}
+
+
+vp::IoReqStatus PartitionBridge::req(vp::Block *__this, vp::IoReq *req)
+{
+    PartitionBridge *_this = (PartitionBridge *)__this;
+
+    _this->trace.msg(vp::Trace::LEVEL_TRACE, "Received request (req: %p, offset: 0x%lx, size: 0x%lx, is_write: %d)\n",
+        req, req->get_addr(), req->get_size(), req->get_is_write());
+
+    // If the simulation is not partitioned, the bridge is transparent and the target replies
+    // directly to the initiator
+    if (!_this->time.get_engine()->is_partitioned())
+    {
+        return _this->output.req_forward(req);
+    }
+
+    // The request is forwarded to the other partition at the next synchronization point.
+    // Remember the port where the response must be sent, since it will be overwritten
+    // by the output port.
+    req->arg_push(req->get_resp_port());
+    _this->time.get_engine()->sync_post(_this, &PartitionBridge::req_forward, req);
+
+    return vp::IO_REQ_PENDING;
+}
+
+
+void PartitionBridge::req_forward(vp::Block *__this, void *arg)
+{
+    PartitionBridge *_this = (PartitionBridge *)__this;
+    vp::IoReq *req = (vp::IoReq *)arg;
+
+    vp::IoReqStatus status = _this->output.req(req);
+    if (status != vp::IO_REQ_PENDING)
+    {
+        // All partitions are stopped, the response can be sent immediately
+        req->status = status;
+        PartitionBridge::resp_forward(_this, req);
+    }
+}
+
+
+void PartitionBridge::response(vp::Block *__this, vp::IoReq *req)
+{
+    PartitionBridge *_this = (PartitionBridge *)__this;
+
+    // This is called from the partition of the target, the response is sent back at the next
+    // synchronization point
+    _this->time.get_engine()->sync_post(_this, &PartitionBridge::resp_forward, req);
+}
+
+
+void PartitionBridge::resp_forward(vp::Block *__this, void *arg)
+{
+    PartitionBridge *_this = (PartitionBridge *)__this;
+    vp::IoReq *req = (vp::IoReq *)arg;
+    vp::IoSlave *resp_port = (vp::IoSlave *)req->arg_pop();
+
+    _this->trace.msg(vp::Trace::LEVEL_TRACE, "Sending back response (req: %p, status: %d)\n",
+        req, req->status);
+
+    resp_port->resp(req);
+}
+
+
+void PartitionBridge::wire_sync(vp::Block *__this, bool value, int id)
+{
+    PartitionBridge *_this = (PartitionBridge *)__this;
+
+    _this->time.get_engine()->sync_post(_this, &PartitionBridge::wire_forward,
+        (void *)(((intptr_t)id << 1) | value));
+}
+
+
+void PartitionBridge::wire_forward(vp::Block *__this, void *arg)
+{
+    PartitionBridge *_this = (PartitionBridge *)__this;
+    intptr_t data = (intptr_t)arg;
+    int id = data >> 1;
+    bool value = data & 1;
+
+    _this->trace.msg(vp::Trace::LEVEL_TRACE, "Forwarding wire (id: %d, value: %d)\n", id, value);
+
+    _this->wire_outputs[id].sync(value);
+}
+
+
+extern "C" vp::Component *gv_new(vp::ComponentConf &config)
+{
+    return new PartitionBridge(config);
+}
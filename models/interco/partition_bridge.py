@@ -0,0 +1,43 @@
+#
+# Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and University of Bologna
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import gvsoc.systree as st
+
+class Partition_bridge(st.Component):
+    """Bridge for bindings crossing time partitions
+
+    All IO requests and wires going from one time partition to another must go through this
+    component, so that they are forwarded at the next synchronization point when simulation
+    is executed in parallel.
+
+    Attributes
+    ----------
+    parent: gvsoc.systree.Component
+        The parent component where this one should be instantiated.
+    name: str
+        The name of the component within the parent space.
+    nb_wires: int
+        Number of boolean wires which can be forwarded, on top of the IO requests.
+    """
+
+    def __init__(self, parent, name, nb_wires=0):
+        super(Partition_bridge, self).__init__(parent, name)
+
+        self.set_component('interco.partition_bridge')
+
+        self.add_properties({
+            'nb_wires': nb_wires,
+        })
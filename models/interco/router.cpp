@@ -45,8 +45,17 @@ public:
     // the latency and duration with the current utilization of the limiter with respect to the
     // bandwidth
     void apply_bandwidth(int64_t cycles, vp::IoReq *req);
+    // Same for a segment of a vectored request, which is timed as a scalar request
+    void apply_bandwidth(int64_t cycles, vp::IoReqSegment *segment, bool is_write);
+    // Can be called on a direct memory access grant going through the limiter to add the fixed
+    // latency. Returns false if a bandwidth is specified, since it can not be respected without
+    // seeing the requests.
+    bool apply_dmi(vp::IoDmi *dmi);
 
 private:
+    void apply_bandwidth(int64_t cycles, uint64_t size, bool is_write, int64_t &latency,
+        int64_t &duration);
+
     Router *top;
     // Bandwidth in bytes per cycle to be respected
     int64_t bandwidth;
@@ -90,6 +99,9 @@ public:
     InputPort(Router *top, int64_t bandwidth, int64_t latency);
     vp::IoSlave itf;
     BandwidthLimiter bw_limiter;
+    // Last mapping hit by a request from this port. Most requests coming from the same initiator
+    // go to the same target, so it is checked before looking up the mapping tree.
+    vp::MappingTreeEntry *last_mapping = NULL;
 };
 
 
@@ -106,9 +118,19 @@ class Router : public RouterCommon
 public:
     Router(vp::ComponentConf &conf);
 
+    void stop() override;
+    std::string handle_command(gv::GvProxy *proxy, FILE *req_file,
+        FILE *reply_file, std::vector<std::string> args, std::string cmd_req) override;
+
 private:
     // Incoming requests are received here. The port indicates from which input port it is received.
     vp::IoReqStatus handle_req(vp::IoReq *req, int port) override;
+    // Incoming vectored requests are received here
+    vp::IoReqStatus handle_req_vectored(vp::IoReq *req, int port);
+    // Get the mapping of an address, first from the last one used by the input port, then from
+    // the tree
+    inline vp::MappingTreeEntry *get_mapping(InputPort *input, uint64_t offset, uint64_t size,
+        bool is_write);
     // Interface callback where incoming requests are received. Just a wrapper for handle_req
     static vp::IoReqStatus req(vp::Block *__this, vp::IoReq *req, int port);
     // Asynchronous response are received here in case a request is spread over multiple mappings.
@@ -116,6 +138,10 @@ private:
     // Called to handle the end of a request, either because it was handled synchronously or through
     // the response callback
     void handle_entry_req_end(vp::IoReq *req);
+    // Interface callback where direct memory access queries are received
+    static bool dmi_req(vp::Block *__this, uint64_t addr, vp::IoDmi *dmi, int port);
+    // Called when a target revokes direct memory accesses, to propagate it to all initiators
+    static void dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size);
 
     // Constants giving the position of the temporary arguments stored in the requests.
     static constexpr int REQ_REM_SIZE = 0;
@@ -133,6 +159,10 @@ private:
     std::vector<OutputPort *> entries;
     // Tree of mappings
     vp::MappingTree mapping_tree;
+    // Number of mapping lookups done for incoming requests, and how many of them were resolved by
+    // the last mapping of the input port
+    uint64_t nb_lookups = 0;
+    uint64_t nb_lookup_hits = 0;
     // Gives the ID of the error mapping, the one returning an error when a request is matching
     // this mapping
     int error_id = -1;
@@ -159,6 +189,8 @@ Router::Router(vp::ComponentConf &config)
         vp::IoSlave *input = &input_port->itf;
         std::string name = i == 0 ? "input" : "input_" + std::to_string(i);
         input->set_req_meth_muxed(&Router::req, i);
+        input->set_dmi_meth_muxed(&Router::dmi_req);
+        input->set_vectored(true);
         this->new_slave_port(name, input, this);
     }
 
@@ -177,6 +209,7 @@ Router::Router(vp::ComponentConf &config)
             OutputPort *entry = new OutputPort(this, bandwidth, config->get_int("latency"));
 
             entry->itf.set_resp_meth(&Router::response);
+            entry->itf.set_dmi_invalidate_meth(&Router::dmi_invalidate);
             this->new_master_port(name, &entry->itf);
 
             entry->remove_offset = config->get_uint("remove_offset");
@@ -202,8 +235,36 @@ vp::IoReqStatus Router::req(vp::Block *__this, vp::IoReq *req, int port)
     return _this->handle_req(req, port);
 }
 
+inline vp::MappingTreeEntry *Router::get_mapping(InputPort *input, uint64_t offset,
+    uint64_t size, bool is_write)
+{
+    vp::MappingTreeEntry *mapping = input->last_mapping;
+    this->nb_lookups++;
+    if (mapping && offset - mapping->base < mapping->size)
+    {
+        this->nb_lookup_hits++;
+    }
+    else
+    {
+        mapping = this->mapping_tree.get(offset, size, is_write);
+
+        // The default mapping is not cached since it only applies outside the other mappings
+        if (mapping && mapping->size != 0 && this->mapping_tree.is_cacheable())
+        {
+            input->last_mapping = mapping;
+        }
+    }
+
+    return mapping;
+}
+
 vp::IoReqStatus Router::handle_req(vp::IoReq *req, int port)
 {
+    if (req->is_vectored())
+    {
+        return this->handle_req_vectored(req, port);
+    }
+
     uint64_t offset = req->get_addr();
     uint64_t size = req->get_size();
     uint8_t *data = req->get_data();
@@ -215,8 +276,8 @@ vp::IoReqStatus Router::handle_req(vp::IoReq *req, int port)
     // First apply the bandwidth limitation coming from the input port
     this->inputs[port]->bw_limiter.apply_bandwidth(this->clock.get_cycles(), req);
 
-    // Get the mapping from the tree
-    vp::MappingTreeEntry *mapping = this->mapping_tree.get(offset, size, req->get_is_write());
+    // Get the mapping, first from the last one used by the input port, then from the tree
+    vp::MappingTreeEntry *mapping = this->get_mapping(this->inputs[port], offset, size, is_write);
 
     // In case no mapping was found, or we hit the error mapping, return an error
     if (!mapping || mapping->id == this->error_id)
@@ -347,6 +408,146 @@ vp::IoReqStatus Router::handle_req(vp::IoReq *req, int port)
     }
 }
 
+vp::IoReqStatus Router::handle_req_vectored(vp::IoReq *req, int port)
+{
+    vp::IoReqSegment *segments = req->get_segments();
+    int nb_segments = req->get_nb_segments();
+    bool is_write = req->get_is_write();
+    int64_t cycles = this->clock.get_cycles();
+    InputPort *input = this->inputs[port];
+    vp::IoReqStatus status = vp::IO_REQ_OK;
+
+    this->trace.msg(vp::Trace::LEVEL_TRACE, "Received vectored IO req (nb_segments: %d, is_write: %d)\n",
+        nb_segments, is_write);
+
+    // Segments are routed in one pass. Consecutive segments going to the same mapping are
+    // forwarded together as a vectored request, after their addresses have been translated in
+    // place.
+    int index = 0;
+    while (index < nb_segments)
+    {
+        vp::IoReqSegment *segment = &segments[index];
+        input->bw_limiter.apply_bandwidth(cycles, segment, is_write);
+
+        vp::MappingTreeEntry *mapping = this->get_mapping(input, segment->addr, segment->size,
+            is_write);
+
+        if (!mapping || mapping->id == this->error_id)
+        {
+            status = vp::IO_REQ_INVALID;
+            index++;
+            continue;
+        }
+
+        OutputPort *entry = this->entries[mapping->id];
+
+        if (!entry->itf.is_bound())
+        {
+            this->trace.msg(vp::Trace::LEVEL_WARNING, "Invalid access, trying to route to non-connected interface (offset: 0x%llx, size: 0x%llx, is_write: %d)\n",
+                segment->addr, segment->size, is_write);
+            status = vp::IO_REQ_INVALID;
+            index++;
+            continue;
+        }
+
+        uint64_t offset = entry->add_offset - entry->remove_offset;
+
+        if (mapping->size != 0 && segment->addr + segment->size > mapping->base + mapping->size)
+        {
+            // Rare case where the segment is spread over several mappings, each part is sent
+            // as a separate request
+            uint64_t addr = segment->addr;
+            uint64_t size = segment->size;
+            uint8_t *data = segment->data;
+
+            while (size)
+            {
+                uint64_t iter_size = std::min(mapping->size - (addr - mapping->base), size);
+                vp::IoReqSegment part = { addr + offset, iter_size, data,
+                    segment->latency, segment->duration };
+
+                entry->bw_limiter.apply_bandwidth(cycles, &part, is_write);
+
+                req->set_segments(&part, 1);
+                if (entry->itf.req_forward(req) != vp::IO_REQ_OK)
+                {
+                    status = vp::IO_REQ_INVALID;
+                }
+
+                // Timing model is that all parts are sent at the same time and the segment
+                // takes the timing of the longest one
+                segment->latency = std::max(segment->latency, part.latency);
+                segment->duration = std::max(segment->duration, part.duration);
+
+                size -= iter_size;
+                addr += iter_size;
+                if (data)
+                    data += iter_size;
+
+                if (size)
+                {
+                    mapping = this->get_mapping(input, addr, size, is_write);
+                    if (!mapping || mapping->id == this->error_id ||
+                        !this->entries[mapping->id]->itf.is_bound())
+                    {
+                        status = vp::IO_REQ_INVALID;
+                        break;
+                    }
+                    entry = this->entries[mapping->id];
+                    offset = entry->add_offset - entry->remove_offset;
+                }
+            }
+
+            index++;
+            continue;
+        }
+
+        // Gather the following segments which entirely fall into the same mapping
+        int first = index;
+        index++;
+        while (index < nb_segments)
+        {
+            vp::IoReqSegment *next = &segments[index];
+            bool same_mapping = mapping->size != 0 && this->mapping_tree.is_cacheable() ?
+                next->addr - mapping->base < mapping->size :
+                this->mapping_tree.get(next->addr, next->size, is_write) == mapping;
+            if (!same_mapping ||
+                (mapping->size != 0 && next->addr + next->size > mapping->base + mapping->size))
+            {
+                break;
+            }
+            input->bw_limiter.apply_bandwidth(cycles, next, is_write);
+            index++;
+        }
+
+        this->trace.msg(vp::Trace::LEVEL_TRACE, "Routing segments to entry (OutputPort: %s, nb_segments: %d)\n",
+            mapping->name.c_str(), index - first);
+
+        for (int i=first; i<index; i++)
+        {
+            entry->bw_limiter.apply_bandwidth(cycles, &segments[i], is_write);
+            segments[i].addr += offset;
+        }
+
+        req->set_segments(&segments[first], index - first);
+        if (entry->itf.req_forward(req) != vp::IO_REQ_OK)
+        {
+            status = vp::IO_REQ_INVALID;
+        }
+
+        // Restore the addresses since the segments belong to the initiator
+        for (int i=first; i<index; i++)
+        {
+            segments[i].addr -= offset;
+        }
+    }
+
+    req->set_segments(segments, nb_segments);
+    req->update_segments_timing();
+
+    return status;
+}
+
 void Router::response(vp::Block *__this, vp::IoReq *req)
 {
     Router *_this = (Router *)__this;
@@ -381,6 +582,88 @@ void Router::response(vp::Block *__this, vp::IoReq *req)
     _this->entries[port]->itf.req_del(req);
 }
 
+bool Router::dmi_req(vp::Block *__this, uint64_t addr, vp::IoDmi *dmi, int port)
+{
+    Router *_this = (Router *)__this;
+
+    vp::MappingTreeEntry *mapping = _this->mapping_tree.get(addr, 1, false);
+
+    // The default mapping is refused since the range granted by the target could overlap the
+    // other mappings
+    if (!mapping || mapping->id == _this->error_id || mapping->size == 0)
+    {
+        return false;
+    }
+
+    OutputPort *entry = _this->entries[mapping->id];
+    if (!entry->itf.is_bound())
+    {
+        return false;
+    }
+
+    uint64_t offset = entry->add_offset - entry->remove_offset;
+
+    if (!entry->itf.dmi_req(addr + offset, dmi))
+    {
+        return false;
+    }
+
+    // Restrict the grant to the mapping, and then convert it back to the input address space
+    if (!dmi->clip(mapping->base + offset, mapping->size))
+    {
+        return false;
+    }
+    dmi->base -= offset;
+
+    if (!_this->inputs[port]->bw_limiter.apply_dmi(dmi) || !entry->bw_limiter.apply_dmi(dmi))
+    {
+        return false;
+    }
+
+    _this->trace.msg(vp::Trace::LEVEL_DEBUG, "Granted direct access (OutputPort: %s, base: 0x%llx, size: 0x%llx)\n",
+        mapping->name.c_str(), dmi->base, dmi->size);
+
+    return true;
+}
+
+void Router::stop()
+{
+    this->trace.msg(vp::Trace::LEVEL_INFO, "Mapping lookups (total: %lld, port cache hits: %lld)\n",
+        this->nb_lookups, this->nb_lookup_hits);
+}
+
+std::string Router::handle_command(gv::GvProxy *proxy, FILE *req_file,
+    FILE *reply_file, std::vector<std::string> args, std::string cmd_req)
+{
+    if (args[0] == "lookup_stats")
+    {
+        std::string result = "err=0;lookups=" + std::to_string(this->nb_lookups) +
+            ";hits=" + std::to_string(this->nb_lookup_hits);
+
+        if (args.size() > 1 && args[1] == "clear")
+        {
+            this->nb_lookups = 0;
+            this->nb_lookup_hits = 0;
+        }
+
+        return result;
+    }
+
+    return RouterCommon::handle_command(proxy, req_file, reply_file, args, cmd_req);
+}
+
+void Router::dmi_invalidate(vp::Block *__this, uint64_t base, uint64_t size)
+{
+    Router *_this = (Router *)__this;
+
+    // The output port on which the invalidation is received is not known, so the whole address
+    // space is invalidated
+    for (InputPort *input: _this->inputs)
+    {
+        input->itf.dmi_invalidate(0, (uint64_t)-1);
+    }
+}
+
 void Router::handle_entry_req_end(vp::IoReq *entry_req)
 {
     // This is called when a child request is over and should be accounted on the parent request
@@ -425,8 +708,23 @@ BandwidthLimiter::BandwidthLimiter(Router *top, int64_t bandwidth, int64_t laten
 
 void BandwidthLimiter::apply_bandwidth(int64_t cycles, vp::IoReq *req)
 {
-    uint64_t size = req->get_size();
+    int64_t latency = req->get_latency();
+    int64_t duration = req->get_duration();
 
+    this->apply_bandwidth(cycles, req->get_size(), req->get_is_write(), latency, duration);
+
+    req->set_latency(latency);
+    req->set_duration(duration);
+}
+
+void BandwidthLimiter::apply_bandwidth(int64_t cycles, vp::IoReqSegment *segment, bool is_write)
+{
+    this->apply_bandwidth(cycles, segment->size, is_write, segment->latency, segment->duration);
+}
+
+void BandwidthLimiter::apply_bandwidth(int64_t cycles, uint64_t size, bool is_write,
+    int64_t &latency, int64_t &duration)
+{
     if (this->bandwidth != 0)
     {
         // Bandwidth was specified
@@ -437,34 +735,42 @@ void BandwidthLimiter::apply_bandwidth(int64_t cycles, vp::IoReq *req)
         // Update burst duration
         // This will update it only if it is bigger than the current duration, in case there is a
         // slower router on the path
-        req->set_duration(burst_duration);
+        duration = std::max(duration, burst_duration);
 
         // Now we need to compute the start cycle of the burst, which is its latency.
         // First get the cyclestamp where the router becomes available, due to previous requests
-        int64_t *next_burst_cycle = req->get_is_write() ?
+        int64_t *next_burst_cycle = is_write ?
             &this->next_write_burst_cycle : &this->next_read_burst_cycle;
         int64_t router_latency = *next_burst_cycle - cycles;
 
         // Then compare that to the request latency and take the highest to properly delay the
-        // request in case the bandwidth is reached.
-        int64_t latency = std::max((int64_t)req->get_latency(), router_latency);
-
-        // Apply the computed latency and add the fixed one
-        req->set_latency(latency + this->latency);
+        // request in case the bandwidth is reached, and add the fixed one
+        latency = std::max(latency, router_latency) + this->latency;
 
         // Update the bandwidth information by appending the new burst right after the previous one.
         *next_burst_cycle = std::max(cycles, *next_burst_cycle) + burst_duration;
 
         this->top->trace.msg(vp::Trace::LEVEL_TRACE, "Updating %s burst bandwidth cyclestamp (bandwidth: %d, next_burst: %d)\n",
-            req->get_is_write() ? "write" : "read", this->bandwidth, *next_burst_cycle);
+            is_write ? "write" : "read", this->bandwidth, *next_burst_cycle);
     }
     else
     {
         // No bandwidth was specified, just add the specified latency
-        req->inc_latency(this->latency);
+        latency += this->latency;
     }
 }
 
+bool BandwidthLimiter::apply_dmi(vp::IoDmi *dmi)
+{
+    if (this->bandwidth != 0)
+    {
+        return false;
+    }
+
+    dmi->latency += this->latency;
+    return true;
+}
+
 extern "C" vp::Component *gv_new(vp::ComponentConf &config)
 {
     return new Router(config);
@@ -134,6 +134,9 @@ void Router_proxy::response(vp::Block *__this, vp::IoReq *req)
     gv::Io_request *io_req = (gv::Io_request *)req->arg_pop();
     io_req->retval = req->status == vp::IO_REQ_INVALID ? gv::Io_request_ko : gv::Io_request_ok;
 
+    // The request is not needed anymore, whether it was handled synchronously or not
+    _this->out.req_del(req);
+
     _this->user->reply(io_req);
 }
 
@@ -182,20 +185,16 @@ void Router_proxy::access(gv::Io_request *io_req)
     {
         this->time.get_engine()->lock();
     }
-    vp::IoReq *req = new vp::IoReq();
-    req->init();
-    req->set_addr(io_req->addr);
-    req->set_size(io_req->size);
-    req->set_is_write(io_req->type == gv::Io_request_write);
-    req->set_data(io_req->data);
+    vp::IoReq *req = this->out.req_new(io_req->addr, io_req->data, io_req->size,
+        io_req->type == gv::Io_request_write);
     req->arg_push(io_req);
     req->set_debug(true);
 
     int err = this->out.req(req);
     if (err == vp::IO_REQ_OK || err == vp::IO_REQ_INVALID)
     {
+        req->status = (vp::IoReqStatus)err;
         this->response(this, req);
-        delete req;
     }
     if (this->get_launcher()->get_is_async())
     {
@@ -24,7 +24,13 @@
 #include <vp/itf/wire.hpp>
 #include <stdio.h>
 #include <string.h>
+#include <vp/proxy.hpp>
 #include "memory_memcheck.hpp"
+#include "memory_store.hpp"
+
+// Memories bigger than this are granted direct accesses by chunks of this size when their pages
+// are tracked, so that the pages are touched before they are accessed
+#define MEMORY_DMI_CHUNK_SIZE (1ULL << 20)
 
 
 class Memory : public vp::Component
@@ -34,8 +40,11 @@ public:
     Memory(vp::ComponentConf &config);
 
     void reset(bool active);
+    std::string handle_command(gv::GvProxy *proxy, FILE *req_file, FILE *reply_file,
+        std::vector<std::string> args, std::string cmd_req) override;
 
     static vp::IoReqStatus req(vp::Block *__this, vp::IoReq *req);
+    static bool dmi_req(vp::Block *__this, uint64_t addr, vp::IoDmi *dmi);
 
     uint64_t memcheck_alloc(uint64_t ptr, uint64_t size);
     uint64_t memcheck_free(uint64_t ptr, uint64_t size);
@@ -45,6 +54,7 @@ private:
     static void meminfo_sync_back(vp::Block *__this, void **value);
     static void meminfo_sync(vp::Block *__this, void *value);
     static void memcheck_sync(vp::Block *__this, MemoryMemcheckBuffer *info);
+    static vp::IoReqStatus handle_req(Memory *_this, vp::IoReq *req);
     vp::IoReqStatus handle_write(uint64_t addr, uint64_t size, uint8_t *data, uint8_t *memcheck_data);
     vp::IoReqStatus handle_read(uint64_t addr, uint64_t size, uint8_t *data, uint8_t *memcheck_data);
     vp::IoReqStatus handle_atomic(uint64_t addr, uint64_t size, uint8_t *in_data, uint8_t *out_data,
@@ -64,6 +74,11 @@ private:
     int width_bits = 0;
     int latency;
 
+    // Backing stores of the memory and of the memcheck arrays
+    MemoryStore store;
+    MemoryStore memcheck_store;
+    MemoryStore memcheck_valid_store;
+
     uint8_t *mem_data;
     uint8_t *memcheck_data = NULL;
     uint8_t *check_mem;
@@ -104,6 +119,8 @@ Memory::Memory(vp::ComponentConf &config)
 {
     traces.new_trace("trace", &trace, vp::DEBUG);
     in.set_req_meth(&Memory::req);
+    in.set_dmi_meth(&Memory::dmi_req);
+    in.set_vectored(true);
     new_slave_port("input", &in);
 
     this->power_ctrl_itf.set_sync_meth(&Memory::power_ctrl_sync);
@@ -132,18 +149,21 @@ Memory::Memory(vp::ComponentConf &config)
     this->width_bits = get_js_config()->get_child_int("width_bits");
     this->latency = get_js_config()->get_child_int("latency");
     int align = get_js_config()->get_child_int("align");
+    bool track_pages = get_js_config()->get_child_bool("track_pages");
 
     trace.msg("Building Memory (size: 0x%x, check: %d)\n", size, check);
 
-    if (align)
-    {
-        mem_data = (uint8_t *)aligned_alloc(align, size);
-    }
-    else
+    // Initialize the Memory with a special value to detect uninitialized
+    // variables.
+    // Only do it for small memories, since big ones are often expected to be cleared by
+    // software relying on them being zero.
+    // Pages are only allocated and initialized when they are touched for the first time.
+    int poison = size < (2<<24) ? 0x57 : -1;
+    if (!this->store.alloc(size, align, poison, track_pages))
     {
-        mem_data = (uint8_t *)calloc(size, 1);
-        if (mem_data == NULL) throw std::bad_alloc();
+        throw std::bad_alloc();
     }
+    mem_data = this->store.get_data();
 
     // Special option to check for uninitialized accesses
     if (check)
@@ -157,8 +177,8 @@ Memory::Memory(vp::ComponentConf &config)
 
     if (this->traces.get_trace_engine()->is_memcheck_enabled())
     {
-        this->memcheck_data = (uint8_t *)calloc(size, 1);
-        if (this->memcheck_data == NULL) throw std::bad_alloc();
+        if (!this->memcheck_store.alloc(size, 0, -1, false)) throw std::bad_alloc();
+        this->memcheck_data = this->memcheck_store.get_data();
 
         int memcheck_id = this->get_js_config()->get_child_int("memcheck_id");
         if (memcheck_id != -1)
@@ -168,22 +188,14 @@ Memory::Memory(vp::ComponentConf &config)
 
             this->memcheck_expansion_factor = this->get_js_config()->get_child_int("memcheck_expansion_factor");
             int memcheck_size = size * this->memcheck_expansion_factor;
-            this->memcheck_valid_flags = (uint8_t *)calloc((memcheck_size + 7) / 8, 1);
-            if (this->memcheck_valid_flags == NULL) throw std::bad_alloc();
+            if (!this->memcheck_valid_store.alloc((memcheck_size + 7) / 8, 0, -1, false)) throw std::bad_alloc();
+            this->memcheck_valid_flags = this->memcheck_valid_store.get_data();
 
             this->memcheck_base = this->get_js_config()->get_child_int("memcheck_base");
             this->memcheck_virtual_base = this->get_js_config()->get_child_int("memcheck_virtual_base");
         }
     }
 
-    // Initialize the Memory with a special value to detect uninitialized
-    // variables.
-    // Only do it for small memories to not slow down too much simulation init.
-    if (size < (2<<24))
-    {
-        memset(mem_data, 0x57, size);
-    }
-
     // Preload the Memory
     js::Config *stim_file_conf = this->get_js_config()->get("stim_file");
     if (stim_file_conf != NULL)
@@ -193,15 +205,11 @@ Memory::Memory(vp::ComponentConf &config)
         {
             trace.msg("Preloading Memory with stimuli file (path: %s)\n", path.c_str());
 
-            FILE *file = fopen(path.c_str(), "rb");
-            if (file == NULL)
-            {
-                this->trace.fatal("Unable to open stim file: %s, %s\n", path.c_str(), strerror(errno));
-                return;
-            }
-            if (fread(this->mem_data, 1, size, file) == 0)
+            // The file is mapped instead of being read, so that only the pages which are
+            // accessed are loaded, and only the ones which are written are copied
+            if (!this->store.map_file(path, get_js_config()->get_child_bool("writeback")))
             {
-                this->trace.fatal("Failed to read stim file: %s, %s\n", path.c_str(), strerror(errno));
+                this->trace.fatal("Unable to map stim file: %s, %s\n", path.c_str(), strerror(errno));
                 return;
             }
         }
@@ -218,6 +226,20 @@ vp::IoReqStatus Memory::req(vp::Block *__this, vp::IoReq *req)
 {
     Memory *_this = (Memory *)__this;
 
+    // All segments of vectored requests are handled in this call, each one being timed as a
+    // scalar request
+    if (req->is_vectored())
+    {
+        return req->handle_segments([_this](vp::IoReq *req) { return Memory::handle_req(_this, req); });
+    }
+
+    return Memory::handle_req(_this, req);
+}
+
+
+
+vp::IoReqStatus Memory::handle_req(Memory *_this, vp::IoReq *req)
+{
     uint64_t offset = req->get_addr();
     uint8_t *data = req->get_data();
     uint64_t size = req->get_size();
@@ -361,6 +383,7 @@ vp::IoReqStatus Memory::handle_write(uint64_t offset, uint64_t size, uint8_t *da
 
     if (data)
     {
+        this->store.touch(offset, size);
         memcpy((void *)&this->mem_data[offset], (void *)data, size);
     }
 
@@ -538,6 +561,7 @@ vp::IoReqStatus Memory::handle_read(uint64_t offset, uint64_t size, uint8_t *dat
 
     if (data)
     {
+        this->store.touch(offset, size);
         memcpy((void *)data, (void *)&this->mem_data[offset], size);
     }
 
@@ -640,6 +664,43 @@ vp::IoReqStatus Memory::handle_atomic(uint64_t addr, uint64_t size, uint8_t *in_
 
 
 
+bool Memory::dmi_req(vp::Block *__this, uint64_t addr, vp::IoDmi *dmi)
+{
+    Memory *_this = (Memory *)__this;
+
+    // Direct accesses are not possible if the memory must see every access, either to check
+    // them, to model its bandwidth, or to account power
+    if (_this->check_mem != NULL || _this->memcheck_data != NULL || _this->power_trigger ||
+        _this->width_bits != 0 || _this->power.get_power_trace()->get_active() ||
+        !_this->powered_up || addr >= _this->size)
+    {
+        return false;
+    }
+
+    _this->trace.msg(vp::Trace::LEVEL_DEBUG, "Granting direct access (offset: 0x%lx)\n", addr);
+
+    dmi->base = 0;
+    dmi->size = _this->size;
+
+    // Accesses through the grant are not seen, so the pages must be touched before. Only grant
+    // a chunk around the address to not touch the whole memory.
+    if (_this->store.is_tracked() && _this->size > MEMORY_DMI_CHUNK_SIZE)
+    {
+        dmi->base = addr & ~(MEMORY_DMI_CHUNK_SIZE - 1);
+        dmi->size = std::min<uint64_t>(MEMORY_DMI_CHUNK_SIZE, _this->size - dmi->base);
+    }
+    _this->store.touch(dmi->base, dmi->size);
+
+    dmi->data = _this->mem_data + dmi->base;
+    dmi->read = true;
+    dmi->write = true;
+    dmi->latency = _this->latency;
+
+    return true;
+}
+
+
+
 void Memory::reset(bool active)
 {
     if (active)
@@ -651,9 +712,55 @@ void Memory::reset(bool active)
 
 
 
+std::string Memory::handle_command(gv::GvProxy *proxy, FILE *req_file, FILE *reply_file,
+    std::vector<std::string> args, std::string cmd_req)
+{
+    // Report the pages which were touched, and optionally dump the bitmap to a file
+    if (args[0] == "touched_pages")
+    {
+        if (!this->store.is_tracked())
+        {
+            return "err=1;msg=pages are not tracked";
+        }
+
+        if (args.size() > 1)
+        {
+            const std::vector<uint64_t> &bitmap = this->store.get_touched_bitmap();
+            FILE *file = fopen(args[1].c_str(), "wb");
+            if (file == NULL)
+            {
+                return "err=1;msg=failed to open file";
+            }
+            bool written = fwrite(bitmap.data(), sizeof(uint64_t), bitmap.size(), file) ==
+                bitmap.size();
+            written = fclose(file) == 0 && written;
+            if (!written)
+            {
+                return "err=1;msg=failed to write file";
+            }
+        }
+
+        return "err=0;page_size=" + std::to_string(MEMORY_STORE_PAGE_SIZE) +
+            ";nb_pages=" + std::to_string(this->store.get_nb_pages()) +
+            ";nb_touched=" + std::to_string(this->store.get_nb_touched_pages());
+    }
+
+    return "err=1;msg=unknown command";
+}
+
+
+
 void Memory::power_ctrl_sync(vp::Block *__this, bool value)
 {
     Memory *_this = (Memory *)__this;
+
+    // Writes must be ignored while the memory is powered down, which is not possible with
+    // direct accesses. Also invalidate when powering up so that refused accesses get asked again.
+    if (value != _this->powered_up)
+    {
+        _this->in.dmi_invalidate(0, _this->size);
+    }
+
     _this->powered_up = value;
 }
 
@@ -662,6 +769,8 @@ void Memory::power_ctrl_sync(vp::Block *__this, bool value)
 void Memory::meminfo_sync_back(vp::Block *__this, void **value)
 {
     Memory *_this = (Memory *)__this;
+    // The other model accesses the data directly
+    _this->store.touch_all();
     *value = _this->mem_data;
 }
 
@@ -670,7 +779,9 @@ void Memory::meminfo_sync_back(vp::Block *__this, void **value)
 void Memory::meminfo_sync(vp::Block *__this, void *value)
 {
     Memory *_this = (Memory *)__this;
+    _this->store.untrack();
     _this->mem_data = (uint8_t *)value;
+    _this->in.dmi_invalidate(0, _this->size);
 }
 
 
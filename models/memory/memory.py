@@ -38,7 +38,11 @@ class Memory(gvsoc.systree.Component):
         bandwidth.
     stim_file: str
         The path to a binary file which should be preloaded at beginning of the memory. The format
-        is a raw binary, and is loaded with an fread.
+        is a raw binary, and is mapped copy-on-write, so that the file is never modified.
+    writeback: bool
+        True if the stim file should instead become the persistent content of the memory, so that
+        everything written to the memory ends up in the file. The file is created if it does not
+        exist.
     power_trigger: bool
         True if the memory should trigger power report generation based on dedicated accesses.
     align: int
@@ -56,15 +60,20 @@ class Memory(gvsoc.systree.Component):
         Absolute virtual base of allocated buffers.
     memcheck_expansion_factor: int
         Extra size used to track buffer overflow.
+    track_pages: bool
+        True if the pages touched by the simulation should be tracked, so that they can be
+        reported through the proxy for checkpointing or statistics. Pages are anyway tracked for
+        memories whose content is initialized lazily.
     """
     def __init__(self, parent: gvsoc.systree.Component, name: str, size: int, width_log2: int=2,
             stim_file: str=None, power_trigger: bool=False,
             align: int=0, atomics: bool=False, latency=0, memcheck_id: int=-1, memcheck_base: int=0,
-            memcheck_virtual_base: int=0, memcheck_expansion_factor: int=5):
+            memcheck_virtual_base: int=0, memcheck_expansion_factor: int=5,
+            track_pages: bool=False, writeback: bool=False):
 
         super().__init__(parent, name)
 
-        self.add_sources(['memory/memory.cpp'])
+        self.add_sources(['memory/memory.cpp', 'memory/memory_store.cpp'])
 
         # Since atomics are slowing down the model, this is better to compile the support only
         # if needed. Note that the framework will take care of compiling this model twice
@@ -83,6 +92,8 @@ class Memory(gvsoc.systree.Component):
             'memcheck_base': memcheck_base,
             'memcheck_virtual_base': memcheck_virtual_base,
             'memcheck_expansion_factor': memcheck_expansion_factor,
+            'track_pages': track_pages,
+            'writeback': writeback,
         })
 
     def i_INPUT(self) -> gvsoc.systree.SlaveItf:
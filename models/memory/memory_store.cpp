@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <vp/mmap_file.hpp>
+#include "memory_store.hpp"
+
+
+MemoryStore::~MemoryStore()
+{
+    if (this->map)
+    {
+        munmap(this->map, this->map_size);
+    }
+}
+
+bool MemoryStore::alloc(uint64_t size, uint64_t align, int poison, bool track)
+{
+    // The mapping is page aligned, bigger alignments are obtained by mapping more
+    uint64_t extra = align > MEMORY_STORE_PAGE_SIZE ? align : 0;
+
+    this->map_size = std::max<uint64_t>(size + extra, 1);
+    this->map = mmap(NULL, this->map_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (this->map == MAP_FAILED)
+    {
+        this->map = NULL;
+        return false;
+    }
+
+    this->data = (uint8_t *)this->map;
+    if (extra)
+    {
+        this->data += (align - ((uintptr_t)this->data & (align - 1))) & (align - 1);
+    }
+
+    this->size = size;
+    this->poison = poison;
+    this->tracked = track || (poison != -1 && size > MEMORY_STORE_EAGER_POISON_SIZE);
+
+    if (this->tracked)
+    {
+        this->touched.resize((this->get_nb_pages() + 63) / 64);
+    }
+    else if (poison != -1)
+    {
+        memset(this->data, poison, size);
+    }
+
+    return true;
+}
+
+bool MemoryStore::map_file(std::string path, bool shared)
+{
+    int64_t mapped = vp::mmap_file(this->data, this->size, path, shared);
+    if (mapped == -1)
+    {
+        return false;
+    }
+
+    // The end of the last host page containing the file reads as zeros, poison it as if the file
+    // had been read into the store. With shared mappings, this is part of the persistent content.
+    uint64_t end = mapped;
+    if (!shared && this->poison != -1)
+    {
+        uint64_t host_page_size = sysconf(_SC_PAGESIZE);
+        end = std::min<uint64_t>((mapped + host_page_size - 1) & ~(host_page_size - 1), this->size);
+        memset(this->data + mapped, this->poison, end - mapped);
+    }
+
+    // Pages coming from the file must not be poisoned when they are touched
+    if (this->tracked && end != 0)
+    {
+        this->populate(0, (end - 1) >> MEMORY_STORE_PAGE_BITS, false);
+    }
+
+    return true;
+}
+
+void MemoryStore::touch_all()
+{
+    if (this->tracked && this->size != 0)
+    {
+        this->populate(0, this->get_nb_pages() - 1);
+    }
+}
+
+void MemoryStore::untrack()
+{
+    this->tracked = false;
+}
+
+void MemoryStore::populate(uint64_t first_page, uint64_t last_page, bool init)
+{
+    for (uint64_t page = first_page; page <= last_page; page++)
+    {
+        uint64_t *word = &this->touched[page >> 6];
+        uint64_t bit = 1ULL << (page & 63);
+
+        if (!(*word & bit))
+        {
+            if (init && this->poison != -1)
+            {
+                uint64_t offset = page << MEMORY_STORE_PAGE_BITS;
+                uint64_t size = std::min<uint64_t>(MEMORY_STORE_PAGE_SIZE, this->size - offset);
+                memset(this->data + offset, this->poison, size);
+            }
+
+            *word |= bit;
+            this->nb_touched++;
+        }
+    }
+}
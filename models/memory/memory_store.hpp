@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Size of the pages which are tracked
+#define MEMORY_STORE_PAGE_BITS 12
+#define MEMORY_STORE_PAGE_SIZE (1ULL << MEMORY_STORE_PAGE_BITS)
+
+// Memories up to this size which must be poisoned are poisoned when they are allocated, since
+// this is cheap and avoids checking pages on every access
+#define MEMORY_STORE_EAGER_POISON_SIZE (1ULL << 20)
+
+
+/**
+ * @brief Backing store of a memory model
+ *
+ * The store is reserved with mmap without committing swap space, so that the host only
+ * allocates the pages the simulated software actually accesses. Big memories thus cost neither
+ * startup time nor host memory for the areas which are never accessed.
+ *
+ * When the memory must be initialized with a poison value to detect uninitialized data, the
+ * poison is written page per page the first time each one is touched, which is tracked with a
+ * bitmap. The bitmap can also be enabled without poison, to know which pages were used, for
+ * example for checkpointing or statistics.
+ *
+ * Models must call touch before accessing the data directly, which is free when pages are not
+ * tracked.
+ */
+class MemoryStore
+{
+public:
+    ~MemoryStore();
+
+    // Allocate the store. Poison is the value of the bytes of the pages when they are touched
+    // for the first time, or -1 to keep them to 0. Track forces the touched bitmap.
+    // Returns false if the store could not be allocated.
+    bool alloc(uint64_t size, uint64_t align, int poison, bool track);
+    // Preload the store with a file, which is mapped over it instead of being read, see
+    // vp::mmap_file. With shared, the file becomes the persistent content of the whole store.
+    // Returns false if the file could not be mapped, in which case errno gives the reason.
+    bool map_file(std::string path, bool shared);
+
+    inline uint8_t *get_data() { return this->data; }
+
+    // Must be called before accessing directly the specified area
+    inline void touch(uint64_t offset, uint64_t size);
+    // Touch all pages, for example when the data pointer is given to another model which will
+    // access it without calling touch
+    void touch_all();
+    // Stop tracking pages, for example when the data pointer is replaced by another one
+    void untrack();
+
+    // Tell if touched pages are tracked, in which case the bitmap is available
+    inline bool is_tracked() { return this->tracked; }
+    // Bitmap of the touched pages, one bit per page, page 0 being bit 0 of the first word
+    inline const std::vector<uint64_t> &get_touched_bitmap() { return this->touched; }
+    inline uint64_t get_nb_pages() { return (this->size + MEMORY_STORE_PAGE_SIZE - 1) >> MEMORY_STORE_PAGE_BITS; }
+    inline uint64_t get_nb_touched_pages() { return this->nb_touched; }
+
+private:
+    void populate(uint64_t first_page, uint64_t last_page, bool init=true);
+
+    // Mapping as returned by mmap, which may start before the data for alignment
+    void *map = NULL;
+    uint64_t map_size = 0;
+    uint8_t *data = NULL;
+    uint64_t size = 0;
+    int poison = -1;
+    bool tracked = false;
+    std::vector<uint64_t> touched;
+    uint64_t nb_touched = 0;
+};
+
+
+inline void MemoryStore::touch(uint64_t offset, uint64_t size)
+{
+    if (__builtin_expect(this->tracked, 0) && size != 0)
+    {
+        uint64_t first_page = offset >> MEMORY_STORE_PAGE_BITS;
+        uint64_t last_page = (offset + size - 1) >> MEMORY_STORE_PAGE_BITS;
+
+        if (first_page != last_page || !((this->touched[first_page >> 6] >> (first_page & 63)) & 1))
+        {
+            this->populate(first_page, last_page);
+        }
+    }
+}